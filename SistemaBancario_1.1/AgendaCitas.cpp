@@ -0,0 +1,744 @@
+/**
+ * @file AgendaCitas.cpp
+ * @brief Implementación del almacén indexado de citas presenciales.
+ */
+
+#include "AgendaCitas.h"
+#include "CalendarioBancario.h"
+#include "ReemplazoArchivo.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+/**
+ * @brief Constructor de la estructura CitaAgendada
+ */
+CitaAgendada::CitaAgendada(const std::string& dni, const std::string& nombre, const std::string& tel,
+                           int suc_id, const std::string& suc_nombre, const std::string& sec,
+                           const std::string& fecha_h, const std::string& num_conf,
+                           const std::string& fecha_ag, bool act)
+    : dni(dni), nombre_completo(nombre), telefono(tel), sucursal_id(suc_id),
+      sucursal_nombre(suc_nombre), sector(sec), fecha_hora(fecha_h),
+      numero_confirmacion(num_conf), fecha_agendamiento(fecha_ag), activa(act) {}
+
+/**
+ * @brief Orden por sector, sucursal y día.
+ */
+bool AgendaCitas::ClaveAgenda::operator<(const ClaveAgenda& otra) const {
+    return std::tie(sector, sucursal_id, dia) < std::tie(otra.sector, otra.sucursal_id, otra.dia);
+}
+
+/**
+ * @brief Hash FNV-1a del texto convertido a mayúsculas.
+ */
+size_t AgendaCitas::HashSinMayusculas::operator()(std::string_view texto) const {
+    size_t hash = 1469598103934665603ull;
+    for (unsigned char c : texto) {
+        hash = (hash ^ static_cast<size_t>(std::toupper(c))) * 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Compara dos textos sin distinguir mayúsculas.
+ */
+bool AgendaCitas::IgualSinMayusculas::operator()(std::string_view a, std::string_view b) const {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (std::toupper(static_cast<unsigned char>(a[i])) != std::toupper(static_cast<unsigned char>(b[i]))) return false;
+    }
+    return true;
+}
+
+namespace {
+
+/**
+ * @brief Escribe un entero al final de un búfer, con el orden de bytes de la máquina.
+ */
+template <typename T>
+void escribirEntero(std::string& buffer, T valor) {
+    buffer.append(reinterpret_cast<const char*>(&valor), sizeof(T));
+}
+
+/**
+ * @brief Escribe una cadena al final de un búfer, precedida por su longitud (uint16).
+ */
+void escribirCadena(std::string& buffer, const std::string& texto) {
+    if (texto.size() > 0xFFFF) throw std::length_error("Campo de cita demasiado largo");
+    escribirEntero<uint16_t>(buffer, static_cast<uint16_t>(texto.size()));
+    buffer.append(texto);
+}
+
+/**
+ * @brief Cursor de lectura sobre un búfer, con verificación de límites.
+ */
+class LectorBinario {
+public:
+    LectorBinario(const std::string& datos, size_t posicion, size_t fin)
+        : datos(datos), posicion(posicion), fin(fin) {}
+
+    template <typename T>
+    T entero() {
+        T valor;
+        std::memcpy(&valor, bytes(sizeof(T)), sizeof(T));
+        return valor;
+    }
+
+    std::string cadena() {
+        uint16_t longitud = entero<uint16_t>();
+        return std::string(bytes(longitud), longitud);
+    }
+
+    const char* bytes(size_t cantidad) {
+        if (cantidad > fin - posicion) throw std::runtime_error("Archivo de citas truncado");
+        const char* inicio = datos.data() + posicion;
+        posicion += cantidad;
+        return inicio;
+    }
+
+    size_t getPosicion() const { return posicion; }
+
+private:
+    const std::string& datos;
+    size_t posicion;
+    size_t fin;
+};
+
+/**
+ * @brief Tabla de cadenas internadas: cada texto distinto se guarda una sola vez.
+ */
+class TablaCadenas {
+public:
+    uint32_t indice(const std::string& texto) {
+        auto it = indices.find(texto);
+        if (it != indices.end()) return it->second;
+        uint32_t nuevo = static_cast<uint32_t>(cadenas.size());
+        indices.emplace(texto, nuevo);
+        cadenas.push_back(texto);
+        return nuevo;
+    }
+
+    const std::vector<std::string>& getCadenas() const { return cadenas; }
+
+private:
+    std::unordered_map<std::string, uint32_t> indices;
+    std::vector<std::string> cadenas;
+};
+
+const char* const DIAS_SEMANA[] = {"Dom", "Lun", "Mar", "Mié", "Jue", "Vie", "Sáb"};
+
+} // namespace
+
+/**
+ * @brief Constructor por defecto. Crea una agenda vacía asociada a "citas_agendadas.dat".
+ */
+AgendaCitas::AgendaCitas()
+    : archivo("citas_agendadas.dat"), archivo_listo(false), archivo_bloqueado(false), activas(0), cancelaciones_anexadas(0) {}
+
+/**
+ * @brief Carga la agenda desde un archivo binario, leyéndolo completo y recorriéndolo una sola vez.
+ * @param archivo Archivo de citas
+ * @return true si se cargó, false si el archivo no existe o no es un archivo de citas válido
+ */
+bool AgendaCitas::cargar(const std::string& archivo) {
+    this->archivo = archivo;
+    archivo_listo = false;
+    archivo_bloqueado = false;
+    limpiar();
+    try {
+        std::ifstream file(archivo, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false; // Archivo no existe, es normal al inicio
+        }
+        std::string datos(static_cast<size_t>(file.tellg()), '\0');
+        file.seekg(0);
+        file.read(&datos[0], static_cast<std::streamsize>(datos.size()));
+        file.close();
+
+        // Tras un registro incompleto no se puede anexar: el archivo se reescribe sin él antes de usarlo
+        if (!leerRegistros(datos, leerInstantanea(datos))) {
+            compactar();
+            return true;
+        }
+        archivo_listo = true;
+        compactarSiConviene();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en cargar citas: " << e.what() << std::endl;
+        limpiar();
+        // La próxima cita escribiría una agenda vacía sobre el archivo: se conserva aparte
+        std::string danado = archivo + ".danado";
+        std::remove(danado.c_str());
+        if (std::rename(archivo.c_str(), danado.c_str()) == 0) {
+            std::cerr << "Error en cargar citas: el archivo se conservó como " << danado << std::endl;
+        } else {
+            archivo_bloqueado = true;
+        }
+        return false;
+    }
+}
+
+/**
+ * @brief Reemplaza la agenda con las citas de un archivo de texto y las guarda en el archivo binario actual.
+ * @param archivo_texto Archivo en formato de texto
+ * @return true si se importó y se guardó
+ */
+bool AgendaCitas::importarTexto(const std::string& archivo_texto) {
+    try {
+        std::ifstream file(archivo_texto);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        limpiar();
+        std::string line;
+        std::vector<std::string> campos;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+
+            campos.clear();
+            size_t inicio = 0;
+            while (true) {
+                size_t fin = line.find('|', inicio);
+                campos.push_back(line.substr(inicio, fin - inicio));
+                if (fin == std::string::npos) break;
+                inicio = fin + 1;
+            }
+
+            if (campos.size() == 10) {
+                indexar(CitaAgendada(campos[0], campos[1], campos[2], std::stoi(campos[3]), campos[4],
+                                     campos[5], campos[6], campos[7], campos[8], campos[9] == "1"));
+            } else if (campos.size() == 3 && campos[0] == "B") {
+                desactivar(campos[1], campos[2]);
+            }
+        }
+        file.close();
+        return compactar();
+    } catch (const std::exception& e) {
+        std::cerr << "Error en importar citas: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+/**
+ * @brief Escribe la agenda en formato de texto (una línea por cita).
+ * @param archivo_texto Archivo destino
+ * @return true si se escribió
+ */
+bool AgendaCitas::exportarTexto(const std::string& archivo_texto) const {
+    try {
+        std::ofstream file(archivo_texto, std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        for (const auto& cita : citas) {
+            file << lineaTexto(cita) << '\n';
+        }
+        file.close();
+        return static_cast<bool>(file);
+    } catch (const std::exception& e) {
+        std::cerr << "Error en exportar citas: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+/**
+ * @brief Agrega una cita, la indexa y anexa su registro al archivo.
+ * @param cita Cita a agregar
+ * @return true si se agregó y se escribió en el archivo
+ */
+bool AgendaCitas::agregar(const CitaAgendada& cita) {
+    try {
+        if (!anexar(REGISTRO_ALTA, registroAlta(cita))) return false;
+        indexar(cita);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en agregar cita: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+/**
+ * @brief Cancela la cita activa de un cliente con el número de confirmación dado.
+ * @param dni DNI del cliente
+ * @param numero_confirmacion Número de confirmación (sin distinguir mayúsculas)
+ * @return true si se canceló, false si no existe una cita activa con esos datos
+ */
+bool AgendaCitas::cancelar(const std::string& dni, const std::string& numero_confirmacion) {
+    bool existe = false;
+    auto rango = por_dni.equal_range(dni);
+    for (auto it = rango.first; it != rango.second; ++it) {
+        if (IgualSinMayusculas()(citas[it->second].numero_confirmacion, numero_confirmacion)) {
+            existe = true;
+            break;
+        }
+    }
+    if (!existe) return false;
+
+    try {
+        std::string datos;
+        escribirCadena(datos, dni);
+        escribirCadena(datos, numero_confirmacion);
+        if (!anexar(REGISTRO_BAJA, datos)) return false;
+        desactivar(dni, numero_confirmacion);
+        cancelaciones_anexadas++;
+        compactarSiConviene();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en cancelar cita: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+/**
+ * @brief Indica si un cliente tiene al menos una cita activa.
+ */
+bool AgendaCitas::tieneCitaActiva(const std::string& dni) const {
+    return por_dni.find(dni) != por_dni.end();
+}
+
+/**
+ * @brief Busca una cita (activa o no) por número de confirmación.
+ */
+const CitaAgendada* AgendaCitas::buscarPorConfirmacion(const std::string& numero_confirmacion) const {
+    auto rango = por_confirmacion.equal_range(numero_confirmacion);
+    if (rango.first == rango.second) return nullptr;
+    size_t ultima = rango.first->second;
+    for (auto it = rango.first; it != rango.second; ++it) ultima = std::max(ultima, it->second);
+    return &citas[ultima];
+}
+
+/**
+ * @brief Obtiene las citas activas de un cliente, en orden de agendamiento.
+ */
+std::vector<const CitaAgendada*> AgendaCitas::citasActivasDe(const std::string& dni) const {
+    std::vector<size_t> posiciones;
+    auto rango = por_dni.equal_range(dni);
+    for (auto it = rango.first; it != rango.second; ++it) posiciones.push_back(it->second);
+    std::sort(posiciones.begin(), posiciones.end());
+
+    std::vector<const CitaAgendada*> resultado;
+    resultado.reserve(posiciones.size());
+    for (size_t posicion : posiciones) resultado.push_back(&citas[posicion]);
+    return resultado;
+}
+
+/**
+ * @brief Obtiene las citas activas de un sector (todas si el sector está vacío).
+ */
+std::vector<const CitaAgendada*> AgendaCitas::citasPorSector(const std::string& sector) const {
+    std::vector<const CitaAgendada*> resultado;
+    auto it = sector.empty() ? por_agenda.begin() : por_agenda.lower_bound(ClaveAgenda{sector, INT_MIN, SIN_DIA});
+    for (; it != por_agenda.end() && (sector.empty() || it->first.sector == sector); ++it) {
+        for (size_t posicion : it->second) resultado.push_back(&citas[posicion]);
+    }
+    return resultado;
+}
+
+/**
+ * @brief Obtiene las citas activas de una sucursal en un día.
+ */
+std::vector<const CitaAgendada*> AgendaCitas::citasPorSucursalYDia(const std::string& sector, int sucursal_id,
+                                                                   long dia) const {
+    std::vector<const CitaAgendada*> resultado;
+    auto it = por_agenda.find(ClaveAgenda{sector, sucursal_id, dia});
+    if (it == por_agenda.end()) return resultado;
+    resultado.reserve(it->second.size());
+    for (size_t posicion : it->second) resultado.push_back(&citas[posicion]);
+    return resultado;
+}
+
+/**
+ * @brief Cantidad de citas activas.
+ */
+size_t AgendaCitas::getCantidadActivas() const {
+    return activas;
+}
+
+/**
+ * @brief Día y minuto de una cita, con el año deducido de la fecha de agendamiento.
+ */
+bool AgendaCitas::fechaDe(const CitaAgendada& cita, long& dia, int& minuto) {
+    size_t espacio = cita.fecha_hora.find(' ');
+    if (espacio == std::string::npos) return false;
+    int dia_mes, mes, hora, minutos;
+    int dia_ag, mes_ag, anio_ag;
+    if (std::sscanf(cita.fecha_hora.c_str() + espacio + 1, "%2d/%2d %2d:%2d", &dia_mes, &mes, &hora, &minutos) != 4 ||
+        std::sscanf(cita.fecha_agendamiento.c_str(), "%2d/%2d/%4d", &dia_ag, &mes_ag, &anio_ag) != 3 ||
+        dia_mes < 1 || dia_mes > 31 || mes < 1 || mes > 12 || hora < 0 || hora > 23 || minutos < 0 || minutos > 59) {
+        return false;
+    }
+    dia = CalendarioBancario::diasDesdeCivil(anio_ag, mes, dia_mes);
+    if (dia < CalendarioBancario::diasDesdeCivil(anio_ag, mes_ag, dia_ag)) {
+        dia = CalendarioBancario::diasDesdeCivil(anio_ag + 1, mes, dia_mes);
+    }
+    minuto = hora * 60 + minutos;
+    return true;
+}
+
+/**
+ * @brief Reescribe el archivo actual como instantánea, descartando los registros anexados.
+ */
+bool AgendaCitas::compactar() {
+    return guardarComo(archivo);
+}
+
+/**
+ * @brief Escribe la instantánea binaria de la agenda en un archivo.
+ * @details Se escribe primero un archivo temporal y luego se reemplaza el destino, de modo que una
+ *          falla a mitad de la escritura no deja el archivo de citas truncado.
+ */
+bool AgendaCitas::guardarComo(const std::string& destino) {
+    if (archivo_bloqueado && destino == archivo) {
+        std::cerr << "Error en guardar citas: " << archivo << " no se pudo cargar y no se reemplaza" << std::endl;
+        return false;
+    }
+    try {
+        std::string temporal = destino + ".tmp";
+        std::ofstream file(temporal, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        std::string datos = instantanea();
+        file.write(datos.data(), static_cast<std::streamsize>(datos.size()));
+        file.close();
+        if (!file) {
+            std::remove(temporal.c_str());
+            return false;
+        }
+
+        if (!reemplazarArchivo(temporal, destino)) {
+            std::remove(temporal.c_str());
+            return false;
+        }
+        if (destino == archivo) {
+            cancelaciones_anexadas = 0;
+            archivo_listo = true;
+        }
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en guardar citas: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+/**
+ * @brief Vacía la agenda en memoria (no modifica el archivo).
+ */
+void AgendaCitas::limpiar() {
+    citas.clear();
+    por_dni.clear();
+    por_confirmacion.clear();
+    por_agenda.clear();
+    activas = 0;
+    cancelaciones_anexadas = 0;
+}
+
+/**
+ * @brief Agrega una cita en memoria y la incorpora a los índices.
+ */
+void AgendaCitas::indexar(CitaAgendada cita) {
+    size_t posicion = citas.size();
+    citas.push_back(std::move(cita));
+    const CitaAgendada& guardada = citas.back();
+    por_confirmacion.emplace(guardada.numero_confirmacion, posicion);
+    if (guardada.activa) {
+        por_dni.emplace(guardada.dni, posicion);
+        por_agenda[claveDe(guardada)].push_back(posicion);
+        activas++;
+    }
+}
+
+/**
+ * @brief Marca como cancelada la cita activa de un cliente con ese número y la quita de los índices de activas.
+ */
+bool AgendaCitas::desactivar(const std::string& dni, const std::string& numero_confirmacion) {
+    auto rango = por_dni.equal_range(dni);
+    for (auto it = rango.first; it != rango.second; ++it) {
+        size_t posicion = it->second;
+        CitaAgendada& cita = citas[posicion];
+        if (!IgualSinMayusculas()(cita.numero_confirmacion, numero_confirmacion)) continue;
+
+        cita.activa = false;
+        activas--;
+        auto agenda = por_agenda.find(claveDe(cita));
+        quitar(agenda->second, posicion);
+        if (agenda->second.empty()) por_agenda.erase(agenda);
+        por_dni.erase(it);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Anexa un registro al archivo actual (escribe antes la instantánea si el archivo no existe).
+ */
+bool AgendaCitas::anexar(uint8_t tipo, const std::string& datos) {
+    if (!archivo_listo && !compactar()) {
+        return false;
+    }
+    std::string registro;
+    registro.reserve(datos.size() + 5);
+    escribirEntero<uint8_t>(registro, tipo);
+    escribirEntero<uint32_t>(registro, static_cast<uint32_t>(datos.size()));
+    registro.append(datos);
+
+    std::ofstream file(archivo, std::ios::binary | std::ios::app);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(registro.data(), static_cast<std::streamsize>(registro.size()));
+    file.close();
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Lee la instantánea por columnas desde el inicio de un búfer.
+ * @return Posición del primer registro anexado
+ */
+size_t AgendaCitas::leerInstantanea(const std::string& datos) {
+    LectorBinario lector(datos, 0, datos.size());
+    if (lector.entero<uint32_t>() != MAGIA) throw std::runtime_error("No es un archivo de citas");
+    if (lector.entero<uint32_t>() != VERSION) throw std::runtime_error("Versión de archivo de citas no soportada");
+
+    std::vector<std::string> cadenas(lector.entero<uint32_t>());
+    for (auto& cadena : cadenas) cadena = lector.cadena();
+    auto cadena = [&](uint32_t indice) -> const std::string& {
+        if (indice >= cadenas.size()) throw std::runtime_error("Índice de cadena inválido");
+        return cadenas[indice];
+    };
+
+    uint32_t total = lector.entero<uint32_t>();
+    std::vector<std::string> dnis(total), nombres(total), telefonos(total), confirmaciones(total);
+    std::vector<int32_t> sucursales(total);
+    std::vector<uint32_t> nombres_sucursal(total), sectores(total), fechas_hora(total), fechas(total);
+    for (auto& dni : dnis) dni = lector.cadena();
+    for (auto& nombre : nombres) nombre = lector.cadena();
+    for (auto& telefono : telefonos) telefono = lector.cadena();
+    for (auto& sucursal : sucursales) sucursal = lector.entero<int32_t>();
+    for (auto& indice : nombres_sucursal) indice = lector.entero<uint32_t>();
+    for (auto& indice : sectores) indice = lector.entero<uint32_t>();
+    for (auto& fecha_hora : fechas_hora) fecha_hora = lector.entero<uint32_t>();
+    for (auto& confirmacion : confirmaciones) confirmacion = lector.cadena();
+    for (auto& fecha : fechas) fecha = lector.entero<uint32_t>();
+    const char* activas_bits = lector.bytes((total + 7) / 8);
+
+    por_dni.reserve(total);
+    por_confirmacion.reserve(total);
+    const std::string vacia;
+    for (uint32_t i = 0; i < total; i++) {
+        CitaAgendada cita(vacia, vacia, vacia, sucursales[i], cadena(nombres_sucursal[i]), cadena(sectores[i]),
+                          vacia, vacia, vacia, (activas_bits[i / 8] >> (i % 8)) & 1);
+        cita.dni = std::move(dnis[i]);
+        cita.nombre_completo = std::move(nombres[i]);
+        cita.telefono = std::move(telefonos[i]);
+        cita.fecha_hora = (fechas_hora[i] & FECHA_INTERNADA)
+            ? cadena(fechas_hora[i] & ~FECHA_INTERNADA) : desempaquetarFechaHora(fechas_hora[i]);
+        cita.numero_confirmacion = std::move(confirmaciones[i]);
+        cita.fecha_agendamiento = (fechas[i] & FECHA_INTERNADA)
+            ? cadena(fechas[i] & ~FECHA_INTERNADA) : desempaquetarFecha(fechas[i]);
+        indexar(std::move(cita));
+    }
+    return lector.getPosicion();
+}
+
+/**
+ * @brief Reproduce los registros anexados a partir de una posición del búfer.
+ * @details Un registro final incompleto corresponde a una escritura interrumpida y se descarta.
+ */
+bool AgendaCitas::leerRegistros(const std::string& datos, size_t posicion) {
+    while (posicion < datos.size()) {
+        LectorBinario cabecera(datos, posicion, datos.size());
+        uint8_t tipo;
+        uint32_t longitud;
+        try {
+            tipo = cabecera.entero<uint8_t>();
+            longitud = cabecera.entero<uint32_t>();
+            cabecera.bytes(longitud);
+        } catch (const std::runtime_error&) {
+            std::cerr << "Error en cargar citas: se descarta un registro incompleto al final del archivo" << std::endl;
+            return false;
+        }
+
+        LectorBinario lector(datos, posicion + 5, posicion + 5 + longitud);
+        if (tipo == REGISTRO_ALTA) {
+            std::string dni = lector.cadena(), nombre = lector.cadena(), telefono = lector.cadena();
+            int32_t sucursal_id = lector.entero<int32_t>();
+            std::string sucursal = lector.cadena(), sector = lector.cadena(), fecha_hora = lector.cadena();
+            std::string confirmacion = lector.cadena(), fecha = lector.cadena();
+            bool activa = lector.entero<uint8_t>() != 0;
+            indexar(CitaAgendada(dni, nombre, telefono, sucursal_id, sucursal, sector, fecha_hora,
+                                 confirmacion, fecha, activa));
+        } else if (tipo == REGISTRO_BAJA) {
+            std::string dni = lector.cadena();
+            std::string confirmacion = lector.cadena();
+            desactivar(dni, confirmacion);
+            cancelaciones_anexadas++;
+        } else {
+            throw std::runtime_error("Tipo de registro de citas desconocido");
+        }
+        posicion += 5 + longitud;
+    }
+    return true;
+}
+
+/**
+ * @brief Instantánea por columnas de la agenda, con cabecera.
+ */
+std::string AgendaCitas::instantanea() const {
+    TablaCadenas tabla;
+    std::vector<uint32_t> nombres_sucursal, sectores, fechas_hora, fechas;
+    nombres_sucursal.reserve(citas.size());
+    sectores.reserve(citas.size());
+    fechas_hora.reserve(citas.size());
+    fechas.reserve(citas.size());
+    for (const auto& cita : citas) {
+        nombres_sucursal.push_back(tabla.indice(cita.sucursal_nombre));
+        sectores.push_back(tabla.indice(cita.sector));
+        uint32_t fecha_hora = empaquetarFechaHora(cita.fecha_hora);
+        fechas_hora.push_back(fecha_hora != FECHA_INTERNADA ? fecha_hora
+                                                            : (FECHA_INTERNADA | tabla.indice(cita.fecha_hora)));
+        uint32_t fecha = empaquetarFecha(cita.fecha_agendamiento);
+        fechas.push_back(fecha != FECHA_INTERNADA ? fecha : (FECHA_INTERNADA | tabla.indice(cita.fecha_agendamiento)));
+    }
+
+    std::string datos;
+    escribirEntero<uint32_t>(datos, MAGIA);
+    escribirEntero<uint32_t>(datos, VERSION);
+    escribirEntero<uint32_t>(datos, static_cast<uint32_t>(tabla.getCadenas().size()));
+    for (const auto& cadena : tabla.getCadenas()) escribirCadena(datos, cadena);
+
+    escribirEntero<uint32_t>(datos, static_cast<uint32_t>(citas.size()));
+    for (const auto& cita : citas) escribirCadena(datos, cita.dni);
+    for (const auto& cita : citas) escribirCadena(datos, cita.nombre_completo);
+    for (const auto& cita : citas) escribirCadena(datos, cita.telefono);
+    for (const auto& cita : citas) escribirEntero<int32_t>(datos, cita.sucursal_id);
+    for (uint32_t indice : nombres_sucursal) escribirEntero<uint32_t>(datos, indice);
+    for (uint32_t indice : sectores) escribirEntero<uint32_t>(datos, indice);
+    for (uint32_t fecha_hora : fechas_hora) escribirEntero<uint32_t>(datos, fecha_hora);
+    for (const auto& cita : citas) escribirCadena(datos, cita.numero_confirmacion);
+    for (uint32_t fecha : fechas) escribirEntero<uint32_t>(datos, fecha);
+    std::string activas_bits((citas.size() + 7) / 8, '\0');
+    for (size_t i = 0; i < citas.size(); i++) {
+        if (citas[i].activa) activas_bits[i / 8] |= static_cast<char>(1 << (i % 8));
+    }
+    datos.append(activas_bits);
+    return datos;
+}
+
+/**
+ * @brief Compacta el archivo si las cancelaciones anexadas superan la cuarta parte de las citas.
+ * @details Con este umbral cada compactación reescribe a lo sumo unas cuatro líneas por cancelación
+ *          acumulada, por lo que su costo amortizado por operación es constante.
+ */
+void AgendaCitas::compactarSiConviene() {
+    if (cancelaciones_anexadas >= MIN_COMPACTACION && cancelaciones_anexadas * 4 >= citas.size()) {
+        compactar();
+    }
+}
+
+/**
+ * @brief Clave de índice sector/sucursal/día de una cita.
+ */
+AgendaCitas::ClaveAgenda AgendaCitas::claveDe(const CitaAgendada& cita) {
+    long dia;
+    int minuto;
+    if (!fechaDe(cita, dia, minuto)) dia = SIN_DIA;
+    return ClaveAgenda{cita.sector, cita.sucursal_id, dia};
+}
+
+/**
+ * @brief Datos del registro de alta de una cita.
+ */
+std::string AgendaCitas::registroAlta(const CitaAgendada& cita) {
+    std::string datos;
+    escribirCadena(datos, cita.dni);
+    escribirCadena(datos, cita.nombre_completo);
+    escribirCadena(datos, cita.telefono);
+    escribirEntero<int32_t>(datos, cita.sucursal_id);
+    escribirCadena(datos, cita.sucursal_nombre);
+    escribirCadena(datos, cita.sector);
+    escribirCadena(datos, cita.fecha_hora);
+    escribirCadena(datos, cita.numero_confirmacion);
+    escribirCadena(datos, cita.fecha_agendamiento);
+    escribirEntero<uint8_t>(datos, cita.activa ? 1 : 0);
+    return datos;
+}
+
+/**
+ * @brief Línea de texto de una cita.
+ */
+std::string AgendaCitas::lineaTexto(const CitaAgendada& cita) {
+    return cita.dni + "|" + cita.nombre_completo + "|" + cita.telefono + "|" +
+           std::to_string(cita.sucursal_id) + "|" + cita.sucursal_nombre + "|" + cita.sector + "|" +
+           cita.fecha_hora + "|" + cita.numero_confirmacion + "|" + cita.fecha_agendamiento + "|" +
+           (cita.activa ? "1" : "0");
+}
+
+/**
+ * @brief Empaqueta "Www DD/MM HH:MM" en un entero (día de la semana, mes, día, hora y minuto).
+ * @details Solo se empaqueta si al desempaquetar se obtiene exactamente el mismo texto.
+ */
+uint32_t AgendaCitas::empaquetarFechaHora(const std::string& fecha_hora) {
+    size_t espacio = fecha_hora.find(' ');
+    if (espacio == std::string::npos) return FECHA_INTERNADA;
+    int dia_semana = -1;
+    for (int i = 0; i < 7; i++) {
+        if (fecha_hora.compare(0, espacio, DIAS_SEMANA[i]) == 0) dia_semana = i;
+    }
+    int dia, mes, hora, minuto;
+    if (dia_semana < 0 || std::sscanf(fecha_hora.c_str() + espacio + 1, "%2d/%2d %2d:%2d", &dia, &mes, &hora, &minuto) != 4 ||
+        dia < 1 || dia > 31 || mes < 1 || mes > 12 || hora < 0 || hora > 23 || minuto < 0 || minuto > 59) {
+        return FECHA_INTERNADA;
+    }
+    uint32_t valor = (uint32_t)dia_semana << 20 | (uint32_t)mes << 16 | (uint32_t)dia << 11 | (uint32_t)hora << 6 | (uint32_t)minuto;
+    return desempaquetarFechaHora(valor) == fecha_hora ? valor : FECHA_INTERNADA;
+}
+
+/**
+ * @brief Texto de una fecha y hora empaquetada.
+ */
+std::string AgendaCitas::desempaquetarFechaHora(uint32_t valor) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), " %02u/%02u %02u:%02u", (valor >> 11) & 31, (valor >> 16) & 15,
+                  (valor >> 6) & 31, valor & 63);
+    return DIAS_SEMANA[((valor >> 20) & 7) % 7] + std::string(buffer);
+}
+
+/**
+ * @brief Empaqueta "DD/MM/AAAA" en un entero (año, mes y día).
+ * @details Solo se empaqueta si al desempaquetar se obtiene exactamente el mismo texto.
+ */
+uint32_t AgendaCitas::empaquetarFecha(const std::string& fecha) {
+    int dia, mes, anio;
+    if (std::sscanf(fecha.c_str(), "%2d/%2d/%4d", &dia, &mes, &anio) != 3 ||
+        dia < 1 || dia > 31 || mes < 1 || mes > 12 || anio < 0 || anio > 9999) {
+        return FECHA_INTERNADA;
+    }
+    uint32_t valor = (uint32_t)anio << 9 | (uint32_t)mes << 5 | (uint32_t)dia;
+    return desempaquetarFecha(valor) == fecha ? valor : FECHA_INTERNADA;
+}
+
+/**
+ * @brief Texto de una fecha empaquetada.
+ */
+std::string AgendaCitas::desempaquetarFecha(uint32_t valor) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%02u/%02u/%04u", valor & 31, (valor >> 5) & 15, (valor >> 9) & 0x3FFF);
+    return buffer;
+}
+
+/**
+ * @brief Quita una posición de una lista de posiciones.
+ */
+void AgendaCitas::quitar(std::vector<size_t>& posiciones, size_t posicion) {
+    auto it = std::find(posiciones.begin(), posiciones.end(), posicion);
+    if (it != posiciones.end()) posiciones.erase(it);
+}
@@ -0,0 +1,292 @@
+/**
+ * @file AgendaCitas.h
+ * @brief Definición de la estructura CitaAgendada y de la clase AgendaCitas, almacén indexado de citas presenciales.
+ *
+ * Las citas se indexan por DNI, por número de confirmación y por sector/sucursal/día, y se persisten en un
+ * archivo binario: una instantánea por columnas seguida de un registro de solo anexado, de modo que agendar o
+ * cancelar escribe un único registro al final del archivo. El archivo se compacta (reescribe como instantánea)
+ * solo cuando acumula suficientes cancelaciones. El formato de texto anterior se conserva para importar/exportar.
+ */
+
+#ifndef AGENDACITAS_H_INCLUDED
+#define AGENDACITAS_H_INCLUDED
+
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Estructura para almacenar información de citas agendadas
+ * @details Esta estructura mantiene registro de todas las citas presenciales
+ *          agendadas para evitar duplicados y permitir consultas por sector
+ */
+struct CitaAgendada {
+    std::string dni;                    ///< DNI del cliente que agendó la cita
+    std::string nombre_completo;        ///< Nombre completo del cliente
+    std::string telefono;               ///< Teléfono del cliente
+    int sucursal_id;                    ///< ID de la sucursal donde se agendó
+    std::string sucursal_nombre;        ///< Nombre de la sucursal
+    std::string sector;                 ///< Sector/zona de la sucursal
+    std::string fecha_hora;             ///< Fecha y hora de la cita
+    std::string numero_confirmacion;    ///< Número de confirmación de la cita
+    std::string fecha_agendamiento;     ///< Fecha cuando se agendó la cita
+    bool activa;                        ///< Estado de la cita (activa/cancelada)
+
+    /**
+     * @brief Constructor de la estructura CitaAgendada
+     * @param dni DNI del cliente
+     * @param nombre Nombre completo del cliente
+     * @param tel Teléfono del cliente
+     * @param suc_id ID de la sucursal
+     * @param suc_nombre Nombre de la sucursal
+     * @param sec Sector de la sucursal
+     * @param fecha_h Fecha y hora de la cita
+     * @param num_conf Número de confirmación
+     * @param fecha_ag Fecha de agendamiento
+     * @param act Estado activo de la cita
+     */
+    CitaAgendada(const std::string& dni, const std::string& nombre, const std::string& tel,
+                 int suc_id, const std::string& suc_nombre, const std::string& sec,
+                 const std::string& fecha_h, const std::string& num_conf,
+                 const std::string& fecha_ag, bool act = true);
+};
+
+/**
+ * @class AgendaCitas
+ * @brief Citas presenciales indexadas, con persistencia por registro de anexado.
+ *
+ * Las citas se guardan en un deque, por lo que los punteros devueltos por las consultas siguen siendo
+ * válidos al agendar o cancelar (hasta el próximo cargar() o limpiar()); por lo mismo, las claves de los
+ * índices son vistas (string_view) sobre los campos de las citas guardadas y no copias. Las citas canceladas
+ * se conservan como historial pero salen de los índices de citas activas.
+ *
+ * Formato binario (enteros en el orden de bytes de la máquina):
+ * - Cabecera: MAGIA y VERSION (uint32).
+ * - Instantánea: tabla de cadenas internadas (nombres de sucursal, sectores y fechas sin formato conocido) y,
+ *   por columnas, DNI, nombre, teléfono, ID de sucursal, sucursal y sector (índices en la tabla), fecha y hora
+ *   empaquetada, confirmación, fecha de agendamiento empaquetada y un mapa de bits de citas activas.
+ * - Registro: entradas "tipo (uint8) + longitud (uint32) + datos", ALTA con la cita completa o BAJA con DNI y
+ *   confirmación. Una entrada final incompleta (corte durante la escritura) se descarta al cargar.
+ *
+ * Formato de texto: cada cita es una línea "dni|nombre|telefono|sucursal_id|sucursal|sector|fecha_hora|
+ * confirmacion|fecha_agendamiento|activa" y cada cancelación posterior una línea "B|dni|confirmacion".
+ */
+class AgendaCitas {
+public:
+    static const size_t MIN_COMPACTACION = 64; ///< Cancelaciones anexadas a partir de las cuales se considera compactar
+    static const uint32_t MAGIA = 0x41544943;   ///< "CITA" al inicio del archivo binario
+    static const uint32_t VERSION = 1;          ///< Versión del formato binario
+
+    /**
+     * @brief Constructor por defecto. Crea una agenda vacía asociada a "citas_agendadas.dat".
+     */
+    AgendaCitas();
+
+    /**
+     * @brief Carga la agenda desde un archivo binario, leyéndolo completo y recorriéndolo una sola vez.
+     * @param archivo Archivo de citas; pasa a ser el archivo donde se anexan los cambios
+     * @return true si se cargó, false si el archivo no existe o no es un archivo de citas válido
+     * @note Un archivo inválido se aparta como "<archivo>.danado" antes de que una cita nueva lo reemplace;
+     *       si no se puede apartar, la agenda no vuelve a escribir en él.
+     */
+    bool cargar(const std::string& archivo);
+    /**
+     * @brief Reemplaza la agenda con las citas de un archivo de texto y las guarda en el archivo binario actual.
+     * @param archivo_texto Archivo en formato de texto (altas y líneas "B|dni|confirmacion")
+     * @return true si se importó y se guardó
+     */
+    bool importarTexto(const std::string& archivo_texto);
+    /**
+     * @brief Escribe la agenda en formato de texto (una línea por cita).
+     * @param archivo_texto Archivo destino
+     * @return true si se escribió
+     */
+    bool exportarTexto(const std::string& archivo_texto) const;
+    /**
+     * @brief Agrega una cita, la indexa y anexa su registro al archivo.
+     * @param cita Cita a agregar
+     * @return true si se agregó y se escribió en el archivo
+     */
+    bool agregar(const CitaAgendada& cita);
+    /**
+     * @brief Cancela la cita activa de un cliente con el número de confirmación dado.
+     * @param dni DNI del cliente
+     * @param numero_confirmacion Número de confirmación (sin distinguir mayúsculas)
+     * @return true si se canceló, false si no existe una cita activa con esos datos
+     */
+    bool cancelar(const std::string& dni, const std::string& numero_confirmacion);
+
+    /**
+     * @brief Indica si un cliente tiene al menos una cita activa.
+     */
+    bool tieneCitaActiva(const std::string& dni) const;
+    /**
+     * @brief Busca una cita (activa o no) por número de confirmación.
+     * @param numero_confirmacion Número de confirmación (sin distinguir mayúsculas)
+     * @return Puntero a la cita más reciente con ese número, nullptr si no existe
+     */
+    const CitaAgendada* buscarPorConfirmacion(const std::string& numero_confirmacion) const;
+    /**
+     * @brief Obtiene las citas activas de un cliente, en orden de agendamiento.
+     */
+    std::vector<const CitaAgendada*> citasActivasDe(const std::string& dni) const;
+    /**
+     * @brief Obtiene las citas activas de un sector (todas si el sector está vacío).
+     * @return Citas agrupadas por sector, sucursal y día
+     */
+    std::vector<const CitaAgendada*> citasPorSector(const std::string& sector) const;
+    /**
+     * @brief Obtiene las citas activas de una sucursal en un día.
+     * @param sector Sector de la sucursal
+     * @param sucursal_id ID de la sucursal
+     * @param dia Día de la cita, como días desde 1970-01-01 (ver fechaDe())
+     */
+    std::vector<const CitaAgendada*> citasPorSucursalYDia(const std::string& sector, int sucursal_id, long dia) const;
+    /**
+     * @brief Cantidad de citas activas.
+     */
+    size_t getCantidadActivas() const;
+    /**
+     * @brief Día y minuto de una cita. La fecha y hora ("Www DD/MM HH:MM") no trae año: se toma el de la
+     *        fecha de agendamiento, o el siguiente si ese día ya había pasado (cita de enero agendada en diciembre).
+     * @param cita Cita a consultar
+     * @param dia Recibe la fecha como días desde 1970-01-01
+     * @param minuto Recibe el minuto del día
+     * @return false si la fecha y hora o la fecha de agendamiento no tienen el formato esperado
+     */
+    static bool fechaDe(const CitaAgendada& cita, long& dia, int& minuto);
+
+    /**
+     * @brief Reescribe el archivo actual como instantánea, descartando los registros anexados.
+     * @return true si se reescribió
+     */
+    bool compactar();
+    /**
+     * @brief Escribe la instantánea binaria de la agenda en un archivo.
+     * @param archivo Archivo destino; si es el archivo actual equivale a compactar()
+     * @return true si se escribió
+     */
+    bool guardarComo(const std::string& archivo);
+    /**
+     * @brief Vacía la agenda en memoria (no modifica el archivo).
+     */
+    void limpiar();
+
+private:
+    /**
+     * @struct ClaveAgenda
+     * @brief Sector, sucursal y día de una cita, ordenados en ese orden.
+     */
+    struct ClaveAgenda {
+        std::string_view sector;
+        int sucursal_id;
+        long dia; ///< Días desde 1970-01-01 (SIN_DIA si la fecha de la cita no tiene el formato esperado)
+        bool operator<(const ClaveAgenda& otra) const;
+    };
+    /**
+     * @struct HashSinMayusculas
+     * @brief Hash de texto que no distingue mayúsculas (números de confirmación).
+     */
+    struct HashSinMayusculas {
+        size_t operator()(std::string_view texto) const;
+    };
+    /**
+     * @struct IgualSinMayusculas
+     * @brief Comparación de texto que no distingue mayúsculas (números de confirmación).
+     */
+    struct IgualSinMayusculas {
+        bool operator()(std::string_view a, std::string_view b) const;
+    };
+
+    std::deque<CitaAgendada> citas; ///< Todas las citas, en orden de agendamiento
+    std::unordered_multimap<std::string_view, size_t> por_dni; ///< DNI -> posiciones de sus citas activas
+    std::unordered_multimap<std::string_view, size_t, HashSinMayusculas, IgualSinMayusculas> por_confirmacion; ///< Confirmación -> posiciones
+    std::map<ClaveAgenda, std::vector<size_t>> por_agenda; ///< Sector/sucursal/día -> posiciones de citas activas
+    std::string archivo;        ///< Archivo donde se anexan los cambios
+    bool archivo_listo;         ///< El archivo actual tiene una instantánea válida a la que anexar
+    bool archivo_bloqueado;     ///< El archivo no se pudo cargar ni apartar: no se escribe sobre él
+    size_t activas;             ///< Citas activas
+    size_t cancelaciones_anexadas; ///< Registros de cancelación que una compactación eliminaría
+
+    static const uint8_t REGISTRO_ALTA = 'A'; ///< Tipo de registro anexado: cita nueva
+    static const uint8_t REGISTRO_BAJA = 'B'; ///< Tipo de registro anexado: cancelación
+
+    /**
+     * @brief Agrega una cita en memoria y la incorpora a los índices.
+     */
+    void indexar(CitaAgendada cita);
+    /**
+     * @brief Marca como cancelada la cita activa de un cliente con ese número y la quita de los índices de activas.
+     * @return true si existía
+     */
+    bool desactivar(const std::string& dni, const std::string& numero_confirmacion);
+    /**
+     * @brief Anexa un registro al archivo actual (escribe antes la instantánea si el archivo no existe).
+     * @param tipo REGISTRO_ALTA o REGISTRO_BAJA
+     * @param datos Datos del registro
+     */
+    bool anexar(uint8_t tipo, const std::string& datos);
+    /**
+     * @brief Lee la instantánea por columnas desde el inicio de un búfer.
+     * @return Posición del primer registro anexado
+     * @throws std::runtime_error si el búfer no contiene una instantánea válida
+     */
+    size_t leerInstantanea(const std::string& datos);
+    /**
+     * @brief Reproduce los registros anexados a partir de una posición del búfer.
+     * @return true si el búfer termina con un registro completo, false si se descartó un registro final incompleto
+     */
+    bool leerRegistros(const std::string& datos, size_t posicion);
+    /**
+     * @brief Instantánea por columnas de la agenda, con cabecera.
+     */
+    std::string instantanea() const;
+    /**
+     * @brief Compacta el archivo si las cancelaciones anexadas superan la cuarta parte de las citas.
+     */
+    void compactarSiConviene();
+    /**
+     * @brief Clave de índice sector/sucursal/día de una cita.
+     */
+    static ClaveAgenda claveDe(const CitaAgendada& cita);
+    /**
+     * @brief Datos del registro de alta de una cita.
+     */
+    static std::string registroAlta(const CitaAgendada& cita);
+    /**
+     * @brief Línea de texto de una cita.
+     */
+    static std::string lineaTexto(const CitaAgendada& cita);
+    /**
+     * @brief Empaqueta "Www DD/MM HH:MM" en un entero.
+     * @return Valor empaquetado, o FECHA_INTERNADA si el texto no tiene exactamente ese formato
+     */
+    static uint32_t empaquetarFechaHora(const std::string& fecha_hora);
+    /**
+     * @brief Texto de una fecha y hora empaquetada.
+     */
+    static std::string desempaquetarFechaHora(uint32_t valor);
+    /**
+     * @brief Empaqueta "DD/MM/AAAA" en un entero.
+     * @return Valor empaquetado, o FECHA_INTERNADA si el texto no tiene exactamente ese formato
+     */
+    static uint32_t empaquetarFecha(const std::string& fecha);
+    /**
+     * @brief Texto de una fecha empaquetada.
+     */
+    static std::string desempaquetarFecha(uint32_t valor);
+
+    static const uint32_t FECHA_INTERNADA = 0x80000000u; ///< Bit que indica que la fecha es un índice de la tabla de cadenas
+    static const long SIN_DIA = LONG_MIN; ///< Día de índice de las citas cuya fecha no se puede interpretar
+    /**
+     * @brief Quita una posición de una lista de posiciones.
+     */
+    static void quitar(std::vector<size_t>& posiciones, size_t posicion);
+};
+
+#endif
@@ -79,6 +79,7 @@ double Ahorro::get_tasa_interes() {
  */
 void Ahorro::set_tasa_interes(double _tasa) {
     tasa_interes = _tasa;
+    modificada = true;
 }
 
 /**
@@ -93,103 +94,3 @@ std::string Ahorro::to_string() {
     return "Cuenta Ahorros: ID=" + id_cuenta + ", Saldo=" + std::to_string(saldo) +
            ", Fecha Apertura=" + fecha_apertura.to_string() + ", Tasa Interés=" + std::to_string(tasa_interes) + "%";
 }
-
-/**
- * @brief Guarda los datos de la cuenta de ahorro en formato binario
- * @param archivo Puntero al archivo donde se guardará la información
- * @details Serializa todos los datos de la cuenta de ahorro en formato binario,
- *          incluyendo ID, saldo, tasa de interés, fecha de apertura, branchId,
- *          tiempo de cita y lista de movimientos. Maneja excepciones durante
- *          el proceso de escritura.
- * @throw std::runtime_error Si el archivo no es válido o hay errores de escritura
- * @warning El archivo debe estar abierto en modo binario de escritura
- */
-void Ahorro::guardar_binario(FILE* archivo) {
-    try {
-        // Validar que el archivo sea válido para escritura
-        if (!archivo) throw std::runtime_error("Archivo no válido para escritura");
-        
-        // Guardar el ID de la cuenta (primero la longitud, luego el contenido)
-        size_t len = id_cuenta.length();
-        fwrite(&len, sizeof(size_t), 1, archivo);
-        fwrite(id_cuenta.c_str(), sizeof(char), len + 1, archivo);
-        
-        // Guardar datos básicos de la cuenta
-        fwrite(&saldo, sizeof(double), 1, archivo);
-        fwrite(&tasa_interes, sizeof(double), 1, archivo);
-        fwrite(&fecha_apertura, sizeof(Fecha), 1, archivo);
-        
-        // Guardar información de sucursal y cita
-        fwrite(&branchId, sizeof(int), 1, archivo);
-        time_t tt = std::chrono::system_clock::to_time_t(appointmentTime);
-        fwrite(&tt, sizeof(time_t), 1, archivo);
-        
-        // Guardar lista de movimientos
-        int num_movimientos = 0;
-        movimientos->recorrer([&](Movimiento) { num_movimientos++; });
-        fwrite(&num_movimientos, sizeof(int), 1, archivo);
-        movimientos->recorrer([&](Movimiento m) { m.guardar_binario(archivo); });
-    } catch (const std::exception& e) {
-        std::cerr << "Error en guardar_binario: " << e.what() << std::endl;
-    }
-}
-
-/**
- * @brief Carga los datos de la cuenta de ahorro desde un archivo binario
- * @param archivo Puntero al archivo desde donde se cargarán los datos
- * @details Deserializa todos los datos de la cuenta de ahorro desde formato binario,
- *          incluyendo ID, saldo, tasa de interés, fecha de apertura, branchId,
- *          tiempo de cita y lista de movimientos. Maneja excepciones durante
- *          el proceso de lectura y recrea la estructura de datos completa.
- * @throw std::runtime_error Si el archivo no es válido o hay errores de lectura
- * @warning El archivo debe estar abierto en modo binario de lectura
- * @note Libera la memoria de movimientos existentes antes de cargar nuevos datos
- */
-void Ahorro::cargar_binario(FILE* archivo) {
-    try {
-        // Validar que el archivo sea válido para lectura
-        if (!archivo) throw std::runtime_error("Archivo no válido para lectura");
-        
-        // Cargar el ID de la cuenta
-        size_t len;
-        if (fread(&len, sizeof(size_t), 1, archivo) != 1) throw std::runtime_error("Error al leer longitud de id_cuenta");
-        char* buffer = new char[len + 1];
-        if (fread(buffer, sizeof(char), len + 1, archivo) != len + 1) {
-            delete[] buffer;
-            throw std::runtime_error("Error al leer id_cuenta");
-        }
-        id_cuenta = std::string(buffer);
-        delete[] buffer;
-        
-        // Cargar datos básicos de la cuenta
-        if (fread(&saldo, sizeof(double), 1, archivo) != 1) throw std::runtime_error("Error al leer saldo");
-        if (fread(&tasa_interes, sizeof(double), 1, archivo) != 1) throw std::runtime_error("Error al leer tasa_interes");
-        if (fread(&fecha_apertura, sizeof(Fecha), 1, archivo) != 1) throw std::runtime_error("Error al leer fecha_apertura");
-        
-        // Cargar información de sucursal y cita
-        if (fread(&branchId, sizeof(int), 1, archivo) != 1) throw std::runtime_error("Error al leer branchId");
-        time_t tt;
-        if (fread(&tt, sizeof(time_t), 1, archivo) != 1) throw std::runtime_error("Error al leer appointmentTime");
-        appointmentTime = std::chrono::system_clock::from_time_t(tt);
-        
-        // Cargar lista de movimientos
-        int num_movimientos;
-        if (fread(&num_movimientos, sizeof(int), 1, archivo) != 1) throw std::runtime_error("Error al leer número de movimientos");
-        
-        // Liberar memoria existente y crear nueva lista
-        if (movimientos) {
-            delete movimientos;
-        }
-        movimientos = new ListaDoble<Movimiento>();
-        
-        // Cargar cada movimiento individualmente
-        for (int i = 0; i < num_movimientos; i++) {
-            Movimiento movimiento;
-            movimiento.cargar_binario(archivo);
-            movimientos->insertar_cola(movimiento);
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "Error en cargar_binario: " << e.what() << std::endl;
-        throw;
-    }
-}
\ No newline at end of file
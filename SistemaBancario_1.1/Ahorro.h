@@ -45,16 +45,6 @@ public:
      * @return Cadena con la información de la cuenta en formato legible.
      */
     std::string to_string() override;
-    /**
-     * @brief Guarda los datos de la cuenta en un archivo binario.
-     * @param archivo Puntero al archivo donde se guardarán los datos.
-     */
-    void guardar_binario(FILE* archivo) override;
-     /**
-     * @brief Carga los datos de la cuenta desde un archivo binario.
-     * @param archivo Puntero al archivo desde donde se leerán los datos.
-     */
-    void cargar_binario(FILE* archivo) override;
 private:
     double tasa_interes;
 };
@@ -1,11 +1,16 @@
 /**
  * @file ArbolBinario.cpp
- * @brief Implementación de las funciones para el manejo de árboles binarios y AVL de clientes.
+ * @brief Implementación de la visualización de los árboles Rojo-Negro de clientes.
  *
- * Este archivo contiene la implementación de las funciones para la creación, inserción,
- * balanceo y visualización de árboles binarios y AVL, utilizados para organizar y mostrar
+ * Este archivo contiene las funciones de visualización de los árboles Rojo-Negro que el banco
+ * mantiene por campo (ver MapaRojoNegro e IndiceClientes), utilizados para organizar y mostrar
  * clientes en el sistema bancario. Incluye algoritmos para impresión en formato ASCII y
  * utilidades para estadísticas y manejo de memoria.
+ *
+ * Ambas vistas trabajan por ventanas: la consola muestra unos pocos niveles a partir del nodo
+ * elegido y la ventana SFML solo recorre los subárboles que caen dentro de la vista, ubicando
+ * cada nodo por su posición en orden (tamaños de subárbol). Así siguen siendo interactivas con
+ * millones de clientes.
  */
 
 #include "ArbolBinario.h"
@@ -47,6 +52,9 @@ int rprofile[MAX_HEIGHT];
 int print_next;
 int gap = 3;
 
+/// Niveles mostrados por página en la vista ASCII
+const int NIVELES_VENTANA_ASCII = 4;
+
 // Clase para nodos ASCII
 class asciinode_struct {
 public:
@@ -60,32 +68,8 @@ public:
 
 typedef class asciinode_struct asciinode;
 
-// Enum para los colores del árbol Rojo-Negro
-enum Color { RED, BLACK };
-
-/**
- * @class Tree
- * @brief Nodo de un árbol Rojo-Negro de clientes.
- *
- * Esta clase representa un nodo de un árbol Rojo-Negro, utilizado para almacenar y organizar
- * clientes según diferentes campos (DNI, nombre, apellido, teléfono o email).
- * Cada nodo contiene un puntero al cliente, el valor del campo por el que se ordena,
- * punteros a los hijos izquierdo y derecho, y el color para el balanceo Rojo-Negro.
- */
-class Tree {
-public:
-    Tree* left, *right; ///< Punteros a los hijos izquierdo y derecho
-    Tree* parent;       ///< Puntero al nodo padre
-    string element;     ///< Valor del campo por el que se ordena
-    Cliente* cliente;   ///< Puntero al cliente asociado
-    Color color;        ///< Color del nodo (RED o BLACK)
-    /**
-     * @brief Constructor de Tree
-     * @param elem Valor del campo por el que se ordena
-     * @param cli Puntero al cliente asociado
-     */
-    Tree(string elem, Cliente* cli) : element(elem), cliente(cli), left(nullptr), right(nullptr), parent(nullptr), color(RED) {}
-};
+/// Nodo del árbol Rojo-Negro de clientes que mantiene el banco (ver IndiceClientes)
+typedef ArbolClientes::Nodo Tree;
 
 // Función para obtener el valor a mostrar según el campo
 /**
@@ -115,41 +99,6 @@ string obtener_valor_campo(Cliente* cliente, int campo) {
     }
 }
 
-/**
- * @brief Inserta un nodo en un árbol binario de búsqueda (BST).
- * @param nodo Nodo raíz actual
- * @param valor Valor a insertar
- * @param cliente Puntero al cliente
- * @param campo Campo por el que se ordena
- * @return Nueva raíz del subárbol
- */
-Tree* insertar_bst(Tree* nodo, string valor, Cliente* cliente, int campo) {
-    if (!nodo) {
-        return new Tree(valor, cliente);
-    }
-    
-    string valor_nodo = obtener_valor_campo(nodo->cliente, campo);
-    
-    // Comparación para diferentes tipos de datos
-    bool menor = false;
-    if (campo == 0 || campo == 3) { // DNI o Teléfono (numérico)
-        menor = stoi(valor) < stoi(valor_nodo);
-    } else { // Texto (nombres, apellidos, email)
-        string val_lower = valor, nodo_lower = valor_nodo;
-        transform(val_lower.begin(), val_lower.end(), val_lower.begin(), ::tolower);
-        transform(nodo_lower.begin(), nodo_lower.end(), nodo_lower.begin(), ::tolower);
-        menor = val_lower < nodo_lower;
-    }
-    
-    if (menor) {
-        nodo->left = insertar_bst(nodo->left, valor, cliente, campo);
-    } else {
-        nodo->right = insertar_bst(nodo->right, valor, cliente, campo);
-    }
-    
-    return nodo;
-}
-
 /**
  * @brief Crea una etiqueta truncada para visualización en el árbol ASCII.
  * @param valor Valor original
@@ -163,283 +112,21 @@ string crear_etiqueta(string valor) {
     }
 }
 
-// FUNCIONES PARA ÁRBOL ROJO-NEGRO
-
-// Nodo NIL para el árbol Rojo-Negro
-Tree* NIL = nullptr;
-
-/**
- * @brief Inicializa el nodo NIL para el árbol Rojo-Negro.
- */
-void inicializar_nil() {
-    if (NIL == nullptr) {
-        NIL = new Tree("", nullptr);
-        NIL->color = BLACK;
-        NIL->left = NIL->right = NIL->parent = nullptr;
-    }
-}
-
-/**
- * @brief Obtiene el color de un nodo.
- * @param nodo Nodo a consultar
- * @return Color del nodo (BLACK si es nulo)
- */
-Color obtener_color(Tree* nodo) {
-    if (nodo == nullptr || nodo == NIL) return BLACK;
-    return nodo->color;
-}
-
-/**
- * @brief Establece el color de un nodo.
- * @param nodo Nodo a modificar
- * @param color Color a establecer
- */
-void establecer_color(Tree* nodo, Color color) {
-    if (nodo != nullptr && nodo != NIL) {
-        nodo->color = color;
-    }
-}
-
-/**
- * @brief Realiza una rotación a la izquierda en un subárbol Rojo-Negro.
- * @param raiz Referencia a la raíz del árbol
- * @param x Nodo sobre el que realizar la rotación
- */
-void rotacion_izquierda_rb(Tree*& raiz, Tree* x) {
-    Tree* y = x->right;
-    x->right = y->left;
-    
-    if (y->left != NIL && y->left != nullptr) {
-        y->left->parent = x;
-    }
-    
-    y->parent = x->parent;
-    
-    if (x->parent == nullptr) {
-        raiz = y;
-    } else if (x == x->parent->left) {
-        x->parent->left = y;
-    } else {
-        x->parent->right = y;
-    }
-    
-    y->left = x;
-    x->parent = y;
-}
-
-/**
- * @brief Realiza una rotación a la derecha en un subárbol Rojo-Negro.
- * @param raiz Referencia a la raíz del árbol
- * @param y Nodo sobre el que realizar la rotación
- */
-void rotacion_derecha_rb(Tree*& raiz, Tree* y) {
-    Tree* x = y->left;
-    y->left = x->right;
-    
-    if (x->right != NIL && x->right != nullptr) {
-        x->right->parent = y;
-    }
-    
-    x->parent = y->parent;
-    
-    if (y->parent == nullptr) {
-        raiz = x;
-    } else if (y == y->parent->left) {
-        y->parent->left = x;
-    } else {
-        y->parent->right = x;
-    }
-    
-    x->right = y;
-    y->parent = x;
-}
-
-/**
- * @brief Corrige las violaciones de las propiedades Rojo-Negro después de la inserción.
- * @param raiz Referencia a la raíz del árbol
- * @param z Nodo recién insertado
- */
-void arreglar_insercion_rb(Tree*& raiz, Tree* z) {
-    while (z != raiz && obtener_color(z->parent) == RED) {
-        if (z->parent == z->parent->parent->left) {
-            Tree* y = z->parent->parent->right; // Tío
-            
-            if (obtener_color(y) == RED) {
-                // Caso 1: El tío es rojo
-                establecer_color(z->parent, BLACK);
-                establecer_color(y, BLACK);
-                establecer_color(z->parent->parent, RED);
-                z = z->parent->parent;
-            } else {
-                if (z == z->parent->right) {
-                    // Caso 2: El tío es negro y z es hijo derecho
-                    z = z->parent;
-                    rotacion_izquierda_rb(raiz, z);
-                }
-                // Caso 3: El tío es negro y z es hijo izquierdo
-                establecer_color(z->parent, BLACK);
-                establecer_color(z->parent->parent, RED);
-                rotacion_derecha_rb(raiz, z->parent->parent);
-            }
-        } else {
-            Tree* y = z->parent->parent->left; // Tío
-            
-            if (obtener_color(y) == RED) {
-                // Caso 1: El tío es rojo
-                establecer_color(z->parent, BLACK);
-                establecer_color(y, BLACK);
-                establecer_color(z->parent->parent, RED);
-                z = z->parent->parent;
-            } else {
-                if (z == z->parent->left) {
-                    // Caso 2: El tío es negro y z es hijo izquierdo
-                    z = z->parent;
-                    rotacion_derecha_rb(raiz, z);
-                }
-                // Caso 3: El tío es negro y z es hijo derecho
-                establecer_color(z->parent, BLACK);
-                establecer_color(z->parent->parent, RED);
-                rotacion_izquierda_rb(raiz, z->parent->parent);
-            }
-        }
-    }
-    establecer_color(raiz, BLACK);
-}
-
-/**
- * @brief Inserta un nodo en un árbol Rojo-Negro, manteniendo las propiedades.
- * @param raiz Referencia a la raíz del árbol
- * @param valor Valor a insertar
- * @param cliente Puntero al cliente
- * @param campo Campo por el que se ordena
- */
-void insertar_rb(Tree*& raiz, string valor, Cliente* cliente, int campo) {
-    inicializar_nil();
-    
-    Tree* z = new Tree(valor, cliente);
-    z->left = z->right = NIL;
-    
-    Tree* y = nullptr;
-    Tree* x = raiz;
-    
-    // Búsqueda del lugar de inserción
-    while (x != nullptr && x != NIL) {
-        y = x;
-        
-        string valor_x = obtener_valor_campo(x->cliente, campo);
-        bool menor = false;
-        
-        if (campo == 0 || campo == 3) { // DNI o Teléfono (numérico)
-            menor = stoi(valor) < stoi(valor_x);
-        } else { // Texto (nombres, apellidos, email)
-            string val_lower = valor, x_lower = valor_x;
-            transform(val_lower.begin(), val_lower.end(), val_lower.begin(), ::tolower);
-            transform(x_lower.begin(), x_lower.end(), x_lower.begin(), ::tolower);
-            menor = val_lower < x_lower;
-        }
-        
-        if (menor) {
-            x = x->left;
-        } else {
-            x = x->right;
-        }
-    }
-    
-    z->parent = y;
-    
-    if (y == nullptr) {
-        raiz = z;
-    } else {
-        string valor_y = obtener_valor_campo(y->cliente, campo);
-        bool menor = false;
-        
-        if (campo == 0 || campo == 3) {
-            menor = stoi(valor) < stoi(valor_y);
-        } else {
-            string val_lower = valor, y_lower = valor_y;
-            transform(val_lower.begin(), val_lower.end(), val_lower.begin(), ::tolower);
-            transform(y_lower.begin(), y_lower.end(), y_lower.begin(), ::tolower);
-            menor = val_lower < y_lower;
-        }
-        
-        if (menor) {
-            y->left = z;
-        } else {
-            y->right = z;
-        }
-    }
-    
-    z->color = RED;
-    arreglar_insercion_rb(raiz, z);
-}
-
-/**
- * @brief Calcula la altura de un árbol Rojo-Negro.
- * @param nodo Nodo raíz
- * @return Altura del árbol
- */
-int calcular_altura_rb(Tree* nodo) {
-    if (nodo == nullptr || nodo == NIL) return 0;
-    return 1 + MAX(calcular_altura_rb(nodo->left), calcular_altura_rb(nodo->right));
-}
-
-/**
- * @brief Cuenta los nodos negros en un camino desde la raíz hasta una hoja.
- * @param nodo Nodo actual
- * @return Número de nodos negros
- */
-int contar_nodos_negros(Tree* nodo) {
-    if (nodo == nullptr || nodo == NIL) return 1;
-    
-    int left_count = contar_nodos_negros(nodo->left);
-    if (left_count == -1) return -1;
-    
-    int right_count = contar_nodos_negros(nodo->right);
-    if (right_count == -1) return -1;
-    
-    if (left_count != right_count) return -1;
-    
-    return left_count + (nodo->color == BLACK ? 1 : 0);
-}
-
-/**
- * @brief Verifica si un árbol cumple las propiedades Rojo-Negro.
- * @param nodo Nodo raíz
- * @return true si es válido, false en caso contrario
- */
-bool verificar_rb(Tree* nodo) {
-    if (nodo == nullptr) return true;
-    
-    // Propiedad 1: La raíz debe ser negra
-    if (nodo->color != BLACK) return false;
-    
-    // Propiedad 2: No puede haber dos nodos rojos consecutivos
-    if (nodo->color == RED) {
-        if ((nodo->left != NIL && nodo->left != nullptr && nodo->left->color == RED) ||
-            (nodo->right != NIL && nodo->right != nullptr && nodo->right->color == RED)) {
-            return false;
-        }
-    }
-    
-    // Verificar recursivamente
-    return verificar_rb(nodo->left) && verificar_rb(nodo->right) && (contar_nodos_negros(nodo) != -1);
-}
-
 /**
  * @brief Muestra estadísticas del árbol Rojo-Negro.
- * @param raiz Nodo raíz del árbol
+ * @param arbol Árbol de clientes
  */
-void mostrar_estadisticas_arbol_rb(Tree* raiz) {
-    if (raiz == nullptr) {
+void mostrar_estadisticas_arbol_rb(const ArbolClientes& arbol) {
+    if (arbol.esta_vacio()) {
         cout << "Árbol vacío" << endl;
         return;
     }
     
     cout << "=== ESTADÍSTICAS DEL ÁRBOL ROJO-NEGRO ===" << endl;
-    cout << "Altura total: " << calcular_altura_rb(raiz) << endl;
-    cout << "Color de la raíz: " << (raiz->color == BLACK ? "NEGRO" : "ROJO") << endl;
-    cout << "Altura negra: " << contar_nodos_negros(raiz) << endl;
-    cout << "¿Cumple propiedades RB?: " << (verificar_rb(raiz) ? "SÍ" : "NO") << endl;
+    cout << "Altura total: " << arbol.altura() << endl;
+    cout << "Color de la raíz: " << (arbol.getRaiz()->color == ArbolClientes::NEGRO ? "NEGRO" : "ROJO") << endl;
+    cout << "Altura negra: " << arbol.alturaNegra() << endl;
+    cout << "¿Cumple propiedades RB?: " << (arbol.verificar() ? "SÍ" : "NO") << endl;
     cout << "=========================================" << endl;
 }
 
@@ -560,14 +247,24 @@ void compute_edge_lengths(asciinode *node) {
     node->height = h;
 }
 
-asciinode* build_ascii_tree_recursive(Tree* t) {
+asciinode* build_ascii_tree_recursive(const ArbolClientes& arbol, const Tree* t, int campo, int niveles) {
     asciinode* node;
 
-    if (t == NULL || t == NIL) return NULL;
+    if (t == NULL) return NULL;
 
     node = (asciinode*)malloc(sizeof(asciinode));
-    node->left = build_ascii_tree_recursive(t->left);
-    node->right = build_ascii_tree_recursive(t->right);
+
+    // Fuera de la ventana de niveles: el subárbol se resume con su cantidad de nodos
+    if (niveles == 0) {
+        string resumen = "(+" + to_string(arbol.tamSubarbol(t)) + ")";
+        node->left = node->right = NULL;
+        snprintf(node->label, sizeof(node->label), "%s", resumen.c_str());
+        node->lablen = (int)strlen(node->label);
+        return node;
+    }
+
+    node->left = build_ascii_tree_recursive(arbol, arbol.hijoIzquierdo(t), campo, niveles - 1);
+    node->right = build_ascii_tree_recursive(arbol, arbol.hijoDerecho(t), campo, niveles - 1);
 
     if (node->left != NULL) {
         node->left->parent_dir = -1;
@@ -578,23 +275,23 @@ asciinode* build_ascii_tree_recursive(Tree* t) {
     }
 
     // Crear etiqueta con color para Rojo-Negro
-    string etiqueta = crear_etiqueta(t->element);
-    if (t->color == RED) {
+    string etiqueta = crear_etiqueta(obtener_valor_campo(t->valor, campo));
+    if (t->color == ArbolClientes::ROJO) {
         etiqueta = "R:" + etiqueta; // Prefijo R para rojo
     } else {
         etiqueta = "B:" + etiqueta; // Prefijo B para negro
     }
     
-    strcpy(node->label, etiqueta.c_str());
-    node->lablen = etiqueta.length();
+    snprintf(node->label, sizeof(node->label), "%s", etiqueta.c_str());
+    node->lablen = (int)strlen(node->label);
 
     return node;
 }
 
-asciinode* build_ascii_tree(Tree* t) {
+asciinode* build_ascii_tree(const ArbolClientes& arbol, const Tree* raiz, int campo, int niveles) {
     asciinode* node;
-    if (t == NULL) return NULL;
-    node = build_ascii_tree_recursive(t);
+    if (raiz == NULL) return NULL;
+    node = build_ascii_tree_recursive(arbol, raiz, campo, niveles);
     node->parent_dir = 0;
     return node;
 }
@@ -607,14 +304,17 @@ void free_ascii_tree(asciinode* node) {
 }
 
 /**
- * @brief Imprime el árbol Rojo-Negro en formato ASCII por consola.
- * @param t Nodo raíz del árbol
+ * @brief Imprime en formato ASCII una ventana del árbol Rojo-Negro por consola.
+ * @param arbol Árbol de clientes
+ * @param raiz Nodo desde el que se imprime
+ * @param campo Campo por el que está ordenado el árbol
+ * @param niveles Cantidad de niveles impresos; los subárboles más profundos se muestran como (+n)
  */
-void imprimir_arbol_ascii(Tree* t) {
+void imprimir_arbol_ascii(const ArbolClientes& arbol, const Tree* raiz, int campo, int niveles) {
     asciinode* proot;
     int xmin, i;
-    if (t == NULL || t == NIL) return;
-    proot = build_ascii_tree(t);
+    if (raiz == NULL) return;
+    proot = build_ascii_tree(arbol, raiz, campo, niveles);
     compute_edge_lengths(proot);
     for (i = 0; i < proot->height && i < MAX_HEIGHT; i++) {
         lprofile[i] = ASCII_INFINITY;
@@ -635,18 +335,6 @@ void imprimir_arbol_ascii(Tree* t) {
     free_ascii_tree(proot);
 }
 
-/**
- * @brief Libera la memoria de un árbol Rojo-Negro.
- * @param nodo Nodo raíz a liberar
- */
-void liberar_arbol(Tree* nodo) {
-    if (nodo && nodo != NIL) {
-        liberar_arbol(nodo->left);
-        liberar_arbol(nodo->right);
-        delete nodo;
-    }
-}
-
 /**
  * @brief Muestra el menú y visualiza el árbol Rojo-Negro de clientes según el campo seleccionado.
  * @param banco Referencia al objeto Banco
@@ -678,49 +366,57 @@ void mostrar_arbol_binario(Banco& banco) {
     cout << "===    ORDENADO POR: " << campos[campo] << "    ===" << endl;
     cout << "===========================================" << endl;
 
-    // Inicializar NIL para el árbol Rojo-Negro
-    inicializar_nil();
-    
-    // Crear árbol Rojo-Negro
-    Tree* raiz = nullptr;
-    auto& lista = *clientes;
-    int n = lista.getTam();
-    
-    cout << "\nCreando árbol Rojo-Negro autobalanceado..." << endl;
-    
-    for (int i = 0; i < n; ++i) {
-        Cliente* cliente = lista.get_contador(i);
-        string valor = obtener_valor_campo(cliente, campo);
-        insertar_rb(raiz, valor, cliente, campo);
-    }
+    // El banco mantiene el árbol Rojo-Negro de cada campo: solo se lee
+    const ArbolClientes& arbol = banco.getIndices().getArbol(campo);
+    int n = (int)arbol.getTam();
 
     // Mostrar estadísticas del árbol
-    mostrar_estadisticas_arbol_rb(raiz);
+    mostrar_estadisticas_arbol_rb(arbol);
+    cout << "\nPresione cualquier tecla para ver el arbol...";
+    getch();
 
-    cout << "\nVisualizacion del Arbol Rojo-Negro (Auto-Balanceado):\n";
-    cout << "===================================================\n";
-    cout << "Leyenda: R: = Nodo Rojo, B: = Nodo Negro\n";
-    cout << "===================================================\n\n";
-    
-    if (raiz) {
-        imprimir_arbol_ascii(raiz);
-    } else {
-        cout << "Arbol vacio\n";
+    // Navegación por páginas: se muestran NIVELES_VENTANA_ASCII niveles desde el nodo actual
+    const Tree* actual = arbol.getRaiz();
+    vector<const Tree*> camino; // Ancestros del nodo actual para volver con la flecha arriba
+    int tecla = 0;
+    while (true) {
+        if (tecla == 75 && arbol.hijoIzquierdo(actual)) {
+            camino.push_back(actual);
+            actual = arbol.hijoIzquierdo(actual);
+        } else if (tecla == 77 && arbol.hijoDerecho(actual)) {
+            camino.push_back(actual);
+            actual = arbol.hijoDerecho(actual);
+        } else if (tecla == 72 && !camino.empty()) {
+            actual = camino.back();
+            camino.pop_back();
+        }
+
+        system("cls");
+        cout << "\nVisualizacion del Arbol Rojo-Negro (Auto-Balanceado) - ORDENADO POR: " << campos[campo] << "\n";
+        cout << "===================================================\n";
+        cout << "Leyenda: R: = Nodo Rojo, B: = Nodo Negro, (+n) = subarbol de n nodos\n";
+        cout << "Profundidad: " << camino.size() << "   Nodos en este subarbol: " << arbol.tamSubarbol(actual) << "\n";
+        cout << "===================================================\n\n";
+
+        if (!arbol.esta_vacio()) {
+            imprimir_arbol_ascii(arbol, actual, campo, NIVELES_VENTANA_ASCII);
+        } else {
+            cout << "Arbol vacio\n";
+        }
+
+        cout << "\n===================================================\n";
+        cout << "Total de clientes en el arbol: " << n << endl;
+        cout << "Arbol Rojo-Negro: Todas las operaciones en O(log n)" << endl;
+        cout << "Nota: Si los nombres son muy largos, se muestran truncados" << endl;
+        cout << "Flechas izq/der: bajar al hijo, arriba: volver al padre, ESC/Enter: salir" << endl;
+        cout << "===================================================\n";
+
+        if (arbol.esta_vacio()) break;
+        tecla = getch();
+        if (tecla == 0 || tecla == 224) tecla = getch(); // Prefijo de teclas especiales
+        if (tecla == 27 || tecla == 13) break;
     }
     
-    cout << "\n===================================================\n";
-    cout << "Total de clientes en el arbol: " << n << endl;
-    cout << "Arbol Rojo-Negro: Todas las operaciones en O(log n)" << endl;
-    cout << "Propiedades: Altura balanceada, sin nodos rojos consecutivos" << endl;
-    cout << "Nota: Si los nombres son muy largos, se muestran truncados" << endl;
-    cout << "===================================================\n";
-
-    // Limpiar memoria
-    liberar_arbol(raiz);
-    
-    cout << "\nPresione cualquier tecla para continuar...";
-    getch();
-    
     // REINICIAR LA MARQUESINA DESPUÉS DE MOSTRAR EL ÁRBOL
     inicializar_marquesina();
 }
@@ -732,72 +428,97 @@ void mostrar_arbol_binario(Banco& banco) {
  */
 struct NodoSFML {
     float x, y;           // Posición en pantalla
-    Tree* nodo;           // Puntero al nodo del árbol
+    const Tree* nodo;     // Puntero al nodo del árbol
     string etiqueta;      // Texto a mostrar
     bool es_rojo;         // Color del nodo
     
-    NodoSFML(float _x, float _y, Tree* _nodo, const string& _etiqueta, bool _es_rojo) 
+    NodoSFML(float _x, float _y, const Tree* _nodo, const string& _etiqueta, bool _es_rojo) 
         : x(_x), y(_y), nodo(_nodo), etiqueta(_etiqueta), es_rojo(_es_rojo) {}
 };
 
 /**
- * @brief Calcula las posiciones de los nodos para la visualización SFML.
- * @param nodo Nodo actual del árbol
- * @param x Posición X actual
- * @param y Posición Y actual
- * @param espaciado Espaciado horizontal entre nodos
- * @param nivel_altura Altura entre niveles
- * @param nodos_sfml Vector para almacenar los nodos con sus posiciones
- * @param campo Campo por el que está ordenado el árbol
+ * @brief Subárbol que por su tamaño en pantalla o su profundidad se dibuja resumido.
  */
-void calcular_posiciones_sfml(Tree* nodo, float x, float y, float espaciado, float nivel_altura, 
-                             vector<NodoSFML>& nodos_sfml, int campo) {
-    if (!nodo || nodo == NIL) return;
-    
-    // Crear etiqueta del nodo
-    string etiqueta = crear_etiqueta(obtener_valor_campo(nodo->cliente, campo));
-    bool es_rojo = (nodo->color == RED);
-    
-    // Agregar nodo actual
-    nodos_sfml.push_back(NodoSFML(x, y, nodo, etiqueta, es_rojo));
-    
-    // Calcular posiciones de los hijos con mejor espaciado
-    float nuevo_espaciado = espaciado * 0.5f; // Reducir más el espaciado para acomodar mejor
-    
-    if (nodo->left && nodo->left != NIL) {
-        calcular_posiciones_sfml(nodo->left, x - espaciado, y + nivel_altura, 
-                                nuevo_espaciado, nivel_altura, nodos_sfml, campo);
-    }
-    
-    if (nodo->right && nodo->right != NIL) {
-        calcular_posiciones_sfml(nodo->right, x + espaciado, y + nivel_altura, 
-                                nuevo_espaciado, nivel_altura, nodos_sfml, campo);
-    }
-}
+struct ResumenSFML {
+    float x_raiz, x_min, x_max, y; // Extensión horizontal del subárbol y nivel de su raíz
+    size_t cantidad;               // Nodos que contiene
+};
 
 /**
- * @brief Dibuja las conexiones entre nodos padre e hijo.
- * @param window Ventana de SFML
- * @param nodos_sfml Vector de nodos con posiciones
+ * @brief Diseño del árbol por posición en orden: la x de un nodo depende solo de su posición
+ * (obtenida con los tamaños de subárbol) y la y de su profundidad, sin recorrer el resto del árbol.
  */
-void dibujar_conexiones_sfml(sf::RenderWindow& window, const vector<NodoSFML>& nodos_sfml) {
-    for (const auto& nodo_sfml : nodos_sfml) {
-        if (!nodo_sfml.nodo || nodo_sfml.nodo == NIL) continue;
-        
-        // Buscar hijos y dibujar líneas
-        for (const auto& hijo_sfml : nodos_sfml) {
-            if (!hijo_sfml.nodo || hijo_sfml.nodo == NIL) continue;
-            
-            // Verificar si es hijo izquierdo o derecho
-            if (nodo_sfml.nodo->left == hijo_sfml.nodo || nodo_sfml.nodo->right == hijo_sfml.nodo) {
-                sf::Vertex linea[2];
-                linea[0].position = sf::Vector2f(nodo_sfml.x, nodo_sfml.y);
-                linea[0].color = sf::Color::White;
-                linea[1].position = sf::Vector2f(hijo_sfml.x, hijo_sfml.y);
-                linea[1].color = sf::Color::White;
-                window.draw(linea, 2, sf::PrimitiveType::Lines);
-            }
-        }
+struct DisenoArbolSFML {
+    float origen_x;       // x del primer elemento en orden
+    float origen_y;       // y de la raíz
+    float separacion;     // Distancia horizontal entre posiciones consecutivas
+    float altura_nivel;   // Distancia vertical entre niveles
+    int profundidad_max;  // Niveles dibujados antes de resumir
+};
+
+const float RADIO_NODO_SFML = 25.0f;
+const float ANCHO_MINIMO_SUBARBOL_PX = 40.0f; ///< Debajo de este ancho en pantalla el subárbol se resume
+const int NIVELES_AL_DESPLEGAR_SFML = 4;      ///< Niveles que se agregan bajo un subárbol resumido al desplegarlo
+
+/**
+ * @brief Recolecta los nodos, aristas y resúmenes visibles de un subárbol.
+ *
+ * Descarta los subárboles que no intersectan la vista (su rango de posiciones queda fuera) o que
+ * están por debajo de ella, y resume los que quedan más profundos que la ventana de niveles o son
+ * demasiado angostos en pantalla. El costo es proporcional a lo que se ve, no al tamaño del árbol.
+ *
+ * @param arbol Árbol de clientes
+ * @param nodo Raíz del subárbol
+ * @param posicion_inicial Posición en orden del primer elemento del subárbol
+ * @param profundidad Profundidad de la raíz del subárbol
+ * @param diseno Parámetros de diseño
+ * @param visible Rectángulo visible en coordenadas del mundo
+ * @param escala Píxeles por unidad del mundo
+ * @param campo Campo por el que está ordenado el árbol
+ * @param nodos Nodos a dibujar
+ * @param aristas Líneas padre-hijo a dibujar
+ * @param resumenes Subárboles resumidos
+ */
+void recolectar_visibles_sfml(const ArbolClientes& arbol, const Tree* nodo, size_t posicion_inicial, int profundidad,
+                              const DisenoArbolSFML& diseno, const sf::FloatRect& visible, float escala, int campo,
+                              vector<NodoSFML>& nodos, sf::VertexArray& aristas, vector<ResumenSFML>& resumenes) {
+    if (!nodo) return;
+
+    float y = diseno.origen_y + profundidad * diseno.altura_nivel;
+    if (y - RADIO_NODO_SFML > visible.position.y + visible.size.y) return;
+
+    size_t tam = arbol.tamSubarbol(nodo);
+    float x_min = diseno.origen_x + posicion_inicial * diseno.separacion;
+    float x_max = diseno.origen_x + (posicion_inicial + tam - 1) * diseno.separacion;
+    if (x_max + RADIO_NODO_SFML < visible.position.x || x_min - RADIO_NODO_SFML > visible.position.x + visible.size.x) return;
+
+    const Tree* izquierdo = arbol.hijoIzquierdo(nodo);
+    const Tree* derecho = arbol.hijoDerecho(nodo);
+    size_t posicion = posicion_inicial + arbol.tamSubarbol(izquierdo);
+    float x = diseno.origen_x + posicion * diseno.separacion;
+
+    if (tam > 1 && (profundidad >= diseno.profundidad_max || (x_max - x_min) * escala < ANCHO_MINIMO_SUBARBOL_PX)) {
+        resumenes.push_back({x, x_min, x_max, y, tam});
+        return;
+    }
+
+    nodos.push_back(NodoSFML(x, y, nodo, crear_etiqueta(obtener_valor_campo(nodo->valor, campo)),
+                             nodo->color == ArbolClientes::ROJO));
+
+    float y_hijo = y + diseno.altura_nivel;
+    if (izquierdo) {
+        float x_hijo = diseno.origen_x + (posicion_inicial + arbol.tamSubarbol(arbol.hijoIzquierdo(izquierdo))) * diseno.separacion;
+        aristas.append(sf::Vertex{sf::Vector2f(x, y), sf::Color::White});
+        aristas.append(sf::Vertex{sf::Vector2f(x_hijo, y_hijo), sf::Color::White});
+        recolectar_visibles_sfml(arbol, izquierdo, posicion_inicial, profundidad + 1, diseno, visible, escala, campo,
+                                 nodos, aristas, resumenes);
+    }
+    if (derecho) {
+        float x_hijo = diseno.origen_x + (posicion + 1 + arbol.tamSubarbol(arbol.hijoIzquierdo(derecho))) * diseno.separacion;
+        aristas.append(sf::Vertex{sf::Vector2f(x, y), sf::Color::White});
+        aristas.append(sf::Vertex{sf::Vector2f(x_hijo, y_hijo), sf::Color::White});
+        recolectar_visibles_sfml(arbol, derecho, posicion + 1, profundidad + 1, diseno, visible, escala, campo,
+                                 nodos, aristas, resumenes);
     }
 }
 
@@ -808,7 +529,7 @@ void dibujar_conexiones_sfml(sf::RenderWindow& window, const vector<NodoSFML>& n
  * @param font Fuente para el texto
  */
 void dibujar_nodos_sfml(sf::RenderWindow& window, const vector<NodoSFML>& nodos_sfml, sf::Font& font) {
-    const float radio_nodo = 25.0f;
+    const float radio_nodo = RADIO_NODO_SFML;
     
     for (const auto& nodo_sfml : nodos_sfml) {
         // Crear círculo para el nodo
@@ -839,15 +560,58 @@ void dibujar_nodos_sfml(sf::RenderWindow& window, const vector<NodoSFML>& nodos_
     }
 }
 
+/**
+ * @brief Dibuja los subárboles resumidos como triángulos con la cantidad de nodos que contienen.
+ * @param window Ventana de SFML
+ * @param resumenes Subárboles resumidos
+ * @param font Fuente para el texto
+ * @param escala Píxeles por unidad del mundo
+ */
+void dibujar_resumenes_sfml(sf::RenderWindow& window, const vector<ResumenSFML>& resumenes, sf::Font& font, float escala) {
+    for (const auto& resumen : resumenes) {
+        sf::ConvexShape triangulo(3);
+        triangulo.setPoint(0, sf::Vector2f(resumen.x_raiz, resumen.y - RADIO_NODO_SFML));
+        triangulo.setPoint(1, sf::Vector2f(resumen.x_min - RADIO_NODO_SFML, resumen.y + RADIO_NODO_SFML));
+        triangulo.setPoint(2, sf::Vector2f(resumen.x_max + RADIO_NODO_SFML, resumen.y + RADIO_NODO_SFML));
+        triangulo.setFillColor(sf::Color(90, 90, 90));
+        triangulo.setOutlineColor(sf::Color::White);
+        triangulo.setOutlineThickness(1.0f);
+        window.draw(triangulo);
+
+        // Solo se rotula si el texto entra en pantalla
+        if ((resumen.x_max - resumen.x_min + 2 * RADIO_NODO_SFML) * escala >= ANCHO_MINIMO_SUBARBOL_PX) {
+            sf::Text texto(font, to_string(resumen.cantidad), 12);
+            texto.setFillColor(sf::Color::Yellow);
+            sf::FloatRect bounds = texto.getLocalBounds();
+            texto.setPosition(sf::Vector2f(resumen.x_raiz - bounds.size.x / 2, resumen.y));
+            window.draw(texto);
+        }
+    }
+}
+
+/**
+ * @brief Calcula las estadísticas del árbol mostradas en la ventana (recorren el árbol completo).
+ * @param arbol Árbol de clientes
+ * @return Texto con total de nodos, alturas y validez de las propiedades
+ */
+string calcular_estadisticas_sfml(const ArbolClientes& arbol) {
+    return "Total de nodos: " + to_string(arbol.getTam()) +
+           "\nAltura: " + to_string(arbol.altura()) +
+           "\nAltura negra: " + to_string(arbol.alturaNegra()) +
+           "\nPropiedades RB: " + (arbol.verificar() ? "VALIDAS" : "INVALIDAS");
+}
+
 /**
  * @brief Muestra información adicional del árbol en la ventana SFML.
  * @param window Ventana de SFML
  * @param font Fuente para el texto
- * @param raiz Raíz del árbol
+ * @param estadisticas Estadísticas precalculadas del árbol
  * @param campo Campo por el que está ordenado
- * @param total_nodos Total de nodos en el árbol
+ * @param diseno Parámetros de diseño (ventana de niveles)
+ * @param dibujados Nodos dibujados en el cuadro actual
  */
-void dibujar_informacion_arbol_sfml(sf::RenderWindow& window, sf::Font& font, Tree* raiz, int campo, int total_nodos) {
+void dibujar_informacion_arbol_sfml(sf::RenderWindow& window, sf::Font& font, const string& estadisticas, int campo,
+                                    const DisenoArbolSFML& diseno, size_t dibujados) {
     const char* campos[] = {"DNI", "Nombre", "Apellido", "Teléfono", "Email"};
     
     // Título principal
@@ -863,19 +627,18 @@ void dibujar_informacion_arbol_sfml(sf::RenderWindow& window, sf::Font& font, Tr
     window.draw(campo_texto);
     
     // Estadísticas
-    string stats = "Total de nodos: " + to_string(total_nodos) + 
-                  "\nAltura: " + to_string(calcular_altura_rb(raiz)) +
-                  "\nAltura negra: " + to_string(contar_nodos_negros(raiz)) +
-                  "\nPropiedades RB: " + (verificar_rb(raiz) ? "VALIDAS" : "INVALIDAS");
-    sf::Text estadisticas(font, stats, 14);
-    estadisticas.setFillColor(sf::Color::White);
-    estadisticas.setPosition(sf::Vector2f(10, 70));
-    window.draw(estadisticas);
+    string stats = estadisticas +
+                  "\nNiveles dibujados: " + to_string(diseno.profundidad_max) +
+                  "\nNodos en pantalla: " + to_string(dibujados);
+    sf::Text texto_estadisticas(font, stats, 14);
+    texto_estadisticas.setFillColor(sf::Color::White);
+    texto_estadisticas.setPosition(sf::Vector2f(10, 70));
+    window.draw(texto_estadisticas);
     
     // Leyenda
-    sf::Text leyenda(font, "LEYENDA:\nCirculos Rojos = Nodos Rojos\nCirculos Negros = Nodos Negros\n\nControles:\nESC - Salir\nSPACE - Ver en consola\nR - Regenerar\nFlechas - Mover vista\nRueda - Zoom", 12);
+    sf::Text leyenda(font, "LEYENDA:\nCirculos Rojos = Nodos Rojos\nCirculos Negros = Nodos Negros\nTriangulos = Subarboles resumidos\n\nControles:\nESC - Salir\nSPACE - Ver en consola\nR - Regenerar\nFlechas - Mover vista\nRueda - Zoom\n+/- - Niveles dibujados", 12);
     leyenda.setFillColor(sf::Color::Green);
-    leyenda.setPosition(sf::Vector2f(10, static_cast<float>(window.getSize().y) - 140));
+    leyenda.setPosition(sf::Vector2f(10, static_cast<float>(window.getSize().y) - 190));
     window.draw(leyenda);
 }
 
@@ -903,19 +666,9 @@ void mostrar_arbol_binario_sfml(Banco& banco) {
     // Detener marquesina
     detener_marquesina();
     
-    // Inicializar NIL y crear árbol
-    inicializar_nil();
-    Tree* raiz = nullptr;
-    auto& lista = *clientes;
-    int n = lista.getTam();
-    
-    cout << "\nCreando árbol Rojo-Negro para visualización gráfica..." << endl;
-    
-    for (int i = 0; i < n; ++i) {
-        Cliente* cliente = lista.get_contador(i);
-        string valor = obtener_valor_campo(cliente, campo);
-        insertar_rb(raiz, valor, cliente, campo);
-    }
+    // Árbol Rojo-Negro vivo del banco para el campo elegido
+    const ArbolClientes& arbol = banco.getIndices().getArbol(campo);
+    string estadisticas = calcular_estadisticas_sfml(arbol);
 
     // Configurar ventana SFML con mayor tamaño
     sf::RenderWindow window(sf::VideoMode(sf::Vector2u(1400, 900)), "Arbol Rojo-Negro - Sistema Bancario");
@@ -931,32 +684,42 @@ void mostrar_arbol_binario_sfml(Banco& banco) {
         }
     }
     
-    // Calcular posiciones de los nodos con mejor distribución
-    vector<NodoSFML> nodos_sfml;
-    if (raiz) {
-        float centro_x = window.getSize().x / 2.0f;
-        float inicio_y = 200.0f; // Más espacio para la información superior
-        float espaciado_inicial = min(400.0f, (window.getSize().x - 100.0f) / 4.0f); // Ajustar según ventana
-        float altura_nivel = 70.0f; // Reducir altura entre niveles
-        
-        calcular_posiciones_sfml(raiz, centro_x, inicio_y, espaciado_inicial, altura_nivel, nodos_sfml, campo);
-    }
+    // La raíz queda centrada: las posiciones a su izquierda ocupan tamSubarbol(izquierdo) lugares
+    DisenoArbolSFML diseno;
+    diseno.origen_y = 200.0f; // Más espacio para la información superior
+    diseno.separacion = 60.0f;
+    diseno.altura_nivel = 70.0f;
+    diseno.profundidad_max = 12;
+    auto centrar_raiz = [&]() {
+        size_t a_la_izquierda = arbol.getRaiz() ? arbol.tamSubarbol(arbol.hijoIzquierdo(arbol.getRaiz())) : 0;
+        diseno.origen_x = window.getSize().x / 2.0f - a_la_izquierda * diseno.separacion;
+    };
+    centrar_raiz();
     
     cout << "Ventana gráfica abierta. Controles disponibles:" << endl;
     cout << "- ESC: Cerrar ventana" << endl;
     cout << "- SPACE: Mostrar versión ASCII en consola" << endl;
     cout << "- R: Regenerar árbol" << endl;
-    cout << "- Clic derecho: Información del nodo" << endl;
+    cout << "- Clic derecho: Información del nodo o desplegar un subárbol resumido" << endl;
     cout << "- Rueda del ratón: Zoom in/out" << endl;
     cout << "- Flechas: Mover vista" << endl;
+    cout << "- +/-: Más o menos niveles dibujados" << endl;
     
     // Variables para zoom y desplazamiento
     sf::View vista = window.getDefaultView();
     float zoom_factor = 1.0f;
     sf::Vector2f offset(0, 0);
+
+    // Buffers reutilizados en cada cuadro: solo contienen lo visible
+    vector<NodoSFML> nodos_sfml;
+    vector<ResumenSFML> resumenes;
+    sf::VertexArray aristas(sf::PrimitiveType::Lines);
     
     // Loop principal de SFML
     while (window.isOpen()) {
+        // El zoom máximo permite ver el ancho completo del árbol (resumido)
+        float zoom_maximo = max(3.0f, arbol.getTam() * diseno.separacion / window.getSize().x);
+
         std::optional<sf::Event> eventOpt;
         while ((eventOpt = window.pollEvent()).has_value()) {
             const sf::Event& event = eventOpt.value();
@@ -966,58 +729,53 @@ void mostrar_arbol_binario_sfml(Banco& banco) {
             }
             
             if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+                // El desplazamiento acompaña al zoom para cruzar árboles anchos
+                float paso = 40.0f * zoom_factor;
                 switch (keyPressed->code) {
                     case sf::Keyboard::Key::Escape:
                         window.close();
                         break;
                         
                     case sf::Keyboard::Key::Space:
-                        // Mostrar versión ASCII en consola
+                        // Mostrar versión ASCII en consola (primeros niveles)
                         system("cls");
                         cout << "\n=== VERSIÓN ASCII DEL MISMO ÁRBOL ===" << endl;
-                        mostrar_estadisticas_arbol_rb(raiz);
-                        if (raiz) {
-                            imprimir_arbol_ascii(raiz);
-                        }
+                        mostrar_estadisticas_arbol_rb(arbol);
+                        imprimir_arbol_ascii(arbol, arbol.getRaiz(), campo, NIVELES_VENTANA_ASCII);
                         cout << "\nPresione cualquier tecla para volver a la ventana gráfica...";
                         getch();
                         break;
                         
                     case sf::Keyboard::Key::R:
-                        // Regenerar árbol (útil para debugging)
+                        // Releer el árbol vivo del banco (puede haber cambiado)
                         cout << "Regenerando árbol..." << endl;
-                        liberar_arbol(raiz);
-                        raiz = nullptr;
-                        nodos_sfml.clear();
-                        
-                        // Recrear árbol
-                        for (int i = 0; i < n; ++i) {
-                            Cliente* cliente = lista.get_contador(i);
-                            string valor = obtener_valor_campo(cliente, campo);
-                            insertar_rb(raiz, valor, cliente, campo);
-                        }
-                        
-                        // Recalcular posiciones
-                        if (raiz) {
-                            float centro_x = window.getSize().x / 2.0f;
-                            float inicio_y = 200.0f;
-                            float espaciado_inicial = min(400.0f, (window.getSize().x - 100.0f) / 4.0f);
-                            float altura_nivel = 70.0f;
-                            calcular_posiciones_sfml(raiz, centro_x, inicio_y, espaciado_inicial, altura_nivel, nodos_sfml, campo);
-                        }
+                        estadisticas = calcular_estadisticas_sfml(arbol);
+                        centrar_raiz();
                         break;
                         
                     case sf::Keyboard::Key::Up:
-                        offset.y -= 20;
+                        offset.y -= paso;
                         break;
                     case sf::Keyboard::Key::Down:
-                        offset.y += 20;
+                        offset.y += paso;
                         break;
                     case sf::Keyboard::Key::Left:
-                        offset.x -= 20;
+                        offset.x -= paso;
                         break;
                     case sf::Keyboard::Key::Right:
-                        offset.x += 20;
+                        offset.x += paso;
+                        break;
+
+                    case sf::Keyboard::Key::Add:
+                    case sf::Keyboard::Key::Equal:
+                        diseno.profundidad_max = min(diseno.profundidad_max + 1, 64);
+                        break;
+                    case sf::Keyboard::Key::Subtract:
+                    case sf::Keyboard::Key::Hyphen:
+                        diseno.profundidad_max = max(diseno.profundidad_max - 1, 1);
+                        break;
+
+                    default:
                         break;
                 }
             }
@@ -1028,30 +786,53 @@ void mostrar_arbol_binario_sfml(Banco& banco) {
                 } else {
                     zoom_factor *= 1.1f; // Zoom out
                 }
-                zoom_factor = max(0.3f, min(zoom_factor, 3.0f)); // Limitar zoom
+                zoom_factor = max(0.3f, min(zoom_factor, zoom_maximo)); // Limitar zoom
             }
             
             if (const auto* mousePressed = event.getIf<sf::Event::MouseButtonPressed>()) {
                 if (mousePressed->button == sf::Mouse::Button::Right) {
-                    // Detectar clic en nodo para mostrar información
-                    float mouse_x = static_cast<float>(mousePressed->position.x);
-                    float mouse_y = static_cast<float>(mousePressed->position.y);
-                    
-                    for (const auto& nodo_sfml : nodos_sfml) {
-                        float dist = sqrt(pow(mouse_x - nodo_sfml.x, 2) + pow(mouse_y - nodo_sfml.y, 2));
-                        if (dist <= 25.0f) { // Radio del nodo
+                    // La posición en orden bajo el cursor identifica al único nodo candidato
+                    sf::Vector2f mundo = window.mapPixelToCoords(mousePressed->position, vista);
+
+                    // Sobre un triángulo (los del último cuadro): se centra la vista en el subárbol, con
+                    // un zoom que le da todo el ancho de la ventana y niveles suficientes para dibujarlo
+                    auto resumen = find_if(resumenes.begin(), resumenes.end(), [&](const ResumenSFML& r) {
+                        return mundo.x >= r.x_min - RADIO_NODO_SFML && mundo.x <= r.x_max + RADIO_NODO_SFML &&
+                               mundo.y >= r.y - RADIO_NODO_SFML && mundo.y <= r.y + RADIO_NODO_SFML;
+                    });
+                    if (resumen != resumenes.end()) {
+                        int nivel = (int)lround((resumen->y - diseno.origen_y) / diseno.altura_nivel);
+                        diseno.profundidad_max = min(max(diseno.profundidad_max, nivel + NIVELES_AL_DESPLEGAR_SFML), 64);
+                        float ancho = resumen->x_max - resumen->x_min + 2 * RADIO_NODO_SFML;
+                        zoom_factor = max(0.3f, min(ancho / window.getSize().x, zoom_maximo));
+                        // La raíz del subárbol queda a un cuarto de la altura, con sus niveles debajo
+                        sf::Vector2f centro((resumen->x_min + resumen->x_max) / 2.0f,
+                                            resumen->y + window.getDefaultView().getSize().y * zoom_factor / 4.0f);
+                        offset = centro - window.getDefaultView().getCenter();
+                        cout << "\nSubárbol resumido de " << resumen->cantidad << " nodos desplegado" << endl;
+                        continue;
+                    }
+
+                    long long posicion = llround((mundo.x - diseno.origen_x) / diseno.separacion);
+                    int profundidad = 0;
+                    const Tree* nodo = posicion >= 0 ? arbol.enPosicion((size_t)posicion, &profundidad) : nullptr;
+                    if (nodo && profundidad < diseno.profundidad_max) {
+                        float x = diseno.origen_x + posicion * diseno.separacion;
+                        float y = diseno.origen_y + profundidad * diseno.altura_nivel;
+                        float dist = sqrt(pow(mundo.x - x, 2) + pow(mundo.y - y, 2));
+                        if (dist <= RADIO_NODO_SFML) {
                             // Mostrar información del cliente en consola
                             cout << "\n=== INFORMACIÓN DEL NODO ===" << endl;
-                            cout << "Valor: " << nodo_sfml.etiqueta << endl;
-                            cout << "Color: " << (nodo_sfml.es_rojo ? "ROJO" : "NEGRO") << endl;
-                            if (nodo_sfml.nodo && nodo_sfml.nodo->cliente) {
-                                Cliente* cliente = nodo_sfml.nodo->cliente;
+                            cout << "Valor: " << crear_etiqueta(obtener_valor_campo(nodo->valor, campo)) << endl;
+                            cout << "Color: " << (nodo->color == ArbolClientes::ROJO ? "ROJO" : "NEGRO") << endl;
+                            cout << "Nodos en su subárbol: " << arbol.tamSubarbol(nodo) << endl;
+                            if (nodo->valor) {
+                                Cliente* cliente = nodo->valor;
                                 cout << "Cliente: " << cliente->get_nombres() << " " << cliente->get_apellidos() << endl;
                                 cout << "DNI: " << cliente->get_dni() << endl;
                                 cout << "Email: " << cliente->get_email() << endl;
                             }
                             cout << "===========================" << endl;
-                            break;
                         }
                     }
                 }
@@ -1062,32 +843,38 @@ void mostrar_arbol_binario_sfml(Banco& banco) {
         vista.setSize(window.getDefaultView().getSize() * zoom_factor);
         vista.setCenter(window.getDefaultView().getCenter() + offset);
         window.setView(vista);
+
+        // Recolectar solo lo que cae dentro de la vista
+        sf::FloatRect visible(vista.getCenter() - vista.getSize() / 2.0f, vista.getSize());
+        float escala = 1.0f / zoom_factor;
+        nodos_sfml.clear();
+        resumenes.clear();
+        aristas.clear();
+        recolectar_visibles_sfml(arbol, arbol.getRaiz(), 0, 0, diseno, visible, escala, campo,
+                                 nodos_sfml, aristas, resumenes);
         
         // Limpiar ventana
         window.clear(sf::Color(30, 30, 30)); // Fondo gris oscuro
         
         // Dibujar conexiones primero (para que queden detrás de los nodos)
-        dibujar_conexiones_sfml(window, nodos_sfml);
+        window.draw(aristas);
         
-        // Dibujar nodos
+        // Dibujar nodos y subárboles resumidos
+        dibujar_resumenes_sfml(window, resumenes, font, escala);
         dibujar_nodos_sfml(window, nodos_sfml, font);
         
         // Restaurar vista para información de interfaz
         window.setView(window.getDefaultView());
         
         // Dibujar información del árbol (siempre visible)
-        dibujar_informacion_arbol_sfml(window, font, raiz, campo, n);
+        dibujar_informacion_arbol_sfml(window, font, estadisticas, campo, diseno, nodos_sfml.size());
         
         // Mostrar todo en pantalla
         window.display();
     }
     
-    // Limpiar memoria
-    liberar_arbol(raiz);
-    
     cout << "\nVentana gráfica cerrada. Regresando al menú..." << endl;
     
     // Reiniciar marquesina
     inicializar_marquesina();
 }
-
@@ -0,0 +1,642 @@
+/**
+ * @file ArchivoMovimientos.cpp
+ * @brief Implementación del almacenamiento en frío de los movimientos antiguos.
+ */
+
+#include "ArchivoMovimientos.h"
+#include "CatalogoRespaldos.h"
+#include "EscritorBinario.h"
+#include "GestorClientes.h"
+#include "LectorBinario.h"
+#include "ReemplazoArchivo.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+const uint32_t ArchivoMovimientos::MAGIA;
+const uint32_t ArchivoMovimientos::MAGIA_SEGMENTO;
+const uint32_t ArchivoMovimientos::VERSION;
+
+namespace {
+
+// Cabecera de cada movimiento comprimido: tipo en los bits 0-1 y, en los bits 2 y 3, si el monto y el
+// saldo se guardaron como centavos enteros en lugar de double.
+const uint8_t TIPO_OTRO = 0;
+const uint8_t TIPO_DEPOSITO = 1;
+const uint8_t TIPO_RETIRO = 2;
+const uint8_t MASCARA_TIPO = 3;
+const uint8_t MONTO_EN_CENTAVOS = 4;
+const uint8_t SALDO_EN_CENTAVOS = 8;
+
+/**
+ * @brief Orden de los segmentos en el índice.
+ */
+bool anterior(const SegmentoMovimientos& a, const SegmentoMovimientos& b) {
+    if (a.periodo != b.periodo) return a.periodo < b.periodo;
+    return a.ejecucion < b.ejecucion;
+}
+
+template <typename T>
+void escribirValor(std::string& destino, const T& valor) {
+    destino.append(reinterpret_cast<const char*>(&valor), sizeof(T));
+}
+
+void escribirTexto(std::string& destino, const std::string& texto) {
+    uint32_t longitud = static_cast<uint32_t>(texto.size());
+    escribirValor(destino, longitud);
+    destino.append(texto);
+}
+
+template <typename T>
+bool leerValor(const std::string& origen, size_t& posicion, size_t fin, T& valor) {
+    if (fin - posicion < sizeof(T)) return false;
+    std::memcpy(&valor, origen.data() + posicion, sizeof(T));
+    posicion += sizeof(T);
+    return true;
+}
+
+bool leerTexto(const std::string& origen, size_t& posicion, size_t fin, std::string& texto) {
+    uint32_t longitud = 0;
+    if (!leerValor(origen, posicion, fin, longitud) || fin - posicion < longitud) return false;
+    texto.assign(origen, posicion, longitud);
+    posicion += longitud;
+    return true;
+}
+
+/**
+ * @brief Escribe un entero sin signo en 7 bits por byte; el bit alto indica que sigue otro byte.
+ */
+void escribirVarint(EscritorBinario& escritor, uint64_t valor) {
+    while (valor >= 0x80) {
+        escritor.escribir(static_cast<uint8_t>(valor | 0x80));
+        valor >>= 7;
+    }
+    escritor.escribir(static_cast<uint8_t>(valor));
+}
+
+uint64_t leerVarint(LectorBinario& lector, const char* campo) {
+    uint64_t valor = 0;
+    for (int desplazamiento = 0; desplazamiento < 64; desplazamiento += 7) {
+        uint8_t byte = 0;
+        lector.leer(byte, campo);
+        valor |= static_cast<uint64_t>(byte & 0x7F) << desplazamiento;
+        if (!(byte & 0x80)) return valor;
+    }
+    throw std::runtime_error(std::string("Error al leer ") + campo + ": entero demasiado largo");
+}
+
+/**
+ * @brief Lleva un entero con signo a uno sin signo pequeño si su valor absoluto es pequeño.
+ */
+uint64_t zigzag(int64_t valor) {
+    return (static_cast<uint64_t>(valor) << 1) ^ static_cast<uint64_t>(valor >> 63);
+}
+
+int64_t desdeZigzag(uint64_t valor) {
+    return static_cast<int64_t>(valor >> 1) ^ -static_cast<int64_t>(valor & 1);
+}
+
+/**
+ * @brief Indica si un importe es exactamente un número de centavos, para guardarlo como entero.
+ * @details Solo se acepta si al dividir los centavos por 100 se obtiene el mismo double, así la
+ *          compresión nunca cambia un saldo.
+ */
+bool enCentavos(double valor, int64_t& centavos) {
+    if (!std::isfinite(valor) || std::fabs(valor) > 9e15 || (valor == 0 && std::signbit(valor))) return false;
+    centavos = std::llround(valor * 100);
+    return static_cast<double>(centavos) / 100.0 == valor;
+}
+
+/**
+ * @brief Instante de una fecha en base mixta (meses de 31 días), creciente con la fecha.
+ * @details No es una cuenta real de segundos, pero dos movimientos cercanos quedan a poca distancia y
+ *          se recupera cada campo sin ambigüedad.
+ */
+int64_t instante(Fecha fecha, const std::string& id_cuenta) {
+    int anio = fecha.get_anuario(), mes = fecha.get_mes(), dia = fecha.get_dia();
+    int hora = fecha.get_hora(), minutos = fecha.get_minutos(), segundos = fecha.get_segundos();
+    if (anio < 0 || mes < 1 || mes > 12 || dia < 1 || dia > 31 || hora < 0 || hora > 23 ||
+        minutos < 0 || minutos > 59 || segundos < 0 || segundos > 59) {
+        throw std::runtime_error("Fecha inválida en un movimiento de la cuenta " + id_cuenta + ": " + fecha.to_string());
+    }
+    return ((((static_cast<int64_t>(anio) * 12 + (mes - 1)) * 31 + (dia - 1)) * 24 + hora) * 60 + minutos) * 60 + segundos;
+}
+
+Fecha fechaDesdeInstante(int64_t valor) {
+    if (valor < 0 || valor / (12LL * 31 * 24 * 3600) > 100000) throw std::runtime_error("Error al leer fecha: fuera de rango");
+    int segundos = static_cast<int>(valor % 60); valor /= 60;
+    int minutos = static_cast<int>(valor % 60); valor /= 60;
+    int hora = static_cast<int>(valor % 24); valor /= 24;
+    int dia = static_cast<int>(valor % 31) + 1; valor /= 31;
+    int mes = static_cast<int>(valor % 12) + 1; valor /= 12;
+    return Fecha(static_cast<int>(valor), mes, dia, hora, minutos, segundos);
+}
+
+/**
+ * @brief Comprime los movimientos de una cuenta en un mes y completa su resumen.
+ * @details Cada movimiento es un byte de cabecera, la diferencia de instante con el anterior, el monto
+ *          en centavos y la diferencia de saldo en centavos con el último saldo guardado así; los
+ *          importes que no son centavos exactos van como double.
+ */
+void codificarMovimientos(EscritorBinario& escritor, const std::vector<const Movimiento*>& movimientos,
+                          ResumenCuentaArchivada& resumen) {
+    int64_t instante_previo = 0;
+    int64_t saldo_previo = 0;
+    for (const Movimiento* movimiento : movimientos) {
+        std::string tipo = movimiento->get_tipo();
+        double monto = movimiento->get_monto();
+        double saldo = movimiento->get_saldo_post_movimiento();
+        int clave = GestorClientes::dateKey(*movimiento);
+
+        uint8_t cabecera = tipo == "Depósito" ? TIPO_DEPOSITO : tipo == "Retiro" ? TIPO_RETIRO : TIPO_OTRO;
+        int64_t centavos_monto = 0, centavos_saldo = 0;
+        bool monto_centavos = monto >= 0 && enCentavos(monto, centavos_monto);
+        bool saldo_centavos = enCentavos(saldo, centavos_saldo);
+        if (monto_centavos) cabecera |= MONTO_EN_CENTAVOS;
+        if (saldo_centavos) cabecera |= SALDO_EN_CENTAVOS;
+
+        int64_t actual = instante(movimiento->get_fecha(), resumen.id_cuenta);
+        escritor.escribir(cabecera);
+        if ((cabecera & MASCARA_TIPO) == TIPO_OTRO) escritor.escribirCadena(tipo);
+        escribirVarint(escritor, zigzag(actual - instante_previo));
+        if (monto_centavos) escribirVarint(escritor, static_cast<uint64_t>(centavos_monto));
+        else escritor.escribir(monto);
+        if (saldo_centavos) {
+            escribirVarint(escritor, zigzag(centavos_saldo - saldo_previo));
+            saldo_previo = centavos_saldo;
+        } else {
+            escritor.escribir(saldo);
+        }
+        instante_previo = actual;
+
+        if (resumen.movimientos == 0 || clave < resumen.desde) resumen.desde = clave;
+        if (resumen.movimientos == 0 || clave > resumen.hasta) resumen.hasta = clave;
+        resumen.movimientos++;
+        if ((cabecera & MASCARA_TIPO) == TIPO_DEPOSITO) {
+            resumen.depositos++;
+            resumen.total_depositos += monto;
+        } else if ((cabecera & MASCARA_TIPO) == TIPO_RETIRO) {
+            resumen.retiros++;
+            resumen.total_retiros += monto;
+        }
+        resumen.saldo_cierre = saldo;
+    }
+}
+
+/**
+ * @brief Escribe una entrada del directorio de un segmento.
+ */
+void escribirResumen(EscritorBinario& escritor, const ResumenCuentaArchivada& resumen) {
+    escritor.escribirCadena(resumen.id_cuenta);
+    escritor.escribir(resumen.movimientos);
+    escritor.escribir(resumen.depositos);
+    escritor.escribir(resumen.retiros);
+    escritor.escribir(resumen.total_depositos);
+    escritor.escribir(resumen.total_retiros);
+    escritor.escribir(resumen.saldo_cierre);
+    escritor.escribir(resumen.desde);
+    escritor.escribir(resumen.hasta);
+    escritor.escribir(resumen.posicion);
+    escritor.escribir(resumen.longitud);
+}
+
+void leerResumen(LectorBinario& lector, ResumenCuentaArchivada& resumen) {
+    lector.leerCadena(resumen.id_cuenta, "id de cuenta archivada");
+    lector.leer(resumen.movimientos, "movimientos archivados");
+    lector.leer(resumen.depositos, "depositos archivados");
+    lector.leer(resumen.retiros, "retiros archivados");
+    lector.leer(resumen.total_depositos, "total de depositos");
+    lector.leer(resumen.total_retiros, "total de retiros");
+    lector.leer(resumen.saldo_cierre, "saldo de cierre");
+    lector.leer(resumen.desde, "fecha inicial");
+    lector.leer(resumen.hasta, "fecha final");
+    lector.leer(resumen.posicion, "posicion del bloque");
+    lector.leer(resumen.longitud, "longitud del bloque");
+}
+
+// Bytes de una entrada del directorio sin contar el id
+const size_t TAMANIO_RESUMEN = sizeof(size_t) + 3 * sizeof(uint32_t) + 3 * sizeof(double) + 2 * sizeof(int) +
+                               2 * sizeof(uint64_t);
+
+/**
+ * @brief Directorio de un archivo, con la barra final, o vacío si no tiene.
+ */
+std::string directorioDe(const std::string& ruta) {
+    size_t barra = ruta.find_last_of("/\\");
+    return barra == std::string::npos ? std::string() : ruta.substr(0, barra + 1);
+}
+
+} // namespace
+
+/**
+ * @brief Constructor. No lee el índice hasta la primera consulta.
+ * @param indice Ruta del archivo de índice
+ */
+ArchivoMovimientos::ArchivoMovimientos(const std::string& indice)
+    : indice(indice), horizonte(0), ejecuciones(0), cargado(false), danado(false) {}
+
+/**
+ * @brief Archivo de movimientos del sistema.
+ */
+ArchivoMovimientos& ArchivoMovimientos::general() {
+    static ArchivoMovimientos instancia;
+    return instancia;
+}
+
+/**
+ * @brief Lee el índice la primera vez que se consulta.
+ */
+void ArchivoMovimientos::asegurarCargado() {
+    if (cargado) return;
+    cargado = true;
+    if (leer()) return;
+    segmentos.clear();
+    horizonte = 0;
+    ejecuciones = 0;
+}
+
+/**
+ * @brief Lee y valida el índice.
+ * @details Formato (orden de bytes nativo): magia, versión (uint32), horizonte (int), última ejecución y
+ *          cantidad de segmentos (uint32); por segmento archivo, periodo, ejecución, fechas, cuentas,
+ *          movimientos, tamaño y huella; al final la huella FNV-1a de todo lo anterior. Si el archivo no
+ *          existe no hay nada archivado; si existe y no es válido se marca como dañado.
+ */
+bool ArchivoMovimientos::leer() {
+    std::ifstream file(indice, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::string datos((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    danado = true;
+    if (datos.size() < 4 * sizeof(uint32_t) + sizeof(int) + sizeof(uint64_t)) {
+        std::cerr << "Índice de movimientos archivados dañado: " << indice << std::endl;
+        return false;
+    }
+
+    size_t fin = datos.size() - sizeof(uint64_t);
+    uint64_t huella = 0;
+    std::memcpy(&huella, datos.data() + fin, sizeof(uint64_t));
+    if (huella != CatalogoRespaldos::fnv1a(datos.data(), fin)) {
+        std::cerr << "Índice de movimientos archivados dañado: " << indice << std::endl;
+        return false;
+    }
+
+    size_t posicion = 0;
+    uint32_t magia = 0, version = 0, cantidad = 0;
+    if (!leerValor(datos, posicion, fin, magia) || magia != MAGIA) return false;
+    if (!leerValor(datos, posicion, fin, version) || version != VERSION) return false;
+    if (!leerValor(datos, posicion, fin, horizonte) || !leerValor(datos, posicion, fin, ejecuciones) ||
+        !leerValor(datos, posicion, fin, cantidad)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < cantidad; i++) {
+        SegmentoMovimientos segmento;
+        if (!leerTexto(datos, posicion, fin, segmento.archivo) ||
+            !leerValor(datos, posicion, fin, segmento.periodo) ||
+            !leerValor(datos, posicion, fin, segmento.ejecucion) ||
+            !leerValor(datos, posicion, fin, segmento.desde) ||
+            !leerValor(datos, posicion, fin, segmento.hasta) ||
+            !leerValor(datos, posicion, fin, segmento.cuentas) ||
+            !leerValor(datos, posicion, fin, segmento.movimientos) ||
+            !leerValor(datos, posicion, fin, segmento.tamanio) ||
+            !leerValor(datos, posicion, fin, segmento.digest)) {
+            return false;
+        }
+        segmentos.push_back(std::move(segmento));
+    }
+    if (posicion != fin) return false;
+
+    if (!std::is_sorted(segmentos.begin(), segmentos.end(), anterior)) {
+        std::sort(segmentos.begin(), segmentos.end(), anterior);
+    }
+    danado = false;
+    return true;
+}
+
+/**
+ * @brief Reescribe el índice completo mediante un archivo temporal.
+ */
+bool ArchivoMovimientos::guardar() const {
+    try {
+        std::string datos;
+        escribirValor(datos, MAGIA);
+        escribirValor(datos, VERSION);
+        escribirValor(datos, horizonte);
+        escribirValor(datos, ejecuciones);
+        escribirValor(datos, static_cast<uint32_t>(segmentos.size()));
+        for (const SegmentoMovimientos& segmento : segmentos) {
+            escribirTexto(datos, segmento.archivo);
+            escribirValor(datos, segmento.periodo);
+            escribirValor(datos, segmento.ejecucion);
+            escribirValor(datos, segmento.desde);
+            escribirValor(datos, segmento.hasta);
+            escribirValor(datos, segmento.cuentas);
+            escribirValor(datos, segmento.movimientos);
+            escribirValor(datos, segmento.tamanio);
+            escribirValor(datos, segmento.digest);
+        }
+        escribirValor(datos, CatalogoRespaldos::fnv1a(datos.data(), datos.size()));
+
+        std::string temporal = indice + ".tmp";
+        std::ofstream file(temporal, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(datos.data(), static_cast<std::streamsize>(datos.size()));
+        file.close();
+        if (!file) {
+            std::remove(temporal.c_str());
+            return false;
+        }
+
+        if (!reemplazarArchivo(temporal, indice)) {
+            std::remove(temporal.c_str());
+            return false;
+        }
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en guardar índice de movimientos archivados: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+/**
+ * @brief Fecha (YYYYMMDD) desde la que los movimientos siguen en el archivo de datos.
+ */
+int ArchivoMovimientos::getHorizonte() {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    asegurarCargado();
+    return horizonte;
+}
+
+/**
+ * @brief Indica si el índice existe pero no se pudo leer.
+ */
+bool ArchivoMovimientos::estaDanado() {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    asegurarCargado();
+    return danado;
+}
+
+/**
+ * @brief Segmentos registrados, del mes más antiguo al más reciente.
+ */
+std::vector<SegmentoMovimientos> ArchivoMovimientos::listar() {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    asegurarCargado();
+    return segmentos;
+}
+
+/**
+ * @brief Codifica y escribe el segmento de un mes.
+ * @details Formato: magia, versión (uint32), periodo (int), ejecución y cantidad de cuentas (uint32),
+ *          longitud del directorio (uint64), el directorio ordenado por id y los bloques de movimientos.
+ *          El segmento se arma en memoria y se escribe de una vez en un temporal que luego se renombra.
+ */
+SegmentoMovimientos ArchivoMovimientos::escribirSegmento(
+    const std::string& archivo, int periodo, uint32_t ejecucion, const std::map<std::string, std::vector<const Movimiento*>>& cuentas) {
+    SegmentoMovimientos segmento;
+    segmento.archivo = archivo;
+    segmento.periodo = periodo;
+    segmento.ejecucion = ejecucion;
+    segmento.cuentas = static_cast<uint32_t>(cuentas.size());
+
+    std::string bloques, directorio, contenido;
+    {
+        EscritorBinario escritor_bloques(bloques);
+        EscritorBinario escritor_directorio(directorio);
+        for (const auto& cuenta : cuentas) {
+            ResumenCuentaArchivada resumen;
+            resumen.id_cuenta = cuenta.first;
+            resumen.posicion = escritor_bloques.getEscritos();
+            codificarMovimientos(escritor_bloques, cuenta.second, resumen);
+            resumen.longitud = escritor_bloques.getEscritos() - resumen.posicion;
+            escribirResumen(escritor_directorio, resumen);
+
+            if (segmento.movimientos == 0 || resumen.desde < segmento.desde) segmento.desde = resumen.desde;
+            if (segmento.movimientos == 0 || resumen.hasta > segmento.hasta) segmento.hasta = resumen.hasta;
+            segmento.movimientos += resumen.movimientos;
+        }
+    }
+    {
+        EscritorBinario escritor(contenido);
+        escritor.escribir(MAGIA_SEGMENTO);
+        escritor.escribir(VERSION);
+        escritor.escribir(periodo);
+        escritor.escribir(ejecucion);
+        escritor.escribir(segmento.cuentas);
+        escritor.escribir(static_cast<uint64_t>(directorio.size()));
+        escritor.escribirBloque(directorio);
+        escritor.escribirBloque(bloques);
+    }
+    segmento.tamanio = contenido.size();
+    segmento.digest = CatalogoRespaldos::fnv1a(contenido.data(), contenido.size());
+
+    std::string temporal = archivo + ".tmp";
+    std::ofstream file(temporal, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) throw std::runtime_error("No se pudo crear el segmento " + archivo);
+    file.write(contenido.data(), static_cast<std::streamsize>(contenido.size()));
+    file.close();
+    if (!file || !reemplazarArchivo(temporal, archivo)) {
+        std::remove(temporal.c_str());
+        throw std::runtime_error("No se pudo escribir el segmento " + archivo);
+    }
+    return segmento;
+}
+
+/**
+ * @brief Escribe los segmentos de un archivado y adelanta el horizonte.
+ * @details Los movimientos se agrupan por mes y, dentro de cada mes, por cuenta en orden de id. Los
+ *          segmentos se escriben antes que el índice: si algo falla se borran y el índice anterior sigue
+ *          vigente, y un segmento que quedó en disco sin entrar al índice nunca se consulta.
+ */
+ResultadoArchivo ArchivoMovimientos::archivar(const std::vector<MovimientosCuenta>& cuentas, int horizonte) {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    asegurarCargado();
+    if (danado) throw std::runtime_error("El índice de movimientos archivados está dañado: " + indice);
+    if (horizonte <= this->horizonte) throw std::invalid_argument("El horizonte debe ser posterior al actual");
+
+    ResultadoArchivo resultado;
+    std::map<int, std::map<std::string, std::vector<const Movimiento*>>> meses;
+    for (const MovimientosCuenta& cuenta : cuentas) {
+        for (const Movimiento& movimiento : cuenta.movimientos) {
+            int clave = GestorClientes::dateKey(movimiento);
+            if (clave < this->horizonte || clave >= horizonte) {
+                throw std::invalid_argument("Movimiento de la cuenta " + cuenta.id_cuenta + " fuera del rango a archivar");
+            }
+            meses[clave / 100][cuenta.id_cuenta].push_back(&movimiento);
+            resultado.movimientos++;
+        }
+        if (!cuenta.movimientos.empty()) resultado.cuentas++;
+    }
+
+    uint32_t ejecucion = ejecuciones + 1;
+    std::string carpeta = directorioDe(indice);
+    std::vector<SegmentoMovimientos> nuevos;
+    try {
+        for (const auto& mes : meses) {
+            std::string archivo = carpeta + "movimientos_" + std::to_string(mes.first) + "_" +
+                                  std::to_string(ejecucion) + ".seg";
+            nuevos.push_back(escribirSegmento(archivo, mes.first, ejecucion, mes.second));
+            resultado.bytes += nuevos.back().tamanio;
+        }
+    } catch (...) {
+        for (const SegmentoMovimientos& segmento : nuevos) std::remove(segmento.archivo.c_str());
+        throw;
+    }
+
+    std::vector<SegmentoMovimientos> anteriores = segmentos;
+    int horizonte_anterior = this->horizonte;
+    segmentos.insert(segmentos.end(), nuevos.begin(), nuevos.end());
+    std::sort(segmentos.begin(), segmentos.end(), anterior);
+    this->horizonte = horizonte;
+    ejecuciones = ejecucion;
+    if (!guardar()) {
+        segmentos.swap(anteriores);
+        this->horizonte = horizonte_anterior;
+        ejecuciones = ejecucion - 1;
+        for (const SegmentoMovimientos& segmento : nuevos) std::remove(segmento.archivo.c_str());
+        throw std::runtime_error("No se pudo guardar el índice de movimientos archivados: " + indice);
+    }
+    resultado.segmentos = nuevos.size();
+    return resultado;
+}
+
+/**
+ * @brief Agrega los movimientos archivados de una cuenta en un rango de fechas.
+ * @details Solo se abren los segmentos cuyo mes y fechas se cruzan con el rango; dentro de cada uno se
+ *          lee el directorio hasta la cuenta y se decodifica únicamente su bloque. La primera vez que se
+ *          abre un segmento se compara su huella con la del índice; como no cambian una vez escritos, no
+ *          se vuelve a recorrer completo en las consultas siguientes.
+ */
+void ArchivoMovimientos::consultar(const std::string& id_cuenta, int desde, int hasta, std::vector<Movimiento>& destino) {
+    std::vector<SegmentoMovimientos> candidatos;
+    std::vector<bool> por_verificar;
+    {
+        std::lock_guard<std::mutex> bloqueo(mutex);
+        asegurarCargado();
+        SegmentoMovimientos clave;
+        clave.periodo = desde / 100;
+        auto it = std::lower_bound(segmentos.begin(), segmentos.end(), clave, anterior);
+        for (; it != segmentos.end() && it->periodo <= hasta / 100; ++it) {
+            if (it->hasta >= desde && it->desde <= hasta) {
+                candidatos.push_back(*it);
+                por_verificar.push_back(verificados.count(it->archivo) == 0);
+            }
+        }
+    }
+    // Los segmentos no cambian una vez escritos, así que se leen sin el mutex
+    for (size_t i = 0; i < candidatos.size(); i++) {
+        if (por_verificar[i]) {
+            verificarSegmento(candidatos[i]);
+            std::lock_guard<std::mutex> bloqueo(mutex);
+            verificados.insert(candidatos[i].archivo);
+        }
+        leerSegmento(candidatos[i], id_cuenta, desde, hasta, destino);
+    }
+}
+
+/**
+ * @brief Comprueba que el tamaño y la huella del segmento coinciden con los del índice.
+ */
+void ArchivoMovimientos::verificarSegmento(const SegmentoMovimientos& segmento) {
+    FILE* file = std::fopen(segmento.archivo.c_str(), "rb");
+    if (!file) throw std::runtime_error("No se pudo abrir el segmento " + segmento.archivo);
+    std::vector<char> buffer(1 << 16);
+    uint64_t hash = 14695981039346656037ull;
+    uint64_t leidos = 0;
+    size_t n = 0;
+    while ((n = std::fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+        hash = CatalogoRespaldos::fnv1a(buffer.data(), n, hash);
+        leidos += n;
+    }
+    bool error = std::ferror(file) != 0;
+    std::fclose(file);
+    if (error) throw std::runtime_error("No se pudo leer el segmento " + segmento.archivo);
+    if (leidos != segmento.tamanio || hash != segmento.digest) {
+        throw std::runtime_error("Segmento " + segmento.archivo + " dañado: la huella no coincide con el índice");
+    }
+}
+
+/**
+ * @brief Lee del segmento el bloque de una cuenta y agrega los movimientos del rango.
+ */
+void ArchivoMovimientos::leerSegmento(const SegmentoMovimientos& segmento, const std::string& id_cuenta, int desde,
+                                      int hasta, std::vector<Movimiento>& destino) {
+    FILE* file = std::fopen(segmento.archivo.c_str(), "rb");
+    if (!file) throw std::runtime_error("No se pudo abrir el segmento " + segmento.archivo);
+    std::string error;
+    try {
+        LectorBinario lector(file, 1 << 16, segmento.tamanio);
+        uint32_t magia = 0, version = 0, ejecucion = 0, cuentas = 0;
+        int periodo = 0;
+        uint64_t longitud_directorio = 0;
+        lector.leer(magia, "cabecera");
+        lector.leer(version, "version");
+        lector.leer(periodo, "periodo");
+        lector.leer(ejecucion, "ejecucion");
+        lector.leer(cuentas, "cantidad de cuentas");
+        lector.leer(longitud_directorio, "longitud del directorio");
+        if (magia != MAGIA_SEGMENTO || version != VERSION || periodo != segmento.periodo ||
+            ejecucion != segmento.ejecucion || longitud_directorio > lector.getRestante() ||
+            cuentas > longitud_directorio / TAMANIO_RESUMEN) {
+            throw std::runtime_error("la cabecera no coincide con el índice");
+        }
+        uint64_t bloques = lector.getPosicion() + longitud_directorio;
+        uint64_t espacio = lector.getRestante() - longitud_directorio;
+
+        // El directorio está ordenado por id: la búsqueda termina al pasar la cuenta
+        ResumenCuentaArchivada resumen;
+        bool encontrada = false;
+        for (uint32_t i = 0; i < cuentas && !encontrada; i++) {
+            leerResumen(lector, resumen);
+            if (resumen.id_cuenta > id_cuenta) break;
+            encontrada = resumen.id_cuenta == id_cuenta;
+        }
+        if (encontrada && resumen.hasta >= desde && resumen.desde <= hasta) {
+            if (lector.getPosicion() > bloques || resumen.posicion > espacio ||
+                resumen.longitud > espacio - resumen.posicion) {
+                throw std::runtime_error("el bloque de la cuenta " + id_cuenta + " está fuera del segmento");
+            }
+            lector.saltar(bloques + resumen.posicion - lector.getPosicion(), "movimientos archivados");
+
+            uint64_t inicio = lector.getPosicion();
+            uint64_t instante_actual = 0;
+            uint64_t saldo_actual = 0;
+            for (uint32_t i = 0; i < resumen.movimientos; i++) {
+                uint8_t cabecera = 0;
+                lector.leer(cabecera, "tipo de movimiento");
+                std::string tipo;
+                switch (cabecera & MASCARA_TIPO) {
+                    case TIPO_DEPOSITO: tipo = "Depósito"; break;
+                    case TIPO_RETIRO: tipo = "Retiro"; break;
+                    case TIPO_OTRO: lector.leerCadena(tipo, "tipo de movimiento"); break;
+                    default: throw std::runtime_error("tipo de movimiento desconocido");
+                }
+                // Las diferencias se suman sin signo para que un valor dañado no desborde
+                instante_actual += static_cast<uint64_t>(desdeZigzag(leerVarint(lector, "fecha de movimiento")));
+                Fecha fecha = fechaDesdeInstante(static_cast<int64_t>(instante_actual));
+                double monto = 0, saldo = 0;
+                if (cabecera & MONTO_EN_CENTAVOS) monto = static_cast<double>(leerVarint(lector, "monto")) / 100.0;
+                else lector.leer(monto, "monto");
+                if (cabecera & SALDO_EN_CENTAVOS) {
+                    saldo_actual += static_cast<uint64_t>(desdeZigzag(leerVarint(lector, "saldo posterior")));
+                    saldo = static_cast<double>(static_cast<int64_t>(saldo_actual)) / 100.0;
+                } else {
+                    lector.leer(saldo, "saldo posterior");
+                }
+                int clave = GestorClientes::dateKey(fecha);
+                if (clave >= desde && clave <= hasta) destino.emplace_back(tipo, monto, fecha, saldo);
+            }
+            if (lector.getPosicion() - inicio != resumen.longitud) {
+                throw std::runtime_error("el bloque de la cuenta " + id_cuenta + " no coincide con su longitud");
+            }
+        }
+    } catch (const std::exception& e) {
+        error = e.what();
+    }
+    std::fclose(file);
+    if (!error.empty()) throw std::runtime_error("Segmento " + segmento.archivo + " dañado: " + error);
+}
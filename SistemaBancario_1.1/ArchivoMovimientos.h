@@ -0,0 +1,180 @@
+/**
+ * @file ArchivoMovimientos.h
+ * @brief Definición de la clase ArchivoMovimientos, almacenamiento en frío de los movimientos antiguos.
+ *
+ * Los movimientos anteriores a un horizonte se sacan del archivo de datos y se guardan en segmentos
+ * inmutables, uno por mes y por ejecución del archivado (movimientos_YYYYMM_N.seg). Cada segmento lleva
+ * un directorio de cuentas ordenado por id con el resumen de la cuenta en ese mes (cantidades, totales y
+ * saldo de cierre) y la ubicación de su bloque de movimientos comprimidos. Un índice propio registra los
+ * segmentos y el horizonte: antes del horizonte los movimientos válidos son los del archivo frío y desde
+ * el horizonte los del archivo de datos, así una falla entre el archivado y el guardado de los datos no
+ * duplica ni pierde movimientos.
+ */
+
+#ifndef ARCHIVOMOVIMIENTOS_H_INCLUDED
+#define ARCHIVOMOVIMIENTOS_H_INCLUDED
+
+#include "Movimiento.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @struct MovimientosCuenta
+ * @brief Movimientos de una cuenta que se van a archivar, en el orden del historial.
+ */
+struct MovimientosCuenta {
+    std::string id_cuenta;                ///< Número de cuenta
+    std::vector<Movimiento> movimientos;  ///< Movimientos anteriores al horizonte
+};
+
+/**
+ * @struct ResumenCuentaArchivada
+ * @brief Entrada del directorio de un segmento: resumen de una cuenta en ese mes.
+ */
+struct ResumenCuentaArchivada {
+    std::string id_cuenta;        ///< Número de cuenta
+    uint32_t movimientos = 0;     ///< Movimientos archivados
+    uint32_t depositos = 0;       ///< Cuántos son depósitos
+    uint32_t retiros = 0;         ///< Cuántos son retiros
+    double total_depositos = 0;   ///< Suma de los depósitos
+    double total_retiros = 0;     ///< Suma de los retiros
+    double saldo_cierre = 0;      ///< Saldo posterior al último movimiento del mes
+    int desde = 0;                ///< Fecha (YYYYMMDD) del movimiento más antiguo
+    int hasta = 0;                ///< Fecha (YYYYMMDD) del más reciente
+    uint64_t posicion = 0;        ///< Inicio del bloque, contado desde el final del directorio
+    uint64_t longitud = 0;        ///< Bytes del bloque
+};
+
+/**
+ * @struct SegmentoMovimientos
+ * @brief Entrada del índice: un archivo de segmento.
+ */
+struct SegmentoMovimientos {
+    std::string archivo;        ///< Nombre del archivo
+    int periodo = 0;            ///< Mes que contiene (YYYYMM)
+    uint32_t ejecucion = 0;     ///< Archivado que lo generó
+    int desde = 0;              ///< Fecha (YYYYMMDD) del movimiento más antiguo
+    int hasta = 0;              ///< Fecha (YYYYMMDD) del más reciente
+    uint32_t cuentas = 0;       ///< Cuentas en el directorio
+    uint64_t movimientos = 0;   ///< Movimientos que contiene
+    uint64_t tamanio = 0;       ///< Tamaño en bytes
+    uint64_t digest = 0;        ///< Huella FNV-1a de 64 bits del contenido
+};
+
+/**
+ * @struct ResultadoArchivo
+ * @brief Resultado de un archivado.
+ */
+struct ResultadoArchivo {
+    size_t segmentos = 0;     ///< Segmentos escritos
+    size_t cuentas = 0;       ///< Cuentas con movimientos archivados
+    size_t movimientos = 0;   ///< Movimientos archivados
+    uint64_t bytes = 0;       ///< Bytes escritos en los segmentos
+};
+
+/**
+ * @class ArchivoMovimientos
+ * @brief Índice de segmentos de movimientos archivados, guardado en un archivo propio.
+ *
+ * Los segmentos no se modifican nunca: un archivado posterior escribe segmentos nuevos con otro número
+ * de ejecución, aunque sean del mismo mes. El índice se reescribe completo en un archivo temporal que
+ * reemplaza al anterior y termina con la huella de su contenido; a diferencia del catálogo de respaldos
+ * no se reconstruye desde el directorio, porque el horizonte no se puede deducir de los archivos. Si el
+ * índice está dañado las consultas no devuelven movimientos archivados y no se permite archivar más.
+ * Todas las operaciones públicas toman un mutex.
+ */
+class ArchivoMovimientos {
+public:
+    static const uint32_t MAGIA = 0x564F4D41u;          ///< "AMOV"
+    static const uint32_t MAGIA_SEGMENTO = 0x4D474553u; ///< "SEGM"
+    static const uint32_t VERSION = 1u;
+
+    /**
+     * @brief Constructor. No lee el índice hasta la primera consulta.
+     * @param indice Ruta del archivo de índice
+     */
+    explicit ArchivoMovimientos(const std::string& indice = "movimientos_archivados.dat");
+
+    /**
+     * @brief Archivo de movimientos del sistema.
+     */
+    static ArchivoMovimientos& general();
+
+    /**
+     * @brief Fecha (YYYYMMDD) desde la que los movimientos siguen en el archivo de datos.
+     * @return 0 si todavía no se archivó nada
+     */
+    int getHorizonte();
+    /**
+     * @brief Indica si el índice existe pero no se pudo leer; en ese caso no se conoce el horizonte.
+     */
+    bool estaDanado();
+    /**
+     * @brief Segmentos registrados, del mes más antiguo al más reciente.
+     */
+    std::vector<SegmentoMovimientos> listar();
+
+    /**
+     * @brief Escribe los segmentos de un archivado y adelanta el horizonte.
+     * @param cuentas Movimientos de cada cuenta, todos anteriores al nuevo horizonte y no anteriores al actual
+     * @param horizonte Nuevo horizonte (YYYYMMDD), posterior al actual
+     * @return Cantidades archivadas
+     * @throw std::runtime_error Si el índice está dañado o no se pudo escribir algún archivo; en ese caso
+     *        se borran los segmentos de esta ejecución y el horizonte no cambia
+     */
+    ResultadoArchivo archivar(const std::vector<MovimientosCuenta>& cuentas, int horizonte);
+    /**
+     * @brief Agrega los movimientos archivados de una cuenta en un rango de fechas.
+     * @param id_cuenta Número de cuenta
+     * @param desde Primera fecha (YYYYMMDD)
+     * @param hasta Última fecha (YYYYMMDD)
+     * @param destino Vector al que se agregan, en orden cronológico
+     * @throw std::runtime_error Si un segmento necesario falta o está dañado
+     */
+    void consultar(const std::string& id_cuenta, int desde, int hasta, std::vector<Movimiento>& destino);
+
+private:
+    std::string indice;                          ///< Ruta del índice
+    std::vector<SegmentoMovimientos> segmentos;  ///< Segmentos ordenados por (periodo, ejecucion)
+    int horizonte;                               ///< Fecha desde la que los movimientos están en caliente
+    uint32_t ejecuciones;                        ///< Último número de ejecución usado
+    bool cargado;                                ///< Si ya se leyó el índice
+    bool danado;                                 ///< Si el índice existe pero no se pudo leer
+    std::set<std::string> verificados;           ///< Segmentos cuya huella ya se comprobó en esta ejecución
+    std::mutex mutex;                            ///< Protege el índice
+
+    /**
+     * @brief Lee el índice la primera vez que se consulta (con el mutex tomado).
+     */
+    void asegurarCargado();
+    /**
+     * @brief Lee y valida el índice.
+     */
+    bool leer();
+    /**
+     * @brief Reescribe el índice completo mediante un archivo temporal.
+     */
+    bool guardar() const;
+    /**
+     * @brief Codifica y escribe el segmento de un mes.
+     */
+    static SegmentoMovimientos escribirSegmento(const std::string& archivo, int periodo, uint32_t ejecucion,
+                                                const std::map<std::string, std::vector<const Movimiento*>>& cuentas);
+    /**
+     * @brief Comprueba que el tamaño y la huella del segmento coinciden con los del índice.
+     * @throw std::runtime_error Si el segmento no se puede leer o no coincide
+     */
+    static void verificarSegmento(const SegmentoMovimientos& segmento);
+    /**
+     * @brief Lee del segmento el bloque de una cuenta y agrega los movimientos del rango.
+     */
+    static void leerSegmento(const SegmentoMovimientos& segmento, const std::string& id_cuenta, int desde, int hasta,
+                             std::vector<Movimiento>& destino);
+};
+
+#endif
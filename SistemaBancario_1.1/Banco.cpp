@@ -8,22 +8,38 @@
 
 #include "Banco.h"
 #include "RespaldoDatos.h"
+#include "CatalogoRespaldos.h"
+#include "SerializadorClientes.h"
+#include "CalendarioBancario.h"
+#include "GestorClientes.h"
 #include "Menus.h"
+#include "ReemplazoArchivo.h"
 #include <stdexcept>
 #include <functional>
 #include <stdio.h>
 #include <conio.h>
 #include <fstream>
 #include <algorithm>
+#include <iterator>
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 /**
  * @brief Constructor de la clase Banco.
  * Inicializa la lista de clientes y variables auxiliares.
  */
-Banco::Banco() {
+Banco::Banco() : trigramas({
+        [](Cliente* c) { return c->get_nombres(); },
+        [](Cliente* c) { return c->get_apellidos(); }
+    }) {
     clientes = new ListaDoble<Cliente*>();
     datos_cargados = false; // Inicializar bandera
-    appointments.resize(4);
+    carga_diferida = true;
+    calendarios.resize(4);
 }
 
 /**
@@ -31,8 +47,8 @@ Banco::Banco() {
  * Libera la memoria de todos los clientes y la lista.
  */
 Banco::~Banco() {
-    clientes->recorrer([](Cliente* c) { delete c; });
-    delete clientes;
+    respaldos.esperar();
+    delete clientes; // La lista libera también los objetos que contiene
 }
 
 /**
@@ -43,6 +59,8 @@ void Banco::agregar_cliente(Cliente* cliente) {
     try {
         if (buscar_cliente(cliente->get_dni())) throw std::invalid_argument("Cliente ya existe");
         clientes->insertar_cola(cliente);
+        indices.insertar(cliente);
+        trigramas.insertar(cliente);
     } catch (const std::exception& e) {
         std::cerr << "Error al agregar cliente: " << e.what() << std::endl;
     }
@@ -62,6 +80,7 @@ void Banco::setClientes(ListaDoble<Cliente*>* nuevos_clientes) {
     
     // Asignar la nueva lista primero
     clientes = nuevos_clientes;
+    reconstruir_indices();
     
     // Liberar solo la estructura de la lista anterior, NO los clientes
     // Los clientes ahora pertenecen a la nueva lista o son nuevos objetos
@@ -83,10 +102,12 @@ void Banco::setClientes(ListaDoble<Cliente*>* nuevos_clientes) {
  * @brief Elimina todos los clientes y reinicia la lista.
  */
 void Banco::limpiar_clientes() {
+    respaldos.esperar();
     if (clientes) {
-        clientes->recorrer([](Cliente* c) { delete c; });
-        delete clientes;
+        delete clientes; // La lista libera también los objetos que contiene
         clientes = new ListaDoble<Cliente*>(); // Crear nueva lista vacía
+        indices.limpiar();
+        trigramas.limpiar();
     }
 }
 
@@ -97,12 +118,8 @@ void Banco::limpiar_clientes() {
  */
 Cliente* Banco::buscar_cliente(std::string dni) {
     try {
-        Cliente* resultado = nullptr;
-        clientes->filtrar(
-            [&](Cliente* c) { return c->get_dni() == dni; },
-            [&](Cliente* c) { resultado = c; }
-        );
-        return resultado;
+        std::vector<Cliente*> encontrados = indices.buscarExacto(0, dni);
+        return encontrados.empty() ? nullptr : encontrados.back();
     } catch (const std::exception& e) {
         std::cerr << "Error al buscar cliente: " << e.what() << std::endl;
         return nullptr;
@@ -125,29 +142,25 @@ void Banco::consultar_cuentas_cliente(std::string dni, std::string nombre, std::
             throw std::invalid_argument("Debe proporcionar al menos un criterio de búsqueda (DNI, nombre o apellido)");
         }
 
+        // Coincidencias por subcadena desde el índice de trigramas (sin recorrer toda la lista)
+        std::vector<uint32_t> ids;
+        if (!nombre.empty()) ids = trigramas.buscarIds(0, nombre);
+        if (!apellido.empty()) {
+            std::vector<uint32_t> ids_apellido = trigramas.buscarIds(1, apellido);
+            std::vector<uint32_t> unidos;
+            std::set_union(ids.begin(), ids.end(), ids_apellido.begin(), ids_apellido.end(), std::back_inserter(unidos));
+            ids.swap(unidos);
+        }
+        std::vector<Cliente*> coincidencias;
+        Cliente* por_dni = dni.empty() ? nullptr : buscar_cliente(dni);
+        if (por_dni) coincidencias.push_back(por_dni);
+        for (uint32_t id : ids) {
+            Cliente* c = trigramas.getCliente(id);
+            if (c && c != por_dni) coincidencias.push_back(c);
+        }
+
         bool encontrado = false;
-        clientes->filtrar(
-            [&](Cliente* c) {
-                bool dni_match = !dni.empty() && c->get_dni() == dni;
-                bool nombre_match = !nombre.empty();
-                if (nombre_match) {
-                    std::string nombre_c = c->get_nombres();
-                    std::transform(nombre_c.begin(), nombre_c.end(), nombre_c.begin(), ::tolower);
-                    std::string nombre_search = nombre;
-                    std::transform(nombre_search.begin(), nombre_search.end(), nombre_search.begin(), ::tolower);
-                    nombre_match = nombre_c.find(nombre_search) != std::string::npos;
-                }
-                bool apellido_match = !apellido.empty();
-                if (apellido_match) {
-                    std::string apellido_c = c->get_apellidos();
-                    std::transform(apellido_c.begin(), apellido_c.end(), apellido_c.begin(), ::tolower);
-                    std::string apellido_search = apellido;
-                    std::transform(apellido_search.begin(), apellido_search.end(), apellido_search.begin(), ::tolower);
-                    apellido_match = apellido_c.find(apellido_search) != std::string::npos;
-                }
-                return dni_match || nombre_match || apellido_match;
-            },
-            [&](Cliente* c) {
+        auto mostrar = [&](Cliente* c) {
                 encontrado = true;
                 const int ancho_consola = 80;
                 auto centrar = [&](const std::string& texto) {
@@ -208,8 +221,8 @@ void Banco::consultar_cuentas_cliente(std::string dni, std::string nombre, std::
                 });
                 std::cout << "└───────────────┴───────────────┴───────────────┴───────────────┘" << std::endl;
                 std::cout << std::endl; // Espaciado adicional
-            }
-        );
+            };
+        for (Cliente* c : coincidencias) mostrar(c);
         if (!encontrado) {
             mover_cursor(1, fila_actual++);
             std::cout << "=== NO SE ENCONTRARON CLIENTES ===" << std::endl;
@@ -251,19 +264,15 @@ void Banco::consultar_movimientos_rango(std::string dni, Fecha inicio, Fecha fin
 }
 
 /**
- * @brief Guarda los datos de clientes en un archivo binario y realiza respaldo.
+ * @brief Guarda los datos de clientes en un archivo binario y solicita un respaldo en segundo plano.
  * @param archivo Nombre del archivo binario
+ * @details El respaldo con marca de tiempo lo escribe el hilo de respaldos a partir de una instantánea
+ *          tomada aquí, así que este método retorna sin esperar a que termine.
  */
 void Banco::guardar_datos_binario(std::string archivo) {
     try {
-        FILE* file = fopen(archivo.c_str(), "wb");
-        if (!file) throw std::runtime_error("No se pudo abrir/crear el archivo para escritura");
-        int num_clientes = 0;
-        clientes->recorrer([&](Cliente* c) { num_clientes++; });
-        fwrite(&num_clientes, sizeof(int), 1, file);
-        clientes->recorrer([&](Cliente* c) { c->guardar_binario(file); });
-        RespaldoDatos::guardarRespaldoClientesConFecha(*clientes);
-        fclose(file);
+        escribir_datos_atomico(archivo);
+        respaldos.solicitar(*clientes);
     } catch (const std::exception& e) {
         std::cerr << "Error al guardar datos: " << e.what() << std::endl;
     }
@@ -274,13 +283,179 @@ void Banco::guardar_datos_binario(std::string archivo) {
  * @param archivo Nombre del archivo binario
  */
 void Banco::guardar_datos_binario_sin_backup(std::string archivo) {
-    FILE* file = fopen(archivo.c_str(), "wb");
+    escribir_datos_atomico(archivo);
+}
+
+/**
+ * @brief Pasa los movimientos anteriores a una fecha a los segmentos de movimientos archivados.
+ * @param horizonte Los movimientos de días anteriores a esta fecha dejan el archivo de datos
+ * @param archivo Nombre del archivo binario que se vuelve a guardar sin esos movimientos
+ * @return Cantidades archivadas
+ * @details Primero se escriben los segmentos y el índice con el nuevo horizonte, después se quitan los
+ *          movimientos de las listas y se guarda el archivo de datos. Si el guardado falla, los
+ *          movimientos anteriores al horizonte que queden en el archivo se ignoran en las consultas,
+ *          porque ya están en los segmentos. Se espera al respaldo en curso porque puede estar
+ *          recorriendo las listas que se reemplazan.
+ */
+ResultadoArchivo Banco::archivar_movimientos(const Fecha& horizonte, const std::string& archivo) {
+    ArchivoMovimientos& archivo_frio = ArchivoMovimientos::general();
+    int nuevo = GestorClientes::dateKey(horizonte);
+    int previo = archivo_frio.getHorizonte();
+    if (nuevo <= previo) return ResultadoArchivo();
+
+    respaldos.esperar();
+    std::vector<MovimientosCuenta> antiguos;
+    clientes->recorrer([&](Cliente* cliente) {
+        cliente->get_cuentas()->recorrer([&](Cuenta* cuenta) {
+            MovimientosCuenta actual;
+            actual.id_cuenta = cuenta->get_id_cuenta();
+            cuenta->get_movimientos()->recorrer([&](Movimiento m) {
+                int clave = GestorClientes::dateKey(m);
+                if (clave >= previo && clave < nuevo) actual.movimientos.push_back(m);
+            });
+            if (!actual.movimientos.empty()) antiguos.push_back(std::move(actual));
+        });
+    });
+
+    ResultadoArchivo resultado = archivo_frio.archivar(antiguos, nuevo);
+    clientes->recorrer([&](Cliente* cliente) {
+        cliente->get_cuentas()->recorrer([&](Cuenta* cuenta) { cuenta->descartar_movimientos_anteriores(nuevo); });
+    });
+    escribir_datos_atomico(archivo);
+    return resultado;
+}
+
+/**
+ * @brief Escribe los clientes en un temporal con pie de verificación y lo renombra sobre el archivo.
+ * @param archivo Nombre del archivo binario
+ * @details El archivo anterior no se trunca: hasta el renombrado sigue completo, y después el nuevo
+ *          ya está sincronizado con el disco. El pie (longitud del contenido, huella FNV-1a, versión
+ *          y marca) va al final, así que una escritura cortada se reconoce leyendo solo los últimos bytes.
+ *          Solo se codifican los clientes que cambiaron desde el último guardado o carga; los demás se
+ *          copian del archivo anterior. Al terminar, cada cliente queda referido al archivo nuevo.
+ */
+void Banco::escribir_datos_atomico(const std::string& archivo) {
+    std::string temporal = archivo + ".tmp";
+    FILE* file = fopen(temporal.c_str(), "wb");
     if (!file) throw std::runtime_error("No se pudo abrir/crear el archivo para escritura");
-    int num_clientes = 0;
-    clientes->recorrer([&](Cliente* c) { num_clientes++; });
-    fwrite(&num_clientes, sizeof(int), 1, file);
-    clientes->recorrer([&](Cliente* c) { c->guardar_binario(file); });
+    bool contenido_escrito = true;
+    std::vector<uint64_t> posiciones;
+    try {
+        EscritorBinario escritor(file);
+        SerializadorClientes::escribir(escritor, SerializadorClientes::capturar(*clientes), &posiciones);
+        escritor.vaciar();
+    } catch (const std::exception& e) {
+        std::cerr << "Error en escribir_datos_atomico: " << e.what() << std::endl;
+        contenido_escrito = false;
+    }
+
+    // Huella del contenido escrito, para el pie
+    EntradaRespaldo contenido;
+    if (!contenido_escrito || fflush(file) != 0 || !CatalogoRespaldos::medirArchivo(temporal, contenido)) {
+        fclose(file);
+        std::remove(temporal.c_str());
+        throw std::runtime_error("No se pudo escribir el archivo de datos");
+    }
+    uint32_t version = VERSION_DATOS, magia = MAGIA_DATOS;
+    fwrite(&contenido.tamanio, sizeof(uint64_t), 1, file);
+    fwrite(&contenido.digest, sizeof(uint64_t), 1, file);
+    fwrite(&version, sizeof(uint32_t), 1, file);
+    fwrite(&magia, sizeof(uint32_t), 1, file);
+
+    // Al disco antes de renombrar: si no, tras un corte de luz el nombre podría apuntar a datos sin escribir
+    bool escrito = fflush(file) == 0 && !ferror(file);
+#ifdef _WIN32
+    escrito = escrito && _commit(_fileno(file)) == 0;
+#else
+    escrito = escrito && fsync(fileno(file)) == 0;
+#endif
+    escrito = fclose(file) == 0 && escrito;
+    if (!escrito) {
+        std::remove(temporal.c_str());
+        throw std::runtime_error("No se pudo escribir el archivo de datos");
+    }
+
+    if (!reemplazarArchivo(temporal, archivo)) throw std::runtime_error("No se pudo reemplazar el archivo de datos");
+
+    // Sin vínculo (sistema de archivos sin enlaces duros) el próximo guardado codifica todo otra vez
+    std::shared_ptr<ArchivoHistoriales> vinculo = ArchivoHistoriales::vincular(archivo);
+    if (!vinculo || posiciones.size() != static_cast<size_t>(clientes->getTam()) + 1) return;
+    size_t i = 0;
+    clientes->recorrer([&](Cliente* cliente) {
+        CodificacionCliente codificado;
+        codificado.archivo = vinculo;
+        codificado.posicion = posiciones[i];
+        codificado.longitud = posiciones[i + 1] - posiciones[i];
+        cliente->set_codificacion(codificado);
+        i++;
+    });
+}
+
+/**
+ * @brief Revisa el pie de verificación del archivo de datos.
+ * @param archivo Nombre del archivo binario
+ * @return Estado del archivo
+ * @details La marca y la longitud del pie descartan al instante un archivo truncado; si coinciden se
+ *          compara la huella del contenido antes de interpretar ningún cliente.
+ */
+EstadoArchivoDatos Banco::verificar_archivo_datos(const std::string& archivo) {
+    const int64_t TAM_PIE = 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t);
+    FILE* file = fopen(archivo.c_str(), "rb");
+    if (!file) return EstadoArchivoDatos::Ausente;
+
+    uint64_t longitud = 0, digest = 0;
+    uint32_t version = 0, magia = 0;
+    int64_t tamanio = (LectorBinario::posicionar(file, 0, SEEK_END) == 0) ? LectorBinario::posicionDe(file) : -1;
+    bool pie_leido = tamanio >= TAM_PIE && LectorBinario::posicionar(file, tamanio - TAM_PIE) == 0 &&
+                     fread(&longitud, sizeof(uint64_t), 1, file) == 1 &&
+                     fread(&digest, sizeof(uint64_t), 1, file) == 1 &&
+                     fread(&version, sizeof(uint32_t), 1, file) == 1 &&
+                     fread(&magia, sizeof(uint32_t), 1, file) == 1;
+    if (tamanio < 0 || !pie_leido || magia != MAGIA_DATOS) {
+        // Solo los archivos del formato anterior (o vacíos) no tienen pie: uno del formato actual sin pie
+        // quedó cortado durante la escritura
+        uint32_t magia_inicio = 0;
+        bool formato_actual = tamanio >= static_cast<int64_t>(sizeof(uint32_t)) && LectorBinario::posicionar(file, 0) == 0 &&
+                              fread(&magia_inicio, sizeof(uint32_t), 1, file) == 1 &&
+                              magia_inicio == SerializadorClientes::MAGIA;
+        fclose(file);
+        return (tamanio < 0 || formato_actual) ? EstadoArchivoDatos::Danado : EstadoArchivoDatos::SinPie;
+    }
+    if (version != VERSION_DATOS || longitud != static_cast<uint64_t>(tamanio - TAM_PIE)) {
+        fclose(file);
+        return EstadoArchivoDatos::Danado;
+    }
+
+    rewind(file);
+    uint64_t hash = 14695981039346656037ull;
+    char buffer[1 << 16];
+    uint64_t restante = longitud;
+    while (restante > 0) {
+        size_t pedir = static_cast<size_t>(std::min<uint64_t>(restante, sizeof(buffer)));
+        size_t leidos = fread(buffer, 1, pedir, file);
+        if (leidos == 0) break;
+        hash = CatalogoRespaldos::fnv1a(buffer, leidos, hash);
+        restante -= leidos;
+    }
     fclose(file);
+    return (restante == 0 && hash == digest) ? EstadoArchivoDatos::Completo : EstadoArchivoDatos::Danado;
+}
+
+/**
+ * @brief Deja el archivo de datos listo para cargarse después de un guardado interrumpido.
+ * @param archivo Nombre del archivo binario
+ * @return true si el archivo quedó completo o es del formato anterior
+ */
+bool Banco::preparar_archivo_datos(const std::string& archivo) {
+    EstadoArchivoDatos estado = verificar_archivo_datos(archivo);
+    if (estado == EstadoArchivoDatos::Completo || estado == EstadoArchivoDatos::SinPie) return true;
+
+    // El temporal solo queda completo si el corte ocurrió entre la sincronización y el renombrado
+    std::string temporal = archivo + ".tmp";
+    if (verificar_archivo_datos(temporal) != EstadoArchivoDatos::Completo) return false;
+    if (!reemplazarArchivo(temporal, archivo)) return false;
+    std::cout << "Se recuperó el último guardado interrumpido de " << archivo << std::endl;
+    return true;
 }
 
 /**
@@ -290,6 +465,13 @@ void Banco::guardar_datos_binario_sin_backup(std::string archivo) {
 void Banco::cargar_datos_binario(std::string archivo) {
     try {
         if (datos_cargados) return;
+        respaldos.esperar();
+        ArchivoHistoriales::limpiarVinculos(archivo);
+
+        // Un guardado interrumpido se detecta por el pie, antes de interpretar ningún cliente
+        if (!preparar_archivo_datos(archivo) && verificar_archivo_datos(archivo) == EstadoArchivoDatos::Danado) {
+            throw std::runtime_error("El archivo " + archivo + " está incompleto o dañado");
+        }
 
         std::ifstream check_file(archivo, std::ios::binary);
         if (!check_file.good()) {
@@ -298,10 +480,10 @@ void Banco::cargar_datos_binario(std::string archivo) {
                 ListaDoble<Cliente*>* clientesRestaurados = RespaldoDatos::restaurarClientesBinario(backupFile);
                 
                 if (clientes) {
-                    clientes->recorrer([](Cliente* c) { delete c; });
-                    delete clientes;
+                    delete clientes; // La lista libera también los objetos que contiene
                 }
                 clientes = clientesRestaurados;
+                reconstruir_indices();
                 
                 guardar_datos_binario_sin_backup(archivo);
                 datos_cargados = true;
@@ -318,33 +500,7 @@ void Banco::cargar_datos_binario(std::string archivo) {
             }
         }
 
-        FILE* file = fopen(archivo.c_str(), "rb");
-        if (!file) throw std::runtime_error("No se pudo abrir el archivo para lectura");
-        
-        int num_clientes;
-        if (fread(&num_clientes, sizeof(int), 1, file) != 1) {
-            fclose(file);
-            throw std::runtime_error("Error al leer el número de clientes");
-        }
-        
-        if (clientes) {
-            clientes->recorrer([](Cliente* c) { delete c; });
-            delete clientes;
-        }
-        
-        clientes = new ListaDoble<Cliente*>();
-        for (int i = 0; i < num_clientes; i++) {
-            Cliente* cliente = new Cliente();
-            try {
-                cliente->cargar_binario(file);
-                clientes->insertar_cola(cliente);
-            } catch (...) {
-                delete cliente;
-                fclose(file);
-                throw std::runtime_error("Error al cargar cliente desde el archivo");
-            }
-        }
-        fclose(file);
+        cargar_clientes_binario(archivo, carga_diferida);
         datos_cargados = true; // Marcar datos como cargados
         std::cout << "Datos cargados exitosamente desde " << archivo << std::endl;
     } catch (const std::exception& e) {
@@ -354,39 +510,62 @@ void Banco::cargar_datos_binario(std::string archivo) {
 }
 
 /**
- * @brief Carga los datos de clientes desde un archivo binario recuperado (sin usar bandera de datos cargados).
+ * @brief Reemplaza la lista de clientes por la leída de un archivo de datos.
  * @param archivo Nombre del archivo binario
+ * @details El archivo se decodifica con SerializadorClientes, que reconoce también el formato anterior
+ *          de datos.txt y, si el archivo tiene índice, reparte los clientes entre varios hilos. Si un
+ *          cliente está truncado o tiene longitudes imposibles, la lista actual queda intacta y se lanza
+ *          la excepción; los registros bien formados con valores inválidos se omiten y se informa cuántos fueron.
+ *          Con historiales diferidos, cada cuenta lee sus movimientos la primera vez que se piden.
  */
-void Banco::cargar_datos_recuperados_binario(std::string archivo) {
-    // NO uses la bandera datos_cargados aquí
+void Banco::cargar_clientes_binario(const std::string& archivo, bool diferir_historiales) {
+    ListaDoble<Cliente*>* cargados = new ListaDoble<Cliente*>();
+    LecturaClientes lectura;
     try {
-        FILE* file = fopen(archivo.c_str(), "rb");
-        if (!file) throw std::runtime_error("No se pudo abrir el archivo para lectura");
+        lectura = SerializadorClientes::leerArchivo(archivo, FormatoClientes::LegadoDatos, *cargados,
+                                                    diferir_historiales);
+    } catch (...) {
+        delete cargados;
+        throw;
+    }
+    if (!lectura.error.empty()) {
+        delete cargados; // La lista libera también los objetos que contiene
+        throw std::runtime_error(lectura.error);
+    }
 
-        int num_clientes;
-        if (fread(&num_clientes, sizeof(int), 1, file) != 1) {
-            fclose(file);
-            throw std::runtime_error("Error al leer el número de clientes");
-        }
+    if (clientes) {
+        delete clientes; // La lista libera también los objetos que contiene
+    }
+    clientes = cargados;
+    reconstruir_indices();
+    if (lectura.descartados > 0) {
+        std::cout << "Se omitieron " << lectura.descartados << " registros con valores inválidos (último: "
+                  << lectura.ultimo_descarte << ")" << std::endl;
+    }
+}
 
-        if (clientes) {
-            clientes->recorrer([](Cliente* c) { delete c; });
-            delete clientes;
-        }
+/**
+ * @brief Activa o desactiva la carga diferida de los historiales de movimientos.
+ * @param activa true para que cargar_datos_binario deje los movimientos en el archivo hasta que se pidan
+ * @details Solo afecta a las cargas siguientes. Los archivos recuperados y los respaldos se leen siempre
+ *          completos.
+ */
+void Banco::set_carga_diferida(bool activa) {
+    carga_diferida = activa;
+}
 
-        clientes = new ListaDoble<Cliente*>();
-        for (int i = 0; i < num_clientes; i++) {
-            Cliente* cliente = new Cliente();
-            try {
-                cliente->cargar_binario(file);
-                clientes->insertar_cola(cliente);
-            } catch (...) {
-                delete cliente;
-                fclose(file);
-                throw std::runtime_error("Error al cargar cliente desde el archivo");
-            }
+/**
+ * @brief Carga los datos de clientes desde un archivo binario recuperado (sin usar bandera de datos cargados).
+ * @param archivo Nombre del archivo binario
+ */
+void Banco::cargar_datos_recuperados_binario(std::string archivo) {
+    // NO uses la bandera datos_cargados aquí
+    respaldos.esperar();
+    try {
+        if (verificar_archivo_datos(archivo) == EstadoArchivoDatos::Danado) {
+            throw std::runtime_error("El archivo " + archivo + " está incompleto o dañado");
         }
-        fclose(file);
+        cargar_clientes_binario(archivo);
         std::cout << "Datos cargados exitosamente desde " << archivo << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Error al cargar datos: " << e.what() << std::endl;
@@ -401,21 +580,19 @@ void Banco::cargar_datos_recuperados_binario(std::string archivo) {
 void Banco::restaurar_desde_respaldo(const std::string& nombreArchivo) {
     try {
         std::cout << "Abriendo backup: " << nombreArchivo << std::endl;
+        respaldos.esperar();
         RespaldoDatos respaldo;
         ListaDoble<Cliente*>* nuevos_clientes = respaldo.restaurarClientesBinario(nombreArchivo);
         std::cout << "Backup abierto, reemplazando clientes..." << std::endl;
         if (clientes) {
             std::cout << "Eliminando clientes actuales..." << std::endl;
-            clientes->recorrer([](Cliente* c) { 
-                std::cout << "Eliminando cliente..." << std::endl;
-                delete c; 
-            });
-            delete clientes;
+            delete clientes; // La lista libera también los objetos que contiene
         }
         if (!nuevos_clientes) {
             std::cout << "La lista de nuevos clientes es nula." << std::endl;
         }
         clientes = nuevos_clientes;
+        reconstruir_indices();
         std::cout << "Clientes reemplazados correctamente." << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Error en restaurar_desde_respaldo: " << e.what() << std::endl;
@@ -424,53 +601,22 @@ void Banco::restaurar_desde_respaldo(const std::string& nombreArchivo) {
 }
 
 /**
- * @brief Busca el siguiente turno disponible en una sucursal.
+ * @brief Busca el siguiente turno disponible en una sucursal, a partir del momento actual.
  * @param branchId ID de la sucursal (1, 2 o 3)
  * @return Fecha y hora del siguiente turno disponible
  */
 std::chrono::system_clock::time_point Banco::findNextAvailableSlot(int branchId) {
     if (branchId < 1 || branchId > 3) throw std::invalid_argument("Sucursal inválida");
-    auto now = std::chrono::system_clock::now();
-    time_t tt = std::chrono::system_clock::to_time_t(now);
-    tm local_tm = *localtime(&tt);
-    local_tm.tm_hour = 9; // Comenzar a las 9:00 del día actual o siguiente
-    local_tm.tm_min = 0;
-    local_tm.tm_sec = 0;
-    auto start = std::chrono::system_clock::from_time_t(mktime(&local_tm));
-
-    // Si estamos fuera del horario laboral (17:00-9:00) o es fin de semana, mover al próximo lunes 9:00
-    if (local_tm.tm_hour >= 17 || local_tm.tm_wday == 0 || local_tm.tm_wday == 6) {
-        start += std::chrono::hours(24 * (8 - local_tm.tm_wday % 7)); // Avanzar al lunes
-    }
-
-    auto& branchAppointments = appointments[branchId];
-    std::sort(branchAppointments.begin(), branchAppointments.end());
-
-    auto nextSlot = start;
-    while (true) {
-        bool available = true;
-        for (const auto& apt : branchAppointments) {
-            if (std::abs(std::chrono::duration_cast<std::chrono::minutes>(apt - nextSlot).count()) < 30) {
-                available = false;
-                break;
-            }
-        }
-        if (available && isWorkingHour(nextSlot)) return nextSlot;
-        nextSlot += std::chrono::minutes(30);
-    }
+    return calendarios[branchId].siguienteLibre(std::chrono::system_clock::now());
 }
 
 /**
- * @brief Verifica si un horario es laboral (lunes a viernes, 9:00-17:00).
+ * @brief Verifica si un horario es laboral (horario general del calendario bancario: lunes a viernes no feriados, 9:00-17:00).
  * @param tp Punto en el tiempo a verificar
  * @return true si es horario laboral, false en caso contrario
  */
 bool Banco::isWorkingHour(const std::chrono::system_clock::time_point& tp) {
-    time_t tt = std::chrono::system_clock::to_time_t(tp);
-    tm local_tm = *localtime(&tt);
-    int hour = local_tm.tm_hour;
-    int wday = local_tm.tm_wday; // 0 = domingo, 1 = lunes, etc.
-    return (wday >= 1 && wday <= 5 && hour >= 9 && hour < 17);
+    return CalendarioBancario::instancia().esMinutoBancario(tp);
 }
 
 /**
@@ -478,9 +624,33 @@ bool Banco::isWorkingHour(const std::chrono::system_clock::time_point& tp) {
  * @param branchId ID de la sucursal
  * @param time Fecha y hora de la cita
  */
-void Banco::addAppointment(int branchId, std::chrono::system_clock::time_point time) {
+bool Banco::addAppointment(int branchId, std::chrono::system_clock::time_point time) {
+    if (branchId < 1 || branchId > 3) throw std::invalid_argument("Sucursal inválida");
+    return calendarios[branchId].reservar(time);
+}
+
+/**
+ * @brief Reserva el turno de una cita agendada y lo recuerda para volver a reservarlo al reconstruir los calendarios.
+ * @param branchId ID de la sucursal
+ * @param time Fecha y hora de la cita
+ * @return true si se reservó, false si el turno ya estaba reservado o está fuera del horario laboral
+ */
+bool Banco::addAgendaAppointment(int branchId, std::chrono::system_clock::time_point time) {
+    if (!addAppointment(branchId, time)) return false;
+    turnos_agenda.insert({branchId, time});
+    return true;
+}
+
+/**
+ * @brief Cancela un turno (cita) de la sucursal indicada, liberando su horario.
+ * @param branchId ID de la sucursal
+ * @param time Fecha y hora de la cita
+ * @return true si el turno estaba reservado
+ */
+bool Banco::cancelAppointment(int branchId, std::chrono::system_clock::time_point time) {
     if (branchId < 1 || branchId > 3) throw std::invalid_argument("Sucursal inválida");
-    appointments[branchId].push_back(time);
+    turnos_agenda.erase({branchId, time});
+    return calendarios[branchId].cancelar(time);
 }
 
 /**
@@ -492,4 +662,42 @@ ListaDoble<Cliente*>* Banco::getClientes() const {
         throw std::runtime_error("La lista de clientes no ha sido inicializada");
     }
     return clientes;
+}
+
+/**
+ * @brief Obtiene el índice secundario ordenado de clientes.
+ * @return Referencia constante al índice
+ */
+const IndiceClientes& Banco::getIndices() const {
+    return indices;
+}
+
+/**
+ * @brief Obtiene el hilo de respaldos en segundo plano.
+ * @return Referencia para solicitar respaldos, esperarlos o consultar su estado
+ */
+RespaldoAsincrono& Banco::getRespaldos() {
+    return respaldos;
+}
+
+/**
+ * @brief Reconstruye los índices de búsqueda y los calendarios de turnos a partir de la lista de clientes actual
+ *        y de los turnos de citas agendadas.
+ */
+void Banco::reconstruir_indices() {
+    indices.limpiar();
+    trigramas.limpiar();
+    for (auto& calendario : calendarios) calendario.limpiar();
+    for (const auto& turno : turnos_agenda) calendarios[turno.first].reservar(turno.second);
+    if (!clientes) return;
+    indices.reconstruir(*clientes);
+    trigramas.reconstruir(*clientes);
+
+    // Los turnos guardados en las cuentas vuelven a ocupar su horario
+    clientes->recorrer([this](Cliente* c) {
+        c->get_cuentas()->recorrer([this](Cuenta* cuenta) {
+            int branchId = cuenta->get_branchId();
+            if (branchId >= 1 && branchId <= 3) calendarios[branchId].reservar(cuenta->get_appointmentTime());
+        });
+    });
 }
\ No newline at end of file
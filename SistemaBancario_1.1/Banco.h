@@ -13,9 +13,28 @@
 #include "Cuenta.h"
 #include "Fecha.h"
 #include "ListaDoble.h"
+#include "IndiceClientes.h"
+#include "IndiceTrigramas.h"
+#include "CalendarioTurnos.h"
+#include "RespaldoAsincrono.h"
+#include "ArchivoMovimientos.h"
 #include <string>
 #include <chrono>
+#include <cstdint>
 #include <functional>
+#include <set>
+#include <utility>
+
+/**
+ * @enum EstadoArchivoDatos
+ * @brief Resultado de revisar el pie de verificación del archivo de datos.
+ */
+enum class EstadoArchivoDatos {
+    Ausente,   ///< El archivo no existe
+    Completo,  ///< El pie coincide con la longitud y la huella del contenido
+    SinPie,    ///< Formato anterior, sin pie: no se puede verificar
+    Danado     ///< Escritura interrumpida o contenido alterado
+};
 
 /**
  * @class Banco
@@ -72,7 +91,7 @@ public:
      */
     void consultar_movimientos_rango(std::string dni, Fecha inicio, Fecha fin);
     /**
-     * @brief Guarda los datos de clientes en un archivo binario y realiza respaldo.
+     * @brief Guarda los datos de clientes en un archivo binario y solicita un respaldo en segundo plano.
      * @param archivo Nombre del archivo binario
      */
     void guardar_datos_binario(std::string archivo);
@@ -81,6 +100,28 @@ public:
      * @param archivo Nombre del archivo binario
      */
     void guardar_datos_binario_sin_backup(std::string archivo);
+    /**
+     * @brief Pasa los movimientos anteriores a una fecha a los segmentos de movimientos archivados.
+     * @param horizonte Los movimientos de días anteriores a esta fecha dejan el archivo de datos
+     * @param archivo Nombre del archivo binario que se vuelve a guardar sin esos movimientos
+     * @return Cantidades archivadas (todo en cero si la fecha no es posterior al horizonte actual)
+     * @throw std::runtime_error Si no se pudieron escribir los segmentos o el archivo de datos
+     */
+    ResultadoArchivo archivar_movimientos(const Fecha& horizonte, const std::string& archivo);
+    /**
+     * @brief Revisa el pie de verificación del archivo de datos.
+     * @param archivo Nombre del archivo binario
+     * @return Estado del archivo; un archivo truncado se detecta sin leer su contenido
+     */
+    static EstadoArchivoDatos verificar_archivo_datos(const std::string& archivo);
+    /**
+     * @brief Deja el archivo de datos listo para cargarse después de un guardado interrumpido.
+     * @param archivo Nombre del archivo binario
+     * @return true si el archivo quedó completo o es del formato anterior
+     * @details Si el archivo falta o está dañado pero el temporal del último guardado está completo,
+     *          el temporal reemplaza al archivo.
+     */
+    static bool preparar_archivo_datos(const std::string& archivo);
     /**
      * @brief Carga los datos de clientes desde un archivo binario, restaurando desde respaldo si es necesario.
      * @param archivo Nombre del archivo binario
@@ -91,19 +132,24 @@ public:
      * @param archivo Nombre del archivo binario
      */
     void cargar_datos_recuperados_binario(std::string archivo);
+    /**
+     * @brief Activa o desactiva la carga diferida de los historiales de movimientos (activa por defecto).
+     * @param activa true para que cargar_datos_binario deje los movimientos en el archivo hasta que se pidan
+     */
+    void set_carga_diferida(bool activa);
     /**
      * @brief Restaura la lista de clientes desde un archivo de respaldo binario.
      * @param nombreArchivo Nombre del archivo de respaldo
      */
     void restaurar_desde_respaldo(const std::string& nombreArchivo);
     /**
-     * @brief Busca el siguiente turno disponible en una sucursal.
+     * @brief Busca el siguiente turno disponible en una sucursal, a partir del momento actual.
      * @param branchId ID de la sucursal (1, 2 o 3)
      * @return Fecha y hora del siguiente turno disponible
      */
     std::chrono::system_clock::time_point findNextAvailableSlot(int branchId);
     /**
-     * @brief Verifica si un horario es laboral (lunes a viernes, 9:00-17:00).
+     * @brief Verifica si un horario es laboral (lunes a viernes no feriados, 9:00-17:00).
      * @param tp Punto en el tiempo a verificar
      * @return true si es horario laboral, false en caso contrario
      */
@@ -112,19 +158,73 @@ public:
      * @brief Agrega un turno (cita) a la sucursal indicada.
      * @param branchId ID de la sucursal
      * @param time Fecha y hora de la cita
+     * @return true si se reservó, false si el turno ya estaba reservado o está fuera del horario laboral
      */
-    void addAppointment(int branchId, std::chrono::system_clock::time_point time);
+    bool addAppointment(int branchId, std::chrono::system_clock::time_point time);
+    /**
+     * @brief Reserva el turno de una cita agendada (no guardada en una cuenta), que se conserva al reconstruir
+     *        los calendarios.
+     * @param branchId ID de la sucursal
+     * @param time Fecha y hora de la cita
+     * @return true si se reservó, false si el turno ya estaba reservado o está fuera del horario laboral
+     */
+    bool addAgendaAppointment(int branchId, std::chrono::system_clock::time_point time);
+    /**
+     * @brief Cancela un turno (cita) de la sucursal indicada, liberando su horario.
+     * @param branchId ID de la sucursal
+     * @param time Fecha y hora de la cita
+     * @return true si el turno estaba reservado
+     * @note También libera el turno de una cita agendada con addAgendaAppointment().
+     */
+    bool cancelAppointment(int branchId, std::chrono::system_clock::time_point time);
     /**
      * @brief Obtiene la lista de clientes del banco.
      * @return Puntero a la lista doble de clientes
      */
     ListaDoble<Cliente*>* getClientes() const;
+    /**
+     * @brief Obtiene el índice secundario ordenado de clientes.
+     * @return Referencia constante al índice, siempre sincronizado con la lista de clientes
+     */
+    const IndiceClientes& getIndices() const;
+    /**
+     * @brief Obtiene el hilo de respaldos en segundo plano.
+     * @return Referencia para solicitar respaldos, esperarlos o consultar su estado
+     */
+    RespaldoAsincrono& getRespaldos();
 
 private:
     ListaDoble<Cliente*>* clientes; ///< Puntero a la lista doble de clientes
     bool datos_cargados; ///< Bandera para indicar si los datos han sido cargados
-    std::vector<std::vector<std::chrono::system_clock::time_point>> appointments; ///< Turnos por sucursal
+    bool carga_diferida; ///< Si los historiales de movimientos se leen recién cuando se piden
+    IndiceClientes indices; ///< Índices ordenados por campo para búsquedas exactas, por prefijo y por rango
+    IndiceTrigramas trigramas; ///< Índice de trigramas de nombres (campo 0) y apellidos (campo 1) para búsqueda por subcadena
+    std::vector<CalendarioTurnos> calendarios; ///< Turnos reservados por sucursal (índice = ID de sucursal)
+    std::set<std::pair<int, std::chrono::system_clock::time_point>> turnos_agenda; ///< Turnos de citas agendadas (sucursal, hora)
+    RespaldoAsincrono respaldos; ///< Escribe los respaldos con marca de tiempo sin bloquear el guardado
     // ... resto de miembros ...
+
+    static const uint32_t MAGIA_DATOS = 0x534F5444u; ///< "DTOS", últimos bytes del pie del archivo de datos
+    static const uint32_t VERSION_DATOS = 1u;        ///< Versión del pie
+
+    /**
+     * @brief Escribe los clientes en un temporal con pie de verificación, lo sincroniza con el disco y
+     *        lo renombra sobre el archivo de datos.
+     * @param archivo Nombre del archivo binario
+     */
+    void escribir_datos_atomico(const std::string& archivo);
+    /**
+     * @brief Reemplaza la lista de clientes por la leída de un archivo de datos, validando cada registro.
+     * @param archivo Nombre del archivo binario
+     * @param diferir_historiales true para dejar los movimientos en el archivo hasta que se pidan
+     */
+    void cargar_clientes_binario(const std::string& archivo, bool diferir_historiales = false);
+
+    /**
+     * @brief Reconstruye los índices de búsqueda y los calendarios de turnos a partir de la lista de clientes actual
+     *        y de los turnos de citas agendadas.
+     */
+    void reconstruir_indices();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,396 @@
+/**
+ * @file CalendarioBancario.cpp
+ * @brief Implementación del calendario bancario compartido.
+ */
+
+#include "CalendarioBancario.h"
+#include "Fecha.h"
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+const int CalendarioBancario::HORARIO_GENERAL;
+const long CalendarioBancario::PRIMER_DIA = -25567; // 1900-01-01
+const long CalendarioBancario::TOTAL_DIAS = 73414;  // 1900-01-01 .. 2100-12-31
+
+namespace {
+
+/**
+ * @brief División entera que redondea hacia menos infinito.
+ */
+long dividirPiso(long a, long b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+/**
+ * @brief Cantidad de días de un mes.
+ */
+int diasDelMes(int anio, int mes) {
+    static const int dias[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool bisiesto = (anio % 4 == 0 && anio % 100 != 0) || anio % 400 == 0;
+    return (mes == 2 && bisiesto) ? 29 : dias[mes - 1];
+}
+
+/**
+ * @brief Quita espacios y saltos de línea al inicio y al final.
+ */
+std::string recortar(const std::string& texto) {
+    size_t ini = texto.find_first_not_of(" \t\r\n");
+    if (ini == std::string::npos) return "";
+    size_t fin = texto.find_last_not_of(" \t\r\n");
+    return texto.substr(ini, fin - ini + 1);
+}
+
+/**
+ * @brief Convierte una cadena de dígitos en entero.
+ * @return -1 si contiene caracteres que no son dígitos
+ */
+int leerNumero(const std::string& texto) {
+    if (texto.empty()) return -1;
+    int valor = 0;
+    for (char c : texto) {
+        if (c < '0' || c > '9') return -1;
+        valor = valor * 10 + (c - '0');
+    }
+    return valor;
+}
+
+}
+
+/**
+ * @brief Obtiene el calendario compartido por todo el sistema.
+ * @return Referencia al calendario
+ */
+CalendarioBancario& CalendarioBancario::instancia() {
+    static CalendarioBancario calendario;
+    return calendario;
+}
+
+/**
+ * @brief Constructor privado: carga los feriados nacionales y el horario general por defecto.
+ */
+CalendarioBancario::CalendarioBancario() {
+    const int feriados[] = {101, 212, 213, 329, 501, 524, 810, 926, 1009, 1102, 1103, 1224, 1225, 1231};
+    feriados_anuales.insert(std::begin(feriados), std::end(feriados));
+
+    Horario general;
+    for (int d = 0; d < 7; d++) {
+        bool laborable = (d >= 1 && d <= 5);
+        general.apertura[d] = 9 * 60;
+        general.cierre[d] = laborable ? 17 * 60 : 9 * 60;
+    }
+    horarios[HORARIO_GENERAL] = general;
+    recalcularFeriados();
+}
+
+/**
+ * @brief Días transcurridos desde 1970-01-01 hasta una fecha del calendario civil.
+ */
+long CalendarioBancario::diasDesdeCivil(int anio, int mes, int dia) {
+    anio -= mes <= 2;
+    const long era = dividirPiso(anio, 400);
+    const long anio_era = anio - era * 400;
+    const long dia_anio = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;
+    const long dia_era = anio_era * 365 + anio_era / 4 - anio_era / 100 + dia_anio;
+    return era * 146097 + dia_era - 719468;
+}
+
+/**
+ * @brief Fecha del calendario civil correspondiente a una cantidad de días desde 1970-01-01.
+ */
+void CalendarioBancario::civilDesdeDias(long dias, int& anio, int& mes, int& dia) {
+    dias += 719468;
+    const long era = dividirPiso(dias, 146097);
+    const long dia_era = dias - era * 146097;
+    const long anio_era = (dia_era - dia_era / 1460 + dia_era / 36524 - dia_era / 146096) / 365;
+    const long dia_anio = dia_era - (365 * anio_era + anio_era / 4 - anio_era / 100);
+    const long mp = (5 * dia_anio + 2) / 153;
+    dia = (int)(dia_anio - (153 * mp + 2) / 5 + 1);
+    mes = (int)(mp < 10 ? mp + 3 : mp - 9);
+    anio = (int)(anio_era + era * 400) + (mes <= 2);
+}
+
+/**
+ * @brief Día de la semana (0 = domingo) de una cantidad de días desde 1970-01-01 (que fue jueves).
+ */
+int CalendarioBancario::diaSemana(long dias) {
+    return (int)(dias - dividirPiso(dias + 4, 7) * 7 + 4);
+}
+
+/**
+ * @brief Descompone un instante en día y minuto del día, en hora local.
+ */
+void CalendarioBancario::descomponer(Instante instante, long& dia, int& minuto, int& segundos) {
+    time_t tt = std::chrono::system_clock::to_time_t(instante);
+    tm local_tm = {};
+#ifdef _WIN32
+    localtime_s(&local_tm, &tt);
+#else
+    localtime_r(&tt, &local_tm);
+#endif
+    dia = diasDesdeCivil(local_tm.tm_year + 1900, local_tm.tm_mon + 1, local_tm.tm_mday);
+    minuto = local_tm.tm_hour * 60 + local_tm.tm_min;
+    segundos = local_tm.tm_sec;
+}
+
+/**
+ * @brief Instante local correspondiente a un día y minuto del día.
+ */
+CalendarioBancario::Instante CalendarioBancario::componer(long dia, int minuto) {
+    int anio, mes, dia_mes;
+    civilDesdeDias(dia, anio, mes, dia_mes);
+    tm local_tm = {};
+    local_tm.tm_year = anio - 1900;
+    local_tm.tm_mon = mes - 1;
+    local_tm.tm_mday = dia_mes;
+    local_tm.tm_hour = minuto / 60;
+    local_tm.tm_min = minuto % 60;
+    local_tm.tm_isdst = -1;
+    return std::chrono::system_clock::from_time_t(mktime(&local_tm));
+}
+
+/**
+ * @brief Indica si un día (desde 1970-01-01) está dentro de la tabla.
+ */
+bool CalendarioBancario::enTabla(long dia) {
+    return dia >= PRIMER_DIA && dia < PRIMER_DIA + TOTAL_DIAS;
+}
+
+/**
+ * @brief Indica si una sucursal atiende en una posición de la tabla.
+ */
+bool CalendarioBancario::abre(long posicion, const Horario& horario) const {
+    int d = diaSemana(PRIMER_DIA + posicion);
+    return !marca_feriado[posicion] && horario.apertura[d] < horario.cierre[d];
+}
+
+/**
+ * @brief Obtiene el horario de una sucursal (el general si no tiene uno propio).
+ */
+const CalendarioBancario::Horario& CalendarioBancario::horarioDe(int sucursal) const {
+    auto it = horarios.find(sucursal);
+    return (it != horarios.end()) ? it->second : horarios.at(HORARIO_GENERAL);
+}
+
+/**
+ * @brief Obtiene la tabla de siguiente apertura de una sucursal (la general si no tiene una propia).
+ */
+const std::vector<int32_t>& CalendarioBancario::siguienteDe(int sucursal) const {
+    auto it = siguiente_abierto.find(sucursal);
+    return (it != siguiente_abierto.end()) ? it->second : siguiente_abierto.at(HORARIO_GENERAL);
+}
+
+/**
+ * @brief Recalcula la marca de feriado de cada día y las tablas que dependen de ella.
+ */
+void CalendarioBancario::recalcularFeriados() {
+    marca_feriado.assign(TOTAL_DIAS, 0);
+    int anio, mes, dia;
+    civilDesdeDias(PRIMER_DIA, anio, mes, dia);
+    for (long i = 0; i < TOTAL_DIAS; i++) {
+        if (feriados_anuales.count(mes * 100 + dia) || feriados_puntuales.count(PRIMER_DIA + i)) {
+            marca_feriado[i] = 1;
+        }
+        // Avanzar al día siguiente sin volver a convertir desde cero
+        if (++dia > diasDelMes(anio, mes)) {
+            dia = 1;
+            if (++mes > 12) {
+                mes = 1;
+                anio++;
+            }
+        }
+    }
+    for (const auto& par : horarios) recalcularSucursal(par.first);
+}
+
+/**
+ * @brief Recalcula la tabla de siguiente apertura de una sucursal (y la numeración si es la general).
+ */
+void CalendarioBancario::recalcularSucursal(int sucursal) {
+    const Horario& horario = horarios.at(sucursal);
+    std::vector<int32_t>& siguiente = siguiente_abierto[sucursal];
+    siguiente.assign(TOTAL_DIAS + 1, (int32_t)TOTAL_DIAS);
+    for (long i = TOTAL_DIAS - 1; i >= 0; i--) {
+        siguiente[i] = abre(i, horario) ? (int32_t)i : siguiente[i + 1];
+    }
+
+    if (sucursal != HORARIO_GENERAL) return;
+    numero_bancario.assign(TOTAL_DIAS + 1, 0);
+    dias_bancarios.clear();
+    for (long i = 0; i < TOTAL_DIAS; i++) {
+        numero_bancario[i] = (int32_t)dias_bancarios.size();
+        if (siguiente[i] == i) dias_bancarios.push_back((int32_t)i);
+    }
+    numero_bancario[TOTAL_DIAS] = (int32_t)dias_bancarios.size();
+}
+
+/**
+ * @brief Reemplaza los feriados con los de un archivo y recalcula las tablas.
+ * @param archivo Ruta del archivo de feriados
+ * @return true si se cargó, false si no se pudo abrir o tiene líneas inválidas
+ */
+bool CalendarioBancario::cargarFeriados(const std::string& archivo) {
+    std::ifstream entrada(archivo);
+    if (!entrada.is_open()) return false;
+
+    try {
+        std::set<int> anuales;
+        std::set<long> puntuales;
+        std::string linea;
+        while (std::getline(entrada, linea)) {
+            linea = recortar(linea);
+            if (linea.empty() || linea[0] == '#') continue;
+
+            if (linea.size() == 5 && linea[2] == '-') {
+                int mes = leerNumero(linea.substr(0, 2));
+                int dia = leerNumero(linea.substr(3, 2));
+                if (!Fecha::es_fecha_valida(2000, mes, dia)) throw std::invalid_argument("Feriado inválido: " + linea);
+                anuales.insert(mes * 100 + dia);
+            } else if (linea.size() == 10 && linea[4] == '-' && linea[7] == '-') {
+                int anio = leerNumero(linea.substr(0, 4));
+                int mes = leerNumero(linea.substr(5, 2));
+                int dia = leerNumero(linea.substr(8, 2));
+                if (!Fecha::es_fecha_valida(anio, mes, dia)) throw std::invalid_argument("Feriado inválido: " + linea);
+                puntuales.insert(diasDesdeCivil(anio, mes, dia));
+            } else {
+                throw std::invalid_argument("Formato de feriado inválido: " + linea);
+            }
+        }
+
+        feriados_anuales.swap(anuales);
+        feriados_puntuales.swap(puntuales);
+        recalcularFeriados();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en cargarFeriados: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+/**
+ * @brief Define el horario de atención de una sucursal para un día de la semana.
+ */
+void CalendarioBancario::definirHorario(int sucursal, int dia_semana, int apertura, int cierre) {
+    if (dia_semana < 0 || dia_semana > 6) throw std::invalid_argument("Día de la semana inválido");
+    if (apertura < 0 || cierre > 24 * 60 || cierre < apertura) throw std::invalid_argument("Horario inválido");
+
+    auto it = horarios.find(sucursal);
+    if (it == horarios.end()) {
+        // Una sucursal nueva parte cerrada todos los días
+        Horario cerrado;
+        for (int d = 0; d < 7; d++) cerrado.apertura[d] = cerrado.cierre[d] = 0;
+        it = horarios.emplace(sucursal, cerrado).first;
+    }
+    it->second.apertura[dia_semana] = apertura;
+    it->second.cierre[dia_semana] = cierre;
+    recalcularSucursal(sucursal);
+}
+
+/**
+ * @brief Indica si una fecha es feriado.
+ */
+bool CalendarioBancario::esFeriado(int anio, int mes, int dia) const {
+    long d = diasDesdeCivil(anio, mes, dia);
+    if (enTabla(d)) return marca_feriado[d - PRIMER_DIA] != 0;
+    return feriados_anuales.count(mes * 100 + dia) || feriados_puntuales.count(d);
+}
+
+/**
+ * @brief Indica si una fecha cae sábado o domingo.
+ */
+bool CalendarioBancario::esFinDeSemana(int anio, int mes, int dia) const {
+    int d = diaSemana(diasDesdeCivil(anio, mes, dia));
+    return d == 0 || d == 6;
+}
+
+/**
+ * @brief Indica si una sucursal atiende en una fecha.
+ */
+bool CalendarioBancario::esDiaBancario(int anio, int mes, int dia, int sucursal) const {
+    long d = diasDesdeCivil(anio, mes, dia);
+    const Horario& horario = horarioDe(sucursal);
+    if (enTabla(d)) return abre(d - PRIMER_DIA, horario);
+    int ds = diaSemana(d);
+    return !esFeriado(anio, mes, dia) && horario.apertura[ds] < horario.cierre[ds];
+}
+
+/**
+ * @brief Indica si un instante está dentro del horario de atención de una sucursal.
+ */
+bool CalendarioBancario::esMinutoBancario(Instante instante, int sucursal) const {
+    long dia;
+    int minuto, segundos;
+    descomponer(instante, dia, minuto, segundos);
+    if (!enTabla(dia)) return false;
+    const Horario& horario = horarioDe(sucursal);
+    int d = diaSemana(dia);
+    return abre(dia - PRIMER_DIA, horario) && minuto >= horario.apertura[d] && minuto < horario.cierre[d];
+}
+
+/**
+ * @brief Indica si un minuto de una fecha está dentro del horario de atención de una sucursal.
+ */
+bool CalendarioBancario::esMinutoBancario(int anio, int mes, int dia, int minuto, int sucursal) const {
+    if (!esDiaBancario(anio, mes, dia, sucursal)) return false;
+    const Horario& horario = horarioDe(sucursal);
+    int d = diaSemana(diasDesdeCivil(anio, mes, dia));
+    return minuto >= horario.apertura[d] && minuto < horario.cierre[d];
+}
+
+/**
+ * @brief Obtiene el primer minuto de atención de una sucursal en o después de un instante.
+ */
+CalendarioBancario::Instante CalendarioBancario::siguienteMinutoBancario(Instante instante, int sucursal) const {
+    long dia;
+    int minuto, segundos;
+    descomponer(instante, dia, minuto, segundos);
+    if (!enTabla(dia)) throw std::out_of_range("Fecha fuera del calendario bancario");
+
+    const Horario& horario = horarioDe(sucursal);
+    long posicion = dia - PRIMER_DIA;
+    if (abre(posicion, horario)) {
+        int d = diaSemana(dia);
+        if (minuto < horario.apertura[d]) return componer(dia, horario.apertura[d]);
+        if (minuto < horario.cierre[d]) return instante;
+        posicion++;
+    }
+
+    long siguiente = siguienteDe(sucursal)[posicion];
+    if (siguiente >= TOTAL_DIAS) throw std::out_of_range("Sin atención hasta el fin del calendario bancario");
+    return componer(PRIMER_DIA + siguiente, horario.apertura[diaSemana(PRIMER_DIA + siguiente)]);
+}
+
+/**
+ * @brief Cantidad de días bancarios generales anteriores a un día.
+ */
+long CalendarioBancario::numeroDiaBancario(long dia) const {
+    if (dia < PRIMER_DIA || dia > PRIMER_DIA + TOTAL_DIAS) throw std::out_of_range("Fecha fuera del calendario bancario");
+    return numero_bancario[dia - PRIMER_DIA];
+}
+
+/**
+ * @brief Día correspondiente a un número de día bancario general.
+ */
+long CalendarioBancario::diaDeNumeroBancario(long numero) const {
+    if (numero < 0 || numero >= (long)dias_bancarios.size()) throw std::out_of_range("Fecha fuera del calendario bancario");
+    return PRIMER_DIA + dias_bancarios[numero];
+}
+
+/**
+ * @brief Horario general de un día de la semana.
+ */
+void CalendarioBancario::horarioGeneral(int dia_semana, int& apertura, int& cierre) const {
+    const Horario& horario = horarios.at(HORARIO_GENERAL);
+    apertura = horario.apertura[dia_semana];
+    cierre = horario.cierre[dia_semana];
+}
+
+/**
+ * @brief Horario de atención de una sucursal en un día de la semana.
+ */
+void CalendarioBancario::horarioSucursal(int sucursal, int dia_semana, int& apertura, int& cierre) const {
+    const Horario& horario = horarioDe(sucursal);
+    apertura = horario.apertura[dia_semana];
+    cierre = horario.cierre[dia_semana];
+}
@@ -0,0 +1,193 @@
+/**
+ * @file CalendarioBancario.h
+ * @brief Definición de la clase CalendarioBancario, calendario de días bancarios, feriados y horarios compartido.
+ *
+ * Precalcula una tabla de días entre 1900 y 2100 con los feriados y, por sucursal, el siguiente día en que
+ * abre. Con ella Fecha, Banco, CalendarioTurnos y SimpleGeolocationSystem responden "¿es horario bancario?"
+ * y "¿cuándo es el siguiente minuto bancario?" en O(1), sin repetir reglas de fin de semana y feriados.
+ */
+
+#ifndef CALENDARIOBANCARIO_H_INCLUDED
+#define CALENDARIOBANCARIO_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class CalendarioBancario
+ * @brief Servicio único (ver instancia()) con los días bancarios y los horarios de atención.
+ *
+ * Los días se identifican por la cantidad de días transcurridos desde 1970-01-01. La sucursal 0 es el
+ * horario general de oficina (lunes a viernes, 9:00-17:00), usado para citas y días hábiles; las demás
+ * sucursales registran su horario de atención con definirHorario().
+ */
+class CalendarioBancario {
+public:
+    typedef std::chrono::system_clock::time_point Instante;
+
+    static const int HORARIO_GENERAL = 0; ///< Sucursal que representa el horario general de oficina
+
+    /**
+     * @brief Obtiene el calendario compartido por todo el sistema.
+     * @return Referencia al calendario
+     */
+    static CalendarioBancario& instancia();
+
+    /**
+     * @brief Reemplaza los feriados con los de un archivo y recalcula las tablas.
+     * @details Cada línea es "MM-DD" (feriado de todos los años) o "AAAA-MM-DD" (feriado puntual);
+     *          las líneas vacías y las que comienzan con '#' se ignoran.
+     * @param archivo Ruta del archivo de feriados
+     * @return true si se cargó, false si no se pudo abrir o tiene líneas inválidas (se conservan los feriados actuales)
+     */
+    bool cargarFeriados(const std::string& archivo);
+    /**
+     * @brief Define el horario de atención de una sucursal para un día de la semana.
+     * @param sucursal ID de la sucursal (0 = horario general)
+     * @param dia_semana Día de la semana (0 = domingo ... 6 = sábado)
+     * @param apertura Minuto del día en que abre
+     * @param cierre Minuto del día en que cierra (exclusivo); igual a apertura si no atiende
+     */
+    void definirHorario(int sucursal, int dia_semana, int apertura, int cierre);
+
+    /**
+     * @brief Indica si una fecha es feriado.
+     */
+    bool esFeriado(int anio, int mes, int dia) const;
+    /**
+     * @brief Indica si una fecha cae sábado o domingo.
+     */
+    bool esFinDeSemana(int anio, int mes, int dia) const;
+    /**
+     * @brief Indica si una sucursal atiende en una fecha (no es feriado y tiene horario ese día).
+     */
+    bool esDiaBancario(int anio, int mes, int dia, int sucursal = HORARIO_GENERAL) const;
+    /**
+     * @brief Indica si un instante está dentro del horario de atención de una sucursal.
+     * @param instante Instante a consultar (hora local)
+     * @param sucursal ID de la sucursal
+     */
+    bool esMinutoBancario(Instante instante, int sucursal = HORARIO_GENERAL) const;
+    /**
+     * @brief Indica si un minuto de una fecha está dentro del horario de atención de una sucursal.
+     * @param minuto Minuto del día (hora * 60 + minutos)
+     */
+    bool esMinutoBancario(int anio, int mes, int dia, int minuto, int sucursal = HORARIO_GENERAL) const;
+    /**
+     * @brief Obtiene el primer minuto de atención de una sucursal en o después de un instante.
+     * @param instante Instante de partida (hora local)
+     * @param sucursal ID de la sucursal
+     * @return Instante devuelto sin cambios si ya es horario de atención; si no, la siguiente apertura
+     * @throws std::out_of_range si no hay apertura antes del fin de la tabla
+     */
+    Instante siguienteMinutoBancario(Instante instante, int sucursal = HORARIO_GENERAL) const;
+
+    /**
+     * @brief Cantidad de días bancarios generales anteriores a un día.
+     * @details Para un día no bancario coincide con el número del siguiente día bancario, de modo
+     *          que los días bancarios quedan numerados de forma consecutiva.
+     * @param dia Días desde 1970-01-01
+     */
+    long numeroDiaBancario(long dia) const;
+    /**
+     * @brief Día correspondiente a un número de día bancario general.
+     * @param numero Número devuelto por numeroDiaBancario
+     * @return Días desde 1970-01-01
+     * @throws std::out_of_range si el número está fuera de la tabla
+     */
+    long diaDeNumeroBancario(long numero) const;
+    /**
+     * @brief Horario general de un día de la semana.
+     * @param dia_semana Día de la semana (0 = domingo)
+     * @param apertura Minuto de apertura
+     * @param cierre Minuto de cierre (exclusivo)
+     */
+    void horarioGeneral(int dia_semana, int& apertura, int& cierre) const;
+    /**
+     * @brief Horario de atención de una sucursal en un día de la semana (el general si no tiene uno propio).
+     * @param sucursal ID de la sucursal
+     * @param dia_semana Día de la semana (0 = domingo)
+     * @param apertura Minuto de apertura
+     * @param cierre Minuto de cierre (exclusivo)
+     */
+    void horarioSucursal(int sucursal, int dia_semana, int& apertura, int& cierre) const;
+
+    /**
+     * @brief Días transcurridos desde 1970-01-01 hasta una fecha del calendario civil.
+     */
+    static long diasDesdeCivil(int anio, int mes, int dia);
+    /**
+     * @brief Fecha del calendario civil correspondiente a una cantidad de días desde 1970-01-01.
+     */
+    static void civilDesdeDias(long dias, int& anio, int& mes, int& dia);
+    /**
+     * @brief Día de la semana (0 = domingo) de una cantidad de días desde 1970-01-01.
+     */
+    static int diaSemana(long dias);
+    /**
+     * @brief Descompone un instante en día (desde 1970-01-01) y minuto del día, en hora local.
+     * @param segundos Recibe los segundos dentro del minuto
+     */
+    static void descomponer(Instante instante, long& dia, int& minuto, int& segundos);
+    /**
+     * @brief Instante local correspondiente a un día y minuto del día.
+     */
+    static Instante componer(long dia, int minuto);
+
+private:
+    /**
+     * @struct Horario
+     * @brief Minutos de apertura y cierre (exclusivo) por día de la semana.
+     */
+    struct Horario {
+        int apertura[7];
+        int cierre[7];
+    };
+
+    std::set<int> feriados_anuales;  ///< Feriados de todos los años (mes * 100 + día)
+    std::set<long> feriados_puntuales; ///< Feriados de un año concreto (días desde 1970-01-01)
+    std::vector<uint8_t> marca_feriado; ///< Feriado por posición de la tabla
+    std::unordered_map<int, Horario> horarios; ///< Horario por sucursal
+    std::unordered_map<int, std::vector<int32_t>> siguiente_abierto; ///< Por sucursal: siguiente posición que abre (o fin)
+    std::vector<int32_t> numero_bancario; ///< Días bancarios generales anteriores a cada posición
+    std::vector<int32_t> dias_bancarios;  ///< Posición de cada día bancario general
+
+    static const long PRIMER_DIA;  ///< 1900-01-01 en días desde 1970-01-01
+    static const long TOTAL_DIAS;  ///< Días de la tabla (hasta 2100-12-31)
+
+    /**
+     * @brief Constructor privado: carga los feriados nacionales y el horario general por defecto.
+     */
+    CalendarioBancario();
+
+    /**
+     * @brief Recalcula la marca de feriado de cada día y las tablas que dependen de ella.
+     */
+    void recalcularFeriados();
+    /**
+     * @brief Recalcula la tabla de siguiente apertura de una sucursal (y la numeración si es la general).
+     */
+    void recalcularSucursal(int sucursal);
+    /**
+     * @brief Obtiene el horario de una sucursal (el general si no tiene uno propio).
+     */
+    const Horario& horarioDe(int sucursal) const;
+    /**
+     * @brief Obtiene la tabla de siguiente apertura de una sucursal (la general si no tiene una propia).
+     */
+    const std::vector<int32_t>& siguienteDe(int sucursal) const;
+    /**
+     * @brief Indica si un día (desde 1970-01-01) está dentro de la tabla.
+     */
+    static bool enTabla(long dia);
+    /**
+     * @brief Indica si una sucursal atiende en una posición de la tabla.
+     */
+    bool abre(long posicion, const Horario& horario) const;
+};
+
+#endif
@@ -0,0 +1,212 @@
+/**
+ * @file CalendarioTurnos.cpp
+ * @brief Implementación del calendario de turnos por sucursal.
+ */
+
+#include "CalendarioTurnos.h"
+#include "CalendarioBancario.h"
+
+/**
+ * @brief Constructor por defecto. Crea un calendario sin reservas.
+ */
+CalendarioTurnos::CalendarioTurnos() : reservados(0) {}
+
+/**
+ * @brief Convierte un instante en día bancario y turno (hora local).
+ */
+bool CalendarioTurnos::descomponer(Instante instante, long& dia, int& turno, int& minutos_sobrantes) {
+    const CalendarioBancario& calendario = CalendarioBancario::instancia();
+    long dia_civil;
+    int minuto, segundos;
+    CalendarioBancario::descomponer(instante, dia_civil, minuto, segundos);
+    dia = calendario.numeroDiaBancario(dia_civil);
+
+    if (calendario.numeroDiaBancario(dia_civil + 1) == dia) {
+        // Fin de semana o feriado: se ubica al inicio del siguiente día bancario
+        turno = 0;
+        minutos_sobrantes = 0;
+        return false;
+    }
+
+    int apertura, cierre;
+    calendario.horarioGeneral(CalendarioBancario::diaSemana(dia_civil), apertura, cierre);
+    int minutos = minuto - apertura;
+    turno = (minutos >= 0) ? minutos / MINUTOS_TURNO : -((-minutos + MINUTOS_TURNO - 1) / MINUTOS_TURNO);
+    minutos_sobrantes = minutos - turno * MINUTOS_TURNO;
+    if (minutos_sobrantes == 0 && segundos > 0) minutos_sobrantes = 1;
+    return true;
+}
+
+/**
+ * @brief Convierte un día bancario y turno en el instante de inicio del turno (hora local).
+ */
+CalendarioTurnos::Instante CalendarioTurnos::componer(long dia, int turno) {
+    const CalendarioBancario& calendario = CalendarioBancario::instancia();
+    long dia_civil = calendario.diaDeNumeroBancario(dia);
+    int apertura, cierre;
+    calendario.horarioGeneral(CalendarioBancario::diaSemana(dia_civil), apertura, cierre);
+    return CalendarioBancario::componer(dia_civil, apertura + turno * MINUTOS_TURNO);
+}
+
+/**
+ * @brief Mapa de bits con todos los turnos de un día bancario reservados.
+ */
+uint16_t CalendarioTurnos::diaLleno(long dia) {
+    const CalendarioBancario& calendario = CalendarioBancario::instancia();
+    int apertura, cierre;
+    calendario.horarioGeneral(CalendarioBancario::diaSemana(calendario.diaDeNumeroBancario(dia)), apertura, cierre);
+    int turnos = (cierre - apertura) / MINUTOS_TURNO;
+    if (turnos > MAX_TURNOS_POR_DIA) turnos = MAX_TURNOS_POR_DIA;
+    return (uint16_t)((1u << turnos) - 1);
+}
+
+/**
+ * @brief Busca la racha de días llenos que contiene un día bancario.
+ */
+std::map<long, long>::const_iterator CalendarioTurnos::rachaLlena(long dia) const {
+    auto it = dias_llenos.upper_bound(dia);
+    if (it == dias_llenos.begin()) return dias_llenos.end();
+    --it;
+    return (it->second >= dia) ? it : dias_llenos.end();
+}
+
+/**
+ * @brief Agrega un día a las rachas de días llenos, uniéndolo con las vecinas.
+ */
+void CalendarioTurnos::marcarLleno(long dia) {
+    long inicio = dia, fin = dia;
+    auto anterior = rachaLlena(dia - 1);
+    if (anterior != dias_llenos.end()) {
+        inicio = anterior->first;
+        dias_llenos.erase(anterior);
+    }
+    auto siguiente = dias_llenos.find(dia + 1);
+    if (siguiente != dias_llenos.end()) {
+        fin = siguiente->second;
+        dias_llenos.erase(siguiente);
+    }
+    dias_llenos[inicio] = fin;
+}
+
+/**
+ * @brief Quita un día de la racha de días llenos que lo contiene.
+ */
+void CalendarioTurnos::desmarcarLleno(long dia) {
+    auto racha = rachaLlena(dia);
+    if (racha == dias_llenos.end()) return;
+    long inicio = racha->first, fin = racha->second;
+    dias_llenos.erase(racha);
+    if (inicio < dia) dias_llenos[inicio] = dia - 1;
+    if (dia < fin) dias_llenos[dia + 1] = fin;
+}
+
+/**
+ * @brief Reserva el turno que contiene el instante dado.
+ * @param instante Fecha y hora de la cita
+ * @return true si se reservó, false si estaba ocupado o fuera del horario laboral
+ */
+bool CalendarioTurnos::reservar(Instante instante) {
+    long dia;
+    int turno, sobrante;
+    if (!descomponer(instante, dia, turno, sobrante)) return false;
+    if (turno < 0 || turno >= MAX_TURNOS_POR_DIA) return false;
+    uint16_t lleno = diaLleno(dia);
+    if (!(lleno & (1u << turno))) return false;
+
+    uint16_t& bits = ocupados[dia];
+    uint16_t mascara = (uint16_t)(1u << turno);
+    if (bits & mascara) return false;
+    bits |= mascara;
+    reservados++;
+    if (bits == lleno) marcarLleno(dia);
+    return true;
+}
+
+/**
+ * @brief Libera el turno que contiene el instante dado.
+ * @param instante Fecha y hora de la cita
+ * @return true si se liberó, false si no estaba reservado
+ */
+bool CalendarioTurnos::cancelar(Instante instante) {
+    long dia;
+    int turno, sobrante;
+    if (!descomponer(instante, dia, turno, sobrante)) return false;
+    if (turno < 0 || turno >= MAX_TURNOS_POR_DIA) return false;
+
+    auto it = ocupados.find(dia);
+    uint16_t mascara = (uint16_t)(1u << turno);
+    if (it == ocupados.end() || !(it->second & mascara)) return false;
+    if (it->second == diaLleno(dia)) desmarcarLleno(dia);
+    it->second &= (uint16_t)~mascara;
+    reservados--;
+    if (it->second == 0) ocupados.erase(it);
+    return true;
+}
+
+/**
+ * @brief Indica si el turno que contiene el instante está libre.
+ */
+bool CalendarioTurnos::estaLibre(Instante instante) const {
+    long dia;
+    int turno, sobrante;
+    if (!descomponer(instante, dia, turno, sobrante)) return false;
+    if (turno < 0 || turno >= MAX_TURNOS_POR_DIA) return false;
+    if (!(diaLleno(dia) & (1u << turno))) return false;
+    auto it = ocupados.find(dia);
+    return it == ocupados.end() || !(it->second & (1u << turno));
+}
+
+/**
+ * @brief Obtiene el primer turno libre que comienza en o después del instante dado.
+ *
+ * Revisa el día de partida desde el turno correspondiente; si no tiene libres, salta de una vez
+ * la racha de días llenos que sigue. El día posterior a una racha siempre tiene un turno libre.
+ */
+CalendarioTurnos::Instante CalendarioTurnos::siguienteLibre(Instante desde) const {
+    long dia;
+    int turno, sobrante;
+    descomponer(desde, dia, turno, sobrante);
+    if (sobrante > 0) turno++;             // El turno en curso ya comenzó
+    if (turno < 0) turno = 0;              // Antes de la apertura
+    if (turno >= MAX_TURNOS_POR_DIA || !(diaLleno(dia) >> turno)) { // Después del cierre
+        dia++;
+        turno = 0;
+    }
+
+    while (true) {
+        auto racha = rachaLlena(dia);
+        if (racha != dias_llenos.end()) {
+            dia = racha->second + 1;
+            turno = 0;
+            continue;
+        }
+        auto it = ocupados.find(dia);
+        uint32_t lleno = diaLleno(dia);
+        uint32_t libres = (it == ocupados.end()) ? lleno : (uint32_t)(uint16_t)~it->second;
+        libres &= lleno << turno;
+        libres &= lleno;
+        if (libres) {
+            int primero = 0;
+            while (!(libres & (1u << primero))) primero++;
+            return componer(dia, primero);
+        }
+        dia++;
+        turno = 0;
+    }
+}
+
+/**
+ * @brief Elimina todas las reservas.
+ */
+void CalendarioTurnos::limpiar() {
+    ocupados.clear();
+    dias_llenos.clear();
+    reservados = 0;
+}
+
+/**
+ * @brief Obtiene la cantidad de turnos reservados.
+ */
+size_t CalendarioTurnos::getReservados() const {
+    return reservados;
+}
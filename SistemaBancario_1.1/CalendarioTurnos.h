@@ -0,0 +1,108 @@
+/**
+ * @file CalendarioTurnos.h
+ * @brief Definición de la clase CalendarioTurnos, calendario de turnos de 30 minutos de una sucursal.
+ *
+ * Cada día bancario (según el horario general de CalendarioBancario) se guarda como un mapa de bits de
+ * hasta 16 turnos de 30 minutos desde la apertura, y los días
+ * sin turnos libres se agrupan en intervalos. Así "siguiente turno libre a partir de t" se responde en
+ * O(log n) sin recorrer las citas existentes, y reservar o cancelar actualiza la estructura en O(log n).
+ */
+
+#ifndef CALENDARIOTURNOS_H_INCLUDED
+#define CALENDARIOTURNOS_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+
+/**
+ * @class CalendarioTurnos
+ * @brief Turnos ocupados de una sucursal, por día hábil.
+ *
+ * Los días se identifican por su número de día bancario (CalendarioBancario::numeroDiaBancario): el viernes
+ * y el lunes siguiente son vecinos, igual que los días a ambos lados de un feriado, de modo que una racha
+ * de días llenos que los cruza se guarda como un único intervalo.
+ */
+class CalendarioTurnos {
+public:
+    typedef std::chrono::system_clock::time_point Instante;
+
+    static const int MINUTOS_TURNO = 30;      ///< Duración de cada turno
+    static const int MAX_TURNOS_POR_DIA = 16; ///< Turnos que caben en el mapa de bits de un día
+
+    /**
+     * @brief Constructor por defecto. Crea un calendario sin reservas.
+     */
+    CalendarioTurnos();
+
+    /**
+     * @brief Reserva el turno que contiene el instante dado.
+     * @param instante Fecha y hora de la cita (se redondea al inicio de su turno)
+     * @return true si se reservó, false si estaba ocupado o fuera del horario laboral
+     */
+    bool reservar(Instante instante);
+    /**
+     * @brief Libera el turno que contiene el instante dado.
+     * @param instante Fecha y hora de la cita
+     * @return true si se liberó, false si no estaba reservado
+     */
+    bool cancelar(Instante instante);
+    /**
+     * @brief Indica si el turno que contiene el instante está libre.
+     * @param instante Fecha y hora a consultar
+     * @return true si es horario laboral y el turno no está reservado
+     */
+    bool estaLibre(Instante instante) const;
+    /**
+     * @brief Obtiene el primer turno libre que comienza en o después del instante dado.
+     * @param desde Instante de inicio de la búsqueda
+     * @return Inicio del turno libre
+     */
+    Instante siguienteLibre(Instante desde) const;
+    /**
+     * @brief Elimina todas las reservas.
+     */
+    void limpiar();
+    /**
+     * @brief Obtiene la cantidad de turnos reservados.
+     */
+    size_t getReservados() const;
+
+private:
+    std::map<long, uint16_t> ocupados; ///< Día bancario -> mapa de bits de turnos reservados
+    std::map<long, long> dias_llenos;  ///< Inicio -> fin (inclusive) de rachas de días bancarios sin turnos libres
+    size_t reservados;                 ///< Turnos reservados
+
+    /**
+     * @brief Convierte un instante en día bancario y turno.
+     * @param instante Instante a convertir
+     * @param dia Número de día bancario resultante (el siguiente si el instante no cae en uno)
+     * @param turno Turno que contiene al instante (puede quedar fuera del día)
+     * @param minutos_sobrantes Minutos desde el inicio del turno
+     * @return true si el instante cae en un día bancario
+     */
+    static bool descomponer(Instante instante, long& dia, int& turno, int& minutos_sobrantes);
+    /**
+     * @brief Convierte un día bancario y turno en el instante de inicio del turno.
+     */
+    static Instante componer(long dia, int turno);
+    /**
+     * @brief Mapa de bits con todos los turnos de un día bancario reservados.
+     */
+    static uint16_t diaLleno(long dia);
+    /**
+     * @brief Busca la racha de días llenos que contiene un día hábil.
+     * @return Iterador a la racha, o end() si el día no está lleno
+     */
+    std::map<long, long>::const_iterator rachaLlena(long dia) const;
+    /**
+     * @brief Agrega un día a las rachas de días llenos, uniéndolo con las vecinas.
+     */
+    void marcarLleno(long dia);
+    /**
+     * @brief Quita un día de la racha de días llenos que lo contiene.
+     */
+    void desmarcarLleno(long dia);
+};
+
+#endif
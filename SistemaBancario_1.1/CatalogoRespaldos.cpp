@@ -0,0 +1,408 @@
+/**
+ * @file CatalogoRespaldos.cpp
+ * @brief Implementación del catálogo persistente de archivos de respaldo.
+ */
+
+#include "CatalogoRespaldos.h"
+#include "ReemplazoArchivo.h"
+#include "SerializadorClientes.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+const uint32_t CatalogoRespaldos::MAGIA;
+const uint32_t CatalogoRespaldos::VERSION;
+const size_t CatalogoRespaldos::TIPOS;
+
+namespace {
+
+/**
+ * @brief Orden de las entradas dentro de cada tipo.
+ */
+bool anterior(const EntradaRespaldo& a, const EntradaRespaldo& b) {
+    if (a.fecha != b.fecha) return a.fecha < b.fecha;
+    return a.archivo < b.archivo;
+}
+
+template <typename T>
+void escribirValor(std::string& destino, const T& valor) {
+    destino.append(reinterpret_cast<const char*>(&valor), sizeof(T));
+}
+
+void escribirTexto(std::string& destino, const std::string& texto) {
+    uint32_t longitud = static_cast<uint32_t>(texto.size());
+    escribirValor(destino, longitud);
+    destino.append(texto);
+}
+
+template <typename T>
+bool leerValor(const std::string& origen, size_t& posicion, size_t fin, T& valor) {
+    if (fin - posicion < sizeof(T)) return false;
+    std::memcpy(&valor, origen.data() + posicion, sizeof(T));
+    posicion += sizeof(T);
+    return true;
+}
+
+bool leerTexto(const std::string& origen, size_t& posicion, size_t fin, std::string& texto) {
+    uint32_t longitud = 0;
+    if (!leerValor(origen, posicion, fin, longitud) || fin - posicion < longitud) return false;
+    texto.assign(origen, posicion, longitud);
+    posicion += longitud;
+    return true;
+}
+
+/**
+ * @brief Interpreta una marca YYYYMMDD_HHMMSS (hora local).
+ */
+bool interpretarMarca(const std::string& marca, std::time_t& fecha) {
+    if (marca.size() != 15) return false;
+    std::tm tm = {};
+    std::istringstream ss(marca);
+    ss >> std::get_time(&tm, "%Y%m%d_%H%M%S");
+    if (ss.fail()) return false;
+    tm.tm_isdst = -1;
+    fecha = std::mktime(&tm);
+    return fecha != static_cast<std::time_t>(-1);
+}
+
+} // namespace
+
+/**
+ * @brief Constructor. No lee el archivo hasta la primera consulta.
+ * @param archivo Ruta del archivo de catálogo
+ */
+CatalogoRespaldos::CatalogoRespaldos(const std::string& archivo) : archivo(archivo), cargado(false) {}
+
+/**
+ * @brief Vector de entradas de un tipo.
+ */
+std::vector<EntradaRespaldo>& CatalogoRespaldos::lista(TipoRespaldo tipo) {
+    size_t indice = static_cast<size_t>(tipo);
+    return entradas[indice < TIPOS ? indice : 0];
+}
+
+/**
+ * @brief Carga el catálogo la primera vez que se consulta.
+ */
+void CatalogoRespaldos::asegurarCargado() {
+    if (!cargado) cargarSinBloqueo();
+}
+
+/**
+ * @brief Lee el catálogo del disco, o lo reconstruye desde el directorio si falta o está dañado.
+ */
+bool CatalogoRespaldos::cargar() {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    return cargarSinBloqueo();
+}
+
+/**
+ * @brief Implementación de cargar() (con el mutex tomado).
+ */
+bool CatalogoRespaldos::cargarSinBloqueo() {
+    cargado = true;
+    for (auto& tipo : entradas) tipo.clear();
+    if (leer()) return true;
+
+    for (auto& tipo : entradas) tipo.clear();
+    reconstruirDesdeDirectorio();
+    guardar();
+    return false;
+}
+
+/**
+ * @brief Lee y valida el archivo de catálogo.
+ * @details Formato (orden de bytes nativo): magia, versión y cantidad de entradas (uint32); por entrada
+ *          tipo (uint8), archivo, fecha (int64), tamaño y huella (uint64), base y clientes (uint32); al
+ *          final la huella FNV-1a de todo lo anterior. Los textos llevan su longitud en uint32.
+ */
+bool CatalogoRespaldos::leer() {
+    std::ifstream file(archivo, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::string datos((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (datos.size() < 3 * sizeof(uint32_t) + sizeof(uint64_t)) return false;
+
+    size_t fin = datos.size() - sizeof(uint64_t);
+    uint64_t huella = 0;
+    std::memcpy(&huella, datos.data() + fin, sizeof(uint64_t));
+    if (huella != fnv1a(datos.data(), fin)) {
+        std::cerr << "Catálogo de respaldos dañado, se reconstruye: " << archivo << std::endl;
+        return false;
+    }
+
+    size_t posicion = 0;
+    uint32_t magia = 0, version = 0, cantidad = 0;
+    if (!leerValor(datos, posicion, fin, magia) || magia != MAGIA) return false;
+    if (!leerValor(datos, posicion, fin, version) || version != VERSION) return false;
+    if (!leerValor(datos, posicion, fin, cantidad)) return false;
+
+    for (uint32_t i = 0; i < cantidad; i++) {
+        EntradaRespaldo entrada;
+        uint8_t tipo = 0;
+        int64_t fecha = 0;
+        if (!leerValor(datos, posicion, fin, tipo) || tipo >= TIPOS ||
+            !leerTexto(datos, posicion, fin, entrada.archivo) ||
+            !leerValor(datos, posicion, fin, fecha) ||
+            !leerValor(datos, posicion, fin, entrada.tamanio) ||
+            !leerValor(datos, posicion, fin, entrada.digest) ||
+            !leerTexto(datos, posicion, fin, entrada.base) ||
+            !leerValor(datos, posicion, fin, entrada.clientes)) {
+            return false;
+        }
+        entrada.tipo = static_cast<TipoRespaldo>(tipo);
+        entrada.fecha = static_cast<std::time_t>(fecha);
+        lista(entrada.tipo).push_back(std::move(entrada));
+    }
+    if (posicion != fin) return false;
+
+    // El archivo se escribe ordenado; se ordena igual por si fue editado a mano
+    for (auto& tipo : entradas) {
+        if (!std::is_sorted(tipo.begin(), tipo.end(), anterior)) std::sort(tipo.begin(), tipo.end(), anterior);
+    }
+    return true;
+}
+
+/**
+ * @brief Reescribe el catálogo completo mediante un archivo temporal.
+ * @details Se escribe primero un archivo temporal y luego se reemplaza el destino, de modo que una
+ *          falla a mitad de la escritura no deja el catálogo truncado.
+ */
+bool CatalogoRespaldos::guardar() const {
+    try {
+        uint32_t cantidad = 0;
+        for (const auto& tipo : entradas) cantidad += static_cast<uint32_t>(tipo.size());
+
+        std::string datos;
+        escribirValor(datos, MAGIA);
+        escribirValor(datos, VERSION);
+        escribirValor(datos, cantidad);
+        for (const auto& tipo : entradas) {
+            for (const EntradaRespaldo& entrada : tipo) {
+                escribirValor(datos, static_cast<uint8_t>(entrada.tipo));
+                escribirTexto(datos, entrada.archivo);
+                escribirValor(datos, static_cast<int64_t>(entrada.fecha));
+                escribirValor(datos, entrada.tamanio);
+                escribirValor(datos, entrada.digest);
+                escribirTexto(datos, entrada.base);
+                escribirValor(datos, entrada.clientes);
+            }
+        }
+        escribirValor(datos, fnv1a(datos.data(), datos.size()));
+
+        std::string temporal = archivo + ".tmp";
+        std::ofstream file(temporal, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(datos.data(), static_cast<std::streamsize>(datos.size()));
+        file.close();
+        if (!file) {
+            std::remove(temporal.c_str());
+            return false;
+        }
+
+        return reemplazarArchivo(temporal, archivo);
+    } catch (const std::exception& e) {
+        std::cerr << "Error en guardar catálogo de respaldos: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+/**
+ * @brief Registra los respaldos existentes en el directorio (migración desde versiones sin catálogo).
+ * @details Es el único recorrido del directorio: reconoce backup_clientes_YYYYMMDD_HHMMSS.bin y
+ *          cifrado_YYYYMMDD_HHMMSS.txt, mide cada archivo y toma la cantidad de clientes de la cabecera
+ *          de los binarios. Un cifrado tiene como base el binario con la misma marca de tiempo.
+ */
+void CatalogoRespaldos::reconstruirDesdeDirectorio() {
+    try {
+        for (const auto& item : fs::directory_iterator(".")) {
+            if (!item.is_regular_file()) continue;
+            std::string nombre = item.path().filename().string();
+
+            EntradaRespaldo entrada;
+            std::string marca;
+            if (nombre.size() == 35 && nombre.compare(0, 16, "backup_clientes_") == 0 &&
+                nombre.compare(31, 4, ".bin") == 0) {
+                entrada.tipo = TipoRespaldo::Completo;
+                marca = nombre.substr(16, 15);
+            } else if (nombre.size() == 27 && nombre.compare(0, 8, "cifrado_") == 0 &&
+                       nombre.compare(23, 4, ".txt") == 0) {
+                entrada.tipo = TipoRespaldo::Cifrado;
+                marca = nombre.substr(8, 15);
+                entrada.base = "backup_clientes_" + marca + ".bin";
+            } else {
+                continue;
+            }
+            if (!interpretarMarca(marca, entrada.fecha)) continue;
+            entrada.archivo = nombre;
+            if (!medirArchivo(nombre, entrada)) continue;
+
+            if (entrada.tipo == TipoRespaldo::Completo) {
+                std::ifstream file(nombre, std::ios::binary);
+                int32_t clientes = 0;
+                bool leido = file.read(reinterpret_cast<char*>(&clientes), sizeof(int32_t)).good();
+                if (leido && static_cast<uint32_t>(clientes) == SerializadorClientes::MAGIA) {
+                    // Formato actual: la cantidad va después de la marca y la versión
+                    leido = file.seekg(2 * sizeof(uint32_t)).read(reinterpret_cast<char*>(&clientes), sizeof(int32_t)).good();
+                }
+                if (leido && clientes > 0) {
+                    entrada.clientes = static_cast<uint32_t>(clientes);
+                }
+            }
+            lista(entrada.tipo).push_back(std::move(entrada));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error en reconstruir catálogo de respaldos: " << e.what() << std::endl;
+    }
+
+    for (auto& tipo : entradas) std::sort(tipo.begin(), tipo.end(), anterior);
+    for (EntradaRespaldo& cifrado : lista(TipoRespaldo::Cifrado)) {
+        if (!fs::exists(cifrado.base)) cifrado.base.clear();
+    }
+}
+
+/**
+ * @brief Agrega o reemplaza (por nombre de archivo) una entrada y guarda el catálogo.
+ * @details La inserción busca la posición con lower_bound; la reescritura del archivo es lineal en la
+ *          cantidad de entradas, pero solo ocurre al generar un respaldo.
+ */
+bool CatalogoRespaldos::registrar(const EntradaRespaldo& entrada) {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    asegurarCargado();
+    for (auto& tipo : entradas) {
+        tipo.erase(std::remove_if(tipo.begin(), tipo.end(),
+                                  [&](const EntradaRespaldo& e) { return e.archivo == entrada.archivo; }),
+                   tipo.end());
+    }
+    std::vector<EntradaRespaldo>& destino = lista(entrada.tipo);
+    destino.insert(std::upper_bound(destino.begin(), destino.end(), entrada, anterior), entrada);
+    return guardar();
+}
+
+/**
+ * @brief Quita la entrada de un archivo y guarda el catálogo.
+ */
+bool CatalogoRespaldos::quitar(const std::string& archivo) {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    asegurarCargado();
+    bool encontrado = false;
+    for (auto& tipo : entradas) {
+        auto it = std::find_if(tipo.begin(), tipo.end(), [&](const EntradaRespaldo& e) { return e.archivo == archivo; });
+        if (it != tipo.end()) {
+            tipo.erase(it);
+            encontrado = true;
+        }
+    }
+    if (encontrado) guardar();
+    return encontrado;
+}
+
+/**
+ * @brief Respaldo más reciente de un tipo.
+ */
+bool CatalogoRespaldos::ultimo(TipoRespaldo tipo, EntradaRespaldo& entrada) {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    asegurarCargado();
+    const std::vector<EntradaRespaldo>& origen = lista(tipo);
+    if (origen.empty()) return false;
+    entrada = origen.back();
+    return true;
+}
+
+/**
+ * @brief Respaldo vigente en una fecha: el más reciente generado en o antes de ese momento.
+ */
+bool CatalogoRespaldos::buscarPorFecha(TipoRespaldo tipo, std::time_t fecha, EntradaRespaldo& entrada) {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    asegurarCargado();
+    const std::vector<EntradaRespaldo>& origen = lista(tipo);
+    auto it = std::upper_bound(origen.begin(), origen.end(), fecha,
+                               [](std::time_t valor, const EntradaRespaldo& e) { return valor < e.fecha; });
+    if (it == origen.begin()) return false;
+    entrada = *(it - 1);
+    return true;
+}
+
+/**
+ * @brief Entrada de un archivo por su nombre.
+ * @details Se recorre desde el final: lo habitual es buscar un respaldo reciente.
+ */
+bool CatalogoRespaldos::buscar(const std::string& archivo, EntradaRespaldo& entrada) {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    asegurarCargado();
+    for (const auto& tipo : entradas) {
+        for (auto it = tipo.rbegin(); it != tipo.rend(); ++it) {
+            if (it->archivo == archivo) {
+                entrada = *it;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Respaldos de un tipo, del más reciente al más antiguo.
+ */
+std::vector<EntradaRespaldo> CatalogoRespaldos::listar(TipoRespaldo tipo) {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    asegurarCargado();
+    const std::vector<EntradaRespaldo>& origen = lista(tipo);
+    return std::vector<EntradaRespaldo>(origen.rbegin(), origen.rend());
+}
+
+/**
+ * @brief Cantidad de respaldos registrados de un tipo.
+ */
+size_t CatalogoRespaldos::getCantidad(TipoRespaldo tipo) {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    asegurarCargado();
+    return lista(tipo).size();
+}
+
+/**
+ * @brief Calcula el tamaño y la huella de un archivo.
+ */
+bool CatalogoRespaldos::medirArchivo(const std::string& ruta, EntradaRespaldo& entrada) {
+    std::ifstream file(ruta, std::ios::binary);
+    if (!file.is_open()) return false;
+    char buffer[1 << 16];
+    uint64_t hash = 14695981039346656037ull;
+    uint64_t tamanio = 0;
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+        size_t leidos = static_cast<size_t>(file.gcount());
+        hash = fnv1a(buffer, leidos, hash);
+        tamanio += leidos;
+    }
+    entrada.tamanio = tamanio;
+    entrada.digest = hash;
+    return true;
+}
+
+/**
+ * @brief Comprueba que el archivo de una entrada siga teniendo el tamaño y la huella registrados.
+ */
+bool CatalogoRespaldos::verificar(const EntradaRespaldo& entrada) {
+    std::error_code error;
+    if (fs::file_size(entrada.archivo, error) != entrada.tamanio || error) return false;
+    EntradaRespaldo actual;
+    return medirArchivo(entrada.archivo, actual) && actual.digest == entrada.digest;
+}
+
+/**
+ * @brief Huella FNV-1a de 64 bits de un bloque, continuando desde un valor previo.
+ */
+uint64_t CatalogoRespaldos::fnv1a(const void* datos, size_t longitud, uint64_t hash) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(datos);
+    for (size_t i = 0; i < longitud; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file CatalogoRespaldos.h
+ * @brief Definición de la clase CatalogoRespaldos, registro persistente de los archivos de respaldo.
+ *
+ * Cada respaldo que genera el sistema se anota en un archivo de catálogo con su fecha, tamaño, huella
+ * del contenido, cantidad de clientes y el respaldo del que deriva. Las consultas del último respaldo o
+ * del vigente en una fecha se resuelven con búsqueda binaria sobre el catálogo en memoria, sin recorrer
+ * el directorio ni interpretar nombres de archivo.
+ */
+
+#ifndef CATALOGORESPALDOS_H_INCLUDED
+#define CATALOGORESPALDOS_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @enum TipoRespaldo
+ * @brief Clase de archivo registrado en el catálogo.
+ */
+enum class TipoRespaldo : uint8_t {
+    Completo = 0,     ///< backup_clientes_*.bin con todos los clientes
+    Diferencial = 1,  ///< Cambios respecto de otro respaldo (su base)
+    Cifrado = 2       ///< cifrado_*.txt generado a partir de un respaldo binario (su base)
+};
+
+/**
+ * @struct EntradaRespaldo
+ * @brief Datos de un archivo de respaldo.
+ */
+struct EntradaRespaldo {
+    std::string archivo;                       ///< Nombre del archivo
+    std::time_t fecha = 0;                     ///< Momento en que se generó
+    TipoRespaldo tipo = TipoRespaldo::Completo; ///< Clase de respaldo
+    uint64_t tamanio = 0;                      ///< Tamaño en bytes
+    uint64_t digest = 0;                       ///< Huella FNV-1a de 64 bits del contenido
+    std::string base;                          ///< Respaldo del que deriva (vacío si es completo)
+    uint32_t clientes = 0;                     ///< Clientes que contiene
+};
+
+/**
+ * @class CatalogoRespaldos
+ * @brief Índice ordenado por fecha de los respaldos, guardado en un archivo propio.
+ *
+ * Las entradas de cada tipo se mantienen en un vector ordenado por (fecha, archivo). Cada cambio reescribe
+ * el catálogo completo en un archivo temporal que luego reemplaza al anterior, así una falla a mitad de la
+ * escritura deja intacta la versión previa. El archivo termina con la huella de su contenido; si falta o
+ * no coincide, el catálogo se reconstruye una sola vez a partir de los respaldos del directorio.
+ * Todas las operaciones públicas toman un mutex: los respaldos en segundo plano registran entradas mientras
+ * la interfaz consulta el catálogo, por eso las consultas devuelven copias de las entradas.
+ */
+class CatalogoRespaldos {
+public:
+    /**
+     * @brief Constructor. No lee el archivo hasta la primera consulta.
+     * @param archivo Ruta del archivo de catálogo
+     */
+    explicit CatalogoRespaldos(const std::string& archivo = "catalogo_respaldos.dat");
+
+    /**
+     * @brief Lee el catálogo del disco, o lo reconstruye desde el directorio si falta o está dañado.
+     * @return true si se leyó el archivo, false si hubo que reconstruirlo
+     */
+    bool cargar();
+    /**
+     * @brief Agrega o reemplaza (por nombre de archivo) una entrada y guarda el catálogo.
+     * @param entrada Datos del respaldo
+     * @return true si el catálogo quedó guardado en disco
+     */
+    bool registrar(const EntradaRespaldo& entrada);
+    /**
+     * @brief Quita la entrada de un archivo y guarda el catálogo.
+     * @param archivo Nombre del archivo de respaldo
+     * @return true si existía la entrada
+     */
+    bool quitar(const std::string& archivo);
+
+    /**
+     * @brief Respaldo más reciente de un tipo.
+     * @param entrada Recibe una copia de la entrada encontrada
+     * @return false si no hay ninguno
+     */
+    bool ultimo(TipoRespaldo tipo, EntradaRespaldo& entrada);
+    /**
+     * @brief Respaldo vigente en una fecha: el más reciente generado en o antes de ese momento.
+     * @param entrada Recibe una copia de la entrada encontrada
+     * @return false si todos son posteriores
+     */
+    bool buscarPorFecha(TipoRespaldo tipo, std::time_t fecha, EntradaRespaldo& entrada);
+    /**
+     * @brief Entrada de un archivo por su nombre.
+     * @param entrada Recibe una copia de la entrada encontrada
+     * @return false si no está registrado
+     */
+    bool buscar(const std::string& archivo, EntradaRespaldo& entrada);
+    /**
+     * @brief Respaldos de un tipo, del más reciente al más antiguo.
+     */
+    std::vector<EntradaRespaldo> listar(TipoRespaldo tipo);
+    /**
+     * @brief Cantidad de respaldos registrados de un tipo.
+     */
+    size_t getCantidad(TipoRespaldo tipo);
+
+    /**
+     * @brief Calcula el tamaño y la huella de un archivo.
+     * @param ruta Archivo a leer
+     * @param entrada Entrada donde se escriben tamanio y digest
+     * @return false si no se pudo leer el archivo
+     */
+    static bool medirArchivo(const std::string& ruta, EntradaRespaldo& entrada);
+    /**
+     * @brief Comprueba que el archivo de una entrada siga teniendo el tamaño y la huella registrados.
+     */
+    static bool verificar(const EntradaRespaldo& entrada);
+    /**
+     * @brief Huella FNV-1a de 64 bits de un bloque, continuando desde un valor previo.
+     */
+    static uint64_t fnv1a(const void* datos, size_t longitud, uint64_t hash = 14695981039346656037ull);
+
+private:
+    static const uint32_t MAGIA = 0x52544143u; ///< "CATR"
+    static const uint32_t VERSION = 1u;
+    static const size_t TIPOS = 3;
+
+    std::string archivo;                          ///< Ruta del catálogo
+    std::vector<EntradaRespaldo> entradas[TIPOS]; ///< Entradas de cada tipo ordenadas por (fecha, archivo)
+    bool cargado;                                 ///< Si ya se leyó o reconstruyó
+    std::mutex mutex;                             ///< Protege las entradas y el archivo
+
+    /**
+     * @brief Carga el catálogo la primera vez que se consulta (con el mutex tomado).
+     */
+    void asegurarCargado();
+    /**
+     * @brief Implementación de cargar() (con el mutex tomado).
+     */
+    bool cargarSinBloqueo();
+    /**
+     * @brief Lee y valida el archivo de catálogo.
+     */
+    bool leer();
+    /**
+     * @brief Reescribe el catálogo completo mediante un archivo temporal.
+     */
+    bool guardar() const;
+    /**
+     * @brief Registra los respaldos existentes en el directorio (migración desde versiones sin catálogo).
+     */
+    void reconstruirDesdeDirectorio();
+    /**
+     * @brief Vector de entradas de un tipo.
+     */
+    std::vector<EntradaRespaldo>& lista(TipoRespaldo tipo);
+};
+
+#endif
@@ -13,8 +13,12 @@
 #include "Cuenta.h"
 #include "ListaDoble.h"
 #include "Fecha.h"
+#include "HistorialDiferido.h"
+#include <cstdio>
 #include <string>
 
+class LectorBinario;
+
 /**
  * @class Cliente
  * @brief Representa a un cliente del sistema bancario.
@@ -156,12 +160,31 @@ public:
      * @param archivo Puntero al archivo binario abierto para lectura
      */
     void cargar_binario(FILE* archivo);
+    /**
+     * @brief Carga los datos del cliente y sus cuentas desde un lector binario acotado.
+     * @param lector Lector posicionado al inicio del cliente
+     * @details Lee el formato de guardar_binario. Las cuentas y movimientos bien formados pero con
+     *          valores inválidos se omiten y se anotan en el lector; un registro truncado o con
+     *          longitudes imposibles lanza una excepción.
+     */
+    void cargar_binario(LectorBinario& lector);
     /**
      * @brief Busca una cuenta del cliente por su ID.
      * @param id_cuenta ID de la cuenta a buscar
      * @return Puntero a la cuenta si se encuentra, nullptr en caso contrario
      */
     Cuenta* buscar_cuenta(const std::string id_cuenta);
+    /**
+     * @brief Obtiene los bytes del cliente en el último archivo cargado o guardado, si siguen vigentes.
+     * @return Ubicación de los bytes, o nullptr si el cliente o alguna de sus cuentas cambió desde entonces
+     * @details Los setters y agregar_cuenta descartan la ubicación; las cuentas anotan sus propios cambios.
+     */
+    const CodificacionCliente* get_codificacion() const;
+    /**
+     * @brief Anota dónde quedó el cliente en un archivo y marca sus cuentas como guardadas.
+     * @param codificacion Ubicación de los bytes que representan el estado actual del cliente
+     */
+    void set_codificacion(const CodificacionCliente& codificacion);
     /**
      * @brief Devuelve una representación en string de los datos principales del cliente.
      * @return String con DNI, nombre y apellido
@@ -178,6 +201,7 @@ private:
     Fecha fecha_nacimiento; ///< Fecha de nacimiento
     std::string contrasenia; ///< Contraseña del cliente
     ListaDoble<Cuenta*>* cuentas; ///< Lista de cuentas asociadas
+    CodificacionCliente codificacion; ///< Bytes del cliente en el último archivo cargado o guardado
 };
 
 #endif
\ No newline at end of file
@@ -48,20 +48,26 @@ public:
      */
     void set_limite_retiro_diario(double limite);
     /**
-     * @brief Devuelve una representación en string de la cuenta corriente.
-     * @return String con los datos principales de la cuenta
+     * @brief Obtiene el monto acumulado de retiros del día registrado.
+     * @return Monto retirado en el día indicado por get_dia_retiro()
      */
-    std::string to_string() override;
+    double get_monto_retirado_hoy() const;
+    /**
+     * @brief Obtiene el día (clave YYYYMMDD) al que corresponde el acumulado de retiros.
+     * @return Clave numérica del día, 0 si aún no hay retiros
+     */
+    int get_dia_retiro() const;
     /**
-     * @brief Guarda los datos de la cuenta corriente en un archivo binario.
-     * @param archivo Puntero al archivo binario abierto para escritura
+     * @brief Restaura el acumulado diario de retiros leído desde un snapshot.
+     * @param dia_clave Día (YYYYMMDD) al que corresponde el acumulado
+     * @param monto Monto retirado en ese día
      */
-    void guardar_binario(FILE* archivo) override;
+    void restaurar_retiro_diario(int dia_clave, double monto);
     /**
-     * @brief Carga los datos de la cuenta corriente desde un archivo binario.
-     * @param archivo Puntero al archivo binario abierto para lectura
+     * @brief Devuelve una representación en string de la cuenta corriente.
+     * @return String con los datos principales de la cuenta
      */
-    void cargar_binario(FILE* archivo) override;
+    std::string to_string() override;
     /**
      * @brief Realiza un retiro de la cuenta corriente, validando límites y días hábiles.
      * @param monto Monto a retirar
@@ -71,8 +77,8 @@ public:
     bool retirar(double monto, Fecha fecha) override;
 private:
     double limite_retiro_diario; ///< Límite de retiro diario
-    double monto_retirado_hoy;   ///< Monto retirado en el día actual
-    Fecha ultimo_dia_retiro;     ///< Última fecha en la que se realizó un retiro
+    double monto_retirado_hoy;   ///< Monto retirado en el día indicado por dia_retiro
+    int dia_retiro;              ///< Día (YYYYMMDD) del último retiro; permite validar el límite en O(1)
 };
 
 #endif
\ No newline at end of file
@@ -7,7 +7,10 @@
  */
 
 #include "Cuenta.h"
+#include "ArchivoMovimientos.h"
 #include "GestorClientes.h"
+#include "HistorialDiferido.h"
+#include "SerializadorClientes.h"
 #include <stdexcept>
 #include <functional>
 #include <vector>
@@ -50,71 +53,23 @@ Cuenta::Cuenta(std::string id, double saldo_inicial, Fecha fecha) {
 }
 
 /**
- * @brief Destructor de Cuenta.
- * Libera la memoria de la lista de movimientos.
+ * @brief Constructor de copia de Cuenta.
+ * Cada copia tiene su propia lista de movimientos; un historial diferido se comparte por su ubicación.
+ * @param otra Cuenta a copiar
  */
-Cuenta::~Cuenta() {
-    delete movimientos;
+Cuenta::Cuenta(const Cuenta& otra)
+    : id_cuenta(otra.id_cuenta), saldo(otra.saldo), fecha_apertura(otra.fecha_apertura),
+      movimientos(new ListaDoble<Movimiento>()), branchId(otra.branchId), appointmentTime(otra.appointmentTime) {
+    otra.movimientos->recorrer([this](Movimiento m) { movimientos->insertar_cola(m); });
+    if (otra.historial) historial.reset(new HistorialDiferido(*otra.historial));
 }
 
 /**
- * @brief Guarda los datos de la cuenta en un archivo binario.
- * @param archivo Puntero al archivo binario abierto para escritura
- */
-void Cuenta::guardar_binario(FILE* archivo) {
-    try {
-        if (!archivo) throw std::runtime_error("Archivo no válido para escritura");
-        size_t len = id_cuenta.length();
-        fwrite(&len, sizeof(size_t), 1, archivo);
-        fwrite(id_cuenta.c_str(), sizeof(char), len + 1, archivo);
-        fwrite(&saldo, sizeof(double), 1, archivo);
-        fwrite(&fecha_apertura, sizeof(Fecha), 1, archivo);
-        fwrite(&branchId, sizeof(int), 1, archivo); // Guardar branchId
-        // Convertir time_point a time_t para guardarlo (simplificación)
-        time_t tt = std::chrono::system_clock::to_time_t(appointmentTime);
-        fwrite(&tt, sizeof(time_t), 1, archivo); // Guardar appointmentTime
-        movimientos->recorrer([&](Movimiento m) { m.guardar_binario(archivo); });
-    } catch (const std::exception& e) {
-        std::cerr << "Error en guardar_binario: " << e.what() << std::endl;
-        throw;
-    }
-}
-
-/**
- * @brief Carga los datos de la cuenta desde un archivo binario.
- * @param archivo Puntero al archivo binario abierto para lectura
+ * @brief Destructor de Cuenta.
+ * Libera la memoria de la lista de movimientos.
  */
-void Cuenta::cargar_binario(FILE* archivo) {
-    try {
-        if (!archivo) throw std::runtime_error("Archivo no válido para lectura");
-        size_t len;
-        char* buffer = nullptr;
-        if (fread(&len, sizeof(size_t), 1, archivo) != 1) throw std::runtime_error("Error al leer longitud de id_cuenta");
-        buffer = new char[len + 1];
-        if (fread(buffer, sizeof(char), len + 1, archivo) != len + 1) {
-            delete[] buffer;
-            throw std::runtime_error("Error al leer id_cuenta");
-        }
-        id_cuenta = std::string(buffer);
-        delete[] buffer;
-
-        if (fread(&saldo, sizeof(double), 1, archivo) != 1) throw std::runtime_error("Error al leer saldo");
-        if (fread(&fecha_apertura, sizeof(Fecha), 1, archivo) != 1) throw std::runtime_error("Error al leer fecha_apertura");
-        if (fread(&branchId, sizeof(int), 1, archivo) != 1) throw std::runtime_error("Error al leer branchId");
-        time_t tt;
-        if (fread(&tt, sizeof(time_t), 1, archivo) != 1) throw std::runtime_error("Error al leer appointmentTime");
-        appointmentTime = std::chrono::system_clock::from_time_t(tt);
-        delete movimientos;
-        movimientos = new ListaDoble<Movimiento>();
-        while (true) {
-            Movimiento m;
-            if (fread(&m, sizeof(Movimiento), 1, archivo) != 1) break;
-            movimientos->insertar_cola(m);
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "Error en cargar_binario: " << e.what() << std::endl;
-        throw;
-    }
+Cuenta::~Cuenta() {
+    delete movimientos;
 }
 
 /**
@@ -133,26 +88,84 @@ double Cuenta::get_saldo() { return saldo; }
  */
 Fecha Cuenta::get_fecha_apertura() { return fecha_apertura; }
 /**
- * @brief Obtiene la lista de movimientos de la cuenta.
+ * @brief Obtiene la lista de movimientos de la cuenta, leyéndolos del archivo si estaban diferidos.
  * @return Puntero a la lista doble de movimientos
+ * @details Los movimientos registrados después de cargar ya están en la lista, así que los del archivo
+ *          se leen aparte y se enlazan delante. Si la lectura falla, el historial sigue pendiente.
+ */
+ListaDoble<Movimiento>* Cuenta::get_movimientos() {
+    if (historial) {
+        ListaDoble<Movimiento> anteriores;
+        SerializadorClientes::leerHistorial(*historial, id_cuenta, anteriores);
+        anteriores.concatenar(*movimientos);
+        movimientos->concatenar(anteriores);
+        historial.reset();
+    }
+    return movimientos;
+}
+
+/**
+ * @brief Deja el historial en el archivo de datos hasta que se pida la lista de movimientos.
+ * @param historial Ubicación de los movimientos en el archivo
+ */
+void Cuenta::diferir_movimientos(const HistorialDiferido& historial) {
+    this->historial.reset(new HistorialDiferido(historial));
+}
+
+/**
+ * @brief Obtiene el historial que sigue en el archivo.
+ * @return Ubicación de los movimientos, o nullptr si ya están en memoria
+ */
+const HistorialDiferido* Cuenta::get_historial_diferido() const { return historial.get(); }
+
+/**
+ * @brief Quita de la lista los movimientos anteriores a una fecha, ya guardados en el archivo frío.
+ * @param horizonte Fecha (YYYYMMDD) del movimiento más antiguo que se conserva
+ * @details La lista se reemplaza por una nueva con los movimientos restantes, en el mismo orden. Quien
+ *          llame debe asegurarse de que ningún respaldo en curso esté recorriendo la lista anterior.
+ */
+void Cuenta::descartar_movimientos_anteriores(int horizonte) {
+    ListaDoble<Movimiento>* actuales = get_movimientos();
+    ListaDoble<Movimiento>* conservados = new ListaDoble<Movimiento>();
+    actuales->recorrer([&](Movimiento m) {
+        if (GestorClientes::dateKey(m) >= horizonte) conservados->insertar_cola(m);
+    });
+    movimientos = conservados;
+    delete actuales;
+    modificada = true;
+}
+
+/**
+ * @brief Anota que la cuenta cambió desde la última vez que se guardó.
  */
-ListaDoble<Movimiento>* Cuenta::get_movimientos() { return movimientos; }
+void Cuenta::marcar_modificada() { modificada = true; }
+
+/**
+ * @brief Indica si la cuenta cambió desde la última vez que se guardó o se cargó.
+ * @return true si su codificación guardada ya no la representa
+ */
+bool Cuenta::esta_modificada() const { return modificada; }
+
+/**
+ * @brief Anota que la cuenta coincide con lo guardado.
+ */
+void Cuenta::marcar_guardada() { modificada = false; }
 
 /**
  * @brief Establece el ID de la cuenta.
  * @param id Nuevo ID de la cuenta
  */
-void Cuenta::set_id_cuenta(std::string id) { id_cuenta = id; }
+void Cuenta::set_id_cuenta(std::string id) { id_cuenta = id; modificada = true; }
 /**
  * @brief Establece el saldo de la cuenta.
  * @param _saldo Nuevo saldo
  */
-void Cuenta::set_saldo(double _saldo) { saldo = _saldo; }
+void Cuenta::set_saldo(double _saldo) { saldo = _saldo; modificada = true; }
 /**
  * @brief Establece la fecha de apertura de la cuenta.
  * @param fecha Nueva fecha de apertura
  */
-void Cuenta::set_fecha_apertura(Fecha fecha) { fecha_apertura = fecha; }
+void Cuenta::set_fecha_apertura(Fecha fecha) { fecha_apertura = fecha; modificada = true; }
 
 /**
  * @brief Realiza un depósito en la cuenta.
@@ -163,9 +176,11 @@ void Cuenta::depositar(double monto, Fecha fecha) {
     try {
         if (monto <= 0) throw std::invalid_argument("Monto de depósito debe ser mayor a 0");
         if (!fecha.es_dia_habil()) throw std::invalid_argument("Depósito no permitido en día no hábil");
+        ListaDoble<Movimiento>* lista = get_movimientos();
         saldo += monto;
         Movimiento movimiento("Depósito", monto, fecha, saldo);
-        movimientos->insertar_cola(movimiento);
+        lista->insertar_cola(movimiento);
+        modificada = true;
     } catch (const std::exception& e) {
         std::cerr << "Error en depositar: " << e.what() << std::endl;
     }
@@ -182,9 +197,11 @@ bool Cuenta::retirar(double monto, Fecha fecha) {
         if (monto <= 0) throw std::invalid_argument("Monto de retiro debe ser mayor a 0");
         if (saldo < monto) throw std::invalid_argument("Saldo insuficiente");
         //if (!fecha.es_dia_habil()) throw std::invalid_argument("Retiro no permitido en día no hábil");
+        ListaDoble<Movimiento>* lista = get_movimientos();
         saldo -= monto;
         Movimiento movimiento("Retiro", monto, fecha, saldo);
-        movimientos->insertar_cola(movimiento);
+        lista->insertar_cola(movimiento);
+        modificada = true;
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Error en retirar: " << e.what() << std::endl;
@@ -213,9 +230,19 @@ void Cuenta::consultar_movimientos_rango(Fecha inicio, Fecha fin) {
         std::cout << "     Desde: " << inicio.to_string() << "  Hasta: " << fin.to_string() << "\n";
         std::cout << "  ==============================================\n";
 
+        int keyInicio = GestorClientes::dateKey(inicio);
+        int keyFin = GestorClientes::dateKey(fin);
+
+        // Antes del horizonte valen los segmentos archivados; un movimiento anterior que siga en la lista
+        // es de un archivado que no llegó a guardar el archivo de datos y ya está en los segmentos
+        ArchivoMovimientos& archivo = ArchivoMovimientos::general();
+        int horizonte = archivo.getHorizonte();
         std::vector<Movimiento> movs;
-        movimientos->recorrer([&](Movimiento m) {
-            movs.push_back(m);
+        if (horizonte > 0 && keyInicio < horizonte) {
+            archivo.consultar(id_cuenta, keyInicio, std::min(keyFin, horizonte - 1), movs);
+        }
+        get_movimientos()->recorrer([&](Movimiento m) {
+            if (GestorClientes::dateKey(m) >= horizonte) movs.push_back(m);
         });
 
         if (movs.empty()) {
@@ -225,9 +252,6 @@ void Cuenta::consultar_movimientos_rango(Fecha inicio, Fecha fin) {
 
         GestorClientes::radixSortFecha(movs);
 
-        int keyInicio = GestorClientes::dateKey(inicio);
-        int keyFin = GestorClientes::dateKey(fin);
-
         int startIdx = GestorClientes::lowerBound(movs, keyInicio);
         int endIdx = GestorClientes::upperBound(movs, keyFin) - 1;
 
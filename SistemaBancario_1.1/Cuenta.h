@@ -13,8 +13,11 @@
 #include "Fecha.h"
 #include "ListaDoble.h"
 #include <string>
+#include <memory>
 #include <chrono> // Para time_point
 
+struct HistorialDiferido;
+
 /**
  * @class Cuenta
  * @brief Clase abstracta para la gestión de cuentas bancarias.
@@ -35,6 +38,11 @@ public:
      * @param fecha Fecha de apertura
      */
     Cuenta(std::string id, double saldo_inicial, Fecha fecha);
+    /**
+     * @brief Constructor de copia. Copia los movimientos y, si sigue en el archivo, la ubicación del historial.
+     * @param otra Cuenta a copiar
+     */
+    Cuenta(const Cuenta& otra);
     /**
      * @brief Destructor virtual de Cuenta.
      */
@@ -55,10 +63,40 @@ public:
      */
     Fecha get_fecha_apertura();
     /**
-     * @brief Obtiene la lista de movimientos de la cuenta.
+     * @brief Obtiene la lista de movimientos de la cuenta, leyéndolos del archivo si estaban diferidos.
      * @return Puntero a la lista doble de movimientos
+     * @throw std::runtime_error Si el historial diferido no se puede leer
      */
     ListaDoble<Movimiento>* get_movimientos();
+    /**
+     * @brief Deja el historial en el archivo de datos hasta que se pida la lista de movimientos.
+     * @param historial Ubicación de los movimientos en el archivo
+     */
+    void diferir_movimientos(const HistorialDiferido& historial);
+    /**
+     * @brief Obtiene el historial que sigue en el archivo.
+     * @return Ubicación de los movimientos, o nullptr si ya están en memoria
+     */
+    const HistorialDiferido* get_historial_diferido() const;
+    /**
+     * @brief Quita de la lista los movimientos anteriores a una fecha, ya guardados en el archivo frío.
+     * @param horizonte Fecha (YYYYMMDD) del movimiento más antiguo que se conserva
+     */
+    void descartar_movimientos_anteriores(int horizonte);
+    /**
+     * @brief Anota que la cuenta cambió desde la última vez que se guardó.
+     * @details La llaman todos los métodos que modifican la cuenta; quien agregue movimientos directamente
+     *          a la lista de get_movimientos() debe llamarla también.
+     */
+    void marcar_modificada();
+    /**
+     * @brief Indica si la cuenta cambió desde la última vez que se guardó o se cargó.
+     */
+    bool esta_modificada() const;
+    /**
+     * @brief Anota que la cuenta coincide con lo guardado.
+     */
+    void marcar_guardada();
     /**
      * @brief Establece el ID de la cuenta.
      * @param id Nuevo ID de la cuenta
@@ -84,16 +122,6 @@ public:
      * @return String con los datos principales de la cuenta
      */
     virtual std::string to_string() = 0;
-    /**
-     * @brief Guarda los datos de la cuenta en un archivo binario (debe ser implementado por las subclases).
-     * @param archivo Puntero al archivo binario abierto para escritura
-     */
-    virtual void guardar_binario(FILE* archivo) = 0;
-    /**
-     * @brief Carga los datos de la cuenta desde un archivo binario (debe ser implementado por las subclases).
-     * @param archivo Puntero al archivo binario abierto para lectura
-     */
-    virtual void cargar_binario(FILE* archivo) = 0;
     /**
      * @brief Realiza un retiro de la cuenta.
      * @param monto Monto a retirar
@@ -116,6 +144,8 @@ public:
      * @brief Consulta e imprime los movimientos de la cuenta en un rango de fechas.
      * @param inicio Fecha de inicio
      * @param fin Fecha de fin
+     * @details Si el rango empieza antes del horizonte de archivado, la parte anterior se lee de los
+     *          segmentos de movimientos archivados.
      */
     void consultar_movimientos_rango(Fecha inicio, Fecha fin);
 
@@ -128,7 +158,7 @@ public:
      * @brief Establece el ID de la sucursal asociada a la cuenta.
      * @param id Nuevo ID de sucursal
      */
-    void set_branchId(int id) { branchId = id; }
+    void set_branchId(int id) { branchId = id; modificada = true; }
     /**
      * @brief Obtiene la hora de la cita asociada a la cuenta.
      * @return Hora de la cita (time_point)
@@ -138,15 +168,17 @@ public:
      * @brief Establece la hora de la cita asociada a la cuenta.
      * @param time Nueva hora de la cita (time_point)
      */
-    void set_appointmentTime(std::chrono::system_clock::time_point time) { appointmentTime = time; }
+    void set_appointmentTime(std::chrono::system_clock::time_point time) { appointmentTime = time; modificada = true; }
 
 protected:
     std::string id_cuenta; ///< ID de la cuenta
     double saldo; ///< Saldo actual de la cuenta
     Fecha fecha_apertura; ///< Fecha de apertura de la cuenta
     ListaDoble<Movimiento>* movimientos; ///< Lista de movimientos de la cuenta
+    std::unique_ptr<HistorialDiferido> historial; ///< Movimientos que siguen en el archivo (nullptr si no hay)
     int branchId; ///< ID de la sucursal asociada (1 = Norte, 2 = Centro, 3 = Sur)
     std::chrono::system_clock::time_point appointmentTime; ///< Hora de la cita asociada
+    bool modificada = true; ///< Si cambió desde la última vez que se guardó o se cargó
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,106 @@
+/**
+ * @file EscritorBinario.cpp
+ * @brief Implementación de la escritura por bloques de archivos binarios de clientes.
+ */
+
+#include "EscritorBinario.h"
+#include "LectorBinario.h"
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * @brief Constructor para escribir en un archivo.
+ */
+EscritorBinario::EscritorBinario(FILE* archivo, size_t capacidad)
+    : archivo(archivo), memoria(nullptr), buffer(capacidad > 0 ? capacidad : 1), lleno(0), escritos(0), inicio(0) {
+    if (!archivo) throw std::runtime_error("Archivo no válido para escritura");
+    inicio = LectorBinario::posicionDe(archivo);
+}
+
+/**
+ * @brief Constructor para escribir al final de una cadena en memoria.
+ */
+EscritorBinario::EscritorBinario(std::string& destino)
+    : archivo(nullptr), memoria(&destino), lleno(0), escritos(0), inicio(static_cast<int64_t>(destino.size())) {}
+
+/**
+ * @brief Destructor. Vacía lo pendiente sin lanzar excepciones.
+ */
+EscritorBinario::~EscritorBinario() {
+    try {
+        vaciar();
+    } catch (...) {
+    }
+}
+
+/**
+ * @brief Copia n bytes al búfer, vaciándolo antes si no caben.
+ * @details Un bloque más grande que el búfer se escribe directamente, sin copiarlo.
+ */
+void EscritorBinario::agregar(const void* datos, size_t n) {
+    escritos += n;
+    if (memoria) {
+        memoria->append(static_cast<const char*>(datos), n);
+        return;
+    }
+    if (buffer.size() - lleno < n) vaciar();
+    if (n > buffer.size()) {
+        if (fwrite(datos, 1, n, archivo) != n) throw std::runtime_error("Error al escribir en el archivo");
+        return;
+    }
+    std::memcpy(buffer.data() + lleno, datos, n);
+    lleno += n;
+}
+
+/**
+ * @brief Escribe una cadena precedida por su longitud (size_t), sin terminador.
+ */
+void EscritorBinario::escribirCadena(const std::string& cadena) {
+    size_t longitud = cadena.size();
+    escribir(longitud);
+    agregar(cadena.data(), longitud);
+}
+
+/**
+ * @brief Escribe bytes ya codificados, sin longitud.
+ */
+void EscritorBinario::escribirBloque(const std::string& bytes) {
+    agregar(bytes.data(), bytes.size());
+}
+
+/**
+ * @brief Sobrescribe n bytes a partir de una posición ya escrita.
+ * @details En un archivo vacía el búfer, escribe en la posición y vuelve al final.
+ */
+void EscritorBinario::reemplazar(uint64_t posicion, const void* datos, size_t n) {
+    if (posicion + n > escritos) throw std::runtime_error("Posición fuera de lo escrito");
+    if (memoria) {
+        std::memcpy(&(*memoria)[static_cast<size_t>(inicio + posicion)], datos, n);
+        return;
+    }
+    vaciar();
+    int64_t final = LectorBinario::posicionDe(archivo);
+    if (inicio < 0 || final < 0 || LectorBinario::posicionar(archivo, inicio + static_cast<int64_t>(posicion)) != 0 ||
+        fwrite(datos, 1, n, archivo) != n || LectorBinario::posicionar(archivo, final) != 0) {
+        throw std::runtime_error("Error al escribir en el archivo");
+    }
+}
+
+/**
+ * @brief Pasa al archivo todo lo que queda en el búfer.
+ */
+void EscritorBinario::vaciar() {
+    if (!archivo || lleno == 0) return;
+    size_t pendientes = lleno;
+    lleno = 0;
+    if (fwrite(buffer.data(), 1, pendientes, archivo) != pendientes) {
+        throw std::runtime_error("Error al escribir en el archivo");
+    }
+}
+
+/**
+ * @brief Bytes entregados al escritor desde su creación.
+ */
+uint64_t EscritorBinario::getEscritos() const {
+    return escritos;
+}
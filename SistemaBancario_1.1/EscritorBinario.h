@@ -0,0 +1,104 @@
+/**
+ * @file EscritorBinario.h
+ * @brief Definición de la clase EscritorBinario, escritura por bloques de archivos binarios de clientes.
+ *
+ * Contraparte de LectorBinario: los valores se copian a un búfer que se reutiliza y llega al archivo en
+ * bloques grandes, en lugar de una llamada a fwrite por campo. También puede escribir en memoria, para
+ * codificar los clientes sin pasar por un archivo.
+ */
+
+#ifndef ESCRITORBINARIO_H_INCLUDED
+#define ESCRITORBINARIO_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @class EscritorBinario
+ * @brief Cursor de escritura con búfer sobre un FILE* abierto en modo binario o sobre una cadena.
+ *
+ * Los errores de escritura se lanzan como std::runtime_error. El destructor vacía lo pendiente pero no
+ * puede informar fallos, así que quien necesite saber si el archivo quedó completo debe llamar a vaciar().
+ */
+class EscritorBinario {
+public:
+    /**
+     * @brief Constructor para escribir en un archivo.
+     * @param archivo Archivo abierto en modo binario de escritura
+     * @param capacidad Tamaño del búfer de escritura
+     */
+    explicit EscritorBinario(FILE* archivo, size_t capacidad = 1 << 16);
+    /**
+     * @brief Constructor para escribir al final de una cadena en memoria.
+     * @param destino Cadena que recibe los bytes
+     */
+    explicit EscritorBinario(std::string& destino);
+    /**
+     * @brief Destructor. Vacía lo pendiente sin lanzar excepciones.
+     */
+    ~EscritorBinario();
+    EscritorBinario(const EscritorBinario&) = delete;
+    EscritorBinario& operator=(const EscritorBinario&) = delete;
+
+    /**
+     * @brief Escribe un valor de tamaño fijo con su representación en memoria.
+     * @param valor Valor a escribir
+     */
+    template <typename T>
+    void escribir(const T& valor) {
+        agregar(&valor, sizeof(T));
+    }
+
+    /**
+     * @brief Escribe una cadena precedida por su longitud (size_t), sin terminador.
+     * @param cadena Cadena a escribir
+     */
+    void escribirCadena(const std::string& cadena);
+    /**
+     * @brief Escribe bytes ya codificados, sin longitud.
+     * @param bytes Bytes a copiar tal como están
+     */
+    void escribirBloque(const std::string& bytes);
+
+    /**
+     * @brief Sobrescribe un valor ya escrito, para completar campos que se conocen al final.
+     * @param posicion Posición del valor, contada como getEscritos() desde el inicio del escritor
+     * @param valor Nuevo valor, del mismo tamaño que el escrito
+     */
+    template <typename T>
+    void reescribir(uint64_t posicion, const T& valor) {
+        reemplazar(posicion, &valor, sizeof(T));
+    }
+
+    /**
+     * @brief Pasa al archivo todo lo que queda en el búfer.
+     * @throw std::runtime_error Si el archivo no acepta todos los bytes
+     */
+    void vaciar();
+    /**
+     * @brief Bytes entregados al escritor desde su creación.
+     */
+    uint64_t getEscritos() const;
+
+private:
+    FILE* archivo;             ///< Archivo de destino (nullptr si se escribe en memoria)
+    std::string* memoria;      ///< Cadena de destino (nullptr si se escribe en un archivo)
+    std::vector<char> buffer;  ///< Búfer reutilizado para todas las escrituras
+    size_t lleno;              ///< Bytes pendientes en el búfer
+    uint64_t escritos;         ///< Bytes entregados al escritor
+    int64_t inicio;            ///< Posición del archivo o tamaño de la cadena al crear el escritor
+
+    /**
+     * @brief Copia n bytes al búfer, vaciándolo antes si no caben.
+     */
+    void agregar(const void* datos, size_t n);
+    /**
+     * @brief Sobrescribe n bytes a partir de una posición ya escrita.
+     */
+    void reemplazar(uint64_t posicion, const void* datos, size_t n);
+};
+
+#endif
@@ -7,6 +7,7 @@
  */
 
 #include "Fecha.h"
+#include "CalendarioBancario.h"
 #include <iostream>
 #include <ctime>
 #include <iomanip>
@@ -18,7 +19,12 @@
  */
 Fecha::Fecha() {
     std::time_t tiempo_actual = std::time(nullptr);
-    std::tm tm_actual = *std::localtime(&tiempo_actual);
+    std::tm tm_actual;  // Los clientes se decodifican en varios hilos: localtime comparte su resultado
+#ifdef _WIN32
+    localtime_s(&tm_actual, &tiempo_actual);
+#else
+    localtime_r(&tiempo_actual, &tm_actual);
+#endif
     std::mktime(&tm_actual);
     dia = tm_actual.tm_mday;
     mes = tm_actual.tm_mon + 1;
@@ -222,6 +228,14 @@ std::string Fecha::to_string() const {
     return oss.str();
 }
 
+/**
+ * @brief Devuelve una clave numérica del día (YYYYMMDD) que se compara como entero.
+ * @return Clave numérica de la fecha
+ */
+int Fecha::clave_dia() const {
+    return anuario * 10000 + mes * 100 + dia;
+}
+
 /**
  * @brief Devuelve la fecha y hora en formato string para documentos (YYYY-MM-DDT_HH-MM-SSZ).
  * @return Fecha y hora como string
@@ -264,7 +278,7 @@ void Fecha::imprimir() {
  * @return true si es día hábil, false en caso contrario
  */
 bool Fecha::es_dia_habil() {
-    return !(es_finde() || es_feriado());
+    return CalendarioBancario::instancia().esDiaBancario(anuario, mes, dia);
 }
 
 /**
@@ -276,20 +290,11 @@ bool Fecha::empty() const {
 }
 
 /**
- * @brief Verifica si la fecha es un feriado nacional.
+ * @brief Verifica si la fecha es un feriado nacional (según el calendario bancario compartido).
  * @return true si es feriado, false en caso contrario
  */
 bool Fecha::es_feriado() {
-    if (mes == 1 && dia == 1) return true;
-    if (mes == 2 && (dia == 12 || dia == 13)) return true;
-    if (mes == 3 && dia == 29) return true;
-    if (mes == 5 && (dia == 1 || dia == 24)) return true;
-    if (mes == 8 && dia == 10) return true;
-    if (mes == 9 && dia == 26) return true;
-    if (mes == 10 && dia == 9) return true;
-    if (mes == 11 && (dia == 2 || dia == 3)) return true;
-    if (mes == 12 && (dia == 24 || dia == 25 || dia == 31)) return true;
-    return false;
+    return CalendarioBancario::instancia().esFeriado(anuario, mes, dia);
 }
 
 /**
@@ -297,13 +302,7 @@ bool Fecha::es_feriado() {
  * @return true si es sábado o domingo, false en caso contrario
  */
 bool Fecha::es_finde() {
-    std::tm tm_fecha = {};
-    tm_fecha.tm_mday = dia;
-    tm_fecha.tm_mon = mes - 1;
-    tm_fecha.tm_year = anuario - 1900;
-    std::mktime(&tm_fecha);
-    int dia_semana = tm_fecha.tm_wday;
-    return (dia_semana == 0 || dia_semana == 6);
+    return CalendarioBancario::instancia().esFinDeSemana(anuario, mes, dia);
 }
 
 /**
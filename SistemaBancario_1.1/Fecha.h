@@ -159,6 +159,11 @@ public:
      * @return Fecha como string
      */
     std::string to_string() const;
+    /**
+     * @brief Devuelve una clave numérica del día (YYYYMMDD) que se compara como entero.
+     * @return Clave numérica de la fecha
+     */
+    int clave_dia() const;
     /**
      * @brief Devuelve la fecha y hora en formato string para documentos (YYYY-MM-DDT_HH-MM-SSZ).
      * @return Fecha y hora como string
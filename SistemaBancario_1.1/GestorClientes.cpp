@@ -9,15 +9,33 @@
 #include "GestorClientes.h"
 #include <algorithm>
 #include <cctype>
+#include <thread>
 using namespace std;
 
+/// Por debajo de este número de elementos el radix sort no lanza hilos.
+static const size_t UMBRAL_RADIX_PARALELO = 1 << 16;
+
+/**
+ * @brief Ejecuta una tarea en varios hilos, usando el hilo actual como el hilo 0.
+ * @param hilos Número de hilos
+ * @param tarea Función que recibe el número de hilo
+ */
+static void ejecutarEnParalelo(unsigned hilos, const std::function<void(unsigned)>& tarea) {
+    std::vector<std::thread> trabajadores;
+    for (unsigned t = 1; t < hilos; ++t)
+        trabajadores.emplace_back(tarea, t);
+    tarea(0);
+    for (auto& h : trabajadores)
+        h.join();
+}
+
 /**
  * @brief Obtiene una clave numérica (YYYYMMDD) a partir de una fecha.
  * @param f Fecha
  * @return Clave numérica de la fecha
  */
 int GestorClientes::dateKey(const Fecha& f) {
-    return f.get_anuario() * 10000 + f.get_mes() * 100 + f.get_dia();
+    return f.clave_dia();
 }
 
 /**
@@ -244,4 +262,167 @@ int GestorClientes::busquedaBinariaString(ListaDoble<Cliente*>& lista, int n, co
         }
     }
     return -1;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Ordena índices por claves de 64 bits con radix sort LSD de 8 o 16 bits por dígito.
+ * @param claves Claves contiguas, una por elemento
+ * @param indices Salida: permutación estable que deja las claves en orden ascendente
+ */
+void GestorClientes::radixSortIndices(std::vector<uint64_t> claves, std::vector<uint32_t>& indices) {
+    const size_t n = claves.size();
+    indices.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        indices[i] = (uint32_t)i;
+    if (n < 2) return;
+
+    // Bits que no son iguales en todas las claves: los demás dígitos no necesitan pasada
+    uint64_t todosOr = 0, todosAnd = ~0ULL;
+    for (uint64_t k : claves) {
+        todosOr |= k;
+        todosAnd &= k;
+    }
+    const uint64_t varian = todosOr ^ todosAnd;
+
+    const int bits = (n >= UMBRAL_RADIX_PARALELO) ? 16 : 8;
+    const size_t cubetas = size_t(1) << bits;
+    const uint64_t mascara = cubetas - 1;
+    unsigned hilos = 1;
+    if (n >= UMBRAL_RADIX_PARALELO) {
+        hilos = std::thread::hardware_concurrency();
+        if (hilos == 0) hilos = 1;
+        hilos = std::min(hilos, 16u);
+    }
+    const size_t bloque = (n + hilos - 1) / hilos;
+
+    std::vector<uint64_t> clavesAux(n);
+    std::vector<uint32_t> indicesAux(n);
+    std::vector<size_t> histograma(hilos * cubetas);
+
+    for (int desp = 0; desp < 64; desp += bits) {
+        if (((varian >> desp) & mascara) == 0) continue;
+        std::fill(histograma.begin(), histograma.end(), 0);
+
+        ejecutarEnParalelo(hilos, [&](unsigned t) {
+            size_t ini = t * bloque, fin = std::min(n, ini + bloque);
+            size_t* h = &histograma[t * cubetas];
+            for (size_t i = ini; i < fin; ++i)
+                h[(claves[i] >> desp) & mascara]++;
+        });
+
+        // Posiciones de inicio: cubeta por cubeta, y dentro de cada cubeta en orden de hilo (estable)
+        size_t total = 0;
+        for (size_t c = 0; c < cubetas; ++c) {
+            for (unsigned t = 0; t < hilos; ++t) {
+                size_t cuenta = histograma[t * cubetas + c];
+                histograma[t * cubetas + c] = total;
+                total += cuenta;
+            }
+        }
+
+        ejecutarEnParalelo(hilos, [&](unsigned t) {
+            size_t ini = t * bloque, fin = std::min(n, ini + bloque);
+            size_t* h = &histograma[t * cubetas];
+            for (size_t i = ini; i < fin; ++i) {
+                size_t destino = h[(claves[i] >> desp) & mascara]++;
+                clavesAux[destino] = claves[i];
+                indicesAux[destino] = indices[i];
+            }
+        });
+
+        claves.swap(clavesAux);
+        indices.swap(indicesAux);
+    }
+}
+
+/**
+ * @brief Reescribe los valores de la lista siguiendo una permutación, en una sola pasada.
+ * @param clientes Lista de clientes a reescribir
+ * @param elementos Clientes en su orden original
+ * @param indices Permutación ascendente de los elementos
+ * @param ascendente false para recorrer la permutación al revés
+ */
+void GestorClientes::aplicarPermutacion(ListaDoble<Cliente*>& clientes, const std::vector<Cliente*>& elementos, const std::vector<uint32_t>& indices, bool ascendente) {
+    size_t n = indices.size();
+    Nodo<Cliente*>* nodo = clientes.get_cabeza();
+    for (size_t i = 0; i < n && nodo; ++i) {
+        nodo->set_valor(elementos[indices[ascendente ? i : n - 1 - i]]);
+        nodo = nodo->get_siguiente();
+    }
+}
+
+/**
+ * @brief Radix sort paralelo para ordenar clientes por un campo string (sin distinguir mayúsculas).
+ * @param clientes Lista de clientes
+ * @param getter Función para obtener el campo string del cliente
+ * @param ascendente true para orden ascendente, false para descendente
+ */
+void GestorClientes::radixSortParaleloString(ListaDoble<Cliente*>& clientes, std::function<std::string(Cliente*)> getter, bool ascendente) {
+    std::vector<Cliente*> elementos;
+    elementos.reserve(clientes.getTam());
+    clientes.recorrer([&](Cliente* c) { elementos.push_back(c); });
+    size_t n = elementos.size();
+    if (n < 2) {
+        return;
+    }
+
+    // Extraer cada clave una sola vez, en minúsculas, y empaquetar sus 8 primeros bytes
+    std::vector<std::string> texto(n);
+    std::vector<uint64_t> claves(n);
+    for (size_t i = 0; i < n; ++i) {
+        texto[i] = getter(elementos[i]);
+        std::transform(texto[i].begin(), texto[i].end(), texto[i].begin(), ::tolower);
+        uint64_t prefijo = 0;
+        for (size_t b = 0; b < 8; ++b) {
+            unsigned char c = (b < texto[i].size()) ? (unsigned char)texto[i][b] : 0;
+            prefijo = (prefijo << 8) | c;
+        }
+        claves[i] = prefijo;
+    }
+
+    std::vector<uint32_t> indices;
+    radixSortIndices(std::move(claves), indices);
+
+    // Resolver empates de prefijo comparando el resto de la clave
+    size_t ini = 0;
+    while (ini < n) {
+        size_t fin = ini + 1;
+        bool largo = texto[indices[ini]].size() > 8;
+        while (fin < n && texto[indices[fin]].compare(0, 8, texto[indices[ini]], 0, 8) == 0) {
+            largo = largo || texto[indices[fin]].size() > 8;
+            ++fin;
+        }
+        if (largo && fin - ini > 1) {
+            std::stable_sort(indices.begin() + ini, indices.begin() + fin,
+                [&](uint32_t a, uint32_t b) { return texto[a] < texto[b]; });
+        }
+        ini = fin;
+    }
+
+    aplicarPermutacion(clientes, elementos, indices, ascendente);
+}
+
+/**
+ * @brief Radix sort paralelo para ordenar clientes por un campo numérico.
+ * @param clientes Lista de clientes
+ * @param getter Función para obtener el campo numérico del cliente
+ * @param ascendente true para orden ascendente, false para descendente
+ */
+void GestorClientes::radixSortParaleloNumerico(ListaDoble<Cliente*>& clientes, std::function<long long(Cliente*)> getter, bool ascendente) {
+    std::vector<Cliente*> elementos;
+    elementos.reserve(clientes.getTam());
+    clientes.recorrer([&](Cliente* c) { elementos.push_back(c); });
+    size_t n = elementos.size();
+    if (n < 2) {
+        return;
+    }
+
+    // Invertir el bit de signo para que el orden sin signo coincida con el orden con signo
+    std::vector<uint64_t> claves(n);
+    for (size_t i = 0; i < n; ++i)
+        claves[i] = (uint64_t)getter(elementos[i]) ^ (1ULL << 63);
+
+    std::vector<uint32_t> indices;
+    radixSortIndices(std::move(claves), indices);
+    aplicarPermutacion(clientes, elementos, indices, ascendente);
+}
@@ -13,6 +13,7 @@
 #include <string>
 #include <functional>
 #include <vector>
+#include <cstdint>
 
 /**
  * @class GestorClientes
@@ -111,6 +112,39 @@ public:
      * @return Índice del primer movimiento > target
      */
     static int upperBound(const std::vector<Movimiento>& arr, int target);
+    /**
+     * @brief Radix sort paralelo para ordenar clientes por un campo string (sin distinguir mayúsculas).
+     * @param clientes Lista de clientes
+     * @param getter Función para obtener el campo string del cliente (se invoca una vez por cliente)
+     * @param ascendente true para orden ascendente, false para descendente
+     * @details Ordena por los primeros 8 caracteres como clave de 64 bits y resuelve los empates
+     * con la clave completa; la permutación se aplica a la lista en una sola pasada.
+     */
+    void radixSortParaleloString(ListaDoble<Cliente*>& clientes, std::function<std::string(Cliente*)> getter, bool ascendente = true);
+    /**
+     * @brief Radix sort paralelo para ordenar clientes por un campo numérico.
+     * @param clientes Lista de clientes
+     * @param getter Función para obtener el campo numérico del cliente (se invoca una vez por cliente)
+     * @param ascendente true para orden ascendente, false para descendente
+     */
+    void radixSortParaleloNumerico(ListaDoble<Cliente*>& clientes, std::function<long long(Cliente*)> getter, bool ascendente = true);
+private:
+    /**
+     * @brief Ordena índices por claves de 64 bits con radix sort LSD de 8 o 16 bits por dígito.
+     * @param claves Claves contiguas, una por elemento
+     * @param indices Salida: permutación estable que deja las claves en orden ascendente
+     * @details Los histogramas y la dispersión de cada pasada se reparten entre hilos;
+     * se omiten los dígitos que son iguales en todas las claves.
+     */
+    static void radixSortIndices(std::vector<uint64_t> claves, std::vector<uint32_t>& indices);
+    /**
+     * @brief Reescribe los valores de la lista siguiendo una permutación, en una sola pasada.
+     * @param clientes Lista de clientes a reescribir
+     * @param elementos Clientes en su orden original
+     * @param indices Permutación ascendente de los elementos
+     * @param ascendente false para recorrer la permutación al revés
+     */
+    static void aplicarPermutacion(ListaDoble<Cliente*>& clientes, const std::vector<Cliente*>& elementos, const std::vector<uint32_t>& indices, bool ascendente);
 };
 
 #endif
\ No newline at end of file
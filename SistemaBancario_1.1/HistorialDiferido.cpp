@@ -0,0 +1,110 @@
+/**
+ * @file HistorialDiferido.cpp
+ * @brief Implementación del vínculo privado al archivo de datos para los historiales diferidos.
+ */
+
+#include "HistorialDiferido.h"
+#include "LectorBinario.h"
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/**
+ * @brief Prefijo de los vínculos que crea este proceso: "<archivo>.historial<pid>_".
+ */
+std::string prefijoPropio(const std::string& archivo) {
+#ifdef _WIN32
+    unsigned long proceso = GetCurrentProcessId();
+#else
+    unsigned long proceso = static_cast<unsigned long>(getpid());
+#endif
+    return archivo + ".historial" + std::to_string(proceso) + "_";
+}
+
+} // namespace
+
+/**
+ * @brief Crea el vínculo privado a un archivo de datos.
+ * @details El nombre lleva el identificador del proceso, para no chocar con vínculos que otra ejecución
+ *          dejó al interrumpirse, y un contador, para que una recarga no borre el vínculo de la carga
+ *          anterior, cuyas cuentas siguen vivas hasta que la nueva lista las reemplaza. Un vínculo con el
+ *          mismo nombre solo puede quedar de una ejecución interrumpida que tuvo el mismo identificador.
+ */
+std::shared_ptr<ArchivoHistoriales> ArchivoHistoriales::vincular(const std::string& archivo) {
+    static std::atomic<unsigned> cargas{0};
+    std::string vinculo = prefijoPropio(archivo) + std::to_string(++cargas);
+    std::remove(vinculo.c_str());
+#ifdef _WIN32
+    bool vinculado = CreateHardLinkA(vinculo.c_str(), archivo.c_str(), nullptr) != 0;
+#else
+    bool vinculado = link(archivo.c_str(), vinculo.c_str()) == 0;
+#endif
+    if (!vinculado) return nullptr;
+    return std::shared_ptr<ArchivoHistoriales>(new ArchivoHistoriales(vinculo));
+}
+
+/**
+ * @brief Borra los vínculos de un archivo de datos que dejaron ejecuciones anteriores interrumpidas.
+ * @details Se conservan los de este proceso, que pueden seguir en uso tras una recarga.
+ */
+void ArchivoHistoriales::limpiarVinculos(const std::string& archivo) {
+    fs::path ruta(archivo);
+    fs::path carpeta = ruta.has_parent_path() ? ruta.parent_path() : fs::path(".");
+    std::string prefijo = ruta.filename().string() + ".historial";
+    std::string propio = fs::path(prefijoPropio(archivo)).filename().string();
+
+    std::error_code error;
+    std::vector<fs::path> abandonados;
+    for (fs::directory_iterator it(carpeta, error), fin; !error && it != fin; it.increment(error)) {
+        std::string nombre = it->path().filename().string();
+        if (nombre.compare(0, prefijo.size(), prefijo) == 0 && nombre.compare(0, propio.size(), propio) != 0) {
+            abandonados.push_back(it->path());
+        }
+    }
+    for (const auto& vinculo : abandonados) fs::remove(vinculo, error);
+}
+
+/**
+ * @brief Constructor privado; se crea con vincular().
+ */
+ArchivoHistoriales::ArchivoHistoriales(std::string archivo) : archivo(std::move(archivo)) {}
+
+/**
+ * @brief Destructor. Borra el vínculo privado.
+ */
+ArchivoHistoriales::~ArchivoHistoriales() {
+    std::remove(archivo.c_str());
+}
+
+/**
+ * @brief Copia bytes del archivo tal como están.
+ */
+void ArchivoHistoriales::leer(uint64_t posicion, uint64_t longitud, std::string& destino) const {
+    FILE* file = fopen(archivo.c_str(), "rb");
+    if (!file) throw std::runtime_error("No se pudo abrir " + archivo);
+    destino.resize(static_cast<size_t>(longitud));
+    bool leido = LectorBinario::posicionar(file, static_cast<int64_t>(posicion)) == 0 &&
+                 fread(&destino[0], 1, destino.size(), file) == destino.size();
+    fclose(file);
+    if (!leido) throw std::runtime_error("Historial incompleto en " + archivo);
+}
+
+/**
+ * @brief Nombre del vínculo privado.
+ */
+const std::string& ArchivoHistoriales::getArchivo() const {
+    return archivo;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file HistorialDiferido.h
+ * @brief Definición de ArchivoHistoriales, HistorialDiferido y CodificacionCliente, datos que siguen en el archivo.
+ *
+ * Al cargar datos.txt en modo diferido, los clientes y cuentas se leen completos, pero de cada historial
+ * solo se anota dónde empieza y cuántos movimientos tiene. Los movimientos se leen la primera vez que
+ * alguien pide la lista de la cuenta. Como cada guardado reemplaza datos.txt, las posiciones se refieren
+ * a un vínculo privado del archivo cargado, que no cambia hasta que se libera el último historial.
+ *
+ * Del mismo modo, cada cliente recuerda dónde están sus bytes en el último archivo cargado o guardado;
+ * mientras no cambie, el siguiente guardado copia esos bytes en lugar de codificarlo otra vez.
+ */
+
+#ifndef HISTORIALDIFERIDO_H_INCLUDED
+#define HISTORIALDIFERIDO_H_INCLUDED
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @class ArchivoHistoriales
+ * @brief Vínculo privado (enlace duro) al archivo de datos cargado, compartido por los historiales pendientes.
+ *
+ * El vínculo apunta al mismo contenido que el archivo original, así que crearlo no copia datos; cuando el
+ * guardado renombra el temporal sobre datos.txt, el vínculo sigue apuntando al contenido anterior. Se
+ * borra al destruirse, es decir, cuando ya no queda ninguna cuenta con su historial pendiente ni ningún
+ * cliente cuya codificación esté en él.
+ */
+class ArchivoHistoriales {
+public:
+    /**
+     * @brief Crea el vínculo privado a un archivo de datos.
+     * @param archivo Archivo de datos recién verificado
+     * @return El vínculo, o nullptr si el sistema de archivos no admite enlaces duros
+     */
+    static std::shared_ptr<ArchivoHistoriales> vincular(const std::string& archivo);
+    /**
+     * @brief Borra los vínculos de un archivo de datos que dejaron ejecuciones anteriores interrumpidas.
+     * @param archivo Archivo de datos
+     */
+    static void limpiarVinculos(const std::string& archivo);
+    /**
+     * @brief Destructor. Borra el vínculo privado.
+     */
+    ~ArchivoHistoriales();
+    ArchivoHistoriales(const ArchivoHistoriales&) = delete;
+    ArchivoHistoriales& operator=(const ArchivoHistoriales&) = delete;
+
+    /**
+     * @brief Copia bytes del archivo tal como están.
+     * @param posicion Posición del primer byte
+     * @param longitud Cantidad de bytes
+     * @param destino Cadena que recibe los bytes
+     * @throw std::runtime_error Si el archivo no se puede abrir o es más corto de lo esperado
+     */
+    void leer(uint64_t posicion, uint64_t longitud, std::string& destino) const;
+    /**
+     * @brief Nombre del vínculo privado.
+     */
+    const std::string& getArchivo() const;
+
+private:
+    std::string archivo; ///< Nombre del vínculo privado
+
+    explicit ArchivoHistoriales(std::string archivo);
+};
+
+/**
+ * @struct HistorialDiferido
+ * @brief Movimientos de una cuenta que todavía no se leyeron
+ */
+struct HistorialDiferido {
+    std::shared_ptr<ArchivoHistoriales> archivo; ///< Archivo que contiene los movimientos
+    uint64_t posicion = 0;                       ///< Posición del primer movimiento
+    int cantidad = 0;                            ///< Cantidad de movimientos
+};
+
+/**
+ * @struct CodificacionCliente
+ * @brief Bytes de un cliente tal como quedaron en un archivo en el formato actual
+ */
+struct CodificacionCliente {
+    std::shared_ptr<ArchivoHistoriales> archivo; ///< Archivo que contiene los bytes (nullptr si no hay)
+    uint64_t posicion = 0;                       ///< Posición del primer byte del cliente
+    uint64_t longitud = 0;                       ///< Bytes del cliente, con sus cuentas y movimientos
+};
+
+#endif
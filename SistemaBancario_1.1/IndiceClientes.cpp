@@ -0,0 +1,211 @@
+/**
+ * @file IndiceClientes.cpp
+ * @brief Implementación del índice secundario ordenado de clientes.
+ *
+ * Cada campo se mantiene en un árbol Rojo-Negro ordenado por clave normalizada, por lo que la
+ * inserción, la eliminación y el inicio de cada consulta cuestan O(log n).
+ */
+
+#include "IndiceClientes.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+/**
+ * @brief Normaliza un texto para comparación (minúsculas).
+ * @param texto Texto a normalizar
+ * @return Texto normalizado
+ */
+std::string IndiceClientes::normalizar(const std::string& texto) {
+    std::string resultado = texto;
+    std::transform(resultado.begin(), resultado.end(), resultado.begin(),
+                   [](unsigned char c) { return (char)std::tolower(c); });
+    return resultado;
+}
+
+/**
+ * @brief Indica si un campo se ordena numéricamente (DNI y teléfono).
+ * @param campo Índice del campo
+ */
+bool IndiceClientes::esNumerico(int campo) {
+    return campo == 0 || campo == 3;
+}
+
+/**
+ * @brief Convierte un valor de búsqueda en clave comparable para un campo.
+ * @param valor Valor del campo (se normaliza)
+ * @param campo Índice del campo
+ * @return Clave comparable
+ */
+ClaveCliente IndiceClientes::crearClave(const std::string& valor, int campo) {
+    if (campo < 0 || campo >= NUM_CAMPOS) throw std::invalid_argument("Campo de índice inválido");
+    ClaveCliente resultado;
+    if (esNumerico(campo)) {
+        resultado.texto = valor;
+        bool digitos = !valor.empty() && valor.size() <= 19 &&
+                       std::all_of(valor.begin(), valor.end(), [](unsigned char c) { return std::isdigit(c); });
+        // Valores no numéricos quedan al final, ordenados por texto
+        resultado.numero = digitos ? std::stoull(valor) : UINT64_MAX;
+    } else {
+        resultado.texto = normalizar(valor);
+        uint64_t prefijo = 0;
+        for (size_t i = 0; i < 8; i++) {
+            unsigned char c = (i < resultado.texto.size()) ? (unsigned char)resultado.texto[i] : 0;
+            prefijo = (prefijo << 8) | c;
+        }
+        resultado.numero = prefijo;
+    }
+    return resultado;
+}
+
+/**
+ * @brief Obtiene la clave precalculada de un cliente para un campo.
+ * @param cliente Puntero al cliente
+ * @param campo Índice del campo
+ * @return Clave comparable del campo
+ */
+ClaveCliente IndiceClientes::clave(Cliente* cliente, int campo) {
+    switch (campo) {
+        case 0: return crearClave(cliente->get_dni(), campo);
+        case 1: return crearClave(cliente->get_nombres(), campo);
+        case 2: return crearClave(cliente->get_apellidos(), campo);
+        case 3: return crearClave(cliente->get_telefono(), campo);
+        case 4: return crearClave(cliente->get_email(), campo);
+        default: throw std::invalid_argument("Campo de índice inválido");
+    }
+}
+
+/**
+ * @brief Obtiene el árbol ordenado de un campo (solo lectura).
+ * @param campo Índice del campo
+ * @return Referencia al árbol Rojo-Negro del campo
+ */
+const ArbolClientes& IndiceClientes::getArbol(int campo) const {
+    if (campo < 0 || campo >= NUM_CAMPOS) throw std::invalid_argument("Campo de índice inválido");
+    return arboles[campo];
+}
+
+/**
+ * @brief Reconstruye todos los índices a partir de una lista de clientes.
+ * @param clientes Lista de clientes
+ * @details Cada clave se calcula una sola vez; si la lista ya viene ordenada por el campo el árbol
+ * se arma en O(n), y si no, se ordena primero (estable, para conservar el orden de los iguales).
+ */
+void IndiceClientes::reconstruir(const ListaDoble<Cliente*>& clientes) {
+    std::vector<std::pair<ClaveCliente, Cliente*>> elementos;
+    elementos.reserve(clientes.getTam());
+    for (int campo = 0; campo < NUM_CAMPOS; campo++) {
+        elementos.clear();
+        clientes.recorrer([&](Cliente* c) { elementos.emplace_back(clave(c, campo), c); });
+        auto por_clave = [](const std::pair<ClaveCliente, Cliente*>& a, const std::pair<ClaveCliente, Cliente*>& b) {
+            return a.first < b.first;
+        };
+        if (!std::is_sorted(elementos.begin(), elementos.end(), por_clave)) {
+            std::stable_sort(elementos.begin(), elementos.end(), por_clave);
+        }
+        arboles[campo].construirOrdenado(elementos);
+    }
+}
+
+/**
+ * @brief Inserta un cliente en todos los índices manteniendo el orden.
+ * @param cliente Puntero al cliente
+ */
+void IndiceClientes::insertar(Cliente* cliente) {
+    if (!cliente) return;
+    for (int campo = 0; campo < NUM_CAMPOS; campo++) {
+        arboles[campo].insertar(clave(cliente, campo), cliente);
+    }
+}
+
+/**
+ * @brief Elimina un cliente de todos los índices.
+ * @param cliente Puntero al cliente
+ */
+void IndiceClientes::eliminar(Cliente* cliente) {
+    if (!cliente) return;
+    for (int campo = 0; campo < NUM_CAMPOS; campo++) {
+        arboles[campo].eliminar(clave(cliente, campo), cliente);
+    }
+}
+
+/**
+ * @brief Vacía todos los índices.
+ */
+void IndiceClientes::limpiar() {
+    for (int campo = 0; campo < NUM_CAMPOS; campo++) {
+        arboles[campo].limpiar();
+    }
+}
+
+/**
+ * @brief Obtiene la cantidad de clientes indexados.
+ * @return Número de entradas de cada índice
+ */
+size_t IndiceClientes::getTam() const {
+    return arboles[0].getTam();
+}
+
+/**
+ * @brief Busca los clientes cuyo campo coincide exactamente con el valor (sin distinguir mayúsculas).
+ * @param campo Índice del campo
+ * @param valor Valor a buscar
+ * @return Clientes encontrados, en orden de clave
+ */
+std::vector<Cliente*> IndiceClientes::buscarExacto(int campo, const std::string& valor) const {
+    return buscarRango(campo, valor, valor);
+}
+
+/**
+ * @brief Agrega al resultado los clientes con clave en [desde, hasta].
+ */
+void IndiceClientes::recogerRango(const ArbolClientes& arbol, const ClaveCliente& desde, const ClaveCliente& hasta,
+                                  std::vector<Cliente*>& resultado) const {
+    for (auto it = arbol.lower_bound(desde); it != arbol.fin() && !(hasta < it->clave); ++it) {
+        resultado.push_back(it->valor);
+    }
+}
+
+/**
+ * @brief Busca los clientes cuyo campo comienza con el prefijo dado (sin distinguir mayúsculas).
+ * @param campo Índice del campo
+ * @param prefijo Prefijo a buscar
+ * @return Clientes encontrados, en orden de clave
+ */
+std::vector<Cliente*> IndiceClientes::buscarPrefijo(int campo, const std::string& prefijo) const {
+    const ArbolClientes& arbol = getArbol(campo);
+    std::vector<Cliente*> resultado;
+    if (esNumerico(campo)) {
+        // En orden numérico los valores con un prefijo forman un rango por cada cantidad de dígitos. Con ceros
+        // a la izquierda ("0123" vale 123) el rango de un largo también contiene valores de otros largos
+        // ("123" o "00123"), así que solo se toman los que tienen exactamente ese largo
+        for (size_t largo = std::max<size_t>(prefijo.size(), 1); largo <= 19; largo++) {
+            size_t relleno = largo - prefijo.size();
+            ClaveCliente hasta = crearClave(prefijo + std::string(relleno, '9'), campo);
+            for (auto it = arbol.lower_bound(crearClave(prefijo + std::string(relleno, '0'), campo));
+                 it != arbol.fin() && !(hasta < it->clave); ++it) {
+                if (it->clave.texto.size() == largo) resultado.push_back(it->valor);
+            }
+        }
+        return resultado;
+    }
+    ClaveCliente inicio = crearClave(prefijo, campo);
+    for (auto it = arbol.lower_bound(inicio);
+         it != arbol.fin() && it->clave.texto.compare(0, inicio.texto.size(), inicio.texto) == 0; ++it) {
+        resultado.push_back(it->valor);
+    }
+    return resultado;
+}
+
+/**
+ * @brief Busca los clientes cuyo campo está en el rango [desde, hasta] (sin distinguir mayúsculas).
+ * @param campo Índice del campo
+ * @param desde Límite inferior (inclusive)
+ * @param hasta Límite superior (inclusive)
+ * @return Clientes encontrados, en orden de clave
+ */
+std::vector<Cliente*> IndiceClientes::buscarRango(int campo, const std::string& desde, const std::string& hasta) const {
+    std::vector<Cliente*> resultado;
+    recogerRango(getArbol(campo), crearClave(desde, campo), crearClave(hasta, campo), resultado);
+    return resultado;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file IndiceClientes.h
+ * @brief Definición de la clase IndiceClientes, índice secundario ordenado de clientes por campo.
+ *
+ * Mantiene, para cada campo de búsqueda, un árbol Rojo-Negro de pares (clave normalizada, cliente)
+ * que permite consultas exactas, por prefijo y por rango sin volver a ordenar la lista de clientes.
+ */
+
+#ifndef INDICECLIENTES_H_INCLUDED
+#define INDICECLIENTES_H_INCLUDED
+
+#include "Cliente.h"
+#include "ListaDoble.h"
+#include "MapaRojoNegro.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @struct ClaveCliente
+ * @brief Clave de ordenamiento precalculada una sola vez por cliente y campo.
+ *
+ * En campos numéricos (DNI, teléfono) numero es el valor del campo; en campos de texto son los primeros
+ * 8 bytes del texto en minúsculas, de modo que la mayoría de comparaciones se resuelven con un entero
+ * y solo los empates comparan el texto completo.
+ */
+struct ClaveCliente {
+    uint64_t numero;   ///< Valor numérico o prefijo de 8 bytes empaquetado
+    std::string texto; ///< Texto normalizado completo (dígitos en campos numéricos)
+
+    bool operator<(const ClaveCliente& otra) const {
+        return (numero != otra.numero) ? (numero < otra.numero) : (texto < otra.texto);
+    }
+    bool operator==(const ClaveCliente& otra) const {
+        return numero == otra.numero && texto == otra.texto;
+    }
+};
+
+/// Árbol ordenado de clientes por clave precalculada
+typedef MapaRojoNegro<ClaveCliente, Cliente*> ArbolClientes;
+
+/**
+ * @class IndiceClientes
+ * @brief Índice secundario ordenado de clientes por DNI, nombres, apellidos, teléfono y email.
+ *
+ * Las claves se precalculan (ver ClaveCliente) al insertar, de modo que cada paso de la búsqueda
+ * compara enteros y no vuelve a convertir ni copiar los campos. Inserción y eliminación cuestan O(log n) y las consultas
+ * O(log n + k). Los árboles quedan vivos, de modo que la visualización puede leerlos directamente.
+ */
+class IndiceClientes {
+public:
+    /// Número de campos indexados (0: DNI, 1: Nombres, 2: Apellidos, 3: Teléfono, 4: Email)
+    static const int NUM_CAMPOS = 5;
+
+    /**
+     * @brief Reconstruye todos los índices a partir de una lista de clientes.
+     * @param clientes Lista de clientes
+     */
+    void reconstruir(const ListaDoble<Cliente*>& clientes);
+    /**
+     * @brief Inserta un cliente en todos los índices manteniendo el orden.
+     * @param cliente Puntero al cliente
+     */
+    void insertar(Cliente* cliente);
+    /**
+     * @brief Elimina un cliente de todos los índices.
+     * @param cliente Puntero al cliente
+     */
+    void eliminar(Cliente* cliente);
+    /**
+     * @brief Vacía todos los índices.
+     */
+    void limpiar();
+    /**
+     * @brief Busca los clientes cuyo campo coincide exactamente con el valor (sin distinguir mayúsculas).
+     * @param campo Índice del campo
+     * @param valor Valor a buscar
+     * @return Clientes encontrados, en orden de clave
+     */
+    std::vector<Cliente*> buscarExacto(int campo, const std::string& valor) const;
+    /**
+     * @brief Busca los clientes cuyo campo comienza con el prefijo dado (sin distinguir mayúsculas).
+     * @param campo Índice del campo
+     * @param prefijo Prefijo a buscar
+     * @return Clientes encontrados, en orden de clave
+     */
+    std::vector<Cliente*> buscarPrefijo(int campo, const std::string& prefijo) const;
+    /**
+     * @brief Busca los clientes cuyo campo está en el rango [desde, hasta] (sin distinguir mayúsculas).
+     * @param campo Índice del campo
+     * @param desde Límite inferior (inclusive)
+     * @param hasta Límite superior (inclusive)
+     * @return Clientes encontrados, en orden de clave
+     */
+    std::vector<Cliente*> buscarRango(int campo, const std::string& desde, const std::string& hasta) const;
+    /**
+     * @brief Obtiene la cantidad de clientes indexados.
+     * @return Número de entradas de cada índice
+     */
+    size_t getTam() const;
+    /**
+     * @brief Obtiene el árbol ordenado de un campo (solo lectura).
+     * @param campo Índice del campo
+     * @return Referencia al árbol Rojo-Negro del campo
+     */
+    const ArbolClientes& getArbol(int campo) const;
+    /**
+     * @brief Obtiene la clave precalculada de un cliente para un campo.
+     * @param cliente Puntero al cliente
+     * @param campo Índice del campo
+     * @return Clave comparable del campo
+     */
+    static ClaveCliente clave(Cliente* cliente, int campo);
+    /**
+     * @brief Convierte un valor de búsqueda en clave comparable para un campo.
+     * @param valor Valor del campo (se normaliza)
+     * @param campo Índice del campo
+     * @return Clave comparable
+     */
+    static ClaveCliente crearClave(const std::string& valor, int campo);
+    /**
+     * @brief Indica si un campo se ordena numéricamente (DNI y teléfono).
+     * @param campo Índice del campo
+     */
+    static bool esNumerico(int campo);
+    /**
+     * @brief Normaliza un texto para comparación (minúsculas).
+     * @param texto Texto a normalizar
+     * @return Texto normalizado
+     */
+    static std::string normalizar(const std::string& texto);
+
+private:
+    ArbolClientes arboles[NUM_CAMPOS]; ///< Un árbol ordenado por campo
+
+    /**
+     * @brief Agrega al resultado los clientes con clave en [desde, hasta].
+     */
+    void recogerRango(const ArbolClientes& arbol, const ClaveCliente& desde, const ClaveCliente& hasta,
+                      std::vector<Cliente*>& resultado) const;
+};
+
+#endif
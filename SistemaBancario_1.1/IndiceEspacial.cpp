@@ -0,0 +1,185 @@
+/**
+ * @file IndiceEspacial.cpp
+ * @brief Implementación del árbol k-d de puntos geográficos.
+ */
+
+#include "IndiceEspacial.h"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * @brief Constructor por defecto. Crea un índice vacío.
+ * @param radio_km Radio de la esfera en kilómetros
+ */
+IndiceEspacial::IndiceEspacial(double radio_km) : radio_km(radio_km) {}
+
+/**
+ * @brief Reconstruye el índice con una lista de coordenadas.
+ * @param coordenadas Pares (latitud, longitud) en grados
+ */
+void IndiceEspacial::construir(const std::vector<std::pair<double, double>>& coordenadas) {
+    puntos.resize(coordenadas.size());
+    ejes.assign(coordenadas.size(), 0);
+    for (size_t i = 0; i < coordenadas.size(); i++) {
+        proyectar(coordenadas[i].first, coordenadas[i].second, puntos[i].coord);
+        puntos[i].posicion = i;
+    }
+    construirRango(0, puntos.size());
+}
+
+/**
+ * @brief Ordena recursivamente un rango para que su mediana quede en el centro.
+ * @details Se corta por el eje con mayor extensión del rango, lo que mantiene el árbol equilibrado
+ *          aunque los puntos estén concentrados en una zona pequeña de la esfera (una ciudad o un país).
+ */
+void IndiceEspacial::construirRango(size_t inicio, size_t fin) {
+    if (fin - inicio <= 1) return;
+
+    double minimo[3] = {2, 2, 2}, maximo[3] = {-2, -2, -2};
+    for (size_t i = inicio; i < fin; i++) {
+        for (int e = 0; e < 3; e++) {
+            minimo[e] = std::min(minimo[e], puntos[i].coord[e]);
+            maximo[e] = std::max(maximo[e], puntos[i].coord[e]);
+        }
+    }
+    uint8_t eje = 0;
+    for (uint8_t e = 1; e < 3; e++) {
+        if (maximo[e] - minimo[e] > maximo[eje] - minimo[eje]) eje = e;
+    }
+
+    size_t medio = inicio + (fin - inicio) / 2;
+    std::nth_element(puntos.begin() + inicio, puntos.begin() + medio, puntos.begin() + fin,
+                     [eje](const Punto& a, const Punto& b) { return a.coord[eje] < b.coord[eje]; });
+    ejes[medio] = eje;
+    construirRango(inicio, medio);
+    construirRango(medio + 1, fin);
+}
+
+/**
+ * @brief Obtiene los k puntos más cercanos a una ubicación.
+ * @return Hasta k resultados ordenados por distancia creciente
+ */
+std::vector<IndiceEspacial::Resultado> IndiceEspacial::vecinosMasCercanos(double latitud, double longitud, size_t k) const {
+    std::vector<Resultado> resultado;
+    if (k == 0 || puntos.empty()) return resultado;
+
+    double consulta[3];
+    proyectar(latitud, longitud, consulta);
+    std::vector<std::pair<double, size_t>> monticulo; // Máximo en el frente: el peor de los k actuales
+    monticulo.reserve(k + 1);
+    buscarVecinos(0, puntos.size(), consulta, k, monticulo);
+
+    std::sort_heap(monticulo.begin(), monticulo.end());
+    resultado.reserve(monticulo.size());
+    for (const auto& par : monticulo) resultado.push_back({par.second, kilometros(par.first)});
+    return resultado;
+}
+
+/**
+ * @brief Búsqueda recursiva de los k más cercanos.
+ * @details Se visita primero el lado del corte que contiene a la consulta; el otro lado solo si la
+ *          distancia al plano de corte es menor que el peor de los k candidatos actuales.
+ */
+void IndiceEspacial::buscarVecinos(size_t inicio, size_t fin, const double consulta[3], size_t k,
+                                   std::vector<std::pair<double, size_t>>& monticulo) const {
+    if (inicio >= fin) return;
+    size_t medio = inicio + (fin - inicio) / 2;
+    const Punto& punto = puntos[medio];
+
+    double distancia = cuerdaCuadrada(consulta, punto.coord);
+    if (monticulo.size() < k) {
+        monticulo.push_back({distancia, punto.posicion});
+        std::push_heap(monticulo.begin(), monticulo.end());
+    } else if (distancia < monticulo.front().first) {
+        std::pop_heap(monticulo.begin(), monticulo.end());
+        monticulo.back() = {distancia, punto.posicion};
+        std::push_heap(monticulo.begin(), monticulo.end());
+    }
+
+    double diferencia = consulta[ejes[medio]] - punto.coord[ejes[medio]];
+    bool izquierda_primero = diferencia < 0;
+    if (izquierda_primero) buscarVecinos(inicio, medio, consulta, k, monticulo);
+    else buscarVecinos(medio + 1, fin, consulta, k, monticulo);
+
+    if (monticulo.size() < k || diferencia * diferencia < monticulo.front().first) {
+        if (izquierda_primero) buscarVecinos(medio + 1, fin, consulta, k, monticulo);
+        else buscarVecinos(inicio, medio, consulta, k, monticulo);
+    }
+}
+
+/**
+ * @brief Obtiene los puntos a una distancia menor o igual a un radio.
+ * @return Resultados ordenados por distancia creciente
+ */
+std::vector<IndiceEspacial::Resultado> IndiceEspacial::dentroDeRadio(double latitud, double longitud, double radio_km) const {
+    std::vector<Resultado> resultado;
+    if (radio_km < 0 || puntos.empty()) return resultado;
+
+    double consulta[3];
+    proyectar(latitud, longitud, consulta);
+    // Cuerda correspondiente al arco del radio (a partir de medio perímetro cubre toda la esfera)
+    double angulo = std::min(radio_km / this->radio_km, M_PI);
+    double cuerda = 2.0 * std::sin(angulo / 2.0);
+    std::vector<std::pair<double, size_t>> encontrados;
+    buscarRadio(0, puntos.size(), consulta, cuerda * cuerda * (1.0 + 1e-12), encontrados);
+
+    std::sort(encontrados.begin(), encontrados.end());
+    resultado.reserve(encontrados.size());
+    for (const auto& par : encontrados) resultado.push_back({par.second, kilometros(par.first)});
+    return resultado;
+}
+
+/**
+ * @brief Búsqueda recursiva de los puntos dentro de una cuerda máxima al cuadrado.
+ */
+void IndiceEspacial::buscarRadio(size_t inicio, size_t fin, const double consulta[3], double limite,
+                                 std::vector<std::pair<double, size_t>>& encontrados) const {
+    if (inicio >= fin) return;
+    size_t medio = inicio + (fin - inicio) / 2;
+    const Punto& punto = puntos[medio];
+
+    double distancia = cuerdaCuadrada(consulta, punto.coord);
+    if (distancia <= limite) encontrados.push_back({distancia, punto.posicion});
+
+    double diferencia = consulta[ejes[medio]] - punto.coord[ejes[medio]];
+    if (diferencia < 0 || diferencia * diferencia <= limite) buscarRadio(inicio, medio, consulta, limite, encontrados);
+    if (diferencia >= 0 || diferencia * diferencia <= limite) buscarRadio(medio + 1, fin, consulta, limite, encontrados);
+}
+
+/**
+ * @brief Cantidad de puntos indexados.
+ */
+size_t IndiceEspacial::getCantidad() const {
+    return puntos.size();
+}
+
+/**
+ * @brief Proyecta latitud y longitud (grados) sobre la esfera unitaria.
+ */
+void IndiceEspacial::proyectar(double latitud, double longitud, double destino[3]) {
+    double lat = latitud * M_PI / 180.0;
+    double lon = longitud * M_PI / 180.0;
+    destino[0] = std::cos(lat) * std::cos(lon);
+    destino[1] = std::cos(lat) * std::sin(lon);
+    destino[2] = std::sin(lat);
+}
+
+/**
+ * @brief Distancia al cuadrado entre dos puntos proyectados.
+ */
+double IndiceEspacial::cuerdaCuadrada(const double a[3], const double b[3]) {
+    double dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief Convierte una cuerda al cuadrado en kilómetros sobre la superficie.
+ */
+double IndiceEspacial::kilometros(double cuerda_cuadrada) const {
+    double media_cuerda = std::min(1.0, std::sqrt(cuerda_cuadrada) / 2.0);
+    return 2.0 * radio_km * std::asin(media_cuerda);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file IndiceEspacial.h
+ * @brief Definición de la clase IndiceEspacial, árbol k-d de puntos geográficos para búsquedas por cercanía.
+ *
+ * Cada punto (latitud, longitud) se proyecta sobre la esfera unitaria en coordenadas cartesianas. La distancia
+ * en línea recta entre dos puntos de la esfera (cuerda) crece con la distancia sobre la superficie, por lo que
+ * el árbol k-d en tres dimensiones devuelve exactamente los mismos vecinos que ordenar por Haversine, sin
+ * recorrer todos los puntos: k vecinos en O(log n + k) en promedio y búsquedas por radio acotadas.
+ */
+
+#ifndef INDICEESPACIAL_H_INCLUDED
+#define INDICEESPACIAL_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class IndiceEspacial
+ * @brief Árbol k-d estático sobre puntos geográficos identificados por su posición en un vector externo.
+ *
+ * El árbol se guarda implícito en un vector: la mediana de cada rango es la raíz del subárbol y las mitades
+ * izquierda y derecha son sus hijos. Se reconstruye completo (O(n log n)) cuando cambian los puntos.
+ */
+class IndiceEspacial {
+public:
+    typedef std::pair<size_t, double> Resultado; ///< Posición del punto y distancia en kilómetros
+
+    /**
+     * @brief Constructor por defecto. Crea un índice vacío.
+     * @param radio_km Radio de la esfera en kilómetros (por defecto, el de la Tierra)
+     */
+    explicit IndiceEspacial(double radio_km = 6371.0);
+
+    /**
+     * @brief Reconstruye el índice con una lista de coordenadas.
+     * @param coordenadas Pares (latitud, longitud) en grados; la posición en el vector identifica a cada punto
+     */
+    void construir(const std::vector<std::pair<double, double>>& coordenadas);
+    /**
+     * @brief Obtiene los k puntos más cercanos a una ubicación.
+     * @param latitud Latitud en grados
+     * @param longitud Longitud en grados
+     * @param k Cantidad de puntos a devolver
+     * @return Hasta k resultados ordenados por distancia creciente
+     */
+    std::vector<Resultado> vecinosMasCercanos(double latitud, double longitud, size_t k) const;
+    /**
+     * @brief Obtiene los puntos a una distancia menor o igual a un radio.
+     * @param latitud Latitud en grados
+     * @param longitud Longitud en grados
+     * @param radio_km Radio de búsqueda en kilómetros
+     * @return Resultados ordenados por distancia creciente
+     */
+    std::vector<Resultado> dentroDeRadio(double latitud, double longitud, double radio_km) const;
+    /**
+     * @brief Cantidad de puntos indexados.
+     */
+    size_t getCantidad() const;
+
+private:
+    /**
+     * @struct Punto
+     * @brief Punto proyectado sobre la esfera unitaria.
+     */
+    struct Punto {
+        double coord[3];  ///< Coordenadas x, y, z
+        size_t posicion;  ///< Posición en el vector de coordenadas original
+    };
+
+    std::vector<Punto> puntos;  ///< Árbol implícito
+    std::vector<uint8_t> ejes;  ///< Eje de corte de cada nodo (el de mayor extensión de su rango)
+    double radio_km;            ///< Radio de la esfera
+
+    /**
+     * @brief Ordena recursivamente un rango para que su mediana quede en el centro.
+     */
+    void construirRango(size_t inicio, size_t fin);
+    /**
+     * @brief Búsqueda recursiva de los k más cercanos (cuerda al cuadrado en el montículo).
+     */
+    void buscarVecinos(size_t inicio, size_t fin, const double consulta[3], size_t k,
+                       std::vector<std::pair<double, size_t>>& monticulo) const;
+    /**
+     * @brief Búsqueda recursiva de los puntos dentro de una cuerda máxima al cuadrado.
+     */
+    void buscarRadio(size_t inicio, size_t fin, const double consulta[3], double limite,
+                     std::vector<std::pair<double, size_t>>& encontrados) const;
+    /**
+     * @brief Proyecta latitud y longitud (grados) sobre la esfera unitaria.
+     */
+    static void proyectar(double latitud, double longitud, double destino[3]);
+    /**
+     * @brief Distancia al cuadrado entre dos puntos proyectados.
+     */
+    static double cuerdaCuadrada(const double a[3], const double b[3]);
+    /**
+     * @brief Convierte una cuerda al cuadrado en kilómetros sobre la superficie.
+     */
+    double kilometros(double cuerda_cuadrada) const;
+};
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * @file IndiceTrigramas.cpp
+ * @brief Implementación del índice invertido de trigramas para búsqueda por subcadena.
+ */
+
+#include "IndiceTrigramas.h"
+#include "IndiceClientes.h"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+/**
+ * @brief Constructor de IndiceTrigramas.
+ * @param _campos Funciones que obtienen cada campo a indexar del cliente
+ */
+IndiceTrigramas::IndiceTrigramas(std::vector<std::function<std::string(Cliente*)>> _campos)
+    : campos(_campos), textos(_campos.size()) {
+    if (campos.size() > 256) throw std::invalid_argument("Demasiados campos para el índice de trigramas");
+}
+
+/**
+ * @brief Empaqueta el campo y tres caracteres consecutivos en un entero.
+ * @param campo Posición del campo
+ * @param texto Texto normalizado
+ * @param pos Posición del primer carácter
+ * @return Trigrama empaquetado (campo en los 8 bits altos)
+ */
+uint32_t IndiceTrigramas::trigrama(int campo, const std::string& texto, size_t pos) {
+    return ((uint32_t)campo << 24) |
+           ((uint32_t)(unsigned char)texto[pos] << 16) |
+           ((uint32_t)(unsigned char)texto[pos + 1] << 8) |
+           (uint32_t)(unsigned char)texto[pos + 2];
+}
+
+/**
+ * @brief Reconstruye el índice a partir de una lista de clientes.
+ * @param lista Lista de clientes
+ */
+void IndiceTrigramas::reconstruir(const ListaDoble<Cliente*>& lista) {
+    limpiar();
+    clientes.reserve(lista.getTam());
+    for (auto& t : textos) t.reserve(lista.getTam());
+    lista.recorrer([this](Cliente* c) { insertar(c); });
+}
+
+/**
+ * @brief Agrega un cliente al índice.
+ * @param cliente Puntero al cliente
+ */
+void IndiceTrigramas::insertar(Cliente* cliente) {
+    if (!cliente || ids.count(cliente)) return;
+    uint32_t id = (uint32_t)clientes.size();
+    clientes.push_back(cliente);
+    ids[cliente] = id;
+
+    std::vector<uint32_t> propios;
+    for (size_t campo = 0; campo < campos.size(); campo++) {
+        std::string texto = IndiceClientes::normalizar(campos[campo](cliente));
+        for (size_t i = 0; i + 3 <= texto.size(); i++) {
+            propios.push_back(trigrama((int)campo, texto, i));
+        }
+        textos[campo].push_back(std::move(texto));
+    }
+    // Un mismo trigrama repetido en el texto solo se agrega una vez a su lista
+    std::sort(propios.begin(), propios.end());
+    propios.erase(std::unique(propios.begin(), propios.end()), propios.end());
+    for (uint32_t t : propios) {
+        listas[t].push_back(id);
+    }
+}
+
+/**
+ * @brief Marca un cliente como eliminado; deja de aparecer en las búsquedas.
+ * @param cliente Puntero al cliente
+ */
+void IndiceTrigramas::eliminar(Cliente* cliente) {
+    auto it = ids.find(cliente);
+    if (it == ids.end()) return;
+    clientes[it->second] = nullptr;
+    for (auto& t : textos) t[it->second].clear();
+    ids.erase(it);
+}
+
+/**
+ * @brief Vacía el índice.
+ */
+void IndiceTrigramas::limpiar() {
+    clientes.clear();
+    for (auto& t : textos) t.clear();
+    ids.clear();
+    listas.clear();
+}
+
+/**
+ * @brief Obtiene el cliente asociado a un identificador interno.
+ * @param id Identificador interno
+ * @return Puntero al cliente, nullptr si fue eliminado
+ */
+Cliente* IndiceTrigramas::getCliente(uint32_t id) const {
+    return (id < clientes.size()) ? clientes[id] : nullptr;
+}
+
+/**
+ * @brief Busca los identificadores internos de los clientes cuyo campo contiene el texto dado.
+ * @param campo Posición del campo en el constructor
+ * @param texto Subcadena a buscar
+ * @return Identificadores encontrados, en orden creciente
+ */
+std::vector<uint32_t> IndiceTrigramas::buscarIds(int campo, const std::string& texto) const {
+    if (campo < 0 || campo >= (int)campos.size()) throw std::invalid_argument("Campo de índice inválido");
+    std::vector<uint32_t> resultado;
+    std::string consulta = IndiceClientes::normalizar(texto);
+    if (consulta.empty()) return resultado;
+    const std::vector<std::string>& textosCampo = textos[campo];
+
+    // Consultas de menos de tres caracteres no tienen trigramas: se revisan los textos ya normalizados
+    if (consulta.size() < 3) {
+        for (uint32_t id = 0; id < textosCampo.size(); id++) {
+            if (clientes[id] && textosCampo[id].find(consulta) != std::string::npos) resultado.push_back(id);
+        }
+        return resultado;
+    }
+
+    // Reunir las listas de los trigramas de la consulta, empezando por la más corta
+    std::vector<const std::vector<uint32_t>*> candidatas;
+    for (size_t i = 0; i + 3 <= consulta.size(); i++) {
+        auto it = listas.find(trigrama(campo, consulta, i));
+        if (it == listas.end()) return resultado;
+        candidatas.push_back(&it->second);
+    }
+    std::sort(candidatas.begin(), candidatas.end(),
+              [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return a->size() < b->size(); });
+
+    resultado = *candidatas[0];
+    std::vector<uint32_t> interseccion;
+    for (size_t i = 1; i < candidatas.size() && !resultado.empty(); i++) {
+        interseccion.clear();
+        std::set_intersection(resultado.begin(), resultado.end(),
+                              candidatas[i]->begin(), candidatas[i]->end(),
+                              std::back_inserter(interseccion));
+        resultado.swap(interseccion);
+    }
+
+    // Confirmar la subcadena completa: los trigramas pueden coincidir en posiciones distintas
+    resultado.erase(std::remove_if(resultado.begin(), resultado.end(), [&](uint32_t id) {
+        return !clientes[id] || textosCampo[id].find(consulta) == std::string::npos;
+    }), resultado.end());
+    return resultado;
+}
+
+/**
+ * @brief Busca los clientes cuyo campo contiene el texto dado (sin distinguir mayúsculas).
+ * @param campo Posición del campo en el constructor
+ * @param texto Subcadena a buscar
+ * @return Clientes encontrados, en orden de inserción
+ */
+std::vector<Cliente*> IndiceTrigramas::buscar(int campo, const std::string& texto) const {
+    std::vector<Cliente*> resultado;
+    for (uint32_t id : buscarIds(campo, texto)) {
+        resultado.push_back(clientes[id]);
+    }
+    return resultado;
+}
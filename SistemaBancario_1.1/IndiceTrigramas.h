@@ -0,0 +1,92 @@
+/**
+ * @file IndiceTrigramas.h
+ * @brief Definición de la clase IndiceTrigramas, índice invertido de trigramas para búsqueda por subcadena.
+ *
+ * Indexa uno o más campos de texto de los clientes (nombres, apellidos) normalizados a minúsculas, y responde
+ * búsquedas de subcadenas intersecando las listas de clientes de cada trigrama de la consulta.
+ */
+
+#ifndef INDICETRIGRAMAS_H_INCLUDED
+#define INDICETRIGRAMAS_H_INCLUDED
+
+#include "Cliente.h"
+#include "ListaDoble.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+
+/**
+ * @class IndiceTrigramas
+ * @brief Índice invertido de trigramas sobre campos de texto de los clientes.
+ *
+ * Cada cliente recibe un identificador interno creciente, por lo que las listas de cada trigrama
+ * quedan ordenadas al insertar y se intersecan en tiempo lineal. Los candidatos se confirman contra
+ * el texto normalizado guardado, sin volver a convertir el campo del cliente en cada consulta.
+ */
+class IndiceTrigramas {
+public:
+    /**
+     * @brief Constructor de IndiceTrigramas.
+     * @param campos Funciones que obtienen cada campo a indexar del cliente (máximo 256)
+     */
+    explicit IndiceTrigramas(std::vector<std::function<std::string(Cliente*)>> campos);
+    /**
+     * @brief Reconstruye el índice a partir de una lista de clientes.
+     * @param clientes Lista de clientes
+     */
+    void reconstruir(const ListaDoble<Cliente*>& clientes);
+    /**
+     * @brief Agrega un cliente al índice.
+     * @param cliente Puntero al cliente
+     */
+    void insertar(Cliente* cliente);
+    /**
+     * @brief Marca un cliente como eliminado; deja de aparecer en las búsquedas.
+     * @param cliente Puntero al cliente
+     */
+    void eliminar(Cliente* cliente);
+    /**
+     * @brief Vacía el índice.
+     */
+    void limpiar();
+    /**
+     * @brief Busca los clientes cuyo campo contiene el texto dado (sin distinguir mayúsculas).
+     * @param campo Posición del campo en el constructor
+     * @param texto Subcadena a buscar
+     * @return Clientes encontrados, en orden de inserción
+     */
+    std::vector<Cliente*> buscar(int campo, const std::string& texto) const;
+    /**
+     * @brief Busca los identificadores internos de los clientes cuyo campo contiene el texto dado.
+     * @param campo Posición del campo en el constructor
+     * @param texto Subcadena a buscar
+     * @return Identificadores encontrados, en orden creciente (comunes a todos los campos)
+     */
+    std::vector<uint32_t> buscarIds(int campo, const std::string& texto) const;
+    /**
+     * @brief Obtiene el cliente asociado a un identificador interno.
+     * @param id Identificador interno
+     * @return Puntero al cliente, nullptr si fue eliminado
+     */
+    Cliente* getCliente(uint32_t id) const;
+
+private:
+    std::vector<std::function<std::string(Cliente*)>> campos; ///< Obtienen cada campo indexado
+    std::vector<Cliente*> clientes; ///< Cliente por identificador interno (nullptr si fue eliminado)
+    std::vector<std::vector<std::string>> textos; ///< Texto normalizado por campo e identificador interno
+    std::unordered_map<Cliente*, uint32_t> ids; ///< Identificador interno por cliente
+    std::unordered_map<uint32_t, std::vector<uint32_t>> listas; ///< (campo, trigrama) -> identificadores que lo contienen
+
+    /**
+     * @brief Empaqueta el campo y tres caracteres consecutivos en un entero.
+     * @param campo Posición del campo
+     * @param texto Texto normalizado
+     * @param pos Posición del primer carácter
+     * @return Trigrama empaquetado (campo en los 8 bits altos)
+     */
+    static uint32_t trigrama(int campo, const std::string& texto, size_t pos);
+};
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file LectorBinario.cpp
+ * @brief Implementación de la lectura acotada de archivos binarios de clientes.
+ */
+
+#include "LectorBinario.h"
+#include <algorithm>
+#include <stdexcept>
+
+const size_t LectorBinario::MAX_CADENA;
+
+/**
+ * @brief Posición actual de un archivo, sin el límite de 2 GB de ftell en Windows.
+ */
+int64_t LectorBinario::posicionDe(FILE* archivo) {
+#ifdef _WIN32
+    return _ftelli64(archivo);
+#else
+    return static_cast<int64_t>(ftello(archivo));
+#endif
+}
+
+/**
+ * @brief Mueve un archivo a una posición, sin el límite de 2 GB de fseek en Windows.
+ */
+int LectorBinario::posicionar(FILE* archivo, int64_t posicion, int origen) {
+#ifdef _WIN32
+    return _fseeki64(archivo, posicion, origen);
+#else
+    return fseeko(archivo, static_cast<off_t>(posicion), origen);
+#endif
+}
+
+/**
+ * @brief Constructor. Lee desde la posición actual del archivo hasta su final, o hasta el límite.
+ */
+LectorBinario::LectorBinario(FILE* archivo, size_t capacidad, uint64_t limite)
+    : archivo(archivo), inicio(0), total(0), consumido(0),
+      buffer(std::max(capacidad, MAX_CADENA + 1)), pos(0), lleno(0), descartados(0) {
+    if (!archivo) throw std::runtime_error("Archivo no válido para lectura");
+    inicio = posicionDe(archivo);
+    if (inicio >= 0 && posicionar(archivo, 0, SEEK_END) == 0) {
+        int64_t final = posicionDe(archivo);
+        if (final > inicio) total = std::min(static_cast<uint64_t>(final - inicio), limite);
+    }
+    posicionar(archivo, inicio < 0 ? 0 : inicio, SEEK_SET);
+}
+
+/**
+ * @brief Destructor. Deja el archivo en la posición lógica del lector, no en la del último bloque.
+ */
+LectorBinario::~LectorBinario() {
+    if (inicio >= 0) posicionar(archivo, inicio + static_cast<int64_t>(consumido), SEEK_SET);
+}
+
+/**
+ * @brief Garantiza que haya n bytes contiguos en el búfer o lanza un error de lectura.
+ * @details Si faltan, mueve lo pendiente al principio del búfer y lee un bloque más.
+ */
+void LectorBinario::asegurar(size_t n, const char* campo) {
+    if (lleno - pos >= n) return;
+    if (getRestante() < n) error(campo, "fin de archivo inesperado");
+    if (n > buffer.size()) error(campo, "registro demasiado grande");
+
+    size_t pendientes = lleno - pos;
+    std::memmove(buffer.data(), buffer.data() + pos, pendientes);
+    pos = 0;
+    lleno = pendientes;
+    // No se lee más allá del límite: con varios lectores sobre un archivo, cada uno lee solo su tramo
+    size_t maximo = static_cast<size_t>(std::min<uint64_t>(buffer.size(), getRestante()));
+    while (lleno < n) {
+        size_t leidos = fread(buffer.data() + lleno, 1, maximo - lleno, archivo);
+        if (leidos == 0) error(campo, "fin de archivo inesperado");
+        lleno += leidos;
+    }
+}
+
+/**
+ * @brief Consume n bytes ya disponibles en el búfer.
+ */
+void LectorBinario::avanzar(size_t n) {
+    pos += n;
+    consumido += n;
+}
+
+/**
+ * @brief Omite bytes sin leerlos.
+ * @details Si los bytes no están en el búfer se descarta y el archivo se posiciona después de ellos.
+ */
+void LectorBinario::saltar(uint64_t n, const char* campo) {
+    if (n > getRestante()) error(campo, "fin de archivo inesperado");
+    if (n <= lleno - pos) {
+        avanzar(static_cast<size_t>(n));
+        return;
+    }
+    consumido += n;
+    pos = lleno = 0;
+    if (posicionar(archivo, static_cast<int64_t>(getPosicionArchivo()), SEEK_SET) != 0) error(campo, "posición inválida");
+}
+
+/**
+ * @brief Lanza el error de lectura de un campo con la posición actual.
+ */
+void LectorBinario::error(const char* campo, const char* detalle) const {
+    throw std::runtime_error(std::string("Error al leer ") + campo + " (" + detalle + ", byte " +
+                             std::to_string(getPosicionArchivo()) + ")");
+}
+
+/**
+ * @brief Lee una cadena precedida por su longitud (size_t).
+ * @details La longitud se valida contra el máximo y contra lo que queda del archivo antes de copiar;
+ *          el contenido se toma directamente del búfer, sin reservas intermedias.
+ */
+void LectorBinario::leerCadena(std::string& destino, const char* campo, size_t maximo, bool terminada_en_nulo) {
+    size_t longitud = 0;
+    leer(longitud, campo);
+    if (longitud > maximo) error(campo, "longitud fuera de rango");
+    size_t bytes = longitud + (terminada_en_nulo ? 1 : 0);
+    asegurar(bytes, campo);
+    const char* datos = buffer.data() + pos;
+    if (terminada_en_nulo && datos[longitud] != '\0') error(campo, "cadena sin terminador");
+    destino.assign(datos, longitud);
+    avanzar(bytes);
+}
+
+/**
+ * @brief Lee una cantidad de registros (int) y la valida.
+ */
+int LectorBinario::leerCantidad(const char* campo, size_t tamanio_minimo) {
+    int cantidad = 0;
+    leer(cantidad, campo);
+    if (cantidad < 0) error(campo, "cantidad negativa");
+    if (tamanio_minimo > 0 && static_cast<uint64_t>(cantidad) > getRestante() / tamanio_minimo) {
+        error(campo, "cantidad mayor que los datos restantes");
+    }
+    return cantidad;
+}
+
+/**
+ * @brief Indica si ya no quedan bytes por leer.
+ */
+bool LectorBinario::fin() const {
+    return getRestante() == 0;
+}
+
+/**
+ * @brief Bytes que quedan por leer.
+ */
+uint64_t LectorBinario::getRestante() const {
+    return total - consumido;
+}
+
+/**
+ * @brief Bytes leídos desde el inicio del lector.
+ */
+uint64_t LectorBinario::getPosicion() const {
+    return consumido;
+}
+
+/**
+ * @brief Posición del siguiente byte dentro del archivo.
+ */
+uint64_t LectorBinario::getPosicionArchivo() const {
+    return static_cast<uint64_t>(inicio > 0 ? inicio : 0) + consumido;
+}
+
+/**
+ * @brief Anota un registro bien formado que se omitió por tener valores inválidos.
+ */
+void LectorBinario::descartar(const std::string& motivo) {
+    descartados++;
+    ultimo_descarte = motivo;
+}
+
+/**
+ * @brief Cantidad de registros omitidos.
+ */
+size_t LectorBinario::getDescartados() const {
+    return descartados;
+}
+
+/**
+ * @brief Motivo del último registro omitido.
+ */
+const std::string& LectorBinario::getUltimoDescarte() const {
+    return ultimo_descarte;
+}
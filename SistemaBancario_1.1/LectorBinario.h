@@ -0,0 +1,164 @@
+/**
+ * @file LectorBinario.h
+ * @brief Definición de la clase LectorBinario, lectura acotada de archivos binarios de clientes.
+ *
+ * Los archivos de datos y de respaldo guardan cadenas precedidas por su longitud y listas precedidas
+ * por su cantidad. Antes de reservar memoria o iterar, el lector compara esos valores con un máximo y
+ * con los bytes que quedan en el archivo, así un archivo dañado o manipulado produce un error y nunca
+ * una reserva de varios GB. Los datos se leen por bloques a un búfer que se reutiliza.
+ */
+
+#ifndef LECTORBINARIO_H_INCLUDED
+#define LECTORBINARIO_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @class LectorBinario
+ * @brief Cursor con límites sobre un FILE* abierto en modo binario.
+ *
+ * Los errores de estructura (archivo truncado, longitud o cantidad imposibles) se lanzan como
+ * std::runtime_error con el nombre del campo y la posición, en el mismo estilo que los mensajes
+ * de cargar_binario. Los registros bien formados pero con valores inválidos no son un error del
+ * lector: quien decodifica los omite y los anota con descartar().
+ */
+class LectorBinario {
+public:
+    static const size_t MAX_CADENA = 4096; ///< Longitud máxima por defecto de una cadena
+
+    /**
+     * @brief Constructor. Lee desde la posición actual del archivo hasta su final.
+     * @param archivo Archivo abierto en modo binario de lectura
+     * @param capacidad Tamaño del búfer de lectura (al menos MAX_CADENA + 1)
+     * @param limite Bytes como máximo que se leen desde la posición actual
+     */
+    explicit LectorBinario(FILE* archivo, size_t capacidad = 1 << 16, uint64_t limite = UINT64_MAX);
+    /**
+     * @brief Destructor. Deja el archivo en la posición lógica del lector, no en la del último bloque.
+     */
+    ~LectorBinario();
+    LectorBinario(const LectorBinario&) = delete;
+    LectorBinario& operator=(const LectorBinario&) = delete;
+
+    /**
+     * @brief Posición actual de un archivo en 64 bits (ftell usa long, de 32 bits en Windows).
+     * @return Posición, o -1 si no se pudo obtener
+     */
+    static int64_t posicionDe(FILE* archivo);
+    /**
+     * @brief fseek con posiciones de 64 bits, para archivos de más de 2 GB.
+     * @return 0 si se pudo posicionar
+     */
+    static int posicionar(FILE* archivo, int64_t posicion, int origen = SEEK_SET);
+
+    /**
+     * @brief Lee un valor de tamaño fijo tal como se escribió con fwrite.
+     * @param valor Destino
+     * @param campo Nombre del campo para el mensaje de error
+     */
+    template <typename T>
+    void leer(T& valor, const char* campo) {
+        asegurar(sizeof(T), campo);
+        std::memcpy(static_cast<void*>(&valor), buffer.data() + pos, sizeof(T));
+        avanzar(sizeof(T));
+    }
+
+    /**
+     * @brief Lee un valor de tamaño fijo sin consumirlo.
+     * @param valor Destino
+     * @return false si no quedan bytes suficientes
+     */
+    template <typename T>
+    bool espiar(T& valor) {
+        if (getRestante() < sizeof(T)) return false;
+        asegurar(sizeof(T), "cabecera");
+        std::memcpy(static_cast<void*>(&valor), buffer.data() + pos, sizeof(T));
+        return true;
+    }
+
+    /**
+     * @brief Lee una cadena precedida por su longitud (size_t).
+     * @param destino Cadena donde se copia el contenido
+     * @param campo Nombre del campo para el mensaje de error
+     * @param maximo Longitud máxima aceptada
+     * @param terminada_en_nulo true si se escribió con su '\0' final (formato de datos.txt)
+     */
+    void leerCadena(std::string& destino, const char* campo, size_t maximo = MAX_CADENA, bool terminada_en_nulo = false);
+
+    /**
+     * @brief Omite bytes sin leerlos, por ejemplo un historial que se leerá después.
+     * @param n Cantidad de bytes
+     * @param campo Nombre del campo para el mensaje de error
+     */
+    void saltar(uint64_t n, const char* campo);
+
+    /**
+     * @brief Lee una cantidad de registros (int) y la valida.
+     * @param campo Nombre del campo para el mensaje de error
+     * @param tamanio_minimo Bytes que ocupa como mínimo cada registro
+     * @return Cantidad, no negativa y que cabe en lo que queda del archivo
+     */
+    int leerCantidad(const char* campo, size_t tamanio_minimo);
+
+    /**
+     * @brief Indica si ya no quedan bytes por leer.
+     */
+    bool fin() const;
+    /**
+     * @brief Bytes que quedan por leer.
+     */
+    uint64_t getRestante() const;
+    /**
+     * @brief Bytes leídos desde el inicio del lector.
+     */
+    uint64_t getPosicion() const;
+    /**
+     * @brief Posición del siguiente byte dentro del archivo.
+     */
+    uint64_t getPosicionArchivo() const;
+
+    /**
+     * @brief Anota un registro bien formado que se omitió por tener valores inválidos.
+     * @param motivo Descripción del registro y del problema
+     */
+    void descartar(const std::string& motivo);
+    /**
+     * @brief Cantidad de registros omitidos.
+     */
+    size_t getDescartados() const;
+    /**
+     * @brief Motivo del último registro omitido.
+     */
+    const std::string& getUltimoDescarte() const;
+
+private:
+    FILE* archivo;             ///< Archivo de origen
+    int64_t inicio;            ///< Posición del archivo al crear el lector
+    uint64_t total;            ///< Bytes disponibles desde inicio
+    uint64_t consumido;        ///< Bytes entregados por el lector
+    std::vector<char> buffer;  ///< Búfer reutilizado para todas las lecturas
+    size_t pos;                ///< Siguiente byte del búfer
+    size_t lleno;              ///< Bytes válidos en el búfer
+    size_t descartados;        ///< Registros omitidos
+    std::string ultimo_descarte; ///< Motivo del último registro omitido
+
+    /**
+     * @brief Garantiza que haya n bytes contiguos en el búfer o lanza un error de lectura.
+     */
+    void asegurar(size_t n, const char* campo);
+    /**
+     * @brief Consume n bytes ya disponibles en el búfer.
+     */
+    void avanzar(size_t n);
+    /**
+     * @brief Lanza el error de lectura de un campo con la posición actual.
+     */
+    [[noreturn]] void error(const char* campo, const char* detalle) const;
+};
+
+#endif
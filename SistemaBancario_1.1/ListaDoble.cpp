@@ -312,6 +312,28 @@ void ListaDoble<T>::limpiar_sin_eliminar() {
     }
 }
 
+/**
+ * @brief Mueve todos los nodos de otra lista al final de esta, sin copiar valores.
+ * @param otra Lista cuyos nodos se agregan; queda vacía.
+ * @details Solo se enlazan los extremos de las dos listas circulares, así que el costo es constante.
+ */
+template <typename T>
+void ListaDoble<T>::concatenar(ListaDoble<T>& otra) {
+    if (&otra == this || otra.esta_vacia()) return;
+    if (esta_vacia()) {
+        cabeza = otra.cabeza;
+        cola = otra.cola;
+    } else {
+        cola->set_siguiente(otra.cabeza);
+        otra.cabeza->set_anterior(cola);
+        otra.cola->set_siguiente(cabeza);
+        cabeza->set_anterior(otra.cola);
+        cola = otra.cola;
+    }
+    otra.cabeza = nullptr;
+    otra.cola = nullptr;
+}
+
 // Instanciaciones explícitas
 template class ListaDoble<int>;
 template class ListaDoble<double>;
@@ -118,6 +118,11 @@ public:
      * Útil cuando los elementos son manejados externamente.
      */
     void limpiar_sin_eliminar();
+    /**
+     * @brief Mueve todos los nodos de otra lista al final de esta, sin copiar valores.
+     * @param otra Lista cuyos nodos se agregan; queda vacía.
+     */
+    void concatenar(ListaDoble<T>& otra);
 private:
     /**
      * @brief Puntero al nodo cabeza de la lista.
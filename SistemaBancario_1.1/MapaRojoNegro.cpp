@@ -0,0 +1,619 @@
+/**
+ * @file MapaRojoNegro.cpp
+ * @brief Implementación de la clase template MapaRojoNegro.
+ *
+ * Inserción y eliminación siguen el esquema clásico con centinela NIL: rotaciones, recoloreo y
+ * trasplante de subárboles. Los nodos libres se reciclan a través de una lista enlazada por el campo padre.
+ */
+
+#include "MapaRojoNegro.h"
+#include "IndiceClientes.h"
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Constructor por defecto. Crea un mapa vacío.
+ */
+template <typename K, typename V, typename Comparar>
+MapaRojoNegro<K, V, Comparar>::MapaRojoNegro() {
+    nil = &centinela;
+    nil->izquierdo = nil->derecho = nil->padre = nil;
+    nil->color = NEGRO;
+    nil->tam_subarbol = 0;
+    raiz = nil;
+    tam = 0;
+    libres = nullptr;
+    usados = NODOS_POR_BLOQUE;
+}
+
+/**
+ * @brief Destructor. Libera los bloques del pool de nodos.
+ */
+template <typename K, typename V, typename Comparar>
+MapaRojoNegro<K, V, Comparar>::~MapaRojoNegro() {
+    for (Nodo* bloque : bloques) delete[] bloque;
+}
+
+/**
+ * @brief Toma un nodo del pool (reutilizando uno libre si existe).
+ * @param clave Clave del nodo
+ * @param valor Valor del nodo
+ * @return Nodo rojo sin hijos
+ */
+template <typename K, typename V, typename Comparar>
+typename MapaRojoNegro<K, V, Comparar>::Nodo* MapaRojoNegro<K, V, Comparar>::crearNodo(const K& clave, const V& valor) {
+    Nodo* nodo;
+    if (libres) {
+        nodo = libres;
+        libres = libres->padre;
+    } else {
+        if (usados == NODOS_POR_BLOQUE) {
+            bloques.push_back(new Nodo[NODOS_POR_BLOQUE]);
+            usados = 0;
+        }
+        nodo = &bloques.back()[usados++];
+    }
+    nodo->clave = clave;
+    nodo->valor = valor;
+    nodo->izquierdo = nodo->derecho = nodo->padre = nil;
+    nodo->color = ROJO;
+    nodo->tam_subarbol = 1;
+    return nodo;
+}
+
+/**
+ * @brief Devuelve un nodo al pool.
+ * @param nodo Nodo a liberar
+ */
+template <typename K, typename V, typename Comparar>
+void MapaRojoNegro<K, V, Comparar>::liberarNodo(Nodo* nodo) {
+    nodo->clave = K();
+    nodo->valor = V();
+    nodo->padre = libres;
+    libres = nodo;
+}
+
+/**
+ * @brief Recalcula el tamaño del subárbol de un nodo a partir de sus hijos.
+ */
+template <typename K, typename V, typename Comparar>
+void MapaRojoNegro<K, V, Comparar>::actualizarTam(Nodo* nodo) {
+    nodo->tam_subarbol = nodo->izquierdo->tam_subarbol + nodo->derecho->tam_subarbol + 1;
+}
+
+/**
+ * @brief Rotación a la izquierda sobre x.
+ */
+template <typename K, typename V, typename Comparar>
+void MapaRojoNegro<K, V, Comparar>::rotarIzquierda(Nodo* x) {
+    Nodo* y = x->derecho;
+    x->derecho = y->izquierdo;
+    if (y->izquierdo != nil) y->izquierdo->padre = x;
+    y->padre = x->padre;
+    if (x->padre == nil) raiz = y;
+    else if (x == x->padre->izquierdo) x->padre->izquierdo = y;
+    else x->padre->derecho = y;
+    y->izquierdo = x;
+    x->padre = y;
+    y->tam_subarbol = x->tam_subarbol;
+    actualizarTam(x);
+}
+
+/**
+ * @brief Rotación a la derecha sobre y.
+ */
+template <typename K, typename V, typename Comparar>
+void MapaRojoNegro<K, V, Comparar>::rotarDerecha(Nodo* y) {
+    Nodo* x = y->izquierdo;
+    y->izquierdo = x->derecho;
+    if (x->derecho != nil) x->derecho->padre = y;
+    x->padre = y->padre;
+    if (y->padre == nil) raiz = x;
+    else if (y == y->padre->izquierdo) y->padre->izquierdo = x;
+    else y->padre->derecho = x;
+    x->derecho = y;
+    y->padre = x;
+    x->tam_subarbol = y->tam_subarbol;
+    actualizarTam(y);
+}
+
+/**
+ * @brief Corrige las propiedades Rojo-Negro después de insertar z.
+ */
+template <typename K, typename V, typename Comparar>
+void MapaRojoNegro<K, V, Comparar>::arreglarInsercion(Nodo* z) {
+    while (z->padre->color == ROJO) {
+        if (z->padre == z->padre->padre->izquierdo) {
+            Nodo* tio = z->padre->padre->derecho;
+            if (tio->color == ROJO) {
+                // Caso 1: el tío es rojo
+                z->padre->color = NEGRO;
+                tio->color = NEGRO;
+                z->padre->padre->color = ROJO;
+                z = z->padre->padre;
+            } else {
+                if (z == z->padre->derecho) {
+                    // Caso 2: el tío es negro y z es hijo derecho
+                    z = z->padre;
+                    rotarIzquierda(z);
+                }
+                // Caso 3: el tío es negro y z es hijo izquierdo
+                z->padre->color = NEGRO;
+                z->padre->padre->color = ROJO;
+                rotarDerecha(z->padre->padre);
+            }
+        } else {
+            Nodo* tio = z->padre->padre->izquierdo;
+            if (tio->color == ROJO) {
+                z->padre->color = NEGRO;
+                tio->color = NEGRO;
+                z->padre->padre->color = ROJO;
+                z = z->padre->padre;
+            } else {
+                if (z == z->padre->izquierdo) {
+                    z = z->padre;
+                    rotarDerecha(z);
+                }
+                z->padre->color = NEGRO;
+                z->padre->padre->color = ROJO;
+                rotarIzquierda(z->padre->padre);
+            }
+        }
+    }
+    raiz->color = NEGRO;
+}
+
+/**
+ * @brief Inserta un par (clave, valor). Las claves repetidas se ubican después de las existentes.
+ * @param clave Clave del elemento
+ * @param valor Valor del elemento
+ */
+template <typename K, typename V, typename Comparar>
+void MapaRojoNegro<K, V, Comparar>::insertar(const K& clave, const V& valor) {
+    Nodo* z = crearNodo(clave, valor);
+    Nodo* y = nil;
+    Nodo* x = raiz;
+    bool izquierda = false;
+    while (x != nil) {
+        y = x;
+        x->tam_subarbol++;
+        izquierda = comparar(clave, x->clave);
+        x = izquierda ? x->izquierdo : x->derecho;
+    }
+    z->padre = y;
+    if (y == nil) raiz = z;
+    else if (izquierda) y->izquierdo = z;
+    else y->derecho = z;
+    tam++;
+    arreglarInsercion(z);
+}
+
+/**
+ * @brief Reemplaza el subárbol u por el subárbol v.
+ */
+template <typename K, typename V, typename Comparar>
+void MapaRojoNegro<K, V, Comparar>::trasplantar(Nodo* u, Nodo* v) {
+    if (u->padre == nil) raiz = v;
+    else if (u == u->padre->izquierdo) u->padre->izquierdo = v;
+    else u->padre->derecho = v;
+    v->padre = u->padre;
+}
+
+/**
+ * @brief Corrige las propiedades Rojo-Negro después de eliminar un nodo negro.
+ * @param x Nodo que ocupó el lugar del eliminado (puede ser el centinela)
+ */
+template <typename K, typename V, typename Comparar>
+void MapaRojoNegro<K, V, Comparar>::arreglarEliminacion(Nodo* x) {
+    while (x != raiz && x->color == NEGRO) {
+        if (x == x->padre->izquierdo) {
+            Nodo* w = x->padre->derecho;
+            if (w->color == ROJO) {
+                w->color = NEGRO;
+                x->padre->color = ROJO;
+                rotarIzquierda(x->padre);
+                w = x->padre->derecho;
+            }
+            if (w->izquierdo->color == NEGRO && w->derecho->color == NEGRO) {
+                w->color = ROJO;
+                x = x->padre;
+            } else {
+                if (w->derecho->color == NEGRO) {
+                    w->izquierdo->color = NEGRO;
+                    w->color = ROJO;
+                    rotarDerecha(w);
+                    w = x->padre->derecho;
+                }
+                w->color = x->padre->color;
+                x->padre->color = NEGRO;
+                w->derecho->color = NEGRO;
+                rotarIzquierda(x->padre);
+                x = raiz;
+            }
+        } else {
+            Nodo* w = x->padre->izquierdo;
+            if (w->color == ROJO) {
+                w->color = NEGRO;
+                x->padre->color = ROJO;
+                rotarDerecha(x->padre);
+                w = x->padre->izquierdo;
+            }
+            if (w->derecho->color == NEGRO && w->izquierdo->color == NEGRO) {
+                w->color = ROJO;
+                x = x->padre;
+            } else {
+                if (w->izquierdo->color == NEGRO) {
+                    w->derecho->color = NEGRO;
+                    w->color = ROJO;
+                    rotarIzquierda(w);
+                    w = x->padre->izquierdo;
+                }
+                w->color = x->padre->color;
+                x->padre->color = NEGRO;
+                w->izquierdo->color = NEGRO;
+                rotarDerecha(x->padre);
+                x = raiz;
+            }
+        }
+    }
+    x->color = NEGRO;
+}
+
+/**
+ * @brief Elimina el primer par cuya clave y valor coinciden.
+ * @param clave Clave del elemento
+ * @param valor Valor del elemento
+ * @return true si se eliminó, false si no existía
+ */
+template <typename K, typename V, typename Comparar>
+bool MapaRojoNegro<K, V, Comparar>::eliminar(const K& clave, const V& valor) {
+    Nodo* z = primerNoMenor(clave);
+    while (z != nil && !comparar(clave, z->clave) && !(z->valor == valor)) {
+        z = sucesor(z);
+    }
+    if (z == nil || comparar(clave, z->clave)) return false;
+
+    // Todos los ancestros del nodo que sale físicamente de su posición pierden un elemento
+    Nodo* quitado = (z->izquierdo != nil && z->derecho != nil) ? minimo(z->derecho) : z;
+    for (Nodo* p = quitado->padre; p != nil; p = p->padre) {
+        p->tam_subarbol--;
+    }
+
+    Nodo* y = z;
+    ColorNodo color_original = y->color;
+    Nodo* x;
+    if (z->izquierdo == nil) {
+        x = z->derecho;
+        trasplantar(z, z->derecho);
+    } else if (z->derecho == nil) {
+        x = z->izquierdo;
+        trasplantar(z, z->izquierdo);
+    } else {
+        y = minimo(z->derecho);
+        color_original = y->color;
+        x = y->derecho;
+        if (y->padre == z) {
+            x->padre = y;
+        } else {
+            trasplantar(y, y->derecho);
+            y->derecho = z->derecho;
+            y->derecho->padre = y;
+        }
+        trasplantar(z, y);
+        y->izquierdo = z->izquierdo;
+        y->izquierdo->padre = y;
+        y->color = z->color;
+        y->tam_subarbol = z->tam_subarbol;
+    }
+    if (color_original == NEGRO) arreglarEliminacion(x);
+    // El centinela pudo recibir un padre durante el ajuste; se deja en estado neutro
+    nil->padre = nil;
+    liberarNodo(z);
+    tam--;
+    return true;
+}
+
+/**
+ * @brief Elimina todos los elementos y devuelve la memoria del pool.
+ */
+template <typename K, typename V, typename Comparar>
+void MapaRojoNegro<K, V, Comparar>::limpiar() {
+    for (Nodo* bloque : bloques) delete[] bloque;
+    bloques.clear();
+    libres = nullptr;
+    usados = NODOS_POR_BLOQUE;
+    raiz = nil;
+    tam = 0;
+}
+
+/**
+ * @brief Construye recursivamente un subárbol balanceado con los elementos [ini, fin).
+ * @param profundidad Profundidad del nodo a crear (la raíz tiene 0)
+ * @param profundidad_roja Profundidad del último nivel incompleto, cuyos nodos se pintan de rojo (-1 si no hay)
+ * @param padre Padre del subárbol
+ * @return Raíz del subárbol, o el centinela si el rango está vacío
+ */
+template <typename K, typename V, typename Comparar>
+typename MapaRojoNegro<K, V, Comparar>::Nodo* MapaRojoNegro<K, V, Comparar>::construirRango(
+        const std::vector<std::pair<K, V>>& elementos, size_t ini, size_t fin,
+        int profundidad, int profundidad_roja, Nodo* padre) {
+    if (ini >= fin) return nil;
+    // El elemento central queda como raíz; el recorrido en orden conserva el orden de entrada
+    size_t medio = ini + (fin - ini) / 2;
+    Nodo* nodo = crearNodo(elementos[medio].first, elementos[medio].second);
+    nodo->padre = padre;
+    nodo->color = (profundidad == profundidad_roja) ? ROJO : NEGRO;
+    nodo->tam_subarbol = fin - ini;
+    nodo->izquierdo = construirRango(elementos, ini, medio, profundidad + 1, profundidad_roja, nodo);
+    nodo->derecho = construirRango(elementos, medio + 1, fin, profundidad + 1, profundidad_roja, nodo);
+    return nodo;
+}
+
+/**
+ * @brief Reemplaza el contenido con elementos ya ordenados, construyendo el árbol en O(n).
+ * @param elementos Pares (clave, valor) en orden no decreciente de clave
+ * @details Al partir siempre por el centro, todas las hojas quedan a la misma profundidad o a una
+ * menos; basta pintar de rojo el último nivel cuando está incompleto para cumplir las propiedades.
+ */
+template <typename K, typename V, typename Comparar>
+void MapaRojoNegro<K, V, Comparar>::construirOrdenado(const std::vector<std::pair<K, V>>& elementos) {
+    for (size_t i = 1; i < elementos.size(); i++) {
+        if (comparar(elementos[i].first, elementos[i - 1].first)) {
+            throw std::invalid_argument("Los elementos no están ordenados");
+        }
+    }
+    limpiar();
+    size_t n = elementos.size();
+    if (n == 0) return;
+
+    // Profundidad del nivel más profundo y si ese nivel está completo (n = 2^(d+1) - 1)
+    int profundidad_max = 0;
+    while (((size_t)2 << profundidad_max) - 1 < n) profundidad_max++;
+    bool completo = (((size_t)2 << profundidad_max) - 1 == n);
+
+    raiz = construirRango(elementos, 0, n, 0, completo ? -1 : profundidad_max, nil);
+    raiz->color = NEGRO;
+    tam = n;
+}
+
+/**
+ * @brief Nodo mínimo de un subárbol.
+ */
+template <typename K, typename V, typename Comparar>
+typename MapaRojoNegro<K, V, Comparar>::Nodo* MapaRojoNegro<K, V, Comparar>::minimo(Nodo* nodo) const {
+    if (nodo == nil) return nil;
+    while (nodo->izquierdo != nil) nodo = nodo->izquierdo;
+    return nodo;
+}
+
+/**
+ * @brief Sucesor en orden de un nodo.
+ * @return Sucesor, o el centinela si no existe
+ */
+template <typename K, typename V, typename Comparar>
+typename MapaRojoNegro<K, V, Comparar>::Nodo* MapaRojoNegro<K, V, Comparar>::sucesor(Nodo* nodo) const {
+    if (nodo == nil) return nil;
+    if (nodo->derecho != nil) return minimo(nodo->derecho);
+    Nodo* p = nodo->padre;
+    while (p != nil && nodo == p->derecho) {
+        nodo = p;
+        p = p->padre;
+    }
+    return p;
+}
+
+/**
+ * @brief Primer nodo cuya clave no es menor que la dada.
+ * @return Nodo encontrado, o el centinela si no existe
+ */
+template <typename K, typename V, typename Comparar>
+typename MapaRojoNegro<K, V, Comparar>::Nodo* MapaRojoNegro<K, V, Comparar>::primerNoMenor(const K& clave) const {
+    Nodo* resultado = nil;
+    Nodo* x = raiz;
+    while (x != nil) {
+        if (!comparar(x->clave, clave)) {
+            resultado = x;
+            x = x->izquierdo;
+        } else {
+            x = x->derecho;
+        }
+    }
+    return resultado;
+}
+
+/**
+ * @brief Obtiene el primer elemento cuya clave no es menor que la dada.
+ */
+template <typename K, typename V, typename Comparar>
+typename MapaRojoNegro<K, V, Comparar>::Iterador MapaRojoNegro<K, V, Comparar>::lower_bound(const K& clave) const {
+    return Iterador(this, primerNoMenor(clave));
+}
+
+/**
+ * @brief Obtiene el primer elemento cuya clave es mayor que la dada.
+ */
+template <typename K, typename V, typename Comparar>
+typename MapaRojoNegro<K, V, Comparar>::Iterador MapaRojoNegro<K, V, Comparar>::upper_bound(const K& clave) const {
+    Nodo* resultado = nil;
+    Nodo* x = raiz;
+    while (x != nil) {
+        if (comparar(clave, x->clave)) {
+            resultado = x;
+            x = x->izquierdo;
+        } else {
+            x = x->derecho;
+        }
+    }
+    return Iterador(this, resultado);
+}
+
+/**
+ * @brief Iterador al menor elemento.
+ */
+template <typename K, typename V, typename Comparar>
+typename MapaRojoNegro<K, V, Comparar>::Iterador MapaRojoNegro<K, V, Comparar>::inicio() const {
+    return Iterador(this, minimo(raiz));
+}
+
+/**
+ * @brief Iterador de fin de recorrido.
+ */
+template <typename K, typename V, typename Comparar>
+typename MapaRojoNegro<K, V, Comparar>::Iterador MapaRojoNegro<K, V, Comparar>::fin() const {
+    return Iterador(this, nil);
+}
+
+/**
+ * @brief Recorre el mapa en orden.
+ * @param func Función aplicada a cada (clave, valor)
+ */
+template <typename K, typename V, typename Comparar>
+void MapaRojoNegro<K, V, Comparar>::recorrer(std::function<void(const K&, const V&)> func) const {
+    for (Iterador it = inicio(); it != fin(); ++it) {
+        func(it->clave, it->valor);
+    }
+}
+
+/**
+ * @brief Obtiene la cantidad de elementos.
+ */
+template <typename K, typename V, typename Comparar>
+size_t MapaRojoNegro<K, V, Comparar>::getTam() const {
+    return tam;
+}
+
+/**
+ * @brief Indica si el mapa está vacío.
+ */
+template <typename K, typename V, typename Comparar>
+bool MapaRojoNegro<K, V, Comparar>::esta_vacio() const {
+    return tam == 0;
+}
+
+/**
+ * @brief Obtiene la raíz del árbol para recorridos de solo lectura.
+ */
+template <typename K, typename V, typename Comparar>
+const typename MapaRojoNegro<K, V, Comparar>::Nodo* MapaRojoNegro<K, V, Comparar>::getRaiz() const {
+    return (raiz == nil) ? nullptr : raiz;
+}
+
+/**
+ * @brief Obtiene el hijo izquierdo de un nodo (nullptr si es una hoja).
+ */
+template <typename K, typename V, typename Comparar>
+const typename MapaRojoNegro<K, V, Comparar>::Nodo* MapaRojoNegro<K, V, Comparar>::hijoIzquierdo(const Nodo* nodo) const {
+    return (!nodo || nodo->izquierdo == nil) ? nullptr : nodo->izquierdo;
+}
+
+/**
+ * @brief Obtiene el hijo derecho de un nodo (nullptr si es una hoja).
+ */
+template <typename K, typename V, typename Comparar>
+const typename MapaRojoNegro<K, V, Comparar>::Nodo* MapaRojoNegro<K, V, Comparar>::hijoDerecho(const Nodo* nodo) const {
+    return (!nodo || nodo->derecho == nil) ? nullptr : nodo->derecho;
+}
+
+/**
+ * @brief Obtiene la cantidad de nodos del subárbol de un nodo.
+ */
+template <typename K, typename V, typename Comparar>
+size_t MapaRojoNegro<K, V, Comparar>::tamSubarbol(const Nodo* nodo) const {
+    return nodo ? nodo->tam_subarbol : 0;
+}
+
+/**
+ * @brief Obtiene el elemento en una posición del recorrido en orden, usando los tamaños de subárbol.
+ */
+template <typename K, typename V, typename Comparar>
+const typename MapaRojoNegro<K, V, Comparar>::Nodo* MapaRojoNegro<K, V, Comparar>::enPosicion(size_t posicion, int* profundidad) const {
+    if (posicion >= tam) return nullptr;
+    const Nodo* x = raiz;
+    int nivel = 0;
+    while (x != nil) {
+        size_t izquierda = x->izquierdo->tam_subarbol;
+        if (posicion < izquierda) {
+            x = x->izquierdo;
+        } else if (posicion == izquierda) {
+            if (profundidad) *profundidad = nivel;
+            return x;
+        } else {
+            posicion -= izquierda + 1;
+            x = x->derecho;
+        }
+        nivel++;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Calcula la altura de un subárbol.
+ */
+template <typename K, typename V, typename Comparar>
+int MapaRojoNegro<K, V, Comparar>::altura(const Nodo* nodo) const {
+    if (nodo == nil) return 0;
+    return 1 + std::max(altura(nodo->izquierdo), altura(nodo->derecho));
+}
+
+/**
+ * @brief Calcula la altura del árbol.
+ */
+template <typename K, typename V, typename Comparar>
+int MapaRojoNegro<K, V, Comparar>::altura() const {
+    return altura(raiz);
+}
+
+/**
+ * @brief Calcula la altura negra de un subárbol (-1 si no es uniforme).
+ */
+template <typename K, typename V, typename Comparar>
+int MapaRojoNegro<K, V, Comparar>::alturaNegra(const Nodo* nodo) const {
+    if (nodo == nil) return 1;
+    int izquierda = alturaNegra(nodo->izquierdo);
+    if (izquierda == -1) return -1;
+    int derecha = alturaNegra(nodo->derecho);
+    if (derecha == -1 || izquierda != derecha) return -1;
+    return izquierda + (nodo->color == NEGRO ? 1 : 0);
+}
+
+/**
+ * @brief Calcula la altura negra del árbol.
+ */
+template <typename K, typename V, typename Comparar>
+int MapaRojoNegro<K, V, Comparar>::alturaNegra() const {
+    return alturaNegra(raiz);
+}
+
+/**
+ * @brief Verifica que ningún nodo rojo tenga un hijo rojo.
+ */
+template <typename K, typename V, typename Comparar>
+bool MapaRojoNegro<K, V, Comparar>::sinRojosConsecutivos(const Nodo* nodo) const {
+    if (nodo == nil) return true;
+    if (nodo->color == ROJO && (nodo->izquierdo->color == ROJO || nodo->derecho->color == ROJO)) return false;
+    return sinRojosConsecutivos(nodo->izquierdo) && sinRojosConsecutivos(nodo->derecho);
+}
+
+/**
+ * @brief Verifica que cada nodo guarde el tamaño real de su subárbol.
+ */
+template <typename K, typename V, typename Comparar>
+bool MapaRojoNegro<K, V, Comparar>::tamanosConsistentes(const Nodo* nodo) const {
+    if (nodo == nil) return nodo->tam_subarbol == 0;
+    if (nodo->tam_subarbol != nodo->izquierdo->tam_subarbol + nodo->derecho->tam_subarbol + 1) return false;
+    return tamanosConsistentes(nodo->izquierdo) && tamanosConsistentes(nodo->derecho);
+}
+
+/**
+ * @brief Verifica las propiedades Rojo-Negro y los tamaños de subárbol.
+ */
+template <typename K, typename V, typename Comparar>
+bool MapaRojoNegro<K, V, Comparar>::verificar() const {
+    if (raiz->color != NEGRO) return false;
+    return sinRojosConsecutivos(raiz) && alturaNegra(raiz) != -1 &&
+           raiz->tam_subarbol == tam && tamanosConsistentes(raiz);
+}
+
+// Instanciaciones explícitas
+template class MapaRojoNegro<ClaveCliente, Cliente*>;
@@ -0,0 +1,203 @@
+/**
+ * @file MapaRojoNegro.h
+ * @brief Declaración de la clase template MapaRojoNegro, mapa ordenado basado en un árbol Rojo-Negro.
+ *
+ * Generaliza el árbol Rojo-Negro de ArbolBinario.cpp como contenedor reutilizable: admite claves repetidas,
+ * eliminación, búsqueda del primer elemento >= clave y recorrido en orden. Cada nodo guarda el tamaño
+ * de su subárbol, lo que permite ubicar un elemento por posición en O(log n). Los nodos se toman de un
+ * pool por bloques para no pedir memoria al sistema en cada inserción.
+ */
+#ifndef MAPAROJONEGRO_H_INCLUDED
+#define MAPAROJONEGRO_H_INCLUDED
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @class MapaRojoNegro
+ * @brief Mapa ordenado (con claves repetidas) implementado como árbol Rojo-Negro.
+ * @tparam K Tipo de la clave
+ * @tparam V Tipo del valor asociado
+ * @tparam Comparar Criterio de orden estricto de las claves
+ */
+template <typename K, typename V, typename Comparar = std::less<K>>
+class MapaRojoNegro {
+public:
+    /// Colores de los nodos del árbol
+    enum ColorNodo { ROJO, NEGRO };
+
+    /**
+     * @struct Nodo
+     * @brief Nodo del árbol. Las hojas apuntan al centinela del mapa (usar hijoIzquierdo/hijoDerecho para leerlas).
+     */
+    struct Nodo {
+        K clave;          ///< Clave de ordenamiento
+        V valor;          ///< Valor asociado
+        Nodo* izquierdo;  ///< Hijo izquierdo
+        Nodo* derecho;    ///< Hijo derecho
+        Nodo* padre;      ///< Padre (o siguiente libre dentro del pool)
+        ColorNodo color;  ///< Color del nodo
+        size_t tam_subarbol; ///< Cantidad de nodos del subárbol con raíz en este nodo
+    };
+
+    /**
+     * @class Iterador
+     * @brief Iterador de solo lectura que recorre el mapa en orden.
+     */
+    class Iterador {
+    public:
+        Iterador(const MapaRojoNegro* _mapa, Nodo* _actual) : mapa(_mapa), actual(_actual) {}
+        const Nodo& operator*() const { return *actual; }
+        const Nodo* operator->() const { return actual; }
+        Iterador& operator++() { actual = mapa->sucesor(actual); return *this; }
+        bool operator==(const Iterador& otro) const { return actual == otro.actual; }
+        bool operator!=(const Iterador& otro) const { return actual != otro.actual; }
+    private:
+        const MapaRojoNegro* mapa; ///< Mapa recorrido
+        Nodo* actual;              ///< Nodo actual (centinela al final)
+    };
+
+    /**
+     * @brief Constructor por defecto. Crea un mapa vacío.
+     */
+    MapaRojoNegro();
+    /**
+     * @brief Destructor. Libera los bloques del pool de nodos.
+     */
+    ~MapaRojoNegro();
+    MapaRojoNegro(const MapaRojoNegro&) = delete;
+    MapaRojoNegro& operator=(const MapaRojoNegro&) = delete;
+
+    /**
+     * @brief Inserta un par (clave, valor). Las claves repetidas se ubican después de las existentes.
+     * @param clave Clave del elemento
+     * @param valor Valor del elemento
+     */
+    void insertar(const K& clave, const V& valor);
+    /**
+     * @brief Elimina el primer par cuya clave y valor coinciden.
+     * @param clave Clave del elemento
+     * @param valor Valor del elemento
+     * @return true si se eliminó, false si no existía
+     */
+    bool eliminar(const K& clave, const V& valor);
+    /**
+     * @brief Elimina todos los elementos y devuelve la memoria del pool.
+     */
+    void limpiar();
+    /**
+     * @brief Reemplaza el contenido con elementos ya ordenados, construyendo el árbol en O(n).
+     * @param elementos Pares (clave, valor) en orden no decreciente de clave
+     * @throws std::invalid_argument si los elementos no están ordenados
+     */
+    void construirOrdenado(const std::vector<std::pair<K, V>>& elementos);
+    /**
+     * @brief Obtiene el primer elemento cuya clave no es menor que la dada.
+     * @param clave Clave de búsqueda
+     * @return Iterador al elemento, o fin() si no existe
+     */
+    Iterador lower_bound(const K& clave) const;
+    /**
+     * @brief Obtiene el primer elemento cuya clave es mayor que la dada.
+     * @param clave Clave de búsqueda
+     * @return Iterador al elemento, o fin() si no existe
+     */
+    Iterador upper_bound(const K& clave) const;
+    /**
+     * @brief Iterador al menor elemento.
+     */
+    Iterador inicio() const;
+    /**
+     * @brief Iterador de fin de recorrido.
+     */
+    Iterador fin() const;
+    /**
+     * @brief Recorre el mapa en orden.
+     * @param func Función aplicada a cada (clave, valor)
+     */
+    void recorrer(std::function<void(const K&, const V&)> func) const;
+    /**
+     * @brief Obtiene la cantidad de elementos.
+     */
+    size_t getTam() const;
+    /**
+     * @brief Indica si el mapa está vacío.
+     */
+    bool esta_vacio() const;
+
+    /**
+     * @brief Obtiene la raíz del árbol para recorridos de solo lectura (visualización).
+     * @return Raíz, o nullptr si el mapa está vacío
+     */
+    const Nodo* getRaiz() const;
+    /**
+     * @brief Obtiene el hijo izquierdo de un nodo.
+     * @return Hijo izquierdo, o nullptr si es una hoja
+     */
+    const Nodo* hijoIzquierdo(const Nodo* nodo) const;
+    /**
+     * @brief Obtiene el hijo derecho de un nodo.
+     * @return Hijo derecho, o nullptr si es una hoja
+     */
+    const Nodo* hijoDerecho(const Nodo* nodo) const;
+    /**
+     * @brief Obtiene la cantidad de nodos del subárbol de un nodo.
+     * @return Tamaño del subárbol, 0 si el nodo es nullptr
+     */
+    size_t tamSubarbol(const Nodo* nodo) const;
+    /**
+     * @brief Obtiene el elemento en una posición del recorrido en orden.
+     * @param posicion Posición (comenzando en 0)
+     * @param profundidad Si no es nullptr, recibe la profundidad del nodo (la raíz tiene 0)
+     * @return Nodo en esa posición, o nullptr si está fuera de rango
+     */
+    const Nodo* enPosicion(size_t posicion, int* profundidad = nullptr) const;
+    /**
+     * @brief Calcula la altura del árbol.
+     */
+    int altura() const;
+    /**
+     * @brief Calcula la altura negra del árbol.
+     * @return Altura negra, o -1 si los caminos no la comparten
+     */
+    int alturaNegra() const;
+    /**
+     * @brief Verifica las propiedades Rojo-Negro (raíz negra, sin rojos consecutivos, altura negra uniforme)
+     * y que los tamaños de subárbol sean consistentes.
+     */
+    bool verificar() const;
+
+private:
+    static const size_t NODOS_POR_BLOQUE = 1024; ///< Nodos reservados por bloque del pool
+
+    Nodo centinela;   ///< Hoja NIL compartida (negra)
+    Nodo* nil;        ///< Puntero al centinela
+    Nodo* raiz;       ///< Raíz del árbol (nil si está vacío)
+    size_t tam;       ///< Cantidad de elementos
+    Comparar comparar; ///< Criterio de orden
+    std::vector<Nodo*> bloques; ///< Bloques reservados por el pool
+    Nodo* libres;     ///< Lista de nodos libres (enlazados por padre)
+    size_t usados;    ///< Nodos entregados del último bloque
+
+    Nodo* crearNodo(const K& clave, const V& valor);
+    void liberarNodo(Nodo* nodo);
+    void rotarIzquierda(Nodo* x);
+    void rotarDerecha(Nodo* y);
+    void arreglarInsercion(Nodo* z);
+    void trasplantar(Nodo* u, Nodo* v);
+    void arreglarEliminacion(Nodo* x);
+    Nodo* minimo(Nodo* nodo) const;
+    Nodo* sucesor(Nodo* nodo) const;
+    Nodo* primerNoMenor(const K& clave) const;
+    Nodo* construirRango(const std::vector<std::pair<K, V>>& elementos, size_t ini, size_t fin,
+                         int profundidad, int profundidad_roja, Nodo* padre);
+    int altura(const Nodo* nodo) const;
+    int alturaNegra(const Nodo* nodo) const;
+    bool sinRojosConsecutivos(const Nodo* nodo) const;
+    bool tamanosConsistentes(const Nodo* nodo) const;
+    void actualizarTam(Nodo* nodo);
+};
+
+#endif
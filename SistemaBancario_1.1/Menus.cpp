@@ -20,6 +20,9 @@
 #include "Ubicacion.h"
 #include "QRCodeGenerator.h"
 #include "pdf_generator.h"
+#include "RecuperacionPuntual.h"
+#include "ArchivoMovimientos.h"
+#include "CalendarioBancario.h"
 #include <stdexcept>
 #include <conio.h>
 #include <random>
@@ -296,33 +299,14 @@ void recuperar_backup_por_fecha(Banco& banco)
         cout << "===   RECUPERAR BACKUP DE CLIENTES   ===" << endl;
         cout << "===========================================" << endl;
         
-        // Buscar archivos de backup
-        for (const auto &entry : std::filesystem::directory_iterator("."))
+        // Consultar el catálogo de respaldos (ya ordenado, más reciente primero)
+        std::vector<EntradaRespaldo> respaldos = RespaldoDatos::catalogo().listar(TipoRespaldo::Completo);
+        std::vector<uint64_t> tamanios_backup;
+        for (const EntradaRespaldo& respaldo : respaldos)
         {
-            string nombre = entry.path().filename().string();
-            if (nombre.find("backup_clientes_") == 0 && nombre.substr(nombre.size() - 4) == ".bin")
-            {
-                archivos_backup.push_back(nombre);
-                
-                // Extraer timestamp del nombre del archivo
-                size_t pos1 = nombre.find("backup_clientes_");
-                size_t pos2 = nombre.find(".bin");
-                if (pos1 != string::npos && pos2 != string::npos)
-                {
-                    string timestamp = nombre.substr(16, pos2 - 16);
-                    if (timestamp.length() == 15) // YYYYMMDD_HHMMSS
-                    {
-                        struct tm tm = {};
-                        tm.tm_year = stoi(timestamp.substr(0, 4)) - 1900;
-                        tm.tm_mon = stoi(timestamp.substr(4, 2)) - 1;
-                        tm.tm_mday = stoi(timestamp.substr(6, 2));
-                        tm.tm_hour = stoi(timestamp.substr(9, 2));
-                        tm.tm_min = stoi(timestamp.substr(11, 2));
-                        tm.tm_sec = stoi(timestamp.substr(13, 2));
-                        fechas_backup.push_back(mktime(&tm));
-                    }
-                }
-            }
+            archivos_backup.push_back(respaldo.archivo);
+            fechas_backup.push_back(respaldo.fecha);
+            tamanios_backup.push_back(respaldo.tamanio);
         }
         
         if (archivos_backup.empty())
@@ -336,25 +320,6 @@ void recuperar_backup_por_fecha(Banco& banco)
             return;
         }
         
-        // Ordenar por fecha (más reciente primero)
-        vector<pair<string, time_t>> pares;
-        for (size_t i = 0; i < archivos_backup.size(); ++i)
-        {
-            pares.emplace_back(archivos_backup[i], fechas_backup[i]);
-        }
-        sort(pares.begin(), pares.end(), [](const auto& a, const auto& b) {
-            return a.second > b.second; // Más reciente primero
-        });
-        
-        // Actualizar vectores ordenados
-        archivos_backup.clear();
-        fechas_backup.clear();
-        for (const auto& par : pares)
-        {
-            archivos_backup.push_back(par.first);
-            fechas_backup.push_back(par.second);
-        }
-        
         cout << "\n=== BACKUPS DISPONIBLES ===" << endl;
         cout << "Total de backups encontrados: " << archivos_backup.size() << endl;
         cout << "Seleccione el backup que desea restaurar:" << endl;
@@ -375,10 +340,8 @@ void recuperar_backup_por_fecha(Banco& banco)
             strftime(fecha_str, sizeof(fecha_str), "%d/%m/%Y", tm_info);
             strftime(hora_str, sizeof(hora_str), "%H:%M:%S", tm_info);
             
-            // Obtener tamaño del archivo
-            std::ifstream file(archivos_backup[i], std::ios::binary | std::ios::ate);
-            std::streamsize size = file.tellg();
-            file.close();
+            // Tamaño registrado en el catálogo
+            uint64_t size = tamanios_backup[i];
             
             string tamaño_str;
             if (size >= 1024 * 1024) {
@@ -587,6 +550,213 @@ void recuperar_backup_por_fecha(Banco& banco)
     inicializar_marquesina(); // Reiniciar la marquesina antes de salir
 }
 
+/**
+ * @brief Reconstruye el estado de los clientes en una fecha y hora exactas.
+ * @param banco Referencia al objeto Banco cuyos movimientos se repiten sobre el respaldo base.
+ * @details Combina el respaldo más cercano anterior con los movimientos registrados hasta ese momento.
+ * El resultado se puede guardar como respaldo, cargar en el sistema o descartar.
+ */
+void reconstruir_estado_por_fecha(Banco& banco)
+{
+    system("cls");
+    ajustar_cursor_para_marquesina();
+    visibilidad_cursor(true);
+
+    try
+    {
+        cout << "\n===========================================" << endl;
+        cout << "===   ESTADO DEL BANCO A FECHA Y HORA   ===" << endl;
+        cout << "===========================================" << endl;
+
+        Fecha fecha;
+        do
+        {
+            limpiar_linea("➤ Ingrese la fecha (DD/MM/YYYY): ");
+            fecha = validarFecha("");
+            if (fecha.get_anuario() == -1)
+                return;
+        } while (fecha.empty());
+        cout << endl;
+
+        int hora = 23, minuto = 59, segundo = 59;
+        string texto_hora;
+        do
+        {
+            limpiar_linea("➤ Ingrese la hora (HH:MM:SS, Enter para el fin del día): ");
+            texto_hora = validarHora("");
+            if (texto_hora == "__ESC__")
+                return;
+            if (texto_hora.empty())
+                break;
+            texto_hora.resize(6, '0');
+            hora = stoi(texto_hora.substr(0, 2));
+            minuto = stoi(texto_hora.substr(2, 2));
+            segundo = stoi(texto_hora.substr(4, 2));
+        } while (!validar_hora_minuto_segundo(hora, minuto, segundo));
+        cout << endl;
+
+        struct tm tm = {};
+        tm.tm_year = fecha.get_anuario() - 1900;
+        tm.tm_mon = fecha.get_mes() - 1;
+        tm.tm_mday = fecha.get_dia();
+        tm.tm_hour = hora;
+        tm.tm_min = minuto;
+        tm.tm_sec = segundo;
+        tm.tm_isdst = -1;
+        time_t instante = mktime(&tm);
+
+        cout << "\nReconstruyendo estado..." << endl;
+        auto inicio = chrono::steady_clock::now();
+        ResultadoRecuperacion resultado = RecuperacionPuntual::reconstruir(*banco.getClientes(), instante);
+        auto milisegundos = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - inicio).count();
+
+        char fecha_str[32];
+        strftime(fecha_str, sizeof(fecha_str), "%d/%m/%Y %H:%M:%S", localtime(&instante));
+        cout << "\n=== ESTADO AL " << fecha_str << " ===" << endl;
+        cout << "=======================================" << endl;
+        if (resultado.base.empty())
+        {
+            cout << "Respaldo base: ninguno (se repitió todo el historial)" << endl;
+        }
+        else
+        {
+            char base_str[32];
+            strftime(base_str, sizeof(base_str), "%d/%m/%Y %H:%M:%S", localtime(&resultado.fecha_base));
+            cout << "Respaldo base: " << resultado.base << " (" << base_str << ")" << endl;
+        }
+        cout << "Clientes: " << resultado.clientes->getTam() << endl;
+        cout << "Cuentas: " << resultado.cuentas << endl;
+        cout << "Cuentas actualizadas: " << resultado.cuentas_actualizadas << endl;
+        cout << "Cuentas abiertas después del respaldo: " << resultado.cuentas_agregadas << endl;
+        cout << "Movimientos aplicados: " << resultado.movimientos_aplicados << endl;
+        cout << "Saldo total: $" << fixed << setprecision(2) << resultado.saldo_total << endl;
+        cout << "Tiempo: " << milisegundos << " ms" << endl;
+        cout << "=======================================" << endl;
+        pausar_consola();
+
+        const int NUM_OPCIONES = 3;
+        const char *OPCIONES[NUM_OPCIONES] = {
+            "Guardar como respaldo",
+            "Cargar en el sistema (reemplaza los datos actuales)",
+            "Descartar"};
+        system("cls");
+        ajustar_cursor_para_marquesina();
+        int opcion = seleccionar_opcion("===== ESTADO RECONSTRUIDO =====", OPCIONES, NUM_OPCIONES, 4);
+
+        if (opcion == 0)
+        {
+            char marca[20];
+            strftime(marca, sizeof(marca), "%Y%m%d_%H%M%S", localtime(&instante));
+            string nombre_archivo = string("recuperado_") + marca + ".bin";
+            RespaldoDatos::respaldoClientesBinario(nombre_archivo, *resultado.clientes);
+
+            // Queda en el catálogo como respaldo completo de ese instante, derivado de su base
+            EntradaRespaldo entrada;
+            entrada.archivo = nombre_archivo;
+            entrada.fecha = instante;
+            entrada.base = resultado.base;
+            entrada.clientes = static_cast<uint32_t>(resultado.clientes->getTam());
+            if (CatalogoRespaldos::medirArchivo(nombre_archivo, entrada))
+            {
+                RespaldoDatos::catalogo().registrar(entrada);
+            }
+            delete resultado.clientes;
+            cout << "\nEstado guardado como: " << nombre_archivo << endl;
+        }
+        else if (opcion == 1 && seleccionar_Si_No())
+        {
+            banco.setClientes(resultado.clientes);
+            banco.guardar_datos_binario_sin_backup("datos.txt");
+            cout << "\nEl sistema ha sido restaurado al " << fecha_str << "." << endl;
+        }
+        else
+        {
+            delete resultado.clientes;
+            cout << "\nEstado descartado." << endl;
+        }
+        pausar_consola();
+    }
+    catch (const std::exception& e)
+    {
+        cout << "\n=== ERROR AL RECONSTRUIR ESTADO ===" << endl;
+        cout << "Error: " << e.what() << endl;
+        cout << "\nRegresando al menu principal...\n";
+        pausar_consola();
+    }
+}
+
+/**
+ * @brief Pasa los movimientos anteriores a una fecha a los segmentos de movimientos archivados.
+ * @param banco Referencia al objeto Banco cuyos movimientos se archivan.
+ * @details Los movimientos de días anteriores a la fecha salen del archivo de datos y quedan en
+ * segmentos comprimidos por mes; las consultas por rango los siguen mostrando.
+ */
+void archivar_movimientos_antiguos(Banco& banco)
+{
+    system("cls");
+    ajustar_cursor_para_marquesina();
+    visibilidad_cursor(true);
+
+    try
+    {
+        cout << "\n===========================================" << endl;
+        cout << "===    ARCHIVAR MOVIMIENTOS ANTIGUOS    ===" << endl;
+        cout << "===========================================" << endl;
+
+        int horizonte = ArchivoMovimientos::general().getHorizonte();
+        if (horizonte > 0)
+        {
+            cout << "Archivado hasta el " << setfill('0') << setw(2) << horizonte % 100 << "/" << setw(2)
+                 << horizonte / 100 % 100 << "/" << horizonte / 10000 << " (sin incluir)" << setfill(' ') << endl;
+        }
+
+        Fecha fecha;
+        do
+        {
+            limpiar_linea("➤ Archivar movimientos anteriores al (DD/MM/YYYY): ");
+            fecha = validarFecha("");
+            if (fecha.get_anuario() == -1)
+                return;
+        } while (fecha.empty());
+        cout << endl;
+
+        if (GestorClientes::dateKey(fecha) <= horizonte)
+        {
+            cout << "\nLos movimientos anteriores a esa fecha ya están archivados." << endl;
+            pausar_consola();
+            return;
+        }
+        if (!seleccionar_Si_No())
+        {
+            cout << "\nArchivado cancelado." << endl;
+            pausar_consola();
+            return;
+        }
+
+        cout << "\nArchivando movimientos..." << endl;
+        auto inicio = chrono::steady_clock::now();
+        ResultadoArchivo resultado = banco.archivar_movimientos(fecha, "datos.txt");
+        auto milisegundos = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - inicio).count();
+
+        cout << "\n=== MOVIMIENTOS ARCHIVADOS ===" << endl;
+        cout << "=======================================" << endl;
+        cout << "Movimientos: " << resultado.movimientos << endl;
+        cout << "Cuentas: " << resultado.cuentas << endl;
+        cout << "Segmentos escritos: " << resultado.segmentos << endl;
+        cout << "Tamaño de los segmentos: " << resultado.bytes << " bytes" << endl;
+        cout << "Tiempo: " << milisegundos << " ms" << endl;
+        cout << "=======================================" << endl;
+        pausar_consola();
+    }
+    catch (const std::exception& e)
+    {
+        cout << "\n=== ERROR AL ARCHIVAR MOVIMIENTOS ===" << endl;
+        cout << "Error: " << e.what() << endl;
+        cout << "\nRegresando al menu principal...\n";
+        pausar_consola();
+    }
+}
+
 
 /**
  * @brief Carga y muestra la base de datos de clientes con opciones de ordenamiento y búsqueda.
@@ -619,31 +789,20 @@ void cargar_base_datos(Banco& banco) {
     auto &lista = *clientes;
     int n = lista.getTam();
 
-    // Usar GestorClientes para ordenamiento con Radix Sort
+    // Usar GestorClientes para ordenamiento con Radix Sort (claves extraídas una vez, en paralelo)
     GestorClientes gestor;
-    
+    bool ascendente_orden = (orden == 0);
+
     if (campo == 0) { // DNI
-        gestor.radixSortCampoNumerico(lista, n, [](Cliente* c) { return std::stoi(c->get_dni()); });
+        gestor.radixSortParaleloNumerico(lista, [](Cliente* c) { return std::stoll(c->get_dni()); }, ascendente_orden);
     } else if (campo == 3) { // Teléfono  
-        gestor.radixSortCampoNumerico(lista, n, [](Cliente* c) { return std::stoi(c->get_telefono()); });
+        gestor.radixSortParaleloNumerico(lista, [](Cliente* c) { return std::stoll(c->get_telefono()); }, ascendente_orden);
     } else if (campo == 1) { // Nombre
-        gestor.radixSortStringCampo(lista, n, [](Cliente* c) { return c->get_nombres(); });
+        gestor.radixSortParaleloString(lista, [](Cliente* c) { return c->get_nombres(); }, ascendente_orden);
     } else if (campo == 2) { // Apellido
-        gestor.radixSortStringCampo(lista, n, [](Cliente* c) { return c->get_apellidos(); });
+        gestor.radixSortParaleloString(lista, [](Cliente* c) { return c->get_apellidos(); }, ascendente_orden);
     } else if (campo == 4) { // Email
-        gestor.radixSortStringCampo(lista, n, [](Cliente* c) { return c->get_email(); });
-    }
-
-    // Si el orden es descendente, invertir la lista
-    if (orden == 1) {
-        std::vector<Cliente*> vectorClientes;
-        for (int i = 0; i < n; ++i) {
-            vectorClientes.push_back(lista.get_contador(i));
-        }
-        std::reverse(vectorClientes.begin(), vectorClientes.end());
-        for (int i = 0; i < n; ++i) {
-            lista.set_contador(i, vectorClientes[i]);
-        }
+        gestor.radixSortParaleloString(lista, [](Cliente* c) { return c->get_email(); }, ascendente_orden);
     }
 
     // Detener la marquesina antes de mostrar la tabla
@@ -716,45 +875,15 @@ void cargar_base_datos(Banco& banco) {
             }
         } while (!validar_valor_busqueda(campo, valor_buscar));
 
-        // Buscar todas las coincidencias
-        bool ascendente = (orden == 0);
-        std::vector<int> coincidencias;
-        
-        // Buscar todas las ocurrencias del valor
-        for (int i = 0; i < n; i++) {
-            bool encontrado = false;
-            
-            if (campo == 0) { // DNI
-                int dni_cliente = std::stoi(lista.get_contador(i)->get_dni());
-                int dni_buscar = std::stoi(valor_buscar);
-                encontrado = (dni_cliente == dni_buscar);
-            } else if (campo == 3) { // Teléfono
-                int tel_cliente = std::stoi(lista.get_contador(i)->get_telefono());
-                int tel_buscar = std::stoi(valor_buscar);
-                encontrado = (tel_cliente == tel_buscar);
-            } else if (campo == 1) { // Nombre
-                std::string nombre_cliente = lista.get_contador(i)->get_nombres();
-                std::transform(nombre_cliente.begin(), nombre_cliente.end(), nombre_cliente.begin(), ::tolower);
-                std::string nombre_buscar = valor_buscar;
-                std::transform(nombre_buscar.begin(), nombre_buscar.end(), nombre_buscar.begin(), ::tolower);
-                encontrado = (nombre_cliente == nombre_buscar);
-            } else if (campo == 2) { // Apellido
-                std::string apellido_cliente = lista.get_contador(i)->get_apellidos();
-                std::transform(apellido_cliente.begin(), apellido_cliente.end(), apellido_cliente.begin(), ::tolower);
-                std::string apellido_buscar = valor_buscar;
-                std::transform(apellido_buscar.begin(), apellido_buscar.end(), apellido_buscar.begin(), ::tolower);
-                encontrado = (apellido_cliente == apellido_buscar);
-            } else if (campo == 4) { // Email
-                std::string email_cliente = lista.get_contador(i)->get_email();
-                std::transform(email_cliente.begin(), email_cliente.end(), email_cliente.begin(), ::tolower);
-                std::string email_buscar = valor_buscar;
-                std::transform(email_buscar.begin(), email_buscar.end(), email_buscar.begin(), ::tolower);
-                encontrado = (email_cliente == email_buscar);
-            }
-            
-            if (encontrado) {
-                coincidencias.push_back(i);
-            }
+        // Buscar todas las coincidencias en el índice ordenado del banco (O(log n + k));
+        // en campos de texto, si no hay coincidencia exacta se muestran las que empiezan con el valor
+        const IndiceClientes& indice = banco.getIndices();
+        std::vector<Cliente*> coincidencias = indice.buscarExacto(campo, valor_buscar);
+        if (coincidencias.empty() && (campo == 1 || campo == 2 || campo == 4)) {
+            coincidencias = indice.buscarPrefijo(campo, valor_buscar);
+        }
+        if (orden == 1) {
+            std::reverse(coincidencias.begin(), coincidencias.end());
         }
 
         if (!coincidencias.empty())
@@ -766,7 +895,7 @@ void cargar_base_datos(Banco& banco) {
             }
             
             for (size_t idx = 0; idx < coincidencias.size(); idx++) {
-                Cliente *cliente = lista.get_contador(coincidencias[idx]);
+                Cliente *cliente = coincidencias[idx];
                 
                 if (coincidencias.size() > 1) {
                     cout << "\n--- CLIENTE " << (idx + 1) << " ---\n";
@@ -840,13 +969,9 @@ void cifrar_archivos_txt(Banco& banco) {
     cout << "===========================================" << endl;
 
     vector<string> backups;
-    for (const auto &entry : filesystem::directory_iterator("."))
+    for (const EntradaRespaldo& respaldo : RespaldoDatos::catalogo().listar(TipoRespaldo::Completo))
     {
-        string nombre = entry.path().filename().string();
-        if (nombre.find("backup_clientes_") == 0 && nombre.substr(nombre.size() - 4) == ".bin")
-        {
-            backups.push_back(nombre);
-        }
+        backups.push_back(respaldo.archivo);
     }
 
     if (backups.empty())
@@ -909,7 +1034,7 @@ void cifrar_archivos_txt(Banco& banco) {
  */
 void menu_administrador(Banco &banco)
 {
-    const int NUM_OPCIONES = 14; // Incrementado a 14
+    const int NUM_OPCIONES = 17;
     const char *OPCIONES[NUM_OPCIONES] = {
         "Consultar movimientos por fecha",
         "Consultar cuentas por DNI/nombre",
@@ -924,6 +1049,9 @@ void menu_administrador(Banco &banco)
         "Generar tabla Hash",
         "Generar PDF de clientes",
         "Consultar citas agendadas",
+        "Generar QR de todos los clientes",
+        "Reconstruir estado a fecha y hora",
+        "Archivar movimientos antiguos",
         "Salir"};
 
     system("cls");
@@ -1005,10 +1133,19 @@ void menu_administrador(Banco &banco)
             case 12: // Consultar citas agendadas
                 consultar_citas_por_sector();
                 break;
-            case 13: // Nueva posición de "Salir"
+            case 13: // Generar QR de todos los clientes
+                generar_qr_todos_clientes(banco);
+                break;
+            case 14: // Reconstruir estado a fecha y hora
+                reconstruir_estado_por_fecha(banco);
+                break;
+            case 15: // Archivar movimientos antiguos
+                archivar_movimientos_antiguos(banco);
+                break;
+            case 16: // Nueva posición de "Salir"
                 return;
             }
-        } while (opcion != 13); // Cambiado a 13 para coincidir con "Salir"
+        } while (opcion != 16);
     }
     catch (const std::exception &e)
     {
@@ -1729,7 +1866,11 @@ void abrir_cuenta(Banco& banco, int tipo_cuenta, int branchId, const string& suc
         cuenta->set_branchId(branchId);
         auto appointmentTime = banco.findNextAvailableSlot(branchId);
         cuenta->set_appointmentTime(appointmentTime);
-        banco.addAppointment(branchId, appointmentTime);
+        if (!banco.addAppointment(branchId, appointmentTime))
+        {
+            delete cuenta;
+            throw runtime_error("El turno asignado ya está reservado. Intente nuevamente.");
+        }
 
         if (cliente_existe)
         {
@@ -2327,10 +2468,10 @@ void menu_cita_presencial(Banco& banco) {
         
         switch (opcion) {
             case 0:
-                agendar_cita_presencial();
+                agendar_cita_presencial(banco);
                 break;
             case 1:
-                cancelar_cita_agendada();
+                cancelar_cita_agendada(banco);
                 break;
             case 2:
                 return;
@@ -2344,7 +2485,7 @@ void menu_cita_presencial(Banco& banco) {
  * muestra horarios disponibles y permite al usuario agendar una cita para apertura de cuenta.
  * Incluye control de citas duplicadas para evitar que un cliente agende múltiples citas.
  */
-void agendar_cita_presencial() {
+void agendar_cita_presencial(Banco& banco) {
     system("cls");
     ajustar_cursor_para_marquesina();
     visibilidad_cursor(true);
@@ -2358,9 +2499,6 @@ void agendar_cita_presencial() {
     cout << "• Domingos: CERRADO" << endl;
     cout << "=======================================\n" << endl;
     
-    // Cargar citas existentes
-    geoSystem.cargarCitas();
-    
     // Solicitar datos del cliente para verificar duplicados
     string dni, nombre, apellido, telefono;
     
@@ -2387,20 +2525,18 @@ void agendar_cita_presencial() {
         
         if (respuesta == "S") {
             // Mostrar las citas del cliente
-            auto todas_las_citas = geoSystem.obtenerCitasPorSector();
+            auto citas_cliente = geoSystem.obtenerCitasCliente(dni);
             bool encontrado = false;
             
             cout << "\n=== SUS CITAS AGENDADAS ===" << endl;
-            for (const auto& cita : todas_las_citas) {
-                if (cita.dni == dni) {
-                    cout << "Sucursal: " << cita.sucursal_nombre << endl;
-                    cout << "Sector: " << cita.sector << endl;
-                    cout << "Fecha y Hora: " << cita.fecha_hora << endl;
-                    cout << "Número de Confirmación: " << cita.numero_confirmacion << endl;
-                    cout << "Fecha de Agendamiento: " << cita.fecha_agendamiento << endl;
-                    encontrado = true;
-                    cout << "-----------------------------------" << endl;
-                }
+            for (const CitaAgendada* cita : citas_cliente) {
+                cout << "Sucursal: " << cita->sucursal_nombre << endl;
+                cout << "Sector: " << cita->sector << endl;
+                cout << "Fecha y Hora: " << cita->fecha_hora << endl;
+                cout << "Número de Confirmación: " << cita->numero_confirmacion << endl;
+                cout << "Fecha de Agendamiento: " << cita->fecha_agendamiento << endl;
+                encontrado = true;
+                cout << "-----------------------------------" << endl;
             }
             
             if (!encontrado) {
@@ -2439,7 +2575,7 @@ void agendar_cita_presencial() {
     double distance = result.second;
     
     // Mostrar horarios disponibles para la sucursal más cercana
-    auto horarios = geoSystem.generateValidBankingTimeSlots(selected_branch.queue_position);
+    auto horarios = geoSystem.generateValidBankingTimeSlots(selected_branch.queue_position, selected_branch.id);
     
     cout << "\nSucursal más cercana: " << selected_branch.name << endl;
     cout << "Distancia: " << fixed << setprecision(2) << distance << " km" << endl;
@@ -2449,7 +2585,7 @@ void agendar_cita_presencial() {
         cout << "Tiempo de espera estimado: 0 minutos" << endl;
     } else {
         cout << "Personas en cola: " << selected_branch.queue_position << endl;
-        cout << "Tiempo de espera estimado: " << (selected_branch.queue_position * 40) << " minutos" << endl;
+        cout << "Tiempo de espera estimado: " << geoSystem.estimateWaitMinutes(selected_branch.id, selected_branch.queue_position) << " minutos" << endl;
     }
     
     // Filtrar horarios disponibles (excluir "No disponible")
@@ -2525,6 +2661,17 @@ void agendar_cita_presencial() {
                                horarios_validos[horario_elegido - 1], numero_confirmacion,
                                fecha_actual, true);
         
+        // La cita ocupa su turno en el calendario de la sucursal; un turno ya reservado se rechaza
+        chrono::system_clock::time_point turno;
+        bool ocupa_turno = turno_de_cita(banco, nueva_cita, turno);
+        if (ocupa_turno && !banco.addAgendaAppointment(selected_branch.id, turno)) {
+            cout << "\n=== HORARIO NO DISPONIBLE ===" << endl;
+            cout << "El horario " << nueva_cita.fecha_hora << " ya está reservado en esta sucursal." << endl;
+            cout << "Seleccione otro horario e intente nuevamente." << endl;
+            pausar_consola();
+            return;
+        }
+
         // Agregar cita al sistema
         if (geoSystem.agregarCita(nueva_cita)) {
             // Actualizar la cola de la sucursal (simular que se agendó una cita)
@@ -2540,6 +2687,7 @@ void agendar_cita_presencial() {
             cout << "• No podrá agendar otra cita hasta completar o cancelar esta." << endl;
             cout << "• Guarde su número de confirmación para futuras consultas." << endl;
         } else {
+            if (ocupa_turno) banco.cancelAppointment(selected_branch.id, turno);
             cout << "\n=== ERROR ===" << endl;
             cout << "No se pudo registrar la cita. Intente nuevamente." << endl;
         }
@@ -2807,15 +2955,22 @@ void crear_backup_manual(Banco& banco) {
         cout << "Creando backup manual de los datos del sistema..." << endl;
         fila_actual++;
 
-        // Crear el backup usando RespaldoDatos
-        RespaldoDatos::guardarRespaldoClientesConFecha(*banco.getClientes());
+        // Crear el backup en el hilo de respaldos (no se pisa con uno automático en curso) y esperarlo
+        RespaldoAsincrono& respaldos = banco.getRespaldos();
+        if (!respaldos.esperar(respaldos.solicitar(*banco.getClientes()))) {
+            throw std::runtime_error("No se pudo escribir el archivo de backup");
+        }
+        EstadoRespaldoAsincrono estado = respaldos.getEstado();
         
         mover_cursor(1, fila_actual++);
         cout << "==============================================" << endl;
         mover_cursor(1, fila_actual++);
         cout << "     BACKUP CREADO EXITOSAMENTE" << endl;
         mover_cursor(1, fila_actual++);
-        cout << "Archivo: Backup con marca de tiempo creado" << endl;
+        cout << "Archivo: " << estado.ultimo_archivo << " (" << fixed << setprecision(1) << estado.ultimo_ms << " ms)" << endl;
+        mover_cursor(1, fila_actual++);
+        cout << "Respaldos en segundo plano: " << estado.completados << " completados, "
+             << estado.fallidos << " fallidos" << endl;
         mover_cursor(1, fila_actual++);
         cout << "Ubicación: Directorio actual del proyecto" << endl;
         mover_cursor(1, fila_actual++);
@@ -2849,9 +3004,10 @@ void crear_backup_manual(Banco& banco) {
  */
 bool verificar_y_recuperar_datos(Banco& banco) {
     ifstream archivo("datos.txt");
+    ifstream temporal("datos.txt.tmp"); // Guardado interrumpido antes del renombrado
     
-    // Si el archivo existe, intentar cargarlo
-    if (archivo.good()) {
+    // Si el archivo existe, intentar cargarlo (la carga verifica su pie y recupera el temporal)
+    if (archivo.good() || temporal.good()) {
         archivo.close();
         try {
             banco.cargar_datos_binario("datos.txt");
@@ -2876,15 +3032,11 @@ bool verificar_y_recuperar_datos(Banco& banco) {
     cout << "Es necesario recuperar desde un backup existente." << endl;
     cout << endl;
     
-    // Buscar archivos de backup disponibles
+    // Consultar el catálogo de respaldos (ya ordenado, más reciente primero)
+    vector<EntradaRespaldo> respaldos = RespaldoDatos::catalogo().listar(TipoRespaldo::Completo);
     vector<string> backups;
-    for (const auto& entry : filesystem::directory_iterator(".")) {
-        if (entry.is_regular_file()) {
-            string filename = entry.path().filename().string();
-            if (filename.find("backup_clientes_") == 0 && filename.find(".bin") != string::npos) {
-                backups.push_back(filename);
-            }
-        }
+    for (const EntradaRespaldo& respaldo : respaldos) {
+        backups.push_back(respaldo.archivo);
     }
     
     if (backups.empty()) {
@@ -2897,11 +3049,6 @@ bool verificar_y_recuperar_datos(Banco& banco) {
         return false;
     }
     
-    // Ordenar backups por fecha (más reciente primero)
-    sort(backups.begin(), backups.end(), [](const string& a, const string& b) {
-        return a > b; // Orden descendente (más reciente primero)
-    });
-    
     // Crear opciones para el menú de selección con flechitas
     vector<string> opciones_str;
     vector<const char*> opciones_backup;
@@ -2909,28 +3056,10 @@ bool verificar_y_recuperar_datos(Banco& banco) {
     for (size_t i = 0; i < backups.size(); ++i) {
         string opcion_texto = backups[i];
         
-        // Extraer y mostrar fecha/hora del nombre del archivo
-        size_t pos1 = backups[i].find("backup_clientes_");
-        size_t pos2 = backups[i].find(".bin");
-        if (pos1 != string::npos && pos2 != string::npos) {
-            string timestamp = backups[i].substr(16, pos2 - 16);
-            if (timestamp.length() >= 15) {
-                string fecha = timestamp.substr(0, 8);
-                string hora = timestamp.substr(9, 6);
-                
-                // Formatear fecha DD/MM/YYYY
-                string fecha_formateada = fecha.substr(6, 2) + "/" + 
-                                        fecha.substr(4, 2) + "/" + 
-                                        fecha.substr(0, 4);
-                
-                // Formatear hora HH:MM:SS
-                string hora_formateada = hora.substr(0, 2) + ":" + 
-                                       hora.substr(2, 2) + ":" + 
-                                       hora.substr(4, 2);
-                
-                opcion_texto += " [" + fecha_formateada + " " + hora_formateada + "]";
-            }
-        }
+        // Mostrar fecha/hora registradas en el catálogo
+        char fecha_hora[24];
+        strftime(fecha_hora, sizeof(fecha_hora), "%d/%m/%Y %H:%M:%S", localtime(&respaldos[i].fecha));
+        opcion_texto += " [" + string(fecha_hora) + "]";
         
         opciones_str.push_back(opcion_texto);
         opciones_backup.push_back(opciones_str.back().c_str());
@@ -3014,9 +3143,6 @@ void consultar_citas_por_sector() {
     cout << "\n=== CONSULTAR CITAS POR SECTOR ===" << endl;
     cout << "=======================================\n" << endl;
     
-    // Cargar citas existentes
-    geoSystem.cargarCitas();
-    
     // Menú de opciones de consulta
     const int NUM_SECTORES = 5;
     const char* SECTORES[NUM_SECTORES] = {
@@ -3061,15 +3187,15 @@ void consultar_citas_por_sector() {
         
         // Agrupar por sector si se muestran todas
         if (sector_filtro.empty()) {
-            map<string, vector<CitaAgendada>> citas_por_sector;
-            for (const auto& cita : citas) {
-                citas_por_sector[cita.sector].push_back(cita);
+            map<string, vector<const CitaAgendada*>> citas_por_sector;
+            for (const CitaAgendada* cita : citas) {
+                citas_por_sector[cita->sector].push_back(cita);
             }
             
             for (const auto& par : citas_por_sector) {
                 cout << "\n--- SECTOR: " << par.first << " (" << par.second.size() << " citas) ---" << endl;
                 for (size_t i = 0; i < par.second.size(); i++) {
-                    const auto& cita = par.second[i];
+                    const auto& cita = *par.second[i];
                     cout << "\n" << (i + 1) << ". " << cita.nombre_completo << endl;
                     cout << "   DNI: " << cita.dni << endl;
                     cout << "   Teléfono: " << cita.telefono << endl;
@@ -3082,7 +3208,7 @@ void consultar_citas_por_sector() {
         } else {
             // Mostrar citas del sector específico
             for (size_t i = 0; i < citas.size(); i++) {
-                const auto& cita = citas[i];
+                const auto& cita = *citas[i];
                 cout << "\n" << (i + 1) << ". " << cita.nombre_completo << endl;
                 cout << "   DNI: " << cita.dni << endl;
                 cout << "   Teléfono: " << cita.telefono << endl;
@@ -3099,8 +3225,8 @@ void consultar_citas_por_sector() {
         
         // Estadísticas por sucursal
         map<string, int> por_sucursal;
-        for (const auto& cita : citas) {
-            por_sucursal[cita.sucursal_nombre]++;
+        for (const CitaAgendada* cita : citas) {
+            por_sucursal[cita->sucursal_nombre]++;
         }
         
         cout << "\nCitas por sucursal:" << endl;
@@ -3118,7 +3244,7 @@ void consultar_citas_por_sector() {
  * @details Permite a un cliente cancelar su cita ingresando DNI
  * y número de confirmación de la cita.
  */
-void cancelar_cita_agendada() {
+void cancelar_cita_agendada(Banco& banco) {
     system("cls");
     ajustar_cursor_para_marquesina();
     visibilidad_cursor(true);
@@ -3129,9 +3255,6 @@ void cancelar_cita_agendada() {
     cout << "• Número de confirmación de la cita" << endl;
     cout << "=====================================\n" << endl;
     
-    // Cargar citas existentes
-    geoSystem.cargarCitas();
-    
     string dni, numero_confirmacion;
     
     do {
@@ -3153,18 +3276,11 @@ void cancelar_cita_agendada() {
     }
     
     // Mostrar las citas del cliente
-    auto todas_las_citas = geoSystem.obtenerCitasPorSector();
-    vector<CitaAgendada> citas_cliente;
-    
-    for (const auto& cita : todas_las_citas) {
-        if (cita.dni == dni && cita.activa) {
-            citas_cliente.push_back(cita);
-        }
-    }
+    auto citas_cliente = geoSystem.obtenerCitasCliente(dni);
     
     cout << "\n=== SUS CITAS ACTIVAS ===" << endl;
     for (size_t i = 0; i < citas_cliente.size(); i++) {
-        const auto& cita = citas_cliente[i];
+        const auto& cita = *citas_cliente[i];
         cout << "\nCita " << (i + 1) << ":" << endl;
         cout << "Sucursal: " << cita.sucursal_nombre << endl;
         cout << "Sector: " << cita.sector << endl;
@@ -3184,8 +3300,8 @@ void cancelar_cita_agendada() {
     
     // Validar que el número de confirmación corresponda al cliente
     bool cita_valida = false;
-    for (const auto& cita : citas_cliente) {
-        string numero_cita_upper = cita.numero_confirmacion;
+    for (const CitaAgendada* cita : citas_cliente) {
+        string numero_cita_upper = cita->numero_confirmacion;
         transform(numero_cita_upper.begin(), numero_cita_upper.end(), numero_cita_upper.begin(), ::toupper);
         if (numero_cita_upper == numero_confirmacion) {
             cita_valida = true;
@@ -3202,7 +3318,8 @@ void cancelar_cita_agendada() {
     }
     
     // Mostrar detalles de la cita a cancelar
-    for (const auto& cita : citas_cliente) {
+    for (const CitaAgendada* cita_cliente : citas_cliente) {
+        const auto& cita = *cita_cliente;
         string numero_cita_upper = cita.numero_confirmacion;
         transform(numero_cita_upper.begin(), numero_cita_upper.end(), numero_cita_upper.begin(), ::toupper);
         if (numero_cita_upper == numero_confirmacion) {
@@ -3217,9 +3334,22 @@ void cancelar_cita_agendada() {
         }
     }
     
+    // El turno se toma antes de cancelar: la cita cancelada deja de estar entre las activas del cliente
+    chrono::system_clock::time_point turno;
+    int sucursal_turno = 0;
+    for (const CitaAgendada* cita : citas_cliente) {
+        string numero_cita_upper = cita->numero_confirmacion;
+        transform(numero_cita_upper.begin(), numero_cita_upper.end(), numero_cita_upper.begin(), ::toupper);
+        if (numero_cita_upper == numero_confirmacion && turno_de_cita(banco, *cita, turno)) {
+            sucursal_turno = cita->sucursal_id;
+            break;
+        }
+    }
+
     bool confirmar = seleccionar_Si_No();
     if (confirmar) {
         if (geoSystem.cancelarCita(dni, numero_confirmacion)) {
+            if (sucursal_turno != 0) banco.cancelAppointment(sucursal_turno, turno);
             cout << "\n=== CITA CANCELADA ===" << endl;
             cout << "Su cita ha sido cancelada exitosamente." << endl;
             cout << "Número de confirmación: " << numero_confirmacion << endl;
@@ -3233,4 +3363,75 @@ void cancelar_cita_agendada() {
     }
     
     pausar_consola();
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Obtiene el turno del calendario del banco que ocupa una cita agendada.
+ * @param banco Referencia al objeto Banco para verificar el horario laboral.
+ * @param cita Cita agendada.
+ * @param turno Recibe la fecha y hora de la cita.
+ * @return true si la cita es en una sucursal con calendario de turnos (1, 2 o 3) y en horario laboral.
+ */
+bool turno_de_cita(Banco& banco, const CitaAgendada& cita, chrono::system_clock::time_point& turno) {
+    long dia;
+    int minuto;
+    if (cita.sucursal_id < 1 || cita.sucursal_id > 3 || !AgendaCitas::fechaDe(cita, dia, minuto)) return false;
+    turno = CalendarioBancario::componer(dia, minuto);
+    return banco.isWorkingHour(turno);
+}
+
+/**
+ * @brief Reserva en los calendarios del banco los turnos de las citas agendadas activas.
+ * @param banco Referencia al objeto Banco.
+ */
+void reservar_turnos_citas(Banco& banco) {
+    for (const CitaAgendada* cita : geoSystem.obtenerCitasPorSector()) {
+        chrono::system_clock::time_point turno;
+        if (turno_de_cita(banco, *cita, turno)) banco.addAgendaAppointment(cita->sucursal_id, turno);
+    }
+}
+
+/**
+ * @brief Genera los PDF de códigos QR de todos los clientes con cuentas.
+ * @param banco Referencia al objeto Banco para acceder a los clientes.
+ * @details Prepara un QRCodeGenerator por cliente y los procesa en paralelo con
+ * QRCodeGenerator::generarLote; los clientes sin cuentas se omiten.
+ */
+void generar_qr_todos_clientes(Banco& banco) {
+    system("cls");
+    ajustar_cursor_para_marquesina();
+    visibilidad_cursor(true);
+    try {
+        cout << "\n==============================================" << endl;
+        cout << "     GENERACIÓN DE QR DE TODOS LOS CLIENTES   " << endl;
+        cout << "==============================================" << endl;
+
+        vector<QRCodeGenerator> generadores;
+        size_t cuentas_total = 0;
+        banco.getClientes()->recorrer([&](Cliente* cliente) {
+            ListaDoble<Cuenta*>* cuentas = cliente->get_cuentas();
+            if (cuentas->esta_vacia()) return;
+            generadores.emplace_back(cliente->get_nombres() + " " + cliente->get_apellidos(), cuentas);
+            cuentas_total += cuentas->getTam();
+        });
+
+        if (generadores.empty()) {
+            cout << "No hay clientes con cuentas registradas." << endl;
+            pausar_consola();
+            return;
+        }
+
+        cout << "Generando PDF de " << generadores.size() << " clientes (" << cuentas_total << " cuentas)..." << endl;
+        auto inicio = chrono::steady_clock::now();
+        size_t generados = QRCodeGenerator::generarLote(generadores);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+        cout << "PDF generados: " << generados << " de " << generadores.size() << endl;
+        cout << "Tiempo: " << fixed << setprecision(2) << segundos << " s" << endl;
+        cout << "Archivos: qr_cliente_<nombre>.pdf" << endl;
+        cout << "==============================================" << endl;
+    } catch (const exception& e) {
+        cerr << "Error en generar_qr_todos_clientes: " << e.what() << endl;
+    }
+    pausar_consola();
+}
@@ -20,6 +20,7 @@
 #include <windows.h>
 #include "validaciones.h"
 #include "Banco.h"
+#include "AgendaCitas.h"
 #include "Marquesina.h"
 
 /**
@@ -150,6 +151,20 @@ bool validar_credenciales_administrador(const string& usuario, const string& con
  */
 void recuperar_backup_por_fecha(Banco& banco);
 
+/**
+ * @brief Reconstruye el estado de los clientes en una fecha y hora exactas.
+ * @param banco Referencia al objeto Banco cuyos movimientos se repiten sobre el respaldo base.
+ * @details Combina el respaldo más cercano anterior con los movimientos registrados hasta ese
+ * momento; el resultado se puede guardar como respaldo o cargar en el sistema.
+ */
+void reconstruir_estado_por_fecha(Banco& banco);
+/**
+ * @brief Pasa los movimientos anteriores a una fecha a los segmentos de movimientos archivados.
+ * @param banco Referencia al objeto Banco cuyos movimientos se archivan.
+ * @details Las consultas por rango siguen mostrando los movimientos archivados.
+ */
+void archivar_movimientos_antiguos(Banco& banco);
+
 /**
  * @brief Carga y muestra la base de datos de clientes con opciones de ordenamiento.
  * @param banco Referencia al objeto Banco con los datos de los clientes.
@@ -192,6 +207,14 @@ void cifrar_archivos_txt(Banco& banco);
  */
 void verificar_hash(Banco& banco);
 
+/**
+ * @brief Genera los PDF de códigos QR de todos los clientes con cuentas.
+ * @param banco Referencia al objeto Banco para acceder a los clientes.
+ * @details Crea un PDF por cliente (qr_cliente_<nombre>.pdf) repartiendo los
+ * clientes entre varios hilos, y muestra cuántos se generaron y el tiempo empleado.
+ */
+void generar_qr_todos_clientes(Banco& banco);
+
 /**
  * @brief Implementa búsqueda usando tabla hash para localizar clientes.
  * @param banco Referencia al objeto Banco para acceder a los datos.
@@ -295,10 +318,11 @@ void mostrar_sucursales_cercanas();
 
 /**
  * @brief Procesa el agendamiento de una cita presencial.
+ * @param banco Referencia al objeto Banco, donde la cita reserva su turno.
  * @details Utiliza el sistema de geolocalización para encontrar
  * la sucursal más cercana y agendar una cita disponible.
  */
-void agendar_cita_presencial();
+void agendar_cita_presencial(Banco& banco);
 
 /**
  * @brief Consulta y muestra las citas agendadas por sector.
@@ -309,10 +333,29 @@ void consultar_citas_por_sector();
 
 /**
  * @brief Cancela una cita previamente agendada.
+ * @param banco Referencia al objeto Banco, donde se libera el turno de la cita.
  * @details Permite a un cliente cancelar su cita ingresando DNI
  * y número de confirmación de la cita.
  */
-void cancelar_cita_agendada();
+void cancelar_cita_agendada(Banco& banco);
+
+/**
+ * @brief Obtiene el turno del calendario del banco que ocupa una cita agendada.
+ * @param banco Referencia al objeto Banco para verificar el horario laboral.
+ * @param cita Cita agendada.
+ * @param turno Recibe la fecha y hora de la cita.
+ * @return true si la cita es en una sucursal con calendario de turnos (1, 2 o 3) y en horario laboral;
+ * las citas de sábado o de otras sucursales no ocupan turno.
+ */
+bool turno_de_cita(Banco& banco, const CitaAgendada& cita, std::chrono::system_clock::time_point& turno);
+
+/**
+ * @brief Reserva en los calendarios del banco los turnos de las citas agendadas activas.
+ * @param banco Referencia al objeto Banco.
+ * @details Se llama después de cargar las citas, para que las citas de sesiones anteriores
+ * sigan ocupando su turno.
+ */
+void reservar_turnos_citas(Banco& banco);
 
 // ========== FUNCIONES DE TRANSACCIONES BANCARIAS ==========
 
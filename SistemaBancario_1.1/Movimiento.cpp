@@ -97,69 +97,6 @@ std::string Movimiento::to_string() const {
            ", Fecha=" + fecha.to_string() + ", Saldo posterior=" + std::to_string(saldo_post_movimiento);
 }
 
-/**
- * @brief Guarda el movimiento en un archivo binario.
- * @param archivo Puntero al archivo donde se guardará el movimiento.
- * @details Serializa todos los datos del movimiento en formato binario,
- * incluyendo la longitud del tipo, el tipo, monto, fecha y saldo posterior.
- * @throws std::exception Si ocurre un error durante la escritura.
- */
-void Movimiento::guardar_binario(FILE* archivo) {
-    if (!archivo) {
-        std::cerr << "Error: Archivo no válido para escritura" << std::endl;
-        return;
-    }
-    try {
-        size_t len = tipo.length();
-        fwrite(&len, sizeof(size_t), 1, archivo);
-        fwrite(tipo.c_str(), sizeof(char), len + 1, archivo);
-        fwrite(&monto, sizeof(double), 1, archivo);
-        fwrite(&fecha, sizeof(Fecha), 1, archivo);
-        fwrite(&saldo_post_movimiento, sizeof(double), 1, archivo);
-    } catch (const std::exception& e) {
-        std::cerr << "Error al guardar movimiento en archivo binario: " << e.what() << std::endl;
-    }
-}
-
-/**
- * @brief Carga un movimiento desde un archivo binario.
- * @param archivo Puntero al archivo desde donde se cargará el movimiento.
- * @details Deserializa los datos del movimiento desde formato binario,
- * leyendo la longitud del tipo, el tipo, monto, fecha y saldo posterior.
- * Incluye validación de longitud del tipo para evitar lecturas corruptas.
- * @throws std::runtime_error Si ocurre un error durante la lectura o los datos están corruptos.
- */
-void Movimiento::cargar_binario(FILE* archivo) {
-    if (!archivo) {
-        std::cerr << "Error: Archivo no válido para lectura" << std::endl;
-        return;
-    }
-    try {
-        size_t len;
-        if (fread(&len, sizeof(size_t), 1, archivo) != 1) throw std::runtime_error("Error al leer longitud de tipo");
-        if (len > 100) throw std::runtime_error("Longitud de tipo de movimiento inválida");
-        char* buffer = new char[len + 1];
-        if (fread(buffer, sizeof(char), len + 1, archivo) != len + 1) {
-            delete[] buffer;
-            throw std::runtime_error("Error al leer tipo de movimiento");
-        }
-        tipo = std::string(buffer);
-        delete[] buffer;
-
-        if (fread(&monto, sizeof(double), 1, archivo) != 1) {
-            throw std::runtime_error("Error al leer el monto");
-        }
-        if (fread(&fecha, sizeof(Fecha), 1, archivo) != 1) {
-            throw std::runtime_error("Error al leer la fecha");
-        }
-        if (fread(&saldo_post_movimiento, sizeof(double), 1, archivo) != 1) {
-            throw std::runtime_error("Error al leer el saldo posterior");
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "Error al cargar movimiento desde archivo binario: " << e.what() << std::endl;
-    }
-}
-
 /**
  * @brief Operador de salida para la clase Movimiento.
  * @param os Flujo de salida donde se escribirá el movimiento.
@@ -95,21 +95,6 @@ public:
      */
     std::string to_string() const; // Añadido const
     
-    /**
-     * @brief Guarda el movimiento en un archivo binario.
-     * @param archivo Puntero al archivo donde se guardará el movimiento.
-     * @details Serializa todos los datos del movimiento en formato binario.
-     */
-    void guardar_binario(FILE* archivo);
-    
-    /**
-     * @brief Carga un movimiento desde un archivo binario.
-     * @param archivo Puntero al archivo desde donde se cargará el movimiento.
-     * @details Deserializa los datos del movimiento desde formato binario.
-     * @throws std::runtime_error Si los datos están corruptos o hay errores de lectura.
-     */
-    void cargar_binario(FILE* archivo);
-    
     /**
      * @brief Operador de salida para la clase Movimiento.
      * @param os Flujo de salida donde se escribirá el movimiento.
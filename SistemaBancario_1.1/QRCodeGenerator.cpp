@@ -15,6 +15,10 @@
 #include <string>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include "qrcodegen.h" // Versión en C
 #include "hpdf.h"
 #include "ListaDoble.h"
@@ -42,15 +46,66 @@ void QRCodeGenerator::generateQRImage(const string& data, vector<uint8_t>& buffe
 
     // Obtener el tamaño del QR
     size = qrcodegen_getSize(qr_buffer);
-    buffer.clear();
     buffer.resize(size * size);
 
-    // Convertir a bitmap (1 = negro, 0 = blanco)
-    for (int y = 0; y < size; y++) {
-        for (int x = 0; x < size; x++) {
-            buffer[y * size + x] = qrcodegen_getModule(qr_buffer, x, y) ? 1 : 0;
+    // Convertir a bitmap (1 = negro, 0 = blanco). qrcodegen guarda los módulos fila por fila
+    // a partir del byte 1, ocho por byte y empezando por el bit menos significativo, así que
+    // se desempaquetan byte a byte en lugar de consultar cada módulo con qrcodegen_getModule
+    const uint8_t* bits = qr_buffer + 1;
+    size_t total = buffer.size();
+    size_t i = 0;
+    for (; i + 8 <= total; i += 8) {
+        uint8_t byte = bits[i >> 3];
+        for (int b = 0; b < 8; b++) {
+            buffer[i + b] = (byte >> b) & 1;
         }
     }
+    for (; i < total; i++) {
+        buffer[i] = (bits[i >> 3] >> (i & 7)) & 1;
+    }
+}
+
+// Dibuja el QR como un único trazado de rectángulos fusionados
+size_t QRCodeGenerator::dibujarQR(HPDF_Page page, const vector<uint8_t>& buffer, int size, float x, float y, float module_size) {
+    struct Rectangulo {
+        int columna, ancho, fila, alto;
+    };
+    vector<Rectangulo> rectangulos;
+    // Para cada columna, rectángulo que empieza en ella y llega hasta la fila anterior (-1 si ninguno)
+    vector<int> abierto(size, -1), siguiente(size, -1);
+
+    for (int fila = 0; fila < size; fila++) {
+        fill(siguiente.begin(), siguiente.end(), -1);
+        const uint8_t* modulos = buffer.data() + fila * size;
+        for (int columna = 0; columna < size;) {
+            if (!modulos[columna]) {
+                columna++;
+                continue;
+            }
+            int fin = columna;
+            while (fin < size && modulos[fin]) fin++;
+
+            int previo = abierto[columna];
+            if (previo >= 0 && rectangulos[previo].ancho == fin - columna) {
+                rectangulos[previo].alto++;
+                siguiente[columna] = previo;
+            } else {
+                siguiente[columna] = static_cast<int>(rectangulos.size());
+                rectangulos.push_back({columna, fin - columna, fila, 1});
+            }
+            columna = fin;
+        }
+        abierto.swap(siguiente);
+    }
+
+    if (rectangulos.empty()) return 0;
+    HPDF_Page_SetRGBFill(page, 0, 0, 0); // Color negro
+    for (const auto& r : rectangulos) {
+        HPDF_Page_Rectangle(page, x + r.columna * module_size, y - (r.fila + r.alto - 1) * module_size,
+                            r.ancho * module_size, r.alto * module_size);
+    }
+    HPDF_Page_Fill(page);
+    return rectangulos.size();
 }
 
 // Constructor
@@ -63,19 +118,37 @@ QRCodeGenerator::QRCodeGenerator(const string& nombre, const ListaDoble<Cuenta*>
 
 // Implementación de generateQRAndPDF
 void QRCodeGenerator::generateQRAndPDF() {
+    string pdf_name = getNombreArchivo();
+    if (guardarPDF(pdf_name)) {
+        cout << "PDF con QRs generado como " << pdf_name << endl;
+    }
+}
+
+// Nombre del archivo PDF del cliente
+string QRCodeGenerator::getNombreArchivo() const {
+    // Limpiar el nombre para el nombre del archivo
+    string pdf_name = nombre;
+    replace(pdf_name.begin(), pdf_name.end(), ' ', '_');
+    return "qr_cliente_" + pdf_name + ".pdf";
+}
+
+// Escribe el PDF con una página por cuenta
+bool QRCodeGenerator::guardarPDF(const string& archivo) const {
     HPDF_Doc pdf = HPDF_New(NULL, NULL);
     if (!pdf) {
         cerr << "Error al crear el PDF" << endl;
-        return;
+        return false;
     }
+    HPDF_SetCompressionMode(pdf, HPDF_COMP_ALL);
 
     HPDF_Font font = HPDF_GetFont(pdf, "Helvetica", NULL);
     if (!font) {
         cerr << "Error al cargar la fuente Helvetica" << endl;
         HPDF_Free(pdf);
-        return;
+        return false;
     }
 
+    vector<uint8_t> qr_buffer; // Se reutiliza entre cuentas
     for (const auto& cuenta : cuentas) {
         HPDF_Page page = HPDF_AddPage(pdf);
         HPDF_Page_SetSize(page, HPDF_PAGE_SIZE_A4, HPDF_PAGE_PORTRAIT);
@@ -93,32 +166,63 @@ void QRCodeGenerator::generateQRAndPDF() {
         HPDF_Page_EndText(page);
 
         // Generar el código QR
-        vector<uint8_t> qr_buffer;
         int qr_size;
         generateQRImage(cuenta.second, qr_buffer, qr_size);
+        if (qr_size == 0) { // El error ya se informó; un PDF sin el código no sirve
+            HPDF_Free(pdf);
+            return false;
+        }
 
         // Dibujar el QR en el PDF
-        float qr_x = xPosition;
-        float qr_y = yPosition - 200;
         float module_size = 3.0; // Tamaño de cada módulo en puntos
-        HPDF_Page_SetRGBFill(page, 0, 0, 0); // Color negro
-
-        for (int y = 0; y < qr_size; y++) {
-            for (int x = 0; x < qr_size; x++) {
-                if (qr_buffer[y * qr_size + x]) {
-                    HPDF_Page_Rectangle(page, qr_x + x * module_size, qr_y - y * module_size, module_size, module_size);
-                    HPDF_Page_Fill(page);
-                }
-            }
+        dibujarQR(page, qr_buffer, qr_size, xPosition, yPosition - 200, module_size);
+    }
+
+    if (HPDF_SaveToFile(pdf, archivo.c_str()) != HPDF_OK) {
+        cerr << "Error al guardar el PDF " << archivo << endl;
+        HPDF_Free(pdf);
+        return false;
+    }
+    HPDF_Free(pdf);
+    return true;
+}
+
+// Generación en paralelo de los PDF de muchos clientes
+size_t QRCodeGenerator::generarLote(const vector<QRCodeGenerator>& generadores, unsigned hilos) {
+    // Nombres de archivo únicos (dos hilos no deben escribir el mismo archivo). Un sufijo nunca toma
+    // el nombre propio de otro cliente del lote: "Ana" repetido no puede pisar a un cliente "Ana_2"
+    vector<string> archivos;
+    archivos.reserve(generadores.size());
+    unordered_set<string> propios, usados;
+    for (const auto& generador : generadores) propios.insert(generador.getNombreArchivo());
+    unordered_map<string, int> siguiente_sufijo;
+    for (const auto& generador : generadores) {
+        string archivo = generador.getNombreArchivo();
+        if (usados.count(archivo)) {
+            string base = archivo.substr(0, archivo.size() - 4);
+            int& sufijo = siguiente_sufijo[archivo];
+            if (sufijo < 2) sufijo = 2;
+            do {
+                archivo = base + "_" + to_string(sufijo++) + ".pdf";
+            } while (usados.count(archivo) || propios.count(archivo));
         }
+        usados.insert(archivo);
+        archivos.push_back(archivo);
     }
 
-    // Limpiar el nombre para el nombre del archivo
-    string pdf_name = nombre;
-    replace(pdf_name.begin(), pdf_name.end(), ' ', '_');
-    pdf_name = "qr_cliente_" + pdf_name + ".pdf";
+    if (hilos == 0) hilos = thread::hardware_concurrency();
+    if (hilos == 0) hilos = 1;
+    hilos = static_cast<unsigned>(min<size_t>(hilos, max<size_t>(generadores.size(), 1)));
 
-    HPDF_SaveToFile(pdf, pdf_name.c_str());
-    HPDF_Free(pdf);
-    cout << "PDF con QRs generado como " << pdf_name << endl;
-}
\ No newline at end of file
+    atomic<size_t> siguiente(0), generados(0);
+    auto trabajo = [&]() {
+        for (size_t i = siguiente++; i < generadores.size(); i = siguiente++) {
+            if (generadores[i].guardarPDF(archivos[i])) generados++;
+        }
+    };
+    vector<thread> trabajadores;
+    for (unsigned t = 1; t < hilos; t++) trabajadores.emplace_back(trabajo);
+    trabajo();
+    for (auto& trabajador : trabajadores) trabajador.join();
+    return generados;
+}
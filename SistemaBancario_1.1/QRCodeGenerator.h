@@ -13,10 +13,12 @@
 #ifndef QRCODEGENERATOR_H
 #define QRCODEGENERATOR_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "ListaDoble.h"
 #include "Cuenta.h"
+#include "hpdf.h"
 
 class QRCodeGenerator {
 private:
@@ -28,7 +30,21 @@ private:
      * @param buffer Vector para almacenar la imagen QR como bitmap
      * @param size Tamaño del código QR generado
      */
-    void generateQRImage(const std::string& data, std::vector<uint8_t>& buffer, int& size);
+    static void generateQRImage(const std::string& data, std::vector<uint8_t>& buffer, int& size);
+    /**
+     * @brief Dibuja un código QR en una página como un único trazado relleno
+     * @param page Página del PDF
+     * @param buffer Módulos del código (1 = negro), fila por fila
+     * @param size Módulos por lado
+     * @param x Coordenada x de la esquina superior izquierda
+     * @param y Coordenada y de la primera fila de módulos
+     * @param module_size Tamaño de cada módulo en puntos
+     * @details Los módulos oscuros contiguos de una fila se unen en un rectángulo, y los rectángulos
+     *          con el mismo ancho en filas consecutivas se unen hacia abajo; todos se añaden a un
+     *          mismo trazado que se rellena una sola vez
+     * @return Cantidad de rectángulos del trazado
+     */
+    static size_t dibujarQR(HPDF_Page page, const std::vector<uint8_t>& buffer, int size, float x, float y, float module_size);
 
 public:
     /**
@@ -48,6 +64,32 @@ public:
      * @warning Requiere las bibliotecas qrcodegen y libharu instaladas
      */
     void generateQRAndPDF();
+
+    /**
+     * @brief Escribe el PDF con los códigos QR del cliente
+     * @param archivo Ruta del PDF a crear
+     * @return true si se generó, false si hubo un error (se informa por cerr), incluido un código QR
+     *         que no se pudo generar
+     * @details No escribe en la consola salvo errores, por lo que puede usarse desde varios hilos
+     *          a la vez (cada llamada trabaja con su propio documento)
+     */
+    bool guardarPDF(const std::string& archivo) const;
+
+    /**
+     * @brief Nombre del archivo PDF del cliente (qr_cliente_<nombre con '_'>.pdf)
+     */
+    std::string getNombreArchivo() const;
+
+    /**
+     * @brief Genera en paralelo los PDF de códigos QR de muchos clientes
+     * @param generadores Un generador por cliente
+     * @param hilos Hilos a usar (0 = los núcleos disponibles)
+     * @return Cantidad de PDF generados correctamente
+     * @details Cada hilo toma el siguiente cliente pendiente, codifica sus QR y escribe su PDF.
+     *          Si dos clientes tienen el mismo nombre, los archivos siguientes llevan un sufijo
+     *          numérico (_2, _3, ...) que no coincide con el archivo de ningún otro cliente del lote
+     */
+    static size_t generarLote(const std::vector<QRCodeGenerator>& generadores, unsigned hilos = 0);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,197 @@
+/**
+ * @file RecuperacionPuntual.cpp
+ * @brief Implementación de la reconstrucción del estado del banco en un instante.
+ */
+
+#include "RecuperacionPuntual.h"
+#include "Ahorro.h"
+#include "ArchivoMovimientos.h"
+#include "Corriente.h"
+#include "GestorClientes.h"
+#include "RespaldoDatos.h"
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Clave entera que ordena las fechas igual que sus operadores de comparación.
+ */
+int64_t RecuperacionPuntual::claveFecha(Fecha fecha) {
+    int64_t clave = fecha.get_anuario();
+    clave = clave * 13 + fecha.get_mes();
+    clave = clave * 32 + fecha.get_dia();
+    clave = clave * 24 + fecha.get_hora();
+    clave = clave * 60 + fecha.get_minutos();
+    return clave * 60 + fecha.get_segundos();
+}
+
+/**
+ * @brief Clave de un instante en hora local.
+ */
+int64_t RecuperacionPuntual::claveInstante(std::time_t instante) {
+    std::tm tm = *std::localtime(&instante);
+    return claveFecha(Fecha(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec));
+}
+
+/**
+ * @brief Día (YYYYMMDD) de un instante en hora local, con la clave de los movimientos archivados.
+ */
+int RecuperacionPuntual::diaInstante(std::time_t instante) {
+    std::tm tm = *std::localtime(&instante);
+    return GestorClientes::dateKey(Fecha(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday));
+}
+
+/**
+ * @brief Reconstruye los clientes y cuentas tal como estaban en un instante.
+ * @details Pasos:
+ *          1. Se busca en el catálogo el último respaldo completo anterior al instante cuyo archivo exista
+ *             y se restaura; las cuentas y clientes se indexan por ID y DNI.
+ *          2. Se recorre cada cuenta actual abierta hasta el instante. Si está en el respaldo, se le
+ *             agregan los movimientos con fecha posterior al respaldo y no posterior al instante; si no
+ *             tuvo ninguno, no se toca. Si no está en el respaldo, se crea con sus movimientos hasta el
+ *             instante.
+ *          El saldo de una cuenta en el instante es el saldo posterior de su último movimiento hasta
+ *          entonces; si todavía no tenía movimientos, el saldo previo al primero. Los movimientos anteriores
+ *          al horizonte de archivado se leen de los segmentos de ArchivoMovimientos, igual que en
+ *          Cuenta::consultar_movimientos_rango; si el índice o un segmento necesario no se puede leer, la
+ *          reconstrucción se rechaza en lugar de devolver saldos incompletos.
+ */
+ResultadoRecuperacion RecuperacionPuntual::reconstruir(const ListaDoble<Cliente*>& actual, std::time_t instante) {
+    ResultadoRecuperacion resultado;
+    int64_t clave_instante = claveInstante(instante);
+    int64_t clave_base = std::numeric_limits<int64_t>::min();
+    int dia_instante = diaInstante(instante);
+    int dia_base = 0;
+
+    ArchivoMovimientos& archivo = ArchivoMovimientos::general();
+    if (archivo.estaDanado()) {
+        throw std::runtime_error("El índice de movimientos archivados está dañado: no se pueden repetir los "
+                                 "movimientos anteriores al horizonte de archivado");
+    }
+    int horizonte = archivo.getHorizonte();
+
+    // 1. Respaldo base
+    CatalogoRespaldos& catalogo = RespaldoDatos::catalogo();
+    EntradaRespaldo base;
+    bool hay_base = catalogo.buscarPorFecha(TipoRespaldo::Completo, instante, base);
+    while (hay_base && !std::filesystem::exists(base.archivo)) {
+        hay_base = catalogo.buscarPorFecha(TipoRespaldo::Completo, base.fecha - 1, base);
+    }
+    if (hay_base) {
+        resultado.base = base.archivo;
+        resultado.fecha_base = base.fecha;
+        clave_base = claveInstante(base.fecha);
+        dia_base = diaInstante(base.fecha);
+        resultado.clientes = RespaldoDatos::restaurarClientesBinario(base.archivo);
+    } else {
+        resultado.clientes = new ListaDoble<Cliente*>();
+    }
+
+    std::unordered_map<std::string, Cliente*> clientes_base;
+    std::unordered_map<std::string, Cuenta*> cuentas_base;
+    resultado.clientes->recorrer([&](Cliente* cliente) {
+        clientes_base[cliente->get_dni()] = cliente;
+        cliente->get_cuentas()->recorrer([&](Cuenta* cuenta) { cuentas_base[cuenta->get_id_cuenta()] = cuenta; });
+    });
+
+    // 2. Repetición de movimientos. La bitácora de una cuenta son sus movimientos archivados antes del
+    // horizonte y los de su lista desde él; uno anterior que siga en la lista ya está en los segmentos
+    std::vector<Movimiento> bitacora, pendientes;
+    auto cargarBitacora = [&](Cuenta* cuenta, int desde, int hasta) {
+        bitacora.clear();
+        if (horizonte > 0 && desde < horizonte) {
+            archivo.consultar(cuenta->get_id_cuenta(), desde, std::min(hasta, horizonte - 1), bitacora);
+        }
+        cuenta->get_movimientos()->recorrer([&](Movimiento m) {
+            if (GestorClientes::dateKey(m) >= horizonte) bitacora.push_back(m);
+        });
+    };
+
+    try {
+        actual.recorrer([&](Cliente* cliente) {
+            Cliente* destino = nullptr;
+            auto it_cliente = clientes_base.find(cliente->get_dni());
+            if (it_cliente != clientes_base.end()) destino = it_cliente->second;
+
+            cliente->get_cuentas()->recorrer([&](Cuenta* cuenta) {
+                if (claveFecha(cuenta->get_fecha_apertura()) > clave_instante) return;
+
+                auto it_cuenta = cuentas_base.find(cuenta->get_id_cuenta());
+                if (it_cuenta != cuentas_base.end()) {
+                    // Cuenta del respaldo: solo los movimientos del intervalo (respaldo, instante]
+                    pendientes.clear();
+                    cargarBitacora(cuenta, dia_base, dia_instante);
+                    for (const Movimiento& m : bitacora) {
+                        int64_t clave = claveFecha(m.get_fecha());
+                        if (clave > clave_base && clave <= clave_instante) pendientes.push_back(m);
+                    }
+                    if (pendientes.empty()) return;
+
+                    Cuenta* restaurada = it_cuenta->second;
+                    for (const Movimiento& m : pendientes) restaurada->get_movimientos()->insertar_cola(m);
+                    restaurada->set_saldo(pendientes.back().get_saldo_post_movimiento());
+                    resultado.cuentas_actualizadas++;
+                    resultado.movimientos_aplicados += pendientes.size();
+                    return;
+                }
+
+                // Cuenta abierta después del respaldo: se copia con su historial hasta el instante, leído
+                // completo para tener el primer movimiento posterior al instante aunque esté archivado
+                cargarBitacora(cuenta, 0, std::numeric_limits<int>::max());
+                Cuenta* copia = nullptr;
+                if (Ahorro* ahorro = dynamic_cast<Ahorro*>(cuenta)) {
+                    copia = new Ahorro(cuenta->get_id_cuenta(), 0, cuenta->get_fecha_apertura(), ahorro->get_tasa_interes());
+                } else if (Corriente* corriente = dynamic_cast<Corriente*>(cuenta)) {
+                    copia = new Corriente(cuenta->get_id_cuenta(), 0, cuenta->get_fecha_apertura(),
+                                          corriente->get_limite_retiro_diario());
+                } else {
+                    return;
+                }
+                copia->set_branchId(cuenta->get_branchId());
+                copia->set_appointmentTime(cuenta->get_appointmentTime());
+
+                double saldo = cuenta->get_saldo();
+                bool hay_anterior = false, hay_posterior = false;
+                for (const Movimiento& m : bitacora) {
+                    if (claveFecha(m.get_fecha()) <= clave_instante) {
+                        copia->get_movimientos()->insertar_cola(m);
+                        saldo = m.get_saldo_post_movimiento();
+                        hay_anterior = true;
+                        resultado.movimientos_aplicados++;
+                    } else if (!hay_anterior && !hay_posterior) {
+                        // Saldo previo al primer movimiento
+                        bool deposito = m.get_tipo() != "Retiro";
+                        saldo = m.get_saldo_post_movimiento() + (deposito ? -m.get_monto() : m.get_monto());
+                        hay_posterior = true;
+                    }
+                }
+                copia->set_saldo(saldo);
+
+                if (!destino) {
+                    destino = new Cliente(cliente->get_dni(), cliente->get_nombres(), cliente->get_apellidos(),
+                                          cliente->get_direccion(), cliente->get_telefono(), cliente->get_email(),
+                                          cliente->get_fecha_nacimiento(), cliente->get_contrasenia());
+                    resultado.clientes->insertar_cola(destino);
+                    clientes_base[destino->get_dni()] = destino;
+                }
+                destino->agregar_cuenta(copia);
+                cuentas_base[copia->get_id_cuenta()] = copia;
+                resultado.cuentas_agregadas++;
+            });
+        });
+    } catch (const std::exception& e) {
+        delete resultado.clientes;
+        throw std::runtime_error(std::string("No se pudo leer la bitácora de movimientos: ") + e.what());
+    }
+
+    resultado.clientes->recorrer([&](Cliente* cliente) {
+        cliente->get_cuentas()->recorrer([&](Cuenta* cuenta) {
+            resultado.cuentas++;
+            resultado.saldo_total += cuenta->get_saldo();
+        });
+    });
+    return resultado;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file RecuperacionPuntual.h
+ * @brief Definición de la clase RecuperacionPuntual, reconstrucción del estado del banco en un instante.
+ *
+ * El estado se arma a partir del respaldo completo más cercano anterior al instante (buscado en el catálogo
+ * de respaldos) y del historial de movimientos de los datos actuales, que hace de bitácora: a cada cuenta
+ * se le agregan los movimientos posteriores al respaldo y hasta el instante pedido, y su saldo pasa a ser el
+ * saldo posterior al último de ellos. Las cuentas sin movimientos en ese intervalo quedan tal como están en
+ * el respaldo, sin copiarse ni recalcularse. Los movimientos que ya se archivaron fuera del archivo de datos
+ * se toman de ArchivoMovimientos.
+ */
+
+#ifndef RECUPERACIONPUNTUAL_H_INCLUDED
+#define RECUPERACIONPUNTUAL_H_INCLUDED
+
+#include "Cliente.h"
+#include "Fecha.h"
+#include "ListaDoble.h"
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+/**
+ * @struct ResultadoRecuperacion
+ * @brief Estado reconstruido y estadísticas de la reconstrucción.
+ */
+struct ResultadoRecuperacion {
+    ListaDoble<Cliente*>* clientes = nullptr; ///< Clientes en el instante pedido (pertenecen a quien llama)
+    std::string base;                         ///< Respaldo usado como base (vacío si se partió de cero)
+    std::time_t fecha_base = 0;               ///< Momento del respaldo base
+    size_t cuentas = 0;                       ///< Cuentas existentes en el instante
+    size_t cuentas_actualizadas = 0;          ///< Cuentas del respaldo a las que se aplicaron movimientos
+    size_t cuentas_agregadas = 0;             ///< Cuentas abiertas después del respaldo
+    size_t movimientos_aplicados = 0;         ///< Movimientos tomados de la bitácora
+    double saldo_total = 0;                   ///< Suma de saldos en el instante
+};
+
+/**
+ * @class RecuperacionPuntual
+ * @brief Motor de recuperación a un instante arbitrario: respaldo base más repetición de movimientos.
+ */
+class RecuperacionPuntual {
+public:
+    /**
+     * @brief Reconstruye los clientes y cuentas tal como estaban en un instante.
+     * @param actual Clientes actuales; su historial de movimientos es la bitácora que se repite
+     * @param instante Momento a reconstruir (hora local)
+     * @return Estado reconstruido; la lista de clientes es nueva y no comparte objetos con actual
+     * @details Las cuentas abiertas después del instante no aparecen. Los clientes que no están en el
+     *          respaldo se incluyen solo si tenían alguna cuenta abierta en el instante. Los datos
+     *          personales y las cuentas que ya no existen se toman del respaldo.
+     * @throw std::runtime_error Si hacen falta movimientos archivados y su índice o un segmento no se puede leer
+     */
+    static ResultadoRecuperacion reconstruir(const ListaDoble<Cliente*>& actual, std::time_t instante);
+
+    /**
+     * @brief Clave entera que ordena las fechas igual que sus operadores de comparación.
+     */
+    static int64_t claveFecha(Fecha fecha);
+    /**
+     * @brief Clave de un instante en hora local.
+     */
+    static int64_t claveInstante(std::time_t instante);
+    /**
+     * @brief Día (YYYYMMDD) de un instante en hora local, con la clave de los movimientos archivados.
+     */
+    static int diaInstante(std::time_t instante);
+};
+
+#endif
@@ -0,0 +1,18 @@
+/**
+ * @file ReemplazoArchivo.cpp
+ * @brief Implementación del reemplazo atómico de un archivo por su temporal.
+ */
+
+#include "ReemplazoArchivo.h"
+#include <cstdio>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+bool reemplazarArchivo(const std::string& temporal, const std::string& destino) {
+#ifdef _WIN32
+    return MoveFileExA(temporal.c_str(), destino.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(temporal.c_str(), destino.c_str()) == 0;
+#endif
+}
@@ -0,0 +1,27 @@
+/**
+ * @file ReemplazoArchivo.h
+ * @brief Reemplazo atómico de un archivo por su temporal ya escrito.
+ *
+ * Los archivos que se guardan completos (datos, catálogo de respaldos, agenda, índice y segmentos de
+ * movimientos) se escriben primero en un temporal y después toman el nombre definitivo. En Windows
+ * rename no reemplaza un archivo existente, y borrar el destino antes de renombrar deja un instante
+ * sin ningún archivo: un corte ahí pierde la versión anterior y la nueva.
+ */
+
+#ifndef REEMPLAZOARCHIVO_H_INCLUDED
+#define REEMPLAZOARCHIVO_H_INCLUDED
+
+#include <string>
+
+/**
+ * @brief Da al temporal el nombre del destino, reemplazándolo en un solo paso.
+ * @details En Windows usa MoveFileEx con MOVEFILE_REPLACE_EXISTING y MOVEFILE_WRITE_THROUGH; en los
+ *          demás sistemas rename ya reemplaza el destino de forma atómica. Si falla, el destino anterior
+ *          queda intacto y el temporal sigue en disco.
+ * @param temporal Archivo recién escrito
+ * @param destino Archivo que se reemplaza
+ * @return true si el destino quedó con el contenido del temporal
+ */
+bool reemplazarArchivo(const std::string& temporal, const std::string& destino);
+
+#endif // REEMPLAZOARCHIVO_H_INCLUDED
@@ -0,0 +1,116 @@
+/**
+ * @file RespaldoAsincrono.cpp
+ * @brief Implementación del hilo de respaldos en segundo plano.
+ */
+
+#include "RespaldoAsincrono.h"
+#include <chrono>
+#include <iostream>
+
+/**
+ * @brief Constructor. El hilo se crea con la primera solicitud.
+ */
+RespaldoAsincrono::RespaldoAsincrono()
+    : ultima_solicitud(0), solicitud_pendiente(0), atendida(0), detener(false) {}
+
+/**
+ * @brief Destructor. Termina el respaldo pendiente y detiene el hilo.
+ */
+RespaldoAsincrono::~RespaldoAsincrono() {
+    {
+        std::lock_guard<std::mutex> bloqueo(mutex);
+        detener = true;
+    }
+    hay_trabajo.notify_all();
+    if (hilo.joinable()) hilo.join();
+}
+
+/**
+ * @brief Captura una instantánea de los clientes y la encola para respaldarla.
+ * @details La captura se hace en el hilo que llama, así refleja exactamente el estado guardado;
+ *          la escritura del archivo y el registro en el catálogo quedan para el hilo de respaldos.
+ */
+uint64_t RespaldoAsincrono::solicitar(const ListaDoble<Cliente*>& clientes) {
+    std::unique_ptr<InstantaneaClientes> instantanea(
+        new InstantaneaClientes(RespaldoDatos::capturarInstantanea(clientes)));
+
+    uint64_t numero;
+    {
+        std::lock_guard<std::mutex> bloqueo(mutex);
+        numero = ++ultima_solicitud;
+        estado.solicitados++;
+        if (pendiente) estado.combinados++;
+        pendiente = std::move(instantanea);
+        solicitud_pendiente = numero;
+        if (!hilo.joinable()) hilo = std::thread(&RespaldoAsincrono::trabajar, this);
+    }
+    hay_trabajo.notify_one();
+    return numero;
+}
+
+/**
+ * @brief Bloquea hasta que se escriba un respaldo que incluya la solicitud indicada.
+ */
+bool RespaldoAsincrono::esperar(uint64_t solicitud) {
+    std::unique_lock<std::mutex> bloqueo(mutex);
+    terminado.wait(bloqueo, [&] { return atendida >= solicitud || atendida >= ultima_solicitud; });
+    return estado.ultimo_exito;
+}
+
+/**
+ * @brief Bloquea hasta que no quede ningún respaldo pendiente ni en curso.
+ */
+void RespaldoAsincrono::esperar() {
+    std::unique_lock<std::mutex> bloqueo(mutex);
+    terminado.wait(bloqueo, [&] { return atendida >= ultima_solicitud; });
+}
+
+/**
+ * @brief Copia del estado actual.
+ */
+EstadoRespaldoAsincrono RespaldoAsincrono::getEstado() const {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    return estado;
+}
+
+/**
+ * @brief Ciclo del hilo: toma la instantánea pendiente, la escribe y actualiza el estado.
+ * @details Al pedir la detención se escribe igualmente la instantánea pendiente, para que cerrar el
+ *          programa justo después de guardar no pierda el respaldo.
+ */
+void RespaldoAsincrono::trabajar() {
+    std::unique_lock<std::mutex> bloqueo(mutex);
+    while (true) {
+        hay_trabajo.wait(bloqueo, [&] { return pendiente || detener; });
+        if (!pendiente) break;
+
+        std::unique_ptr<InstantaneaClientes> instantanea = std::move(pendiente);
+        uint64_t numero = solicitud_pendiente;
+        estado.en_curso = true;
+        bloqueo.unlock();
+
+        auto inicio = std::chrono::steady_clock::now();
+        std::string archivo;
+        try {
+            archivo = RespaldoDatos::guardarInstantaneaConFecha(*instantanea);
+        } catch (const std::exception& e) {
+            std::cerr << "Error en respaldo en segundo plano: " << e.what() << std::endl;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+        instantanea.reset();
+
+        bloqueo.lock();
+        estado.en_curso = false;
+        estado.completados++;
+        estado.ultimo_exito = !archivo.empty();
+        if (estado.ultimo_exito) {
+            estado.ultimo_archivo = archivo;
+        } else {
+            estado.fallidos++;
+        }
+        estado.ultima_fecha = std::time(nullptr);
+        estado.ultimo_ms = ms;
+        atendida = numero;
+        terminado.notify_all();
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file RespaldoAsincrono.h
+ * @brief Definición de la clase RespaldoAsincrono, respaldos con marca de tiempo en un hilo dedicado.
+ *
+ * Guardar los datos ya no espera a que se escriba el respaldo: en el hilo que guarda solo se captura
+ * una instantánea de los clientes (RespaldoDatos::capturarInstantanea), cuyo costo no depende de la
+ * cantidad de movimientos, y el hilo de respaldos la escribe y la registra en el catálogo. Cada
+ * solicitud devuelve un número con el que se puede esperar su finalización o consultar el estado.
+ */
+
+#ifndef RESPALDOASINCRONO_H_INCLUDED
+#define RESPALDOASINCRONO_H_INCLUDED
+
+#include "RespaldoDatos.h"
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @struct EstadoRespaldoAsincrono
+ * @brief Contadores y resultado del último respaldo en segundo plano.
+ */
+struct EstadoRespaldoAsincrono {
+    uint64_t solicitados = 0;    ///< Instantáneas pedidas
+    uint64_t completados = 0;    ///< Respaldos terminados (con o sin éxito)
+    uint64_t combinados = 0;     ///< Solicitudes reemplazadas por otra más reciente antes de escribirse
+    uint64_t fallidos = 0;       ///< Respaldos que no se pudieron escribir
+    bool en_curso = false;       ///< Si el hilo está escribiendo un respaldo
+    bool ultimo_exito = false;   ///< Resultado del último respaldo terminado
+    std::string ultimo_archivo;  ///< Archivo del último respaldo escrito
+    std::time_t ultima_fecha = 0; ///< Momento en que terminó el último respaldo
+    double ultimo_ms = 0;        ///< Duración de la escritura del último respaldo
+};
+
+/**
+ * @class RespaldoAsincrono
+ * @brief Hilo de respaldos que escribe instantáneas de los clientes sin bloquear la interfaz.
+ *
+ * Hay a lo sumo una instantánea pendiente: si llega otra antes de que el hilo la tome, la reemplaza,
+ * porque la más reciente ya contiene todo lo de la anterior. Las instantáneas apuntan a los historiales
+ * de las cuentas, así que antes de eliminar clientes o cuentas hay que llamar a esperar().
+ */
+class RespaldoAsincrono {
+public:
+    /**
+     * @brief Constructor. El hilo se crea con la primera solicitud.
+     */
+    RespaldoAsincrono();
+    /**
+     * @brief Destructor. Termina el respaldo pendiente y detiene el hilo.
+     */
+    ~RespaldoAsincrono();
+    RespaldoAsincrono(const RespaldoAsincrono&) = delete;
+    RespaldoAsincrono& operator=(const RespaldoAsincrono&) = delete;
+
+    /**
+     * @brief Captura una instantánea de los clientes y la encola para respaldarla.
+     * @param clientes Lista de clientes actual
+     * @return Número de la solicitud, para esperar(uint64_t)
+     */
+    uint64_t solicitar(const ListaDoble<Cliente*>& clientes);
+    /**
+     * @brief Bloquea hasta que se escriba un respaldo que incluya la solicitud indicada.
+     * @param solicitud Número devuelto por solicitar()
+     * @return Resultado del último respaldo terminado
+     */
+    bool esperar(uint64_t solicitud);
+    /**
+     * @brief Bloquea hasta que no quede ningún respaldo pendiente ni en curso.
+     */
+    void esperar();
+    /**
+     * @brief Copia del estado actual.
+     */
+    EstadoRespaldoAsincrono getEstado() const;
+
+private:
+    std::thread hilo;                              ///< Hilo de respaldos
+    mutable std::mutex mutex;                      ///< Protege todo lo que sigue
+    std::condition_variable hay_trabajo;           ///< Avisa al hilo de una solicitud o de la detención
+    std::condition_variable terminado;             ///< Avisa a quienes esperan que terminó un respaldo
+    std::unique_ptr<InstantaneaClientes> pendiente; ///< Instantánea aún no tomada por el hilo
+    uint64_t ultima_solicitud;                     ///< Número de la última solicitud
+    uint64_t solicitud_pendiente;                  ///< Número de la instantánea pendiente
+    uint64_t atendida;                             ///< Mayor solicitud incluida en un respaldo terminado
+    bool detener;                                  ///< Pide al hilo que termine
+    EstadoRespaldoAsincrono estado;                ///< Contadores expuestos por getEstado()
+
+    /**
+     * @brief Ciclo del hilo: toma la instantánea pendiente, la escribe y actualiza el estado.
+     */
+    void trabajar();
+};
+
+#endif
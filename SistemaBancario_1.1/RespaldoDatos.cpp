@@ -28,174 +28,71 @@ using namespace std;
  *          - Manejo de strings con longitud variable
  */
 void RespaldoDatos::respaldoClientesBinario(const std::string& nombreArchivo, const ListaDoble<Cliente*>& clientes) {
-    ofstream archivo(nombreArchivo, ios::binary);
-    if (!archivo) return;
-
-    // Contar total de clientes para escribir en el archivo
-    int totalClientes = 0;
-    clientes.recorrer([&](Cliente*) { totalClientes++; });
-    archivo.write(reinterpret_cast<char*>(&totalClientes), sizeof(int));
-
-    // Recorrer y serializar cada cliente
-    clientes.recorrer([&](Cliente* cliente) {
-        // Lambda para escribir strings con longitud variable
-        auto escribir_string = [&](const string& s) {
-            size_t len = s.size();
-            archivo.write(reinterpret_cast<const char*>(&len), sizeof(size_t));
-            archivo.write(s.c_str(), len);
-        };
-
-        // Escribir datos personales del cliente
-        escribir_string(cliente->get_dni());
-        escribir_string(cliente->get_nombres());
-        escribir_string(cliente->get_apellidos());
-        escribir_string(cliente->get_direccion());
-        escribir_string(cliente->get_telefono());
-        escribir_string(cliente->get_email());
-        escribir_string(cliente->get_contrasenia());
-        Fecha fechaNac = cliente->get_fecha_nacimiento();
-        archivo.write(reinterpret_cast<const char*>(&fechaNac), sizeof(Fecha));
-
-        // Serializar cuentas del cliente
-        int totalCuentas = 0;
-        cliente->get_cuentas()->recorrer([&](Cuenta*) { totalCuentas++; });
-        archivo.write(reinterpret_cast<char*>(&totalCuentas), sizeof(int));
-
-        cliente->get_cuentas()->recorrer([&](Cuenta* cuenta) {
-            // Escribir información básica de la cuenta
-            escribir_string(cuenta->get_tipo());
-            escribir_string(cuenta->get_id_cuenta());
-            double saldo = cuenta->get_saldo();
-            archivo.write(reinterpret_cast<const char*>(&saldo), sizeof(double));
-            Fecha fechaApertura = cuenta->get_fecha_apertura();
-            archivo.write(reinterpret_cast<const char*>(&fechaApertura), sizeof(Fecha));
-
-            // Escribir datos específicos según el tipo de cuenta
-            if (cuenta->get_tipo() == "Ahorros") {
-                double tasa = static_cast<Ahorro*>(cuenta)->get_tasa_interes();
-                archivo.write(reinterpret_cast<const char*>(&tasa), sizeof(double));
-            } else if (cuenta->get_tipo() == "Corriente") {
-                double limite = static_cast<Corriente*>(cuenta)->get_limite_retiro_diario();
-                archivo.write(reinterpret_cast<const char*>(&limite), sizeof(double));
-            }
+    escribirInstantanea(nombreArchivo, capturarInstantanea(clientes));
+}
+
+/**
+ * @brief Captura una vista consistente de los clientes
+ * @param clientes Lista de clientes actual
+ * @return Instantánea con los datos personales, saldos y límites del historial de cada cuenta
+ * @details Copia los datos de clientes y cuentas, pero de cada historial solo guarda sus nodos
+ *          extremos; el saldo y el último movimiento se toman juntos, así que son coherentes entre sí.
+ *          La instantánea guarda también la hora de la captura, que es la fecha del respaldo.
+ */
+InstantaneaClientes RespaldoDatos::capturarInstantanea(const ListaDoble<Cliente*>& clientes) {
+    return SerializadorClientes::capturar(clientes);
+}
+
+/**
+ * @brief Escribe una instantánea con el formato de SerializadorClientes
+ * @param nombreArchivo Nombre del archivo donde guardar el respaldo
+ * @param instantanea Vista capturada con capturarInstantanea
+ * @return true si el archivo se escribió completo
+ * @details Puede ejecutarse en otro hilo mientras la interfaz sigue registrando movimientos:
+ *          cada historial se recorre desde su primer nodo hasta el último capturado, sin pasar de él.
+ */
+bool RespaldoDatos::escribirInstantanea(const std::string& nombreArchivo, const InstantaneaClientes& instantanea) {
+    FILE* archivo = fopen(nombreArchivo.c_str(), "wb");
+    if (!archivo) return false;
 
-            // Serializar movimientos de la cuenta
-            int totalMovimientos = 0;
-            cuenta->get_movimientos()->recorrer([&](Movimiento) { totalMovimientos++; });
-            archivo.write(reinterpret_cast<char*>(&totalMovimientos), sizeof(int));
-            cuenta->get_movimientos()->recorrer([&](Movimiento m) {
-                std::string tipo = m.get_tipo();
-                size_t len = tipo.size();
-                archivo.write(reinterpret_cast<const char*>(&len), sizeof(size_t));
-                archivo.write(tipo.c_str(), len);
-
-                double monto = m.get_monto();
-                archivo.write(reinterpret_cast<const char*>(&monto), sizeof(double));
-                Fecha fecha = m.get_fecha();
-                archivo.write(reinterpret_cast<const char*>(&fecha), sizeof(Fecha));
-                double saldo_post = m.get_saldo_post_movimiento();
-                archivo.write(reinterpret_cast<const char*>(&saldo_post), sizeof(double));
-            });
-        });
-    });
-
-    archivo.close();
+    bool escrito = true;
+    try {
+        EscritorBinario escritor(archivo);
+        SerializadorClientes::escribir(escritor, instantanea);
+        escritor.vaciar();
+    } catch (const std::exception& e) {
+        std::cerr << "Error en escribirInstantanea: " << e.what() << std::endl;
+        escrito = false;
+    }
+    return fclose(archivo) == 0 && escrito;
 }
 
 /**
  * @brief Restaura clientes desde un archivo binario
  * @param nombreArchivo Nombre del archivo binario a restaurar
  * @return Puntero a ListaDoble con los clientes restaurados
- * @details Deserializa un archivo binario y reconstruye la estructura completa:
- *          - Crea objetos Cliente con todos sus datos
- *          - Reconstruye cuentas Ahorro y Corriente
- *          - Restaura el historial completo de movimientos
- *          - Maneja strings de longitud variable correctamente
+ * @details Deserializa un archivo binario con SerializadorClientes, que reconoce también el formato
+ *          anterior de los respaldos y reparte los clientes entre varios hilos cuando el respaldo tiene
+ *          índice. Las cuentas y movimientos con valores inválidos se omiten; si una parte del archivo
+ *          está truncada o dañada, se devuelven los clientes completos que se pudieron leer.
  */
 ListaDoble<Cliente*>* RespaldoDatos::restaurarClientesBinario(const std::string& nombreArchivo) {
     ListaDoble<Cliente*>* clientes = new ListaDoble<Cliente*>();
-    ifstream archivo(nombreArchivo, ios::binary);
-    if (!archivo) return clientes;
-
-    // Leer total de clientes
-    int totalClientes = 0;
-    archivo.read(reinterpret_cast<char*>(&totalClientes), sizeof(int));
-    
-    // Lambda para leer strings con longitud variable
-    auto leer_string = [&](string& s) {
-        size_t len = 0;
-        archivo.read(reinterpret_cast<char*>(&len), sizeof(size_t));
-        s.resize(len);
-        archivo.read(&s[0], len);
-    };
-
-    // Restaurar cada cliente
-    for (int i = 0; i < totalClientes; ++i) {
-        // Leer datos personales del cliente
-        string dni, nombre, apellido, direccion, telefono, email, contrasenia;
-        leer_string(dni);
-        leer_string(nombre);
-        leer_string(apellido);
-        leer_string(direccion);
-        leer_string(telefono);
-        leer_string(email);
-        leer_string(contrasenia);
-
-        Fecha fechaNacimiento;
-        archivo.read(reinterpret_cast<char*>(&fechaNacimiento), sizeof(Fecha));
-
-        // Crear objeto Cliente
-        Cliente* cliente = new Cliente(dni, nombre, apellido, direccion, telefono, email, fechaNacimiento, contrasenia);
-
-        // Restaurar cuentas del cliente
-        int totalCuentas = 0;
-        archivo.read(reinterpret_cast<char*>(&totalCuentas), sizeof(int));
-        for (int j = 0; j < totalCuentas; ++j) {
-            // Leer información básica de la cuenta
-            string tipo, id;
-            leer_string(tipo);
-            leer_string(id);
-            double saldo;
-            archivo.read(reinterpret_cast<char*>(&saldo), sizeof(double));
-            Fecha fechaApertura;
-            archivo.read(reinterpret_cast<char*>(&fechaApertura), sizeof(Fecha));
-
-            // Crear cuenta específica según el tipo
-            Cuenta* cuenta = nullptr;
-            if (tipo == "Ahorros") {
-                double tasa;
-                archivo.read(reinterpret_cast<char*>(&tasa), sizeof(double));
-                cuenta = new Ahorro(id, saldo, fechaApertura, tasa);
-            } else if (tipo == "Corriente") {
-                double limite;
-                archivo.read(reinterpret_cast<char*>(&limite), sizeof(double));
-                cuenta = new Corriente(id, saldo, fechaApertura, limite);
-            }
-
-            // Restaurar movimientos de la cuenta
-            int totalMovimientos = 0;
-            archivo.read(reinterpret_cast<char*>(&totalMovimientos), sizeof(int));
-            for (int k = 0; k < totalMovimientos; ++k) {
-                string tipoMov;
-                leer_string(tipoMov);
-                double monto;
-                archivo.read(reinterpret_cast<char*>(&monto), sizeof(double));
-                Fecha fecha;
-                archivo.read(reinterpret_cast<char*>(&fecha), sizeof(Fecha));
-                double saldo_post;
-                archivo.read(reinterpret_cast<char*>(&saldo_post), sizeof(double));
-
-                Movimiento mov(tipoMov, monto, fecha, saldo_post);
-                cuenta->get_movimientos()->insertar_cola(mov);
-            }
+    LecturaClientes lectura;
+    try {
+        lectura = SerializadorClientes::leerArchivo(nombreArchivo, FormatoClientes::LegadoRespaldo, *clientes);
+    } catch (const std::exception&) {
+        return clientes; // El archivo no existe o no se puede abrir
+    }
 
-            // Agregar cuenta al cliente si fue creada exitosamente
-            if (cuenta) cliente->agregar_cuenta(cuenta);
-        }
-        // Agregar cliente a la lista
-        clientes->insertar_cola(cliente);
+    if (lectura.descartados > 0) {
+        std::cerr << "Respaldo " << nombreArchivo << ": se omitieron " << lectura.descartados
+                  << " registros con valores inválidos (último: " << lectura.ultimo_descarte << ")" << std::endl;
+    }
+    if (!lectura.error.empty()) {
+        std::cerr << "Error en restaurarClientesBinario: " << lectura.error << ". Se recuperaron " << lectura.leidos
+                  << " de " << lectura.total << " clientes de " << nombreArchivo << std::endl;
     }
-    archivo.close();
     return clientes;
 }
 
@@ -203,25 +100,51 @@ ListaDoble<Cliente*>* RespaldoDatos::restaurarClientesBinario(const std::string&
  * @brief Guarda un respaldo de clientes con marca de tiempo automática
  * @param clientes Lista de clientes a respaldar
  * @details Genera un archivo de respaldo binario con nombre que incluye fecha y hora
- *          en formato YYYYMMDD_HHMMSS para identificación única. Opcionalmente
+ *          en formato YYYYMMDD_HHMMSS para identificación única y lo registra en el
+ *          catálogo con su tamaño, huella y cantidad de clientes. Opcionalmente
  *          puede cifrar el archivo usando cifrado César.
  */
 void RespaldoDatos::guardarRespaldoClientesConFecha(const ListaDoble<Cliente*>& clientes) {
-    // Generar nombre de archivo con timestamp
-    auto t = std::time(nullptr);
-    auto tm = *std::localtime(&t);
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y%m%d_%H%M%S");
-    std::string nombreArchivo = "backup_clientes_" + oss.str() + ".bin";
-    
-    // Llamar al método de respaldo binario
-    respaldoClientesBinario(nombreArchivo, clientes);
-    
+    guardarInstantaneaConFecha(capturarInstantanea(clientes));
+
     // Opcional: cifrar el archivo (deshabilitado por defecto)
     //int numCesar = 3; // Puedes cambiar el número de desplazamiento
     //cifrarArchivoABaseTxt(nombreArchivo, numCesar);
 }
 
+/**
+ * @brief Escribe una instantánea como respaldo con marca de tiempo y la registra en el catálogo
+ * @param instantanea Vista capturada con capturarInstantanea
+ * @return Nombre del archivo generado, o vacío si no se pudo escribir
+ */
+std::string RespaldoDatos::guardarInstantaneaConFecha(const InstantaneaClientes& instantanea) {
+    // El nombre y la fecha del catálogo son los de la captura, no los de la escritura: los movimientos
+    // registrados mientras tanto no están en el respaldo y la recuperación puntual debe repetirlos
+    std::time_t t = instantanea.fecha;
+    std::tm tm;  // Se llama desde el hilo de respaldos: localtime comparte su resultado entre hilos
+#ifdef _WIN32
+    localtime_s(&tm, &t);
+#else
+    localtime_r(&t, &tm);
+#endif
+    std::ostringstream oss;
+    oss << std::put_time(&tm, "%Y%m%d_%H%M%S");
+    std::string nombreArchivo = "backup_clientes_" + oss.str() + ".bin";
+
+    if (!escribirInstantanea(nombreArchivo, instantanea)) return "";
+
+    // Registrar el respaldo en el catálogo
+    EntradaRespaldo entrada;
+    entrada.archivo = nombreArchivo;
+    entrada.fecha = t;
+    entrada.tipo = TipoRespaldo::Completo;
+    entrada.clientes = static_cast<uint32_t>(instantanea.clientes.size());
+    if (CatalogoRespaldos::medirArchivo(nombreArchivo, entrada)) {
+        catalogo().registrar(entrada);
+    }
+    return nombreArchivo;
+}
+
 /**
  * @brief Restaura clientes desde un archivo de texto cifrado
  * @param archivoTxt Nombre del archivo de texto cifrado
@@ -238,34 +161,28 @@ ListaDoble<Cliente*>* RespaldoDatos::restaurarClientesDesdeTxt(const std::string
     return restaurarClientesBinario(archivoBin);
 }
 
+/**
+ * @brief Catálogo de respaldos compartido por todo el sistema
+ * @return Referencia al catálogo, que se lee del disco en la primera consulta
+ */
+CatalogoRespaldos& RespaldoDatos::catalogo() {
+    static CatalogoRespaldos instancia;
+    return instancia;
+}
+
 /**
  * @brief Obtiene el nombre del último archivo de respaldo disponible
  * @return String con el nombre del archivo de respaldo más reciente
- * @details Busca en el directorio actual archivos de respaldo con formato
- *          "backup_clientes_YYYYMMDD_HHMMSS.bin" y devuelve el más reciente
- *          basándose en la marca de tiempo. Si no encuentra ninguno, busca
- *          el archivo legacy "respaldo_clientes.bin".
+ * @details Toma la última entrada completa del catálogo. Si su archivo fue borrado, la quita del
+ *          catálogo y prueba con la anterior. Si no hay ninguno, devuelve el archivo legacy
+ *          "respaldo_clientes.bin" cuando existe.
  */
 string RespaldoDatos::obtenerUltimoRespaldo() {
-    std::vector<std::pair<std::string, std::time_t>> backups;
-
-    for (const auto& entry : fs::directory_iterator(".")) {
-        std::string nombre = entry.path().filename().string();
-        if (nombre.find("backup_clientes_") == 0 && nombre.substr(nombre.size() - 4) == ".bin") {
-            std::string timestampStr = nombre.substr(16, nombre.size() - 20);
-            std::tm tm = {};
-            std::istringstream ss(timestampStr);
-            ss >> std::get_time(&tm, "%Y%m%d_%H%M%S");
-            if (ss.fail()) continue;
-            std::time_t tiempo = std::mktime(&tm);
-            backups.emplace_back(nombre, tiempo);
-        }
-    }
-
-    if (!backups.empty()) {
-        std::sort(backups.begin(), backups.end(), 
-            [](const auto& a, const auto& b) { return a.second > b.second; });
-        return backups[0].first;
+    CatalogoRespaldos& respaldos = catalogo();
+    EntradaRespaldo ultimo;
+    while (respaldos.ultimo(TipoRespaldo::Completo, ultimo)) {
+        if (fs::exists(ultimo.archivo)) return ultimo.archivo;
+        respaldos.quitar(ultimo.archivo);
     }
     if (fs::exists("respaldo_clientes.bin")) {
         return "respaldo_clientes.bin";
@@ -273,6 +190,16 @@ string RespaldoDatos::obtenerUltimoRespaldo() {
     return "";
 }
 
+/**
+ * @brief Obtiene el respaldo vigente en una fecha
+ * @param fecha Momento a consultar
+ * @return Nombre del respaldo más reciente generado en o antes de la fecha, o vacío si no hay
+ */
+string RespaldoDatos::obtenerRespaldoEnFecha(std::time_t fecha) {
+    EntradaRespaldo entrada;
+    return catalogo().buscarPorFecha(TipoRespaldo::Completo, fecha, entrada) ? entrada.archivo : "";
+}
+
 /**
  * @brief Aplica cifrado César a una cadena de texto
  * @param cifradoCesar Referencia a la cadena a cifrar (se modifica)
@@ -361,6 +288,21 @@ void RespaldoDatos::cifrarArchivoABaseTxt(const std::string& archivoBin, int num
             out << contenido.substr(i, ancho) << '\n';
         }
         out.close();
+
+        // Registrar el cifrado en el catálogo, con el binario de origen como base
+        EntradaRespaldo entrada;
+        entrada.archivo = archivoTxt;
+        entrada.fecha = std::time(nullptr);
+        entrada.tipo = TipoRespaldo::Cifrado;
+        entrada.base = archivoBin;
+        EntradaRespaldo origen;
+        if (catalogo().buscar(archivoBin, origen)) {
+            entrada.fecha = origen.fecha;
+            entrada.clientes = origen.clientes;
+        }
+        if (CatalogoRespaldos::medirArchivo(archivoTxt, entrada)) {
+            catalogo().registrar(entrada);
+        }
     }
 }
 
@@ -382,11 +324,11 @@ string RespaldoDatos::decifrarTxtABinario(const std::string& archivoTxt, int num
         throw std::runtime_error("No se pudo abrir el archivo: " + archivoTxt);
     }
     
-    // Leer el contenido cifrado línea por línea
-    std::string contenido;
-    char c;
-    while (in.get(c)) {
-        contenido += c;
+    // Leer el contenido cifrado línea por línea, sin los saltos de línea que agrega el cifrado
+    std::string contenido, linea;
+    while (std::getline(in, linea)) {
+        if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+        contenido += linea;
     }
     in.close();
 
@@ -415,82 +357,39 @@ string RespaldoDatos::decifrarTxtABinario(const std::string& archivoTxt, int num
 /**
  * @brief Obtiene el último archivo de texto cifrado disponible
  * @return String con el nombre del archivo de texto cifrado más reciente
- * @details Busca archivos con patrón "backup_clientes_*_cifrado.txt" y devuelve
- *          el más reciente basándose en la marca de tiempo del nombre
+ * @details Toma la última entrada cifrada del catálogo de respaldos
  */
 string RespaldoDatos::obtenerUltimoTxtCifrado() {
-    std::vector<std::pair<std::string, std::time_t>> backupsTxt;
-
-    for (const auto& entry : fs::directory_iterator(".")) {
-        std::string nombre = entry.path().filename().string();
-        if (nombre.find("backup_clientes_") == 0 && nombre.find("_cifrado.txt") != std::string::npos) {
-            std::string timestampStr = nombre.substr(16, 15); // 15 caracteres para YYYYMMDD_HHMMSS
-            std::tm tm = {};
-            std::istringstream ss(timestampStr);
-            ss >> std::get_time(&tm, "%Y%m%d_%H%M%S");
-            if (!ss.fail()) {
-                std::time_t tiempo = std::mktime(&tm);
-                backupsTxt.emplace_back(nombre, tiempo);
-            }
-        }
-    }
-
-    if (!backupsTxt.empty()) {
-        std::sort(backupsTxt.begin(), backupsTxt.end(), 
-            [](const auto& a, const auto& b) { return a.second > b.second; });
-        return backupsTxt[0].first;
-    }
-    return "";
+    EntradaRespaldo ultimo;
+    return catalogo().ultimo(TipoRespaldo::Cifrado, ultimo) ? ultimo.archivo : "";
 }
 
 /**
  * @brief Lista todos los archivos de texto cifrados disponibles
  * @details Muestra en consola una lista numerada y formateada de todos los archivos
- *          de texto cifrados encontrados en el directorio, incluyendo:
+ *          de texto cifrados registrados en el catálogo, incluyendo:
  *          - Nombre del archivo
  *          - Fecha y hora de creación
  *          - Tamaño en bytes
  *          - Ordenados por fecha (más reciente primero)
  */
 void RespaldoDatos::listarArchivosTxtCifrados() {
-    std::vector<std::pair<std::string, std::time_t>> backupsTxt;
+    std::vector<EntradaRespaldo> backupsTxt = catalogo().listar(TipoRespaldo::Cifrado);
     int contador = 1;
 
     std::cout << "\n=== ARCHIVOS .TXT CIFRADOS DISPONIBLES ===" << std::endl;
     std::cout << "===========================================" << std::endl;
 
-    for (const auto& entry : fs::directory_iterator(".")) {
-        std::string nombre = entry.path().filename().string();
-        if (nombre.find("cifrado_") == 0 && nombre.find(".txt") == nombre.size() - 4) {
-            std::string timestampStr = nombre.substr(8, 15);
-            std::tm tm = {};
-            std::istringstream ss(timestampStr);
-            ss >> std::get_time(&tm, "%Y%m%d_%H%M%S");
-            if (!ss.fail()) {
-                std::time_t tiempo = std::mktime(&tm);
-                backupsTxt.emplace_back(nombre, tiempo);
-            }
-        }
-    }
-
     if (backupsTxt.empty()) {
         std::cout << "No se encontraron archivos .txt cifrados." << std::endl;
         return;
     }
 
-    std::sort(backupsTxt.begin(), backupsTxt.end(), 
-        [](const auto& a, const auto& b) { return a.second > b.second; });
-
     for (const auto& backup : backupsTxt) {
-        std::tm* tm = std::localtime(&backup.second);
-        std::cout << contador << ". " << backup.first << std::endl;
-        std::cout << "• Fecha: " << std::put_time(tm, "%d/%m/%Y %H:%M:%S") << "       • Tamaño: ";
-        try {
-            auto tamanio = fs::file_size(backup.first);
-            std::cout << tamanio << " bytes" << std::endl;
-        } catch (...) {
-            std::cout << "N/A" << std::endl;
-        }
+        std::tm* tm = std::localtime(&backup.fecha);
+        std::cout << contador << ". " << backup.archivo << std::endl;
+        std::cout << "• Fecha: " << std::put_time(tm, "%d/%m/%Y %H:%M:%S") << "       • Tamaño: "
+                  << backup.tamanio << " bytes" << std::endl;
         contador++;
     }
 }
@@ -498,27 +397,14 @@ void RespaldoDatos::listarArchivosTxtCifrados() {
 /**
  * @brief Permite seleccionar y descifrar un archivo de texto
  * @details Interfaz interactiva que:
- *          1. Lista todos los archivos de texto cifrados disponibles
+ *          1. Lista todos los archivos de texto cifrados del catálogo
  *          2. Permite al usuario seleccionar uno por número
  *          3. Descifra el archivo seleccionado usando cifrado César (clave fija: 3)
  *          4. Maneja errores y validaciones de entrada
  *          5. Proporciona feedback al usuario sobre el resultado
  */
 void RespaldoDatos::seleccionarYDescifrarTxt() {
-    std::vector<std::pair<std::string, std::time_t>> backupsTxt;
-    for (const auto& entry : fs::directory_iterator(".")) {
-        std::string nombre = entry.path().filename().string();
-        if (nombre.find("cifrado_") == 0 && nombre.find(".txt") == nombre.size() - 4) {
-            std::string timestampStr = nombre.substr(8, 15);
-            std::tm tm = {};
-            std::istringstream ss(timestampStr);
-            ss >> std::get_time(&tm, "%Y%m%d_%H%M%S");
-            if (!ss.fail()) {
-                std::time_t tiempo = std::mktime(&tm);
-                backupsTxt.emplace_back(nombre, tiempo);
-            }
-        }
-    }
+    std::vector<EntradaRespaldo> backupsTxt = catalogo().listar(TipoRespaldo::Cifrado);
 
     if (backupsTxt.empty()) {
         std::cout << "\nNo se encontraron archivos .txt cifrados para descifrar." << std::endl;
@@ -526,8 +412,6 @@ void RespaldoDatos::seleccionarYDescifrarTxt() {
         return;
     }
 
-    std::sort(backupsTxt.begin(), backupsTxt.end(), 
-        [](const auto& a, const auto& b) { return a.second > b.second; });
     listarArchivosTxtCifrados();
 
     int seleccion;
@@ -546,7 +430,7 @@ void RespaldoDatos::seleccionarYDescifrarTxt() {
     } while (seleccion < 1 || seleccion > static_cast<int>(backupsTxt.size()));
     cout << endl;
 
-    std::string archivoSeleccionado = backupsTxt[seleccion - 1].first;
+    std::string archivoSeleccionado = backupsTxt[seleccion - 1].archivo;
     // No se pide numCesar por teclado, se usa el valor fijo de 3
     int numCesar = 3;
 
@@ -16,6 +16,8 @@
 #include "Cliente.h"
 #include "Ahorro.h"
 #include "Corriente.h"
+#include "CatalogoRespaldos.h"
+#include "SerializadorClientes.h"
 #include <fstream>
 #include <string>
 #include <stdexcept> 
@@ -39,17 +41,30 @@ public:
      * @brief Guarda un respaldo de clientes con marca de tiempo automática
      * @param clientes Lista de clientes a respaldar
      * @details Genera un archivo de respaldo binario con nombre que incluye fecha y hora
-     *          en formato YYYYMMDD_HHMMSS para identificación única del respaldo
+     *          en formato YYYYMMDD_HHMMSS para identificación única del respaldo, y lo
+     *          registra en el catálogo de respaldos
      */
     static void guardarRespaldoClientesConFecha(const ListaDoble<Cliente*>& clientes);
     
     /**
      * @brief Obtiene el nombre del último archivo de respaldo disponible
      * @return String con el nombre del archivo de respaldo más reciente
-     * @details Busca en el directorio actual el archivo de respaldo más reciente
-     *          basándose en las marcas de tiempo de los nombres de archivo
+     * @details Consulta el catálogo de respaldos; no recorre el directorio
      */
     static std::string obtenerUltimoRespaldo();
+
+    /**
+     * @brief Obtiene el respaldo vigente en una fecha
+     * @param fecha Momento a consultar
+     * @return Nombre del respaldo más reciente generado en o antes de la fecha, o vacío si no hay
+     */
+    static std::string obtenerRespaldoEnFecha(std::time_t fecha);
+
+    /**
+     * @brief Catálogo de respaldos compartido por todo el sistema
+     * @return Referencia al catálogo, que se lee del disco en la primera consulta
+     */
+    static CatalogoRespaldos& catalogo();
     
     /**
      * @brief Restaura clientes desde un archivo binario
@@ -68,6 +83,31 @@ public:
      *          incluyendo datos personales, cuentas y movimientos
      */
     static void respaldoClientesBinario(const std::string& nombreArchivo, const ListaDoble<Cliente*>& clientes);
+
+    /**
+     * @brief Captura una vista consistente de los clientes
+     * @param clientes Lista de clientes actual
+     * @return Instantánea con los datos personales, saldos y límites del historial de cada cuenta
+     * @details Su costo depende de la cantidad de clientes y cuentas, no de los movimientos. La
+     *          instantánea es válida mientras no se eliminen los clientes o cuentas capturados.
+     */
+    static InstantaneaClientes capturarInstantanea(const ListaDoble<Cliente*>& clientes);
+
+    /**
+     * @brief Escribe una instantánea con el formato de SerializadorClientes
+     * @param nombreArchivo Nombre del archivo donde guardar el respaldo
+     * @param instantanea Vista capturada con capturarInstantanea
+     * @return true si el archivo se escribió completo
+     */
+    static bool escribirInstantanea(const std::string& nombreArchivo, const InstantaneaClientes& instantanea);
+
+    /**
+     * @brief Escribe una instantánea como respaldo con marca de tiempo y la registra en el catálogo
+     * @param instantanea Vista capturada con capturarInstantanea
+     * @return Nombre del archivo generado, o vacío si no se pudo escribir
+     * @details El nombre y la fecha registrada son los de la captura, aunque se escriba más tarde.
+     */
+    static std::string guardarInstantaneaConFecha(const InstantaneaClientes& instantanea);
     
     /**
      * @brief Restaura clientes desde un archivo de texto cifrado
@@ -99,14 +139,14 @@ public:
     /**
      * @brief Obtiene el último archivo de texto cifrado disponible
      * @return String con el nombre del archivo de texto cifrado más reciente
-     * @details Busca archivos de texto cifrados y devuelve el más reciente
+     * @details Consulta el catálogo de respaldos
      */
     static std::string obtenerUltimoTxtCifrado();
     
     /**
      * @brief Lista todos los archivos de texto cifrados disponibles
      * @details Muestra en consola una lista numerada de todos los archivos
-     *          de texto cifrados con sus fechas y tamaños
+     *          de texto cifrados con sus fechas y tamaños, tomados del catálogo
      */
     static void listarArchivosTxtCifrados();
     
@@ -0,0 +1,768 @@
+/**
+ * @file SerializadorClientes.cpp
+ * @brief Implementación del formato binario único de clientes, cuentas y movimientos.
+ */
+
+#include "SerializadorClientes.h"
+#include "Ahorro.h"
+#include "Corriente.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+const uint32_t SerializadorClientes::MAGIA;
+const uint32_t SerializadorClientes::VERSION;
+const int SerializadorClientes::CLIENTES_POR_HILO;
+
+namespace {
+
+// Los tipos se guardan como su posición en estas tablas; 0 es un tipo desconocido
+const char* const TIPOS_CUENTA[] = {"", "Ahorros", "Corriente"};
+const char* const TIPOS_MOVIMIENTO[] = {"", "Depósito", "Retiro"};
+const uint8_t CANTIDAD_TIPOS = 3;
+
+/**
+ * @brief Bytes que ocupa como mínimo cada registro, para validar las cantidades antes de iterar.
+ */
+struct TamaniosMinimos {
+    size_t cliente;
+    size_t cuenta;
+    size_t movimiento;
+};
+
+TamaniosMinimos tamanios(FormatoClientes formato) {
+    switch (formato) {
+    case FormatoClientes::Actual:
+        // Siete cadenas vacías, fecha y cantidad de cuentas / tipo, id vacío, tres double, fecha, tres int y
+        // la cita / tipo, dos double y fecha
+        return {7 * sizeof(size_t) + sizeof(Fecha) + sizeof(int),
+                1 + sizeof(size_t) + 3 * sizeof(double) + sizeof(Fecha) + 3 * sizeof(int) + sizeof(int64_t),
+                1 + 2 * sizeof(double) + sizeof(Fecha)};
+    case FormatoClientes::LegadoDatos:
+        // Las cadenas llevan su terminador; las cuentas, sucursal, cita y al menos un double
+        return {7 * (sizeof(size_t) + 1) + sizeof(Fecha) + sizeof(int),
+                3 * sizeof(int) + sizeof(size_t) + 1 + 2 * sizeof(double) + sizeof(Fecha) + sizeof(time_t),
+                sizeof(size_t) + 1 + 2 * sizeof(double) + sizeof(Fecha)};
+    default:
+        return {7 * sizeof(size_t) + sizeof(Fecha) + sizeof(int),
+                2 * sizeof(size_t) + sizeof(double) + sizeof(Fecha) + sizeof(int),
+                sizeof(size_t) + 2 * sizeof(double) + sizeof(Fecha)};
+    }
+}
+
+/**
+ * @brief Campos de un movimiento tal como se guardan.
+ */
+struct RegistroMovimiento {
+    std::string tipo;
+    double monto = 0;
+    Fecha fecha;
+    double saldo_post = 0;
+};
+
+/**
+ * @brief Recorre los campos del esquema escribiéndolos.
+ */
+struct Codificar {
+    EscritorBinario& escritor;
+
+    template <typename T>
+    void valor(const T& v, const char*) { escritor.escribir(v); }
+    void cadena(const std::string& s, const char*, size_t) { escritor.escribirCadena(s); }
+    void etiqueta(const std::string& s, const char*, const char* const* nombres) {
+        uint8_t indice = 0;
+        for (uint8_t i = 1; i < CANTIDAD_TIPOS; i++) {
+            if (s == nombres[i]) indice = i;
+        }
+        escritor.escribir(indice);
+    }
+};
+
+/**
+ * @brief Recorre los campos del esquema leyéndolos, con las validaciones de LectorBinario.
+ */
+struct Decodificar {
+    LectorBinario& lector;
+
+    template <typename T>
+    void valor(T& v, const char* campo) { lector.leer(v, campo); }
+    void cadena(std::string& s, const char* campo, size_t maximo) { lector.leerCadena(s, campo, maximo); }
+    void etiqueta(std::string& s, const char* campo, const char* const* nombres) {
+        uint8_t indice = 0;
+        lector.leer(indice, campo);
+        s = indice < CANTIDAD_TIPOS ? nombres[indice] : "";
+    }
+};
+
+// Esquema del formato actual: el orden de los campos se define solo aquí
+
+template <class Campos, class Registro>
+void esquemaCliente(Campos& c, Registro& r) {
+    c.cadena(r.dni, "dni", 64);
+    c.cadena(r.nombres, "nombres", LectorBinario::MAX_CADENA);
+    c.cadena(r.apellidos, "apellidos", LectorBinario::MAX_CADENA);
+    c.cadena(r.direccion, "direccion", LectorBinario::MAX_CADENA);
+    c.cadena(r.telefono, "telefono", 64);
+    c.cadena(r.email, "email", LectorBinario::MAX_CADENA);
+    c.cadena(r.contrasenia, "contrasenia", LectorBinario::MAX_CADENA);
+    c.valor(r.fecha_nacimiento, "fecha_nacimiento");
+}
+
+template <class Campos, class Registro>
+void esquemaCuenta(Campos& c, Registro& r) {
+    c.etiqueta(r.tipo, "tipo de cuenta", TIPOS_CUENTA);
+    c.cadena(r.id, "id_cuenta", 256);
+    c.valor(r.saldo, "saldo");
+    c.valor(r.fecha_apertura, "fecha_apertura");
+    c.valor(r.parametro, "tasa_interes o limite_retiro_diario");
+    c.valor(r.branch_id, "branchId");
+    c.valor(r.cita, "appointmentTime");
+    c.valor(r.dia_retiro, "dia_retiro");
+    c.valor(r.retirado_hoy, "monto_retirado_hoy");
+}
+
+template <class Campos, class Registro>
+void esquemaMovimiento(Campos& c, Registro& r) {
+    c.etiqueta(r.tipo, "tipo de movimiento", TIPOS_MOVIMIENTO);
+    c.valor(r.monto, "el monto");
+    c.valor(r.fecha, "la fecha");
+    c.valor(r.saldo_post, "el saldo posterior");
+}
+
+/**
+ * @brief Indica si un movimiento leído tiene valores que aceptaría la cuenta.
+ */
+bool movimientoValido(const RegistroMovimiento& m) {
+    return (m.tipo == "Depósito" || m.tipo == "Retiro") && std::isfinite(m.monto) && m.monto > 0 &&
+           std::isfinite(m.saldo_post);
+}
+
+/**
+ * @brief Copia los datos personales leídos al cliente de destino.
+ */
+void asignarDatosPersonales(Cliente& destino, InstantaneaCliente& registro) {
+    destino.set_dni(std::move(registro.dni));
+    destino.set_nombres(std::move(registro.nombres));
+    destino.set_apellidos(std::move(registro.apellidos));
+    destino.set_direccion(std::move(registro.direccion));
+    destino.set_telefono(std::move(registro.telefono));
+    destino.set_email(std::move(registro.email));
+    destino.set_contrasenia(std::move(registro.contrasenia));
+    destino.set_fecha_nacimiento(registro.fecha_nacimiento);
+}
+
+/**
+ * @brief Copia bytes de un vínculo privado al escritor, por bloques de tamaño acotado.
+ */
+void copiarBytes(EscritorBinario& escritor, const ArchivoHistoriales& archivo, uint64_t posicion, uint64_t longitud) {
+    const uint64_t BLOQUE = 1 << 20;
+    std::string bytes;
+    while (longitud > 0) {
+        uint64_t parte = std::min(longitud, BLOQUE);
+        archivo.leer(posicion, parte, bytes);
+        escritor.escribirBloque(bytes);
+        posicion += parte;
+        longitud -= parte;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Captura los datos de un cliente y los extremos de los historiales de sus cuentas.
+ * @details El saldo y el último movimiento se toman juntos, así que son coherentes entre sí. Los
+ *          historiales diferidos no se leen aquí: se guarda su ubicación y los copia quien escribe.
+ */
+InstantaneaCliente SerializadorClientes::capturar(Cliente& cliente) {
+    InstantaneaCliente copia;
+    if (const CodificacionCliente* codificado = cliente.get_codificacion()) {
+        copia.codificado = *codificado;
+        return copia;
+    }
+    copia.dni = cliente.get_dni();
+    copia.nombres = cliente.get_nombres();
+    copia.apellidos = cliente.get_apellidos();
+    copia.direccion = cliente.get_direccion();
+    copia.telefono = cliente.get_telefono();
+    copia.email = cliente.get_email();
+    copia.contrasenia = cliente.get_contrasenia();
+    copia.fecha_nacimiento = cliente.get_fecha_nacimiento();
+
+    cliente.get_cuentas()->recorrer([&](Cuenta* cuenta) {
+        InstantaneaCuenta c;
+        c.tipo = cuenta->get_tipo();
+        c.id = cuenta->get_id_cuenta();
+        c.saldo = cuenta->get_saldo();
+        c.fecha_apertura = cuenta->get_fecha_apertura();
+        c.branch_id = cuenta->get_branchId();
+        c.cita = static_cast<int64_t>(std::chrono::system_clock::to_time_t(cuenta->get_appointmentTime()));
+        if (c.tipo == "Ahorros") {
+            c.parametro = static_cast<Ahorro*>(cuenta)->get_tasa_interes();
+        } else if (c.tipo == "Corriente") {
+            Corriente* corriente = static_cast<Corriente*>(cuenta);
+            c.parametro = corriente->get_limite_retiro_diario();
+            c.dia_retiro = corriente->get_dia_retiro();
+            c.retirado_hoy = corriente->get_monto_retirado_hoy();
+        }
+        if (const HistorialDiferido* historial = cuenta->get_historial_diferido()) {
+            // Sin leerlo: los bytes del archivo ya están en el formato de salida y se copian al escribir
+            c.diferido = *historial;
+        } else {
+            c.primero = cuenta->get_movimientos()->get_cabeza();
+            c.ultimo = cuenta->get_movimientos()->get_cola();
+        }
+        copia.cuentas.push_back(std::move(c));
+    });
+    return copia;
+}
+
+/**
+ * @brief Captura una vista consistente de todos los clientes.
+ * @details Su costo depende de la cantidad de clientes y cuentas, no de los movimientos; de los clientes
+ *          sin cambios solo se copia la ubicación de sus bytes.
+ */
+InstantaneaClientes SerializadorClientes::capturar(const ListaDoble<Cliente*>& clientes) {
+    InstantaneaClientes instantanea;
+    instantanea.fecha = std::time(nullptr);
+    clientes.recorrer([&](Cliente* cliente) { instantanea.clientes.push_back(capturar(*cliente)); });
+    return instantanea;
+}
+
+/**
+ * @brief Escribe la cabecera y todos los clientes de una instantánea.
+ */
+void SerializadorClientes::escribir(EscritorBinario& escritor, const InstantaneaClientes& instantanea,
+                                    std::vector<uint64_t>* posiciones_clientes) {
+    uint64_t inicio = escritor.getEscritos();
+    escritor.escribir(MAGIA);
+    escritor.escribir(VERSION);
+    int total = static_cast<int>(instantanea.clientes.size());
+    escritor.escribir(total);
+
+    // La posición del índice se conoce al final; se reserva su lugar y se completa después
+    uint64_t campo_indice = escritor.getEscritos() - inicio;
+    uint64_t indice = 0;
+    escritor.escribir(indice);
+
+    std::vector<uint64_t> posiciones;
+    posiciones.reserve(instantanea.clientes.size() + 1);
+    for (size_t i = 0; i < instantanea.clientes.size();) {
+        const CodificacionCliente& codificado = instantanea.clientes[i].codificado;
+        if (!codificado.archivo) {
+            posiciones.push_back(escritor.getEscritos() - inicio);
+            escribirCliente(escritor, instantanea.clientes[i++]);
+            continue;
+        }
+        // Clientes sin cambios que siguen uno tras otro en el mismo archivo: una sola copia
+        uint64_t fin = codificado.posicion;
+        for (; i < instantanea.clientes.size() && instantanea.clientes[i].codificado.archivo == codificado.archivo &&
+               instantanea.clientes[i].codificado.posicion == fin; i++) {
+            posiciones.push_back(escritor.getEscritos() - inicio + (fin - codificado.posicion));
+            fin += instantanea.clientes[i].codificado.longitud;
+        }
+        copiarBytes(escritor, *codificado.archivo, codificado.posicion, fin - codificado.posicion);
+    }
+
+    indice = escritor.getEscritos() - inicio;
+    for (uint64_t posicion : posiciones) escritor.escribir(posicion);
+    escritor.reescribir(campo_indice, indice);
+    if (posiciones_clientes) {
+        posiciones.push_back(indice);
+        posiciones_clientes->swap(posiciones);
+    }
+}
+
+/**
+ * @brief Escribe un cliente con sus cuentas y movimientos, sin cabecera.
+ * @details Puede ejecutarse en otro hilo mientras la interfaz sigue registrando movimientos:
+ *          cada historial se recorre desde su primer nodo hasta el último capturado, sin pasar de él.
+ */
+void SerializadorClientes::escribirCliente(EscritorBinario& escritor, const InstantaneaCliente& cliente) {
+    if (cliente.codificado.archivo) {
+        copiarBytes(escritor, *cliente.codificado.archivo, cliente.codificado.posicion, cliente.codificado.longitud);
+        return;
+    }
+    Codificar campos{escritor};
+    esquemaCliente(campos, cliente);
+    int total_cuentas = static_cast<int>(cliente.cuentas.size());
+    escritor.escribir(total_cuentas);
+
+    RegistroMovimiento movimiento;
+    for (const InstantaneaCuenta& cuenta : cliente.cuentas) {
+        esquemaCuenta(campos, cuenta);
+
+        int total_movimientos = cuenta.diferido.cantidad;
+        for (Nodo<Movimiento>* n = cuenta.primero; n; n = n->get_siguiente()) {
+            total_movimientos++;
+            if (n == cuenta.ultimo) break;
+        }
+        escritor.escribir(total_movimientos);
+        if (cuenta.diferido.archivo) {
+            copiarBytes(escritor, *cuenta.diferido.archivo, cuenta.diferido.posicion,
+                        static_cast<uint64_t>(cuenta.diferido.cantidad) * tamanios(FormatoClientes::Actual).movimiento);
+        }
+        for (Nodo<Movimiento>* n = cuenta.primero; n; n = n->get_siguiente()) {
+            Movimiento m = n->get_valor();
+            movimiento.tipo = m.get_tipo();
+            movimiento.monto = m.get_monto();
+            movimiento.fecha = m.get_fecha();
+            movimiento.saldo_post = m.get_saldo_post_movimiento();
+            esquemaMovimiento(campos, movimiento);
+            if (n == cuenta.ultimo) break;
+        }
+    }
+}
+
+/**
+ * @brief Lee la cabecera y la cantidad de clientes, reconociendo los formatos anteriores.
+ * @details Los archivos anteriores empiezan directamente con la cantidad de clientes, que nunca coincide
+ *          con la marca porque la cantidad se valida contra el tamaño del archivo. La versión 1 es igual
+ *          a la actual pero sin índice.
+ */
+FormatoClientes SerializadorClientes::leerCabecera(LectorBinario& lector, FormatoClientes legado, int& total,
+                                                   uint64_t& indice) {
+    total = 0;
+    indice = 0;
+    if (lector.fin()) return legado;
+
+    FormatoClientes formato = legado;
+    uint32_t magia = 0;
+    uint32_t version = 0;
+    if (lector.espiar(magia) && magia == MAGIA) {
+        lector.leer(magia, "marca del formato");
+        lector.leer(version, "versión del formato");
+        if (version != 1 && version != VERSION) {
+            throw std::runtime_error("Versión de formato de clientes no soportada: " + std::to_string(version));
+        }
+        formato = FormatoClientes::Actual;
+    }
+    total = lector.leerCantidad("número de clientes", tamanios(formato).cliente);
+    if (version >= 2) lector.leer(indice, "posición del índice");
+    return formato;
+}
+
+/**
+ * @brief Lee y valida el índice de clientes; si no es coherente lo deja vacío.
+ * @details Las posiciones deben empezar justo después de la cabecera, crecer estrictamente y quedar
+ *          antes del índice. Con un índice dañado se pierde solo el paralelismo, no los clientes.
+ */
+void SerializadorClientes::leerIndice(FILE* archivo, uint64_t indice, int total, uint64_t primero,
+                                      std::vector<uint64_t>& posiciones) {
+    posiciones.clear();
+    if (indice == 0 || total <= 0 || LectorBinario::posicionar(archivo, 0, SEEK_END) != 0) return;
+    int64_t tamanio = LectorBinario::posicionDe(archivo);
+    uint64_t bytes = static_cast<uint64_t>(total) * sizeof(uint64_t);
+    if (tamanio < 0 || indice > static_cast<uint64_t>(tamanio) || bytes > static_cast<uint64_t>(tamanio) - indice ||
+        LectorBinario::posicionar(archivo, static_cast<int64_t>(indice)) != 0) {
+        return;
+    }
+    posiciones.resize(static_cast<size_t>(total));
+    bool valido = fread(posiciones.data(), sizeof(uint64_t), posiciones.size(), archivo) == posiciones.size() &&
+                  posiciones.front() == primero;
+    for (size_t i = 1; valido && i < posiciones.size(); i++) valido = posiciones[i] > posiciones[i - 1];
+    if (!valido || posiciones.back() >= indice) posiciones.clear();
+}
+
+/**
+ * @brief Lee clientes consecutivos con un lector y anota el resultado.
+ * @details Se detiene en el primer cliente truncado o con longitudes imposibles, porque sin él no se
+ *          sabe dónde empieza el siguiente. Un cliente del que se omitió algún registro no recuerda sus
+ *          bytes, porque ya no lo representan.
+ */
+void SerializadorClientes::leerTramo(LectorBinario& lector, FormatoClientes formato, int desde, int hasta,
+                                     const std::shared_ptr<ArchivoHistoriales>& vinculo, bool diferir_historiales,
+                                     ListaDoble<Cliente*>& destino, LecturaClientes& lectura) {
+    for (int i = desde; i < hasta; i++) {
+        Cliente* cliente = new Cliente();
+        uint64_t inicio = lector.getPosicionArchivo();
+        size_t descartados = lector.getDescartados();
+        try {
+            leerCliente(lector, formato, *cliente, diferir_historiales ? vinculo : nullptr);
+        } catch (const std::exception& e) {
+            delete cliente;
+            lectura.error = "Error al cargar el cliente " + std::to_string(i + 1) + ": " + e.what();
+            break;
+        }
+        if (vinculo && lector.getDescartados() == descartados) {
+            CodificacionCliente codificado;
+            codificado.archivo = vinculo;
+            codificado.posicion = inicio;
+            codificado.longitud = lector.getPosicionArchivo() - inicio;
+            cliente->set_codificacion(codificado);
+        }
+        destino.insertar_cola(cliente);
+        lectura.leidos++;
+    }
+    lectura.descartados += lector.getDescartados();
+    if (lector.getDescartados() > 0) lectura.ultimo_descarte = lector.getUltimoDescarte();
+}
+
+/**
+ * @brief Lee todos los clientes de un archivo de datos o de respaldo.
+ * @details Cada tramo tiene su propio FILE*, su lector y su lista, así que los hilos no comparten nada
+ *          mientras decodifican. Al final las listas se enlazan en el orden de los tramos sin copiar
+ *          ningún cliente. Sin índice (formatos anteriores o versión 1) se lee todo en este hilo.
+ */
+LecturaClientes SerializadorClientes::leerArchivo(const std::string& archivo, FormatoClientes legado,
+                                                  ListaDoble<Cliente*>& destino, bool diferir_historiales) {
+    FILE* file = fopen(archivo.c_str(), "rb");
+    if (!file) throw std::runtime_error("No se pudo abrir el archivo para lectura");
+
+    LecturaClientes lectura;
+    FormatoClientes formato = legado;
+    uint64_t indice = 0, primero = 0;
+    try {
+        LectorBinario lector(file);
+        formato = leerCabecera(lector, legado, lectura.total, indice);
+        primero = lector.getPosicion();
+    } catch (const std::exception& e) {
+        fclose(file);
+        lectura.error = e.what();
+        return lectura;
+    }
+
+    std::shared_ptr<ArchivoHistoriales> vinculo;
+    if (formato == FormatoClientes::Actual) vinculo = ArchivoHistoriales::vincular(archivo);
+
+    std::vector<uint64_t> posiciones;
+    leerIndice(file, indice, lectura.total, primero, posiciones);
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+    if (posiciones.empty()) hilos = 1;
+    hilos = std::min(hilos, static_cast<unsigned>(std::max(1, lectura.total / CLIENTES_POR_HILO)));
+
+    if (hilos == 1) {
+        try {
+            if (LectorBinario::posicionar(file, static_cast<int64_t>(primero)) != 0) throw std::runtime_error("Error al leer el archivo");
+            LectorBinario lector(file);
+            leerTramo(lector, formato, 0, lectura.total, vinculo, diferir_historiales, destino, lectura);
+        } catch (const std::exception& e) {
+            lectura.error = e.what();
+        }
+        fclose(file);
+        return lectura;
+    }
+    fclose(file);
+
+    struct Tramo {
+        int desde = 0, hasta = 0;
+        uint64_t inicio = 0, fin = 0;
+        ListaDoble<Cliente*> clientes;
+        LecturaClientes lectura;
+    };
+    std::vector<Tramo> tramos(hilos);
+    for (unsigned t = 0; t < hilos; t++) {
+        tramos[t].desde = static_cast<int>(static_cast<int64_t>(lectura.total) * t / hilos);
+        tramos[t].hasta = static_cast<int>(static_cast<int64_t>(lectura.total) * (t + 1) / hilos);
+        tramos[t].inicio = posiciones[tramos[t].desde];
+        tramos[t].fin = (t + 1 < hilos) ? posiciones[tramos[t].hasta] : indice;
+    }
+
+    auto decodificar = [&archivo, &vinculo, diferir_historiales, formato](Tramo& tramo) {
+        FILE* f = fopen(archivo.c_str(), "rb");
+        if (!f) {
+            tramo.lectura.error = "No se pudo abrir el archivo para lectura";
+            return;
+        }
+        try {
+            if (LectorBinario::posicionar(f, static_cast<int64_t>(tramo.inicio)) != 0) throw std::runtime_error("Error al leer el archivo");
+            LectorBinario lector(f, 1 << 16, tramo.fin - tramo.inicio);
+            leerTramo(lector, formato, tramo.desde, tramo.hasta, vinculo, diferir_historiales, tramo.clientes,
+                      tramo.lectura);
+            if (tramo.lectura.error.empty() && !lector.fin()) {
+                tramo.lectura.error = "El índice no coincide con el cliente " + std::to_string(tramo.hasta);
+            }
+        } catch (const std::exception& e) {
+            tramo.lectura.error = e.what();
+        }
+        fclose(f);
+    };
+
+    // El primer tramo lo decodifica este hilo; si no se puede crear un hilo, su tramo también
+    std::vector<std::thread> trabajadores;
+    for (unsigned t = 1; t < hilos; t++) {
+        try {
+            trabajadores.emplace_back(decodificar, std::ref(tramos[t]));
+        } catch (const std::system_error&) {
+            decodificar(tramos[t]);
+        }
+    }
+    decodificar(tramos[0]);
+    for (std::thread& trabajador : trabajadores) trabajador.join();
+
+    lectura.hilos = static_cast<unsigned>(trabajadores.size()) + 1;
+    for (Tramo& tramo : tramos) {
+        destino.concatenar(tramo.clientes);
+        lectura.leidos += tramo.lectura.leidos;
+        lectura.descartados += tramo.lectura.descartados;
+        if (!tramo.lectura.ultimo_descarte.empty()) lectura.ultimo_descarte = tramo.lectura.ultimo_descarte;
+        if (lectura.error.empty()) lectura.error = tramo.lectura.error;
+    }
+    return lectura;
+}
+
+/**
+ * @brief Lee un cliente con sus cuentas y movimientos.
+ */
+void SerializadorClientes::leerCliente(LectorBinario& lector, FormatoClientes formato, Cliente& destino,
+                                       const std::shared_ptr<ArchivoHistoriales>& historiales) {
+    switch (formato) {
+    case FormatoClientes::Actual:
+        leerClienteActual(lector, destino, historiales);
+        break;
+    case FormatoClientes::LegadoDatos:
+        leerClienteLegadoDatos(lector, destino);
+        break;
+    case FormatoClientes::LegadoRespaldo:
+        leerClienteLegadoRespaldo(lector, destino);
+        break;
+    }
+}
+
+/**
+ * @brief Lee un historial diferido.
+ * @details Los movimientos inválidos se omiten igual que en una carga completa y se informa cuántos fueron.
+ */
+void SerializadorClientes::leerHistorial(const HistorialDiferido& historial, const std::string& id_cuenta,
+                                         ListaDoble<Movimiento>& destino) {
+    FILE* file = fopen(historial.archivo->getArchivo().c_str(), "rb");
+    if (!file) throw std::runtime_error("No se pudo abrir el historial de la cuenta " + id_cuenta);
+    try {
+        const size_t tamanio = tamanios(FormatoClientes::Actual).movimiento;
+        if (LectorBinario::posicionar(file, static_cast<int64_t>(historial.posicion)) != 0) throw std::runtime_error("posición inválida");
+        LectorBinario lector(file, 1 << 16, static_cast<uint64_t>(historial.cantidad) * tamanio);
+        Decodificar campos{lector};
+        RegistroMovimiento movimiento;
+        for (int i = 0; i < historial.cantidad; i++) {
+            esquemaMovimiento(campos, movimiento);
+            if (movimientoValido(movimiento)) {
+                destino.insertar_cola(Movimiento(movimiento.tipo, movimiento.monto, movimiento.fecha, movimiento.saldo_post));
+            } else {
+                lector.descartar("Movimiento inválido en la cuenta " + id_cuenta);
+            }
+        }
+        if (lector.getDescartados() > 0) {
+            std::cerr << "Se omitieron " << lector.getDescartados() << " movimientos inválidos de la cuenta "
+                      << id_cuenta << std::endl;
+        }
+    } catch (const std::exception& e) {
+        fclose(file);
+        throw std::runtime_error("Error al leer el historial de la cuenta " + id_cuenta + ": " + e.what());
+    }
+    fclose(file);
+}
+
+/**
+ * @brief Crea la cuenta descrita por un registro, o nullptr si sus valores no son válidos.
+ * @details Además de los valores no finitos y las citas fuera del rango del reloj, se rechaza lo que
+ *          rechazan los constructores de las cuentas (saldo negativo, tasa o límite fuera de rango).
+ */
+Cuenta* SerializadorClientes::crearCuenta(const InstantaneaCuenta& registro) {
+    // Segundos que caben en system_clock; con una cita mayor, from_time_t se desborda
+    const int64_t CITA_MAXIMA =
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::duration::max()).count();
+    if (!std::isfinite(registro.saldo) || registro.saldo < 0 || !std::isfinite(registro.parametro) ||
+        !std::isfinite(registro.retirado_hoy) || registro.cita < -CITA_MAXIMA || registro.cita > CITA_MAXIMA) {
+        return nullptr;
+    }
+    try {
+        std::unique_ptr<Cuenta> cuenta;
+        if (registro.tipo == "Ahorros") {
+            cuenta.reset(new Ahorro(registro.id, registro.saldo, registro.fecha_apertura, registro.parametro));
+        } else if (registro.tipo == "Corriente") {
+            Corriente* corriente = new Corriente(registro.id, registro.saldo, registro.fecha_apertura, registro.parametro);
+            cuenta.reset(corriente);
+            corriente->restaurar_retiro_diario(registro.dia_retiro, registro.retirado_hoy);
+        } else {
+            return nullptr;
+        }
+        cuenta->set_branchId(registro.branch_id);
+        cuenta->set_appointmentTime(std::chrono::system_clock::from_time_t(static_cast<std::time_t>(registro.cita)));
+        return cuenta.release();
+    } catch (const std::invalid_argument&) {
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Agrega un movimiento leído a la cuenta si es válido; si no, lo anota en el lector.
+ * @details Si la cuenta se omitió (nullptr), el movimiento ya se consumió y no hay nada más que hacer.
+ */
+void SerializadorClientes::agregarMovimiento(LectorBinario& lector, Cuenta* cuenta, const std::string& tipo,
+                                             double monto, const Fecha& fecha, double saldo_post) {
+    if (!cuenta) return;
+    RegistroMovimiento registro{tipo, monto, fecha, saldo_post};
+    if (movimientoValido(registro)) {
+        cuenta->get_movimientos()->insertar_cola(Movimiento(tipo, monto, fecha, saldo_post));
+    } else {
+        lector.descartar("Movimiento inválido en la cuenta " + cuenta->get_id_cuenta());
+    }
+}
+
+/**
+ * @brief Decodificador del formato actual.
+ * @details Como todas las cuentas tienen el mismo registro, una de tipo desconocido se omite igual que
+ *          una con valores inválidos. Con historiales diferidos, los movimientos no se validan aquí sino
+ *          al leerlos con leerHistorial.
+ */
+void SerializadorClientes::leerClienteActual(LectorBinario& lector, Cliente& destino,
+                                             const std::shared_ptr<ArchivoHistoriales>& historiales) {
+    const TamaniosMinimos minimos = tamanios(FormatoClientes::Actual);
+    Decodificar campos{lector};
+
+    InstantaneaCliente cliente;
+    esquemaCliente(campos, cliente);
+    std::string dni = cliente.dni;
+    asignarDatosPersonales(destino, cliente);
+
+    int num_cuentas = lector.leerCantidad("número de cuentas", minimos.cuenta);
+    InstantaneaCuenta registro;
+    RegistroMovimiento movimiento;
+    for (int i = 0; i < num_cuentas; i++) {
+        esquemaCuenta(campos, registro);
+        std::unique_ptr<Cuenta> cuenta(crearCuenta(registro));
+
+        int num_movimientos = lector.leerCantidad("número de movimientos", minimos.movimiento);
+        if (historiales && num_movimientos > 0) {
+            // Los movimientos tienen tamaño fijo: basta con anotar dónde empiezan y saltarlos
+            HistorialDiferido historial{historiales, lector.getPosicionArchivo(), num_movimientos};
+            lector.saltar(static_cast<uint64_t>(num_movimientos) * minimos.movimiento, "movimientos");
+            if (cuenta) cuenta->diferir_movimientos(historial);
+        }
+        for (int j = 0; !historiales && j < num_movimientos; j++) {
+            esquemaMovimiento(campos, movimiento);
+            agregarMovimiento(lector, cuenta.get(), movimiento.tipo, movimiento.monto, movimiento.fecha,
+                              movimiento.saldo_post);
+        }
+
+        if (cuenta) {
+            destino.agregar_cuenta(cuenta.release());
+        } else {
+            lector.descartar("Cuenta " + registro.id + " del cliente " + dni + " con valores inválidos");
+        }
+    }
+}
+
+/**
+ * @brief Decodificador del datos.txt anterior.
+ * @details Cadenas con '\0', tipo de cuenta entero (1 Ahorro, 2 Corriente) y campos propios de cada
+ *          tipo; sin el tipo no se conoce el tamaño del registro, así que uno desconocido es un error.
+ *          La cuenta corriente solo guardaba el límite de retiro diario: el acumulado del día empieza en 0.
+ */
+void SerializadorClientes::leerClienteLegadoDatos(LectorBinario& lector, Cliente& destino) {
+    const TamaniosMinimos minimos = tamanios(FormatoClientes::LegadoDatos);
+
+    InstantaneaCliente cliente;
+    lector.leerCadena(cliente.dni, "dni", 64, true);
+    lector.leerCadena(cliente.nombres, "nombres", LectorBinario::MAX_CADENA, true);
+    lector.leerCadena(cliente.apellidos, "apellidos", LectorBinario::MAX_CADENA, true);
+    lector.leerCadena(cliente.direccion, "direccion", LectorBinario::MAX_CADENA, true);
+    lector.leerCadena(cliente.telefono, "telefono", 64, true);
+    lector.leerCadena(cliente.email, "email", LectorBinario::MAX_CADENA, true);
+    lector.leerCadena(cliente.contrasenia, "contrasenia", LectorBinario::MAX_CADENA, true);
+    lector.leer(cliente.fecha_nacimiento, "fecha_nacimiento");
+    std::string dni = cliente.dni;
+    asignarDatosPersonales(destino, cliente);
+
+    int num_cuentas = lector.leerCantidad("número de cuentas", minimos.cuenta);
+    InstantaneaCuenta registro;
+    std::string tipo_movimiento;
+    for (int i = 0; i < num_cuentas; i++) {
+        int tipo_cuenta;
+        lector.leer(tipo_cuenta, "tipo de cuenta");
+        lector.leerCadena(registro.id, "id_cuenta", 256, true);
+        lector.leer(registro.saldo, "saldo");
+        lector.leer(registro.fecha_apertura, "fecha_apertura");
+        lector.leer(registro.branch_id, "branchId");
+        time_t tt;
+        lector.leer(tt, "appointmentTime");
+        registro.cita = static_cast<int64_t>(tt);
+        registro.dia_retiro = 0;
+        registro.retirado_hoy = 0;
+        if (tipo_cuenta == 1) {
+            registro.tipo = "Ahorros";
+            lector.leer(registro.parametro, "tasa_interes");
+        } else if (tipo_cuenta == 2) {
+            registro.tipo = "Corriente";
+            lector.leer(registro.parametro, "limite_retiro_diario");
+        } else {
+            throw std::runtime_error("Tipo de cuenta desconocido");
+        }
+        std::unique_ptr<Cuenta> cuenta(crearCuenta(registro));
+
+        int num_movimientos = lector.leerCantidad("número de movimientos", minimos.movimiento);
+        for (int j = 0; j < num_movimientos; j++) {
+            double monto, saldo_post;
+            Fecha fecha;
+            lector.leerCadena(tipo_movimiento, "tipo de movimiento", 100, true);
+            lector.leer(monto, "el monto");
+            lector.leer(fecha, "la fecha");
+            lector.leer(saldo_post, "el saldo posterior");
+            agregarMovimiento(lector, cuenta.get(), tipo_movimiento, monto, fecha, saldo_post);
+        }
+
+        if (cuenta) {
+            destino.agregar_cuenta(cuenta.release());
+        } else {
+            lector.descartar("Cuenta " + registro.id + " del cliente " + dni + " con valores inválidos");
+        }
+    }
+}
+
+/**
+ * @brief Decodificador de los respaldos anteriores.
+ * @details Cadenas sin '\0', tipo de cuenta como texto y un único parámetro para los tipos conocidos;
+ *          no guardaban sucursal, cita ni el acumulado de retiros del día.
+ */
+void SerializadorClientes::leerClienteLegadoRespaldo(LectorBinario& lector, Cliente& destino) {
+    const TamaniosMinimos minimos = tamanios(FormatoClientes::LegadoRespaldo);
+
+    InstantaneaCliente cliente;
+    lector.leerCadena(cliente.dni, "dni", 64);
+    lector.leerCadena(cliente.nombres, "nombres");
+    lector.leerCadena(cliente.apellidos, "apellidos");
+    lector.leerCadena(cliente.direccion, "direccion");
+    lector.leerCadena(cliente.telefono, "telefono", 64);
+    lector.leerCadena(cliente.email, "email");
+    lector.leerCadena(cliente.contrasenia, "contrasenia");
+    lector.leer(cliente.fecha_nacimiento, "fecha_nacimiento");
+    std::string dni = cliente.dni;
+    asignarDatosPersonales(destino, cliente);
+
+    int num_cuentas = lector.leerCantidad("número de cuentas", minimos.cuenta);
+    InstantaneaCuenta registro;
+    std::string tipo_movimiento;
+    for (int i = 0; i < num_cuentas; i++) {
+        lector.leerCadena(registro.tipo, "tipo de cuenta", 32);
+        lector.leerCadena(registro.id, "id_cuenta", 256);
+        lector.leer(registro.saldo, "saldo");
+        lector.leer(registro.fecha_apertura, "fecha_apertura");
+        registro.parametro = 0;
+        if (registro.tipo == "Ahorros" || registro.tipo == "Corriente") {
+            lector.leer(registro.parametro, registro.tipo == "Ahorros" ? "tasa_interes" : "limite_retiro_diario");
+        }
+        std::unique_ptr<Cuenta> cuenta(crearCuenta(registro));
+
+        int num_movimientos = lector.leerCantidad("número de movimientos", minimos.movimiento);
+        for (int j = 0; j < num_movimientos; j++) {
+            double monto, saldo_post;
+            Fecha fecha;
+            lector.leerCadena(tipo_movimiento, "tipo de movimiento", 100);
+            lector.leer(monto, "el monto");
+            lector.leer(fecha, "la fecha");
+            lector.leer(saldo_post, "el saldo posterior");
+            agregarMovimiento(lector, cuenta.get(), tipo_movimiento, monto, fecha, saldo_post);
+        }
+
+        if (cuenta) {
+            destino.agregar_cuenta(cuenta.release());
+        } else {
+            lector.descartar("Cuenta " + registro.id + " del cliente " + dni + " con valores inválidos");
+        }
+    }
+}
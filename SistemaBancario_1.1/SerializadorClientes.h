@@ -0,0 +1,229 @@
+/**
+ * @file SerializadorClientes.h
+ * @brief Definición de la clase SerializadorClientes, formato binario único de clientes, cuentas y movimientos.
+ *
+ * El archivo de datos, los respaldos con marca de tiempo y las exportaciones cifradas (que son el
+ * respaldo en hexadecimal) se escriben todos con este formato. Sus campos se describen una sola vez
+ * en SerializadorClientes.cpp y esa misma descripción se usa para codificar y para decodificar, así
+ * que la escritura y la lectura no pueden desalinearse.
+ *
+ * Los archivos anteriores no tienen cabecera y siguen dos formatos distintos (el de datos.txt, con
+ * cadenas terminadas en '\0', sucursal y cita, y el de los respaldos, sin ellas); se reconocen por la
+ * falta de la marca y se leen con los decodificadores de compatibilidad de esta misma clase. El
+ * acumulado de retiros del día de las cuentas corrientes solo existe en el formato con cabecera (desde
+ * la versión 1): un archivo sin marca nunca lo lleva.
+ */
+
+#ifndef SERIALIZADORCLIENTES_H_INCLUDED
+#define SERIALIZADORCLIENTES_H_INCLUDED
+
+#include "Cliente.h"
+#include "EscritorBinario.h"
+#include "HistorialDiferido.h"
+#include "LectorBinario.h"
+#include "ListaDoble.h"
+#include "Nodo.h"
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @struct InstantaneaCuenta
+ * @brief Estado de una cuenta congelado en el momento de capturar una instantánea
+ * @details Los movimientos no se copian: las listas de movimientos solo crecen por la cola y sus nodos
+ *          no se modifican después de insertados, así que basta con recordar el primer y el último nodo
+ *          existentes al capturar. El recorrido de primero a ultimo nunca lee enlaces que se escriban
+ *          después, aunque la cuenta siga recibiendo movimientos. De un historial que todavía no se leyó
+ *          solo se guarda su ubicación: el hilo que escribe copia sus bytes sin decodificarlos.
+ */
+struct InstantaneaCuenta {
+    std::string tipo;                      ///< "Ahorros" o "Corriente"
+    std::string id;                        ///< Número de cuenta
+    double saldo = 0;                      ///< Saldo al capturar
+    Fecha fecha_apertura;                  ///< Fecha de apertura
+    double parametro = 0;                  ///< Tasa de interés (Ahorros) o límite de retiro diario (Corriente)
+    int branch_id = 0;                     ///< Sucursal asociada
+    int64_t cita = 0;                      ///< Hora de la cita asociada (time_t)
+    int dia_retiro = 0;                    ///< Día del último retiro (solo Corriente)
+    double retirado_hoy = 0;               ///< Monto retirado ese día (solo Corriente)
+    Nodo<Movimiento>* primero = nullptr;   ///< Primer movimiento (nullptr si no tenía)
+    Nodo<Movimiento>* ultimo = nullptr;    ///< Último movimiento existente al capturar
+    HistorialDiferido diferido;            ///< Historial todavía no leído; sus bytes se copian al escribir
+};
+
+/**
+ * @struct InstantaneaCliente
+ * @brief Copia de los datos personales de un cliente y de sus cuentas en un instante
+ */
+struct InstantaneaCliente {
+    std::string dni, nombres, apellidos, direccion, telefono, email, contrasenia;
+    Fecha fecha_nacimiento;
+    std::vector<InstantaneaCuenta> cuentas;
+    CodificacionCliente codificado; ///< Bytes de un cliente sin cambios; si los hay, el resto queda vacío
+};
+
+/**
+ * @struct InstantaneaClientes
+ * @brief Vista consistente de todos los clientes, lista para escribirse en otro hilo
+ */
+struct InstantaneaClientes {
+    std::vector<InstantaneaCliente> clientes; ///< Clientes en el orden de la lista
+    std::time_t fecha = 0;                    ///< Momento de la captura; los datos son los de ese instante
+};
+
+/**
+ * @enum FormatoClientes
+ * @brief Formato de un archivo de clientes, según su cabecera
+ */
+enum class FormatoClientes {
+    Actual,          ///< Con cabecera; escrito por SerializadorClientes
+    LegadoDatos,     ///< datos.txt anterior: cadenas con '\0', tipo de cuenta entero, sucursal y cita
+    LegadoRespaldo   ///< Respaldos anteriores: cadenas sin '\0', tipo de cuenta como texto
+};
+
+/**
+ * @struct LecturaClientes
+ * @brief Resultado de leer un archivo de clientes
+ */
+struct LecturaClientes {
+    int total = 0;                  ///< Clientes declarados en la cabecera
+    int leidos = 0;                 ///< Clientes leídos completos
+    size_t descartados = 0;         ///< Cuentas y movimientos omitidos por valores inválidos
+    std::string ultimo_descarte;    ///< Motivo del último registro omitido
+    std::string error;              ///< Primer error de estructura (vacío si no hubo)
+    unsigned hilos = 1;             ///< Hilos usados para decodificar
+};
+
+/**
+ * @class SerializadorClientes
+ * @brief Codificador y decodificador de clientes compartido por todas las rutas de persistencia
+ *
+ * Formato actual: marca y versión (uint32), cantidad de clientes (int), posición del índice (uint64)
+ * y cada cliente con sus siete cadenas (longitud size_t sin terminador), fecha de nacimiento y
+ * cuentas. Cada cuenta tiene un registro de tamaño fijo salvo el id, así que un tipo desconocido se
+ * puede omitir sin perder el resto del archivo; los tipos de cuenta y de movimiento se guardan como
+ * un byte. Después del último cliente va el índice: la posición (uint64) donde empieza cada cliente,
+ * que permite repartir la lectura entre varios hilos.
+ */
+class SerializadorClientes {
+public:
+    static const uint32_t MAGIA = 0x31434C53;  ///< "SLC1" en el orden de bytes de la máquina
+    /// Versión del formato actual. Cualquier cambio en los campos la incrementa; la 1 no tenía índice y
+    /// ambas guardan el día y el monto del último retiro de las cuentas corrientes
+    static const uint32_t VERSION = 2;
+    static const int CLIENTES_POR_HILO = 128;  ///< Clientes como mínimo para ocupar un hilo más
+
+    /**
+     * @brief Captura los datos de un cliente y los extremos de los historiales de sus cuentas.
+     * @param cliente Cliente a capturar
+     * @return Instantánea del cliente; si no cambió desde que se leyó o escribió, solo la ubicación de sus bytes
+     */
+    static InstantaneaCliente capturar(Cliente& cliente);
+    /**
+     * @brief Captura una vista consistente de todos los clientes.
+     * @param clientes Lista de clientes actual
+     * @return Instantánea válida mientras no se eliminen los clientes o cuentas capturados, con la hora de captura
+     */
+    static InstantaneaClientes capturar(const ListaDoble<Cliente*>& clientes);
+
+    /**
+     * @brief Escribe la cabecera y todos los clientes de una instantánea.
+     * @param escritor Destino
+     * @param instantanea Clientes a escribir
+     * @param posiciones Si no es nullptr, recibe dónde empieza cada cliente y, al final, dónde termina el último
+     * @details Los clientes sin cambios se copian de su archivo; los que están contiguos en el mismo
+     *          archivo se copian juntos, en bloques grandes.
+     */
+    static void escribir(EscritorBinario& escritor, const InstantaneaClientes& instantanea,
+                         std::vector<uint64_t>* posiciones = nullptr);
+    /**
+     * @brief Escribe un cliente con sus cuentas y movimientos, sin cabecera.
+     * @param escritor Destino
+     * @param cliente Cliente capturado
+     */
+    static void escribirCliente(EscritorBinario& escritor, const InstantaneaCliente& cliente);
+
+    /**
+     * @brief Lee todos los clientes de un archivo de datos o de respaldo.
+     * @param archivo Nombre del archivo
+     * @param legado Formato que se asume si el archivo no tiene cabecera
+     * @param destino Lista a la que se agregan los clientes leídos, en el orden del archivo
+     * @param diferir_historiales true para dejar los movimientos en el archivo hasta que se pidan
+     * @return Cantidades leídas y el primer error de estructura, si hubo
+     * @throw std::runtime_error Si el archivo no se puede abrir
+     * @details Con índice y suficientes clientes, cada hilo abre el archivo y decodifica un tramo
+     *          contiguo en su propia lista; al terminar, las listas se enlazan en orden. Un error en
+     *          un tramo solo descarta el resto de ese tramo. En el formato actual se crea un vínculo
+     *          privado al archivo: los historiales diferidos se leen de él, y cada cliente leído sin
+     *          omisiones recuerda dónde están sus bytes para que el próximo guardado los copie.
+     */
+    static LecturaClientes leerArchivo(const std::string& archivo, FormatoClientes legado,
+                                       ListaDoble<Cliente*>& destino, bool diferir_historiales = false);
+    /**
+     * @brief Lee un historial diferido.
+     * @param historial Ubicación de los movimientos
+     * @param id_cuenta Cuenta dueña del historial, para los mensajes
+     * @param destino Lista que recibe los movimientos válidos
+     * @throw std::runtime_error Si el historial está truncado o el archivo no se puede abrir
+     */
+    static void leerHistorial(const HistorialDiferido& historial, const std::string& id_cuenta,
+                              ListaDoble<Movimiento>& destino);
+    /**
+     * @brief Lee un cliente con sus cuentas y movimientos.
+     * @param lector Lector posicionado al inicio del cliente
+     * @param formato Formato devuelto por leerCabecera
+     * @param destino Cliente que recibe los datos; las cuentas leídas se agregan a las que ya tenga
+     * @param historiales Archivo al que quedan referidos los historiales, o nullptr para leerlos ya
+     * @details Las cuentas y movimientos bien formados pero con valores inválidos se omiten y se anotan
+     *          en el lector; un registro truncado o con longitudes imposibles lanza una excepción.
+     */
+    static void leerCliente(LectorBinario& lector, FormatoClientes formato, Cliente& destino,
+                            const std::shared_ptr<ArchivoHistoriales>& historiales = nullptr);
+
+private:
+    /**
+     * @brief Lee la cabecera y la cantidad de clientes, reconociendo los formatos anteriores.
+     * @param lector Lector al inicio del archivo
+     * @param legado Formato que se asume si el archivo no tiene cabecera
+     * @param total Cantidad de clientes declarada (0 si el archivo está vacío)
+     * @param indice Posición del índice de clientes (0 si no tiene)
+     * @return Formato del resto del archivo
+     */
+    static FormatoClientes leerCabecera(LectorBinario& lector, FormatoClientes legado, int& total, uint64_t& indice);
+    /**
+     * @brief Lee y valida el índice de clientes; si no es coherente lo deja vacío.
+     */
+    static void leerIndice(FILE* archivo, uint64_t indice, int total, uint64_t primero, std::vector<uint64_t>& posiciones);
+    /**
+     * @brief Lee clientes consecutivos con un lector y anota el resultado.
+     */
+    static void leerTramo(LectorBinario& lector, FormatoClientes formato, int desde, int hasta,
+                          const std::shared_ptr<ArchivoHistoriales>& vinculo, bool diferir_historiales,
+                          ListaDoble<Cliente*>& destino, LecturaClientes& lectura);
+    /**
+     * @brief Crea la cuenta descrita por un registro, o nullptr si sus valores no son válidos.
+     */
+    static Cuenta* crearCuenta(const InstantaneaCuenta& registro);
+    /**
+     * @brief Agrega un movimiento leído a la cuenta si es válido; si no, lo anota en el lector.
+     */
+    static void agregarMovimiento(LectorBinario& lector, Cuenta* cuenta, const std::string& tipo, double monto,
+                                  const Fecha& fecha, double saldo_post);
+    /**
+     * @brief Decodificador del formato actual.
+     */
+    static void leerClienteActual(LectorBinario& lector, Cliente& destino,
+                                  const std::shared_ptr<ArchivoHistoriales>& historiales);
+    /**
+     * @brief Decodificador del datos.txt anterior.
+     */
+    static void leerClienteLegadoDatos(LectorBinario& lector, Cliente& destino);
+    /**
+     * @brief Decodificador de los respaldos anteriores.
+     */
+    static void leerClienteLegadoRespaldo(LectorBinario& lector, Cliente& destino);
+};
+
+#endif
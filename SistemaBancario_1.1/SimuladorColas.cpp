@@ -0,0 +1,235 @@
+/**
+ * @file SimuladorColas.cpp
+ * @brief Implementación de la simulación de eventos discretos de la atención en sucursales.
+ */
+
+#include "SimuladorColas.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+const int SimuladorColas::MINUTOS_FRANJA;
+
+/**
+ * @brief Constructor.
+ * @param semilla Semilla del generador aleatorio
+ */
+SimuladorColas::SimuladorColas(unsigned semilla)
+    : modelo_por_defecto(crearModelo(ParametrosSucursal())), semilla(semilla), generador(semilla) {}
+
+/**
+ * @brief Prepara las distribuciones de un conjunto de parámetros.
+ * @details El tiempo de atención es lognormal con la media y el coeficiente de variación pedidos:
+ *          sigma² = ln(1 + cv²) y mu = ln(media) - sigma² / 2.
+ */
+SimuladorColas::Modelo SimuladorColas::crearModelo(const ParametrosSucursal& parametros) {
+    Modelo modelo;
+    modelo.parametros = parametros;
+    double llegadas_por_minuto = parametros.llegadas_por_hora / 60.0;
+    modelo.entre_llegadas = std::exponential_distribution<double>(llegadas_por_minuto > 0 ? llegadas_por_minuto : 1.0);
+    double sigma2 = std::log1p(parametros.atencion_variacion * parametros.atencion_variacion);
+    double mu = std::log(parametros.atencion_media_min) - sigma2 / 2.0;
+    modelo.atencion = std::lognormal_distribution<double>(mu, std::max(std::sqrt(sigma2), 1e-12));
+    return modelo;
+}
+
+/**
+ * @brief Define el modelo de atención de una sucursal.
+ */
+void SimuladorColas::configurarSucursal(int sucursal_id, const ParametrosSucursal& parametros) {
+    if (sucursal_id < 0) throw std::invalid_argument("ID de sucursal negativo");
+    if (parametros.cajeros < 1 || parametros.llegadas_por_hora < 0 ||
+        !(parametros.atencion_media_min > 0) || parametros.atencion_variacion < 0) {
+        throw std::invalid_argument("Parámetros de atención inválidos");
+    }
+    if (static_cast<size_t>(sucursal_id) >= modelos.size()) {
+        modelos.resize(sucursal_id + 1, modelo_por_defecto);
+    }
+    modelos[sucursal_id] = crearModelo(parametros);
+}
+
+/**
+ * @brief Obtiene el modelo de atención de una sucursal.
+ */
+const ParametrosSucursal& SimuladorColas::getParametros(int sucursal_id) const {
+    if (sucursal_id < 0 || static_cast<size_t>(sucursal_id) >= modelos.size()) return modelo_por_defecto.parametros;
+    return modelos[sucursal_id].parametros;
+}
+
+/**
+ * @brief Modelo de una sucursal (el por defecto si no se configuró).
+ */
+SimuladorColas::Modelo& SimuladorColas::modeloDe(int sucursal_id) {
+    if (sucursal_id < 0 || static_cast<size_t>(sucursal_id) >= modelos.size()) return modelo_por_defecto;
+    return modelos[sucursal_id];
+}
+
+/**
+ * @brief Simula varias veces un día de atención de una sucursal.
+ */
+ResultadoSimulacion SimuladorColas::simularDia(int sucursal_id, int apertura, int cierre, const std::vector<int>& citas,
+                                               size_t repeticiones) {
+    Modelo& modelo = modeloDe(sucursal_id);
+    return simular(modelo, modelo.parametros.cajeros, apertura, cierre, citas, repeticiones);
+}
+
+/**
+ * @brief Simula varias veces un día con una cantidad de cajeros dada.
+ */
+ResultadoSimulacion SimuladorColas::simular(Modelo& modelo, int cajeros, int apertura, int cierre,
+                                            std::vector<int> citas, size_t repeticiones) {
+    ResultadoSimulacion resultado;
+    if (cierre <= apertura || repeticiones == 0) return resultado;
+
+    // Las distribuciones guardan estado entre llamadas (la normal de la lognormal genera de a pares):
+    // sin reiniciarlas, la misma semilla no daría la misma secuencia
+    generador.seed(semilla);
+    modelo.atencion.reset();
+    modelo.entre_llegadas.reset();
+    std::sort(citas.begin(), citas.end());
+    size_t franjas = (cierre - apertura + MINUTOS_FRANJA - 1) / MINUTOS_FRANJA;
+    std::vector<double> suma_franja(franjas, 0.0);
+    std::vector<size_t> clientes_franja(franjas, 0);
+    double ocupado = 0, horizonte = 0;
+    esperas.clear();
+
+    for (size_t i = 0; i < repeticiones; i++) {
+        simularUnDia(modelo, cajeros, apertura, cierre, citas, resultado, suma_franja, clientes_franja, ocupado, horizonte);
+    }
+
+    resultado.dias = repeticiones;
+    resultado.clientes = esperas.size();
+    resultado.cola_media_maxima /= repeticiones;
+    resultado.utilizacion = horizonte > 0 ? ocupado / horizonte : 0;
+    resultado.espera_por_franja.resize(franjas);
+    for (size_t f = 0; f < franjas; f++) {
+        resultado.espera_por_franja[f] = clientes_franja[f] ? suma_franja[f] / clientes_franja[f] : 0;
+    }
+    if (!esperas.empty()) {
+        double suma = 0;
+        for (double espera : esperas) suma += espera;
+        resultado.espera_media = suma / esperas.size();
+        size_t p90 = (esperas.size() * 9) / 10;
+        if (p90 >= esperas.size()) p90 = esperas.size() - 1;
+        std::nth_element(esperas.begin(), esperas.begin() + p90, esperas.end());
+        resultado.espera_p90 = esperas[p90];
+    }
+    return resultado;
+}
+
+/**
+ * @brief Simula un día y acumula sus estadísticas.
+ * @details Los eventos son las llegadas (citas y clientes sin cita, ambas ya ordenadas por minuto) y los
+ *          fines de atención (montículo con el minuto en que se libera cada cajero). Como las llegadas se
+ *          recorren en orden, las colas son los rangos ya llegados y aún no atendidos de cada lista. Cuando
+ *          se libera un cajero atiende primero a quien tiene cita, si ya llegó; si no, al cliente sin cita
+ *          que llegó antes. Los clientes que llegan antes del cierre se atienden aunque la atención termine
+ *          después.
+ */
+void SimuladorColas::simularUnDia(Modelo& modelo, int cajeros, int apertura, int cierre, const std::vector<int>& citas,
+                                  ResultadoSimulacion& resultado, std::vector<double>& suma_franja,
+                                  std::vector<size_t>& clientes_franja, double& ocupado, double& horizonte) {
+    const double INFINITO = std::numeric_limits<double>::infinity();
+
+    llegadas_sin_cita.clear();
+    if (modelo.parametros.llegadas_por_hora > 0) {
+        for (double t = apertura + modelo.entre_llegadas(generador); t < cierre; t += modelo.entre_llegadas(generador)) {
+            llegadas_sin_cita.push_back(t);
+        }
+    }
+    fin_cajeros.assign(cajeros, static_cast<double>(apertura));
+
+    size_t total_citas = citas.size(), total_sin_cita = llegadas_sin_cita.size();
+    size_t llegaron_citas = 0, llegaron_sin_cita = 0;   // Siguiente llegada de cada lista
+    size_t atendidas_citas = 0, atendidos_sin_cita = 0; // Siguiente cliente en espera de cada lista
+    size_t cola_maxima = 0;
+    double ultimo_fin = cierre;
+
+    while (atendidas_citas < total_citas || atendidos_sin_cita < total_sin_cita) {
+        double libre = fin_cajeros.front();
+        bool hay_cola = atendidas_citas < llegaron_citas || atendidos_sin_cita < llegaron_sin_cita;
+        double cita = llegaron_citas < total_citas ? std::max<double>(citas[llegaron_citas], apertura) : INFINITO;
+        double sin_cita = llegaron_sin_cita < total_sin_cita ? llegadas_sin_cita[llegaron_sin_cita] : INFINITO;
+        double proxima = std::min(cita, sin_cita);
+
+        if (!hay_cola || proxima <= libre) {
+            // Evento de llegada
+            if (cita <= sin_cita) llegaron_citas++;
+            else llegaron_sin_cita++;
+            if (proxima < libre) {
+                cola_maxima = std::max(cola_maxima, (llegaron_citas - atendidas_citas) + (llegaron_sin_cita - atendidos_sin_cita));
+            }
+            continue;
+        }
+
+        // Evento de fin de atención: el cajero que se libera toma al siguiente de la cola
+        double primera_cita = atendidas_citas < llegaron_citas ? std::max<double>(citas[atendidas_citas], apertura) : INFINITO;
+        double primer_sin_cita = atendidos_sin_cita < llegaron_sin_cita ? llegadas_sin_cita[atendidos_sin_cita] : INFINITO;
+        double inicio = std::max(libre, std::min(primera_cita, primer_sin_cita));
+        double llegada = (primera_cita <= inicio) ? primera_cita : primer_sin_cita;
+        if (primera_cita <= inicio) atendidas_citas++;
+        else atendidos_sin_cita++;
+
+        double atencion = modelo.atencion(generador);
+        std::pop_heap(fin_cajeros.begin(), fin_cajeros.end(), std::greater<double>());
+        fin_cajeros.back() = inicio + atencion;
+        std::push_heap(fin_cajeros.begin(), fin_cajeros.end(), std::greater<double>());
+        ocupado += atencion;
+        ultimo_fin = std::max(ultimo_fin, inicio + atencion);
+
+        double espera = inicio - llegada;
+        esperas.push_back(espera);
+        resultado.espera_maxima = std::max(resultado.espera_maxima, espera);
+        size_t franja = std::min(static_cast<size_t>(std::max(0.0, llegada - apertura) / MINUTOS_FRANJA),
+                                 suma_franja.size() - 1);
+        suma_franja[franja] += espera;
+        clientes_franja[franja]++;
+    }
+
+    resultado.cola_media_maxima += cola_maxima;
+    horizonte += cajeros * (ultimo_fin - apertura);
+}
+
+/**
+ * @brief Espera esperada de un cliente que llega ahora detrás de una cola.
+ * @details Lo que falta de cada atención en curso se toma como una fracción uniforme de un tiempo de
+ *          atención; luego cada cliente de la cola ocupa al primer cajero que se libera.
+ */
+double SimuladorColas::esperaConCola(int sucursal_id, int personas_en_cola, size_t repeticiones) {
+    if (personas_en_cola <= 0 || repeticiones == 0) return 0;
+
+    Modelo& modelo = modeloDe(sucursal_id);
+    generador.seed(semilla);
+    modelo.atencion.reset();
+    modelo.entre_llegadas.reset();
+    std::uniform_real_distribution<double> fraccion(0.0, 1.0);
+    double suma = 0;
+    for (size_t r = 0; r < repeticiones; r++) {
+        fin_cajeros.resize(modelo.parametros.cajeros);
+        for (double& fin : fin_cajeros) fin = fraccion(generador) * modelo.atencion(generador);
+        std::make_heap(fin_cajeros.begin(), fin_cajeros.end(), std::greater<double>());
+        for (int i = 0; i < personas_en_cola; i++) {
+            std::pop_heap(fin_cajeros.begin(), fin_cajeros.end(), std::greater<double>());
+            fin_cajeros.back() += modelo.atencion(generador);
+            std::push_heap(fin_cajeros.begin(), fin_cajeros.end(), std::greater<double>());
+        }
+        suma += fin_cajeros.front();
+    }
+    return suma / repeticiones;
+}
+
+/**
+ * @brief Menor cantidad de cajeros con la que la espera media de un día no supera un objetivo.
+ */
+int SimuladorColas::cajerosNecesarios(int sucursal_id, int apertura, int cierre, const std::vector<int>& citas,
+                                      double espera_objetivo, size_t repeticiones, int maximo_cajeros) {
+    Modelo& modelo = modeloDe(sucursal_id);
+    for (int cajeros = 1; cajeros <= maximo_cajeros; cajeros++) {
+        if (simular(modelo, cajeros, apertura, cierre, citas, repeticiones).espera_media <= espera_objetivo) {
+            return cajeros;
+        }
+    }
+    return maximo_cajeros + 1;
+}
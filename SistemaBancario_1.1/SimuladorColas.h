@@ -0,0 +1,157 @@
+/**
+ * @file SimuladorColas.h
+ * @brief Definición de la clase SimuladorColas, simulación de eventos discretos de la atención en sucursales.
+ *
+ * Cada sucursal tiene un número de cajeros, una tasa de llegada de clientes sin cita (proceso de Poisson)
+ * y un tiempo de atención con distribución lognormal. Un día simulado reproduce las citas agendadas (que
+ * tienen prioridad sobre los clientes sin cita) y las llegadas aleatorias, y mide la espera de cada cliente.
+ * Repetir el día cientos de veces da la espera esperada por franja horaria, con la que se estiman tiempos de
+ * espera, se recomiendan horarios y se calcula cuántos cajeros hacen falta.
+ */
+
+#ifndef SIMULADORCOLAS_H_INCLUDED
+#define SIMULADORCOLAS_H_INCLUDED
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+/**
+ * @struct ParametrosSucursal
+ * @brief Modelo de atención de una sucursal.
+ */
+struct ParametrosSucursal {
+    int cajeros = 2;                   ///< Ventanillas atendiendo en simultáneo
+    double llegadas_por_hora = 3.0;    ///< Clientes sin cita que llegan por hora (media del proceso de Poisson)
+    double atencion_media_min = 40.0;  ///< Tiempo medio de atención en minutos
+    double atencion_variacion = 0.5;   ///< Coeficiente de variación del tiempo de atención (desviación / media)
+};
+
+/**
+ * @struct ResultadoSimulacion
+ * @brief Estadísticas acumuladas de uno o más días simulados. Los tiempos están en minutos.
+ */
+struct ResultadoSimulacion {
+    size_t dias = 0;                    ///< Días simulados
+    size_t clientes = 0;                ///< Clientes atendidos en total
+    double espera_media = 0;            ///< Espera media por cliente
+    double espera_p90 = 0;              ///< Espera que no supera el 90% de los clientes
+    double espera_maxima = 0;           ///< Mayor espera observada
+    double cola_media_maxima = 0;       ///< Promedio por día de la mayor cantidad de clientes esperando
+    double utilizacion = 0;             ///< Fracción del horario en que los cajeros estuvieron ocupados
+    std::vector<double> espera_por_franja; ///< Espera media de quien llega en cada franja desde la apertura
+};
+
+/**
+ * @class SimuladorColas
+ * @brief Motor de simulación de colas con varios cajeros, por sucursal.
+ *
+ * Los parámetros se guardan en un vector indexado directamente por el ID de la sucursal. Cada simulación
+ * reinicia el generador aleatorio con la misma semilla: la misma consulta da siempre el mismo resultado y
+ * al comparar cantidades de cajeros todas las alternativas ven las mismas llegadas.
+ */
+class SimuladorColas {
+public:
+    static const int MINUTOS_FRANJA = 30; ///< Duración de las franjas de espera_por_franja
+
+    /**
+     * @brief Constructor.
+     * @param semilla Semilla del generador aleatorio
+     */
+    explicit SimuladorColas(unsigned semilla = 20250101u);
+
+    /**
+     * @brief Define el modelo de atención de una sucursal.
+     * @param sucursal_id ID de la sucursal (no negativo)
+     * @param parametros Cajeros, llegadas y tiempo de atención
+     * @throws std::invalid_argument si el ID es negativo o los parámetros no son válidos
+     */
+    void configurarSucursal(int sucursal_id, const ParametrosSucursal& parametros);
+    /**
+     * @brief Obtiene el modelo de atención de una sucursal (el por defecto si no se configuró).
+     */
+    const ParametrosSucursal& getParametros(int sucursal_id) const;
+
+    /**
+     * @brief Simula varias veces un día de atención de una sucursal.
+     * @param sucursal_id ID de la sucursal
+     * @param apertura Minuto del día en que abre
+     * @param cierre Minuto del día en que deja de recibir clientes (exclusivo)
+     * @param citas Minuto del día de cada cita agendada
+     * @param repeticiones Días a simular
+     * @return Estadísticas acumuladas de todos los días
+     */
+    ResultadoSimulacion simularDia(int sucursal_id, int apertura, int cierre, const std::vector<int>& citas,
+                                   size_t repeticiones);
+    /**
+     * @brief Espera esperada de un cliente que llega ahora detrás de una cola.
+     * @details Todos los cajeros están ocupados con un cliente a mitad de su atención y delante hay
+     *          personas_en_cola clientes; no se consideran llegadas posteriores (atención por orden de llegada).
+     * @param sucursal_id ID de la sucursal
+     * @param personas_en_cola Clientes esperando delante
+     * @param repeticiones Cantidad de simulaciones a promediar
+     * @return Minutos de espera esperados (0 si no hay cola)
+     */
+    double esperaConCola(int sucursal_id, int personas_en_cola, size_t repeticiones = 500);
+    /**
+     * @brief Menor cantidad de cajeros con la que la espera media de un día no supera un objetivo.
+     * @param sucursal_id ID de la sucursal (se usan sus llegadas y tiempos de atención)
+     * @param apertura Minuto del día en que abre
+     * @param cierre Minuto del día en que deja de recibir clientes (exclusivo)
+     * @param citas Minuto del día de cada cita agendada
+     * @param espera_objetivo Espera media máxima aceptada en minutos
+     * @param repeticiones Días a simular por cada cantidad de cajeros
+     * @param maximo_cajeros Mayor cantidad de cajeros a probar
+     * @return Cajeros necesarios, o maximo_cajeros + 1 si ni con el máximo se cumple el objetivo
+     */
+    int cajerosNecesarios(int sucursal_id, int apertura, int cierre, const std::vector<int>& citas,
+                          double espera_objetivo, size_t repeticiones = 1000, int maximo_cajeros = 10);
+
+private:
+    /**
+     * @struct Modelo
+     * @brief Parámetros de una sucursal con las distribuciones ya preparadas.
+     */
+    struct Modelo {
+        ParametrosSucursal parametros;
+        std::exponential_distribution<double> entre_llegadas; ///< Minutos entre llegadas sin cita
+        std::lognormal_distribution<double> atencion;         ///< Minutos de atención
+    };
+
+    std::vector<Modelo> modelos;   ///< Modelo por ID de sucursal
+    Modelo modelo_por_defecto;     ///< Modelo de las sucursales no configuradas
+    unsigned semilla;              ///< Semilla con la que empieza cada simulación
+    std::mt19937 generador;        ///< Generador aleatorio compartido
+
+    // Memoria reutilizada entre días simulados
+    std::vector<double> llegadas_sin_cita;
+    std::vector<double> fin_cajeros;
+    std::vector<double> esperas;
+
+    /**
+     * @brief Prepara las distribuciones de un conjunto de parámetros.
+     */
+    static Modelo crearModelo(const ParametrosSucursal& parametros);
+    /**
+     * @brief Modelo de una sucursal (el por defecto si no se configuró).
+     */
+    Modelo& modeloDe(int sucursal_id);
+    /**
+     * @brief Simula varias veces un día con una cantidad de cajeros dada.
+     */
+    ResultadoSimulacion simular(Modelo& modelo, int cajeros, int apertura, int cierre, std::vector<int> citas,
+                                size_t repeticiones);
+    /**
+     * @brief Simula un día y acumula sus estadísticas.
+     * @param citas Minutos de las citas, ordenados
+     * @param suma_franja Suma de esperas por franja
+     * @param clientes_franja Clientes por franja
+     * @param ocupado Minutos de atención acumulados de todos los cajeros
+     * @param horizonte Minutos de jornada acumulados (hasta el cierre o el último cliente atendido)
+     */
+    void simularUnDia(Modelo& modelo, int cajeros, int apertura, int cierre, const std::vector<int>& citas,
+                      ResultadoSimulacion& resultado, std::vector<double>& suma_franja,
+                      std::vector<size_t>& clientes_franja, double& ocupado, double& horizonte);
+};
+
+#endif
@@ -10,6 +10,7 @@
  */
 
 #include "Ubicacion.h"
+#include "CalendarioBancario.h"
 #include <iostream>
 #include <iomanip>
 #include <chrono>   
@@ -20,6 +21,8 @@
 #include <string>
 #include <ctime>
 #include <cstring>
+#include <cstdio>
+#include <stdexcept>
 #include <fstream>
 
 // Declaración forward de la función que necesitamos sin incluir todo Menus.h
@@ -31,6 +34,86 @@ using namespace std;
 #define M_PI 3.14159265358979323846
 #endif
 
+namespace {
+
+/**
+ * @brief Barrio de Quito con su zona (0 = Norte, 1 = Centro, 2 = Sur, 3 = Valles) y coordenadas aproximadas
+ */
+struct BarrioQuito {
+    int zona;
+    const char* nombre;
+    double latitud;
+    double longitud;
+};
+
+/**
+ * @brief Barrios disponibles para seleccionar la ubicación, en el orden en que se muestran en los menús
+ */
+const BarrioQuito BARRIOS_QUITO[] = {
+    // Norte
+    {0, "Carcelén", -0.04, -78.485},
+    {0, "La Victoria", -0.06, -78.475},
+    {0, "Cotocollao", -0.08, -78.485},
+    {0, "Comité del Pueblo", -0.10, -78.475},
+    {0, "El Rosario", -0.12, -78.465},
+    {0, "San Carlos", -0.14, -78.475},
+    {0, "Kennedy", -0.16, -78.465},
+    {0, "El Bosque", -0.18, -78.455},
+    {0, "Iñaquito", -0.20, -78.475},
+    {0, "El Batán", -0.15, -78.485},
+    {0, "Naciones Unidas", -0.17, -78.475},
+    {0, "La Carolina", -0.17, -78.485},
+    {0, "Rumipamba", -0.13, -78.475},
+    {0, "Bellavista", -0.19, -78.495},
+    {0, "Ponceano", -0.11, -78.465},
+
+    // Centro
+    {1, "Mariscal Sucre", -0.19, -78.495},
+    {1, "La Floresta", -0.21, -78.495},
+    {1, "La Vicentina", -0.23, -78.505},
+    {1, "El Ejido", -0.22, -78.505},
+    {1, "América", -0.23, -78.51},
+    {1, "San Juan", -0.24, -78.52},
+    {1, "La Colón", -0.21, -78.485},
+    {1, "La Pradera", -0.23, -78.475},
+    {1, "Guápulo", -0.21, -78.445},
+    {1, "Miraflores", -0.23, -78.455},
+    {1, "Ferroviaria", -0.22, -78.505},
+    {1, "San Bartolo", -0.23, -78.505},
+
+    // Sur - Zona Solanda y alrededores
+    {2, "Solanda Centro", -0.28, -78.53},
+    {2, "Turubamba Bajo", -0.305, -78.55},
+    {2, "Turubamba Alto", -0.29, -78.54},
+    {2, "Tachuco", -0.25, -78.525},
+    {2, "La Loma", -0.26, -78.515},
+    {2, "La Colmena", -0.27, -78.505},
+    {2, "Santa Ana", -0.28, -78.515},
+    {2, "Luluncoto", -0.29, -78.525},
+    {2, "Chimbacalle", -0.25, -78.505},
+    {2, "Alpahuasi", -0.30, -78.535},
+    {2, "La Magdalena", -0.26, -78.515},
+    {2, "Villa Flora", -0.24, -78.505},
+    {2, "Marcopamba", -0.315, -78.56},
+    {2, "Atahualpa", -0.325, -78.57},
+    {2, "El Pintado", -0.335, -78.58},
+    {2, "Chinyacu", -0.345, -78.59},
+    {2, "Tarqui", -0.355, -78.60},
+    {2, "Guajalo", -0.365, -78.61},
+    {2, "Santa Rita", -0.375, -78.62},
+    {2, "Chillogallo", -0.385, -78.63},
+    {2, "Ecuatoriana", -0.395, -78.64},
+
+    // Valles
+    {3, "Cumbayá", -0.20, -78.425},
+    {3, "Tumbaco", -0.21, -78.405},
+    {3, "Conocoto", -0.31, -78.435},
+    {3, "Sangolquí", -0.33, -78.445},
+    {3, "San Rafael", -0.32, -78.455},
+};
+
+} // namespace
+
 /**
  * @brief Constructor de la clase Location que inicializa las coordenadas geográficas
  * @param lat Latitud de la ubicación (coordenada en grados)
@@ -67,6 +150,9 @@ Branch::Branch(int id, const string& name, const string& address,
  *          con sus respectivas ubicaciones y configuraciones iniciales.
  */
 SimpleGeolocationSystem::SimpleGeolocationSystem() {
+    for (const auto& barrio : BARRIOS_QUITO) {
+        ubicaciones_barrio.emplace(barrio.nombre, Location(barrio.latitud, barrio.longitud, "Quito", "Ecuador"));
+    }
     initializeBranches();
 }
 
@@ -88,6 +174,45 @@ void SimpleGeolocationSystem::initializeBranches() {
         Branch(6, "Banco Cumbayá", "Av. Francisco de Orellana", -0.2058, -78.4264, 0),
         Branch(7, "Banco Tumbaco", "Av. Interoceánica Km 12", -0.2089, -78.4003, 0)
     };
+
+    // Modelo de atención de cada sucursal (mismo orden que branches): cajeros, clientes
+    // sin cita por hora, minutos medios de atención y coeficiente de variación
+    const ParametrosSucursal modelos_atencion[] = {
+        {2, 2.5, 35.0, 0.5},
+        {3, 4.0, 40.0, 0.6},
+        {2, 2.5, 40.0, 0.5},
+        {1, 1.2, 35.0, 0.5},
+        {1, 1.2, 35.0, 0.5},
+        {2, 2.5, 30.0, 0.4},
+        {1, 1.5, 30.0, 0.4}
+    };
+
+    posicion_sucursal.clear();
+    for (size_t i = 0; i < branches.size(); i++) {
+        int id = branches[i].id;
+        if (static_cast<size_t>(id) >= posicion_sucursal.size()) {
+            posicion_sucursal.resize(id + 1, -1);
+        }
+        posicion_sucursal[id] = static_cast<int>(i);
+        simulador_colas.configurarSucursal(id, modelos_atencion[i]);
+    }
+
+    // Horario de atención al público en el calendario bancario compartido
+    // (el cierre es exclusivo: se suma un minuto para atender hasta las 15:30 y las 12:00)
+    CalendarioBancario& calendario = CalendarioBancario::instancia();
+    for (const Branch& branch : branches) {
+        for (int dia = 1; dia <= 5; dia++) {
+            calendario.definirHorario(branch.id, dia, 9 * 60, 15 * 60 + 31);
+        }
+        calendario.definirHorario(branch.id, 6, 9 * 60, 12 * 60 + 1);
+    }
+
+    vector<pair<double, double>> coordenadas;
+    coordenadas.reserve(branches.size());
+    for (const auto& branch : branches) {
+        coordenadas.push_back({branch.location.latitude, branch.location.longitude});
+    }
+    indice_sucursales.construir(coordenadas);
 }
 
 /**
@@ -96,71 +221,16 @@ void SimpleGeolocationSystem::initializeBranches() {
  * @return Objeto Location con las coordenadas del barrio especificado
  * @details Esta función mapea barrios específicos de Quito a sus coordenadas
  *          geográficas aproximadas. Incluye barrios del norte, centro y sur de la ciudad.
+ *          La búsqueda se hace en una tabla hash cargada una sola vez desde BARRIOS_QUITO.
  *          Si el barrio no está en la base de datos, retorna coordenadas del centro de Quito.
  * @note Las coordenadas están en formato decimal (grados decimales)
  * @warning Si el barrio no existe en la base de datos, se retorna una ubicación por defecto
  */
 Location SimpleGeolocationSystem::getLocationForBarrio(const string& barrio) {
-    // Norte
-    if (barrio == "Carcelén") return Location(-0.04, -78.485, "Quito", "Ecuador");
-    else if (barrio == "La Victoria") return Location(-0.06, -78.475, "Quito", "Ecuador");
-    else if (barrio == "Cotocollao") return Location(-0.08, -78.485, "Quito", "Ecuador");
-    else if (barrio == "Comité del Pueblo") return Location(-0.10, -78.475, "Quito", "Ecuador");
-    else if (barrio == "El Rosario") return Location(-0.12, -78.465, "Quito", "Ecuador");
-    else if (barrio == "San Carlos") return Location(-0.14, -78.475, "Quito", "Ecuador");
-    else if (barrio == "Kennedy") return Location(-0.16, -78.465, "Quito", "Ecuador");
-    else if (barrio == "El Bosque") return Location(-0.18, -78.455, "Quito", "Ecuador");
-    else if (barrio == "Iñaquito") return Location(-0.20, -78.475, "Quito", "Ecuador");
-    else if (barrio == "El Batán") return Location(-0.15, -78.485, "Quito", "Ecuador");
-    else if (barrio == "Naciones Unidas") return Location(-0.17, -78.475, "Quito", "Ecuador");
-    else if (barrio == "La Carolina") return Location(-0.17, -78.485, "Quito", "Ecuador");
-    else if (barrio == "Rumipamba") return Location(-0.13, -78.475, "Quito", "Ecuador");
-    else if (barrio == "Bellavista") return Location(-0.19, -78.495, "Quito", "Ecuador");
-    else if (barrio == "Ponceano") return Location(-0.11, -78.465, "Quito", "Ecuador");
-    
-    // Centro
-    else if (barrio == "Mariscal Sucre") return Location(-0.19, -78.495, "Quito", "Ecuador");
-    else if (barrio == "La Floresta") return Location(-0.21, -78.495, "Quito", "Ecuador");
-    else if (barrio == "La Vicentina") return Location(-0.23, -78.505, "Quito", "Ecuador");
-    else if (barrio == "El Ejido") return Location(-0.22, -78.505, "Quito", "Ecuador");
-    else if (barrio == "América") return Location(-0.23, -78.51, "Quito", "Ecuador");
-    else if (barrio == "San Juan") return Location(-0.24, -78.52, "Quito", "Ecuador");
-    else if (barrio == "La Colón") return Location(-0.21, -78.485, "Quito", "Ecuador");
-    else if (barrio == "La Pradera") return Location(-0.23, -78.475, "Quito", "Ecuador");
-    else if (barrio == "Guápulo") return Location(-0.21, -78.445, "Quito", "Ecuador");
-    else if (barrio == "Miraflores") return Location(-0.23, -78.455, "Quito", "Ecuador");
-    else if (barrio == "Ferroviaria") return Location(-0.22, -78.505, "Quito", "Ecuador");
-    else if (barrio == "San Bartolo") return Location(-0.23, -78.505, "Quito", "Ecuador");
-    
-    // Sur - Zona Solanda y alrededores
-    else if (barrio == "Solanda Centro") return Location(-0.28, -78.53, "Quito", "Ecuador");
-    else if (barrio == "Turubamba Bajo") return Location(-0.305, -78.55, "Quito", "Ecuador");
-    else if (barrio == "Turubamba Alto") return Location(-0.29, -78.54, "Quito", "Ecuador");
-    else if (barrio == "Tachuco") return Location(-0.25, -78.525, "Quito", "Ecuador");
-    else if (barrio == "La Loma") return Location(-0.26, -78.515, "Quito", "Ecuador");
-    else if (barrio == "La Colmena") return Location(-0.27, -78.505, "Quito", "Ecuador");
-    else if (barrio == "Santa Ana") return Location(-0.28, -78.515, "Quito", "Ecuador");
-    else if (barrio == "Luluncoto") return Location(-0.29, -78.525, "Quito", "Ecuador");
-    else if (barrio == "Chimbacalle") return Location(-0.25, -78.505, "Quito", "Ecuador");
-    else if (barrio == "Alpahuasi") return Location(-0.30, -78.535, "Quito", "Ecuador");
-    else if (barrio == "La Magdalena") return Location(-0.26, -78.515, "Quito", "Ecuador");
-    else if (barrio == "Villa Flora") return Location(-0.24, -78.505, "Quito", "Ecuador");
-    else if (barrio == "Marcopamba") return Location(-0.315, -78.56, "Quito", "Ecuador");
-    else if (barrio == "Atahualpa") return Location(-0.325, -78.57, "Quito", "Ecuador");
-    else if (barrio == "El Pintado") return Location(-0.335, -78.58, "Quito", "Ecuador");
-    else if (barrio == "Chinyacu") return Location(-0.345, -78.59, "Quito", "Ecuador");
-    else if (barrio == "Tarqui") return Location(-0.355, -78.60, "Quito", "Ecuador");
-    else if (barrio == "Guajalo") return Location(-0.365, -78.61, "Quito", "Ecuador");
-    else if (barrio == "Santa Rita") return Location(-0.375, -78.62, "Quito", "Ecuador");
-    else if (barrio == "Chillogallo") return Location(-0.385, -78.63, "Quito", "Ecuador");
-    else if (barrio == "Ecuatoriana") return Location(-0.395, -78.64, "Quito", "Ecuador");
-    
-    // Valles
-    else if (barrio == "Cumbayá") return Location(-0.20, -78.425, "Quito", "Ecuador");
-    else if (barrio == "Tumbaco") return Location(-0.21, -78.405, "Quito", "Ecuador");
-    else if (barrio == "Conocoto") return Location(-0.31, -78.435, "Quito", "Ecuador");
-    else if (barrio == "Sangolquí") return Location(-0.33, -78.445, "Quito", "Ecuador");
-    else if (barrio == "San Rafael") return Location(-0.32, -78.455, "Quito", "Ecuador");
+    auto it = ubicaciones_barrio.find(barrio);
+    if (it != ubicaciones_barrio.end()) {
+        return it->second;
+    }
     
     // Por defecto, centro de Quito
     return Location(-0.2028, -78.4957, "Quito", "Ecuador");
@@ -191,70 +261,20 @@ Location SimpleGeolocationSystem::seleccionarUbicacionPorMenu() {
     int sector = seleccionar_opcion("===== SELECCIONE SU SECTOR DE QUITO =====", sectores, 4, 4);
     
     // Paso 2: Seleccionar barrio usando menú con flechas
-    int barrio_num;
-    
-    // Mapear selección a nombre de barrio
-    string barrio_seleccionado;
-    switch(sector) {
-        case 0: { // Norte
-            const char* barrios_norte[] = {
-                "Carcelén", "La Victoria", "Cotocollao", "Comité del Pueblo", "El Rosario",
-                "San Carlos", "Kennedy", "El Bosque", "Iñaquito", "El Batán",
-                "Naciones Unidas", "La Carolina", "Rumipamba", "Bellavista", "Ponceano"
-            };
-            barrio_num = seleccionar_opcion("===== SELECCIONE SU BARRIO - ZONA NORTE =====", barrios_norte, 15, 4);
-            vector<string> nombres_barrios_norte = {
-                "Carcelén", "La Victoria", "Cotocollao", "Comité del Pueblo", "El Rosario",
-                "San Carlos", "Kennedy", "El Bosque", "Iñaquito", "El Batán",
-                "Naciones Unidas", "La Carolina", "Rumipamba", "Bellavista", "Ponceano"
-            };
-            barrio_seleccionado = nombres_barrios_norte[barrio_num];
-            break;
-        }
-        case 1: { // Centro
-            const char* barrios_centro[] = {
-                "Mariscal Sucre", "La Floresta", "La Vicentina", "El Ejido", "América",
-                "San Juan", "La Colón", "La Pradera", "Guápulo", "Miraflores",
-                "Ferroviaria", "San Bartolo"
-            };
-            barrio_num = seleccionar_opcion("===== SELECCIONE SU BARRIO - ZONA CENTRO =====", barrios_centro, 12, 4);
-            vector<string> nombres_barrios_centro = {
-                "Mariscal Sucre", "La Floresta", "La Vicentina", "El Ejido", "América",
-                "San Juan", "La Colón", "La Pradera", "Guápulo", "Miraflores",
-                "Ferroviaria", "San Bartolo"
-            };
-            barrio_seleccionado = nombres_barrios_centro[barrio_num];
-            break;
-        }
-        case 2: { // Sur
-            const char* barrios_sur[] = {
-                "Solanda Centro", "Turubamba Bajo", "Turubamba Alto", "Tachuco", "La Loma",
-                "La Colmena", "Santa Ana", "Luluncoto", "Chimbacalle", "Alpahuasi",
-                "La Magdalena", "Villa Flora", "Marcopamba", "Atahualpa", "El Pintado",
-                "Chinyacu", "Tarqui", "Guajalo", "Santa Rita", "Chillogallo", "Ecuatoriana"
-            };
-            barrio_num = seleccionar_opcion("===== SELECCIONE SU BARRIO - ZONA SUR =====", barrios_sur, 21, 4);
-            vector<string> nombres_barrios_sur = {
-                "Solanda Centro", "Turubamba Bajo", "Turubamba Alto", "Tachuco", "La Loma",
-                "La Colmena", "Santa Ana", "Luluncoto", "Chimbacalle", "Alpahuasi",
-                "La Magdalena", "Villa Flora", "Marcopamba", "Atahualpa", "El Pintado",
-                "Chinyacu", "Tarqui", "Guajalo", "Santa Rita", "Chillogallo", "Ecuatoriana"
-            };
-            barrio_seleccionado = nombres_barrios_sur[barrio_num];
-            break;
-        }
-        case 3: { // Valles
-            const char* barrios_valles[] = {
-                "Cumbayá", "Tumbaco", "Conocoto", "Sangolquí", "San Rafael"
-            };
-            barrio_num = seleccionar_opcion("===== SELECCIONE SU BARRIO - VALLES =====", barrios_valles, 5, 4);
-            vector<string> nombres_barrios_valles = {
-                "Cumbayá", "Tumbaco", "Conocoto", "Sangolquí", "San Rafael"
-            };
-            barrio_seleccionado = nombres_barrios_valles[barrio_num];
-            break;
+    const char* titulos[] = {
+        "===== SELECCIONE SU BARRIO - ZONA NORTE =====",
+        "===== SELECCIONE SU BARRIO - ZONA CENTRO =====",
+        "===== SELECCIONE SU BARRIO - ZONA SUR =====",
+        "===== SELECCIONE SU BARRIO - VALLES ====="
+    };
+    vector<const char*> barrios_zona;
+    for (const auto& barrio : BARRIOS_QUITO) {
+        if (barrio.zona == sector) {
+            barrios_zona.push_back(barrio.nombre);
         }
     }
+    int barrio_num = seleccionar_opcion(titulos[sector], barrios_zona.data(), static_cast<int>(barrios_zona.size()), 4);
+    string barrio_seleccionado = barrios_zona[barrio_num];
     
     Location ubicacion_precisa = getLocationForBarrio(barrio_seleccionado);
     
@@ -294,166 +314,144 @@ double SimpleGeolocationSystem::calculateDistance(const Location& point1, const
 }
 
 /**
- * @brief Encuentra las 2 sucursales bancarias más cercanas a una ubicación específica
+ * @brief Encuentra las sucursales bancarias más cercanas a una ubicación específica
  * @param user_location Ubicación del usuario para la cual se buscan sucursales cercanas
+ * @param cantidad Número de sucursales a retornar (por defecto 2)
  * @return Vector de pares conteniendo las sucursales y sus distancias, ordenadas por proximidad
- * @details Esta función calcula la distancia de todas las sucursales disponibles
- *          respecto a la ubicación del usuario, las ordena por proximidad y retorna
- *          las 2 más cercanas para facilitar la selección del usuario.
- * @note Las distancias se calculan usando la fórmula de Haversine para mayor precisión
- * @warning Si hay menos de 2 sucursales registradas, retornará todas las disponibles
- */
-vector<pair<Branch, double>> SimpleGeolocationSystem::findNearestBranches(const Location& user_location) {
-    vector<pair<Branch, double>> branch_distances;
-    
-    // Calcular distancias desde la ubicación del usuario a todas las sucursales
-    for (auto& branch : branches) {
-        double distance = calculateDistance(user_location, branch.location);
-        branch_distances.push_back({branch, distance});
+ * @details Consulta el índice espacial de sucursales (árbol k-d) en lugar de calcular
+ *          la distancia a todas y ordenarlas; las distancias retornadas se calculan
+ *          con la fórmula de Haversine solo para las sucursales encontradas.
+ * @warning Si hay menos sucursales registradas que las solicitadas, retornará todas las disponibles
+ */
+vector<pair<Branch, double>> SimpleGeolocationSystem::findNearestBranches(const Location& user_location, size_t cantidad) {
+    vector<pair<Branch, double>> resultado;
+    for (const auto& vecino : indice_sucursales.vecinosMasCercanos(user_location.latitude, user_location.longitude, cantidad)) {
+        const Branch& branch = branches[vecino.first];
+        resultado.push_back({branch, calculateDistance(user_location, branch.location)});
     }
-    
-    // Ordenar sucursales por distancia (de menor a mayor)
-    sort(branch_distances.begin(), branch_distances.end(),
-         [](const pair<Branch, double>& a, const pair<Branch, double>& b) {
-             return a.second < b.second;
-         });
-    
-    // Retornar solo las 2 sucursales más cercanas
-    return vector<pair<Branch, double>>(branch_distances.begin(), branch_distances.begin() + 2);
+    return resultado;
+}
+
+/**
+ * @brief Encuentra las sucursales bancarias dentro de un radio
+ * @param user_location Ubicación del usuario
+ * @param radio_km Radio de búsqueda en kilómetros
+ * @return Vector de pares con las sucursales y sus distancias, ordenadas por proximidad
+ * @details Solo visita las ramas del índice espacial que pueden contener sucursales
+ *          dentro del radio
+ */
+vector<pair<Branch, double>> SimpleGeolocationSystem::findBranchesWithinRadius(const Location& user_location, double radio_km) {
+    vector<pair<Branch, double>> resultado;
+    for (const auto& vecino : indice_sucursales.dentroDeRadio(user_location.latitude, user_location.longitude, radio_km)) {
+        const Branch& branch = branches[vecino.first];
+        resultado.push_back({branch, calculateDistance(user_location, branch.location)});
+    }
+    return resultado;
 }
 
 /**
  * @brief Verifica si el día actual es válido para operaciones bancarias
  * @param time_info Estructura tm con información de fecha y hora
+ * @param sucursal_id ID de la sucursal cuyo horario se consulta
  * @return true si es un día válido para operaciones bancarias, false en caso contrario
- * @details Esta función verifica si el día de la semana es apropiado para brindar
- *          servicios bancarios. Los domingos no se atiende al público.
- * @note Los días válidos son de lunes a sábado (1-6 en tm_wday)
+ * @details Consulta la tabla precalculada del calendario bancario compartido, que
+ *          contempla el horario de la sucursal y los feriados.
+ * @note Los días válidos son de lunes a sábado, excepto feriados
  * @warning El domingo (0 en tm_wday) no es válido para operaciones bancarias
  */
-bool SimpleGeolocationSystem::isValidBankingDay(const struct tm* time_info) {
-    // Validar día de la semana (0=domingo, 1=lunes, ..., 6=sábado)
-    int dia_semana = time_info->tm_wday;
-    
-    // Los domingos el banco está cerrado
-    if (dia_semana == 0) {
-        return false;
-    }
-    
-    // Lunes a sábado son días válidos para operaciones bancarias
-    return true;
+bool SimpleGeolocationSystem::isValidBankingDay(const struct tm* time_info, int sucursal_id) {
+    return CalendarioBancario::instancia().esDiaBancario(time_info->tm_year + 1900, time_info->tm_mon + 1,
+                                                        time_info->tm_mday, sucursal_id);
 }
 
 /**
  * @brief Verifica si la hora actual es válida para operaciones bancarias
  * @param time_info Estructura tm con información de fecha y hora
+ * @param sucursal_id ID de la sucursal cuyo horario se consulta
  * @return true si es una hora válida para operaciones bancarias, false en caso contrario
  * @details Esta función verifica si la hora actual está dentro del horario de atención
- *          bancaria. Los horarios varían según el día de la semana:
- *          - Lunes a viernes: 9:00 a 17:00
+ *          bancaria registrado en el calendario compartido:
+ *          - Lunes a viernes: 9:00 a 15:30
  *          - Sábado: 9:00 a 12:00
- *          - Domingo: Cerrado
+ *          - Domingo y feriados: Cerrado
  * @note El horario se evalúa considerando tanto la hora como los minutos
- * @warning Los domingos no hay atención bancaria (retorna false)
  */
-bool SimpleGeolocationSystem::isValidBankingHour(const struct tm* time_info) {
-    // Extraer información temporal
-    int dia_semana = time_info->tm_wday; // 0=domingo, 1=lunes, ..., 6=sábado
-    int hora = time_info->tm_hour;
-    int minutos = time_info->tm_min;
-    
-    // Los domingos no hay atención bancaria
-    if (dia_semana == 0) {
-        return false;
-    }
-    
-    // Horario especial de sábado: 9:00 AM - 12:00 PM
-    if (dia_semana == 6) {
-        if (hora < 9 || (hora >= 12)) {
-            return false;
-        }
-        if (hora == 12 && minutos > 0) {
-            return false;
-        }
-    }
-    
-    // Horario de lunes a viernes: 9:00 AM - 3:30 PM
-    if (dia_semana >= 1 && dia_semana <= 5) {
-        if (hora < 9 || hora > 15) {
-            return false;
-        }
-        if (hora == 15 && minutos > 30) {
-            return false;
-        }
-    }
-    
-    return true;
+bool SimpleGeolocationSystem::isValidBankingHour(const struct tm* time_info, int sucursal_id) {
+    return CalendarioBancario::instancia().esMinutoBancario(time_info->tm_year + 1900, time_info->tm_mon + 1,
+                                                           time_info->tm_mday,
+                                                           time_info->tm_hour * 60 + time_info->tm_min, sucursal_id);
 }
 
 /**
  * @brief Genera horarios válidos para operaciones bancarias basados en la posición en cola
  * @param queue_position Posición actual en la cola de espera
+ * @param sucursal_id ID de la sucursal cuyo horario se usa
  * @return Vector de strings con los horarios disponibles para citas
  * @details Esta función calcula los próximos horarios disponibles para atención bancaria
- *          considerando la posición en cola y el tiempo de servicio. Busca hasta 5 horarios
- *          válidos dentro de las próximas 2 semanas, respetando los días y horas de atención.
- * @note Cada posición en cola equivale a SERVICE_TIME_MINUTES minutos de espera
+ *          a partir de la espera estimada para la cola actual. Recorre los próximos
+ *          DIAS_RECOMENDACION días de atención (dentro de las próximas 2 semanas), simula
+ *          cada día con las citas ya agendadas en la sucursal y, de las franjas de media hora
+ *          aún disponibles (sin una cita agendada), recomienda las 5 con menor espera prevista
+ *          (las más próximas en caso de empate), en orden cronológico.
+ * @note La espera de cada franja se obtiene de DIAS_SIMULADOS repeticiones del día
  * @warning Los horarios generados respetan los días y horas de atención bancaria
  */
-vector<string> SimpleGeolocationSystem::generateValidBankingTimeSlots(int queue_position) {
+vector<string> SimpleGeolocationSystem::generateValidBankingTimeSlots(int queue_position, int sucursal_id) {
     vector<string> slots;
+    const CalendarioBancario& calendario = CalendarioBancario::instancia();
     auto now = chrono::system_clock::now();
-    
-    int wait_minutes = queue_position * SERVICE_TIME_MINUTES;
-    auto current_time = now + chrono::minutes(wait_minutes);
-    
-    int slots_found = 0;
-    int days_checked = 0;
-    const int max_days_to_check = 14; // Buscar hasta 2 semanas adelante
-    
-    while (slots_found < 5 && days_checked < max_days_to_check) {
-        auto slot_time_t = chrono::system_clock::to_time_t(current_time);
-        struct tm* tm_info = localtime(&slot_time_t);
-        
-        if (isValidBankingDay(tm_info) && isValidBankingHour(tm_info)) {
-            char buffer[20];
-            char day_name[10];
-            
-            // Obtener nombre del día en español
-            const char* dias[] = {"Dom", "Lun", "Mar", "Mié", "Jue", "Vie", "Sáb"};
-            strcpy(day_name, dias[tm_info->tm_wday]);
-            
-            strftime(buffer, sizeof(buffer), "%d/%m %H:%M", tm_info);
-            string slot_info = string(day_name) + " " + string(buffer);
-            slots.push_back(slot_info);
-            slots_found++;
-        }
-        
-        // Avanzar al siguiente slot de tiempo
-        if (tm_info->tm_wday == 6 && tm_info->tm_hour >= 11) {
-            // Si es sábado y ya pasó las 11, saltar al lunes a las 9:00
-            current_time += chrono::hours(24 * 2); // Saltar al lunes
-            auto monday_time_t = chrono::system_clock::to_time_t(current_time);
-            struct tm* monday_tm = localtime(&monday_time_t);
-            monday_tm->tm_hour = 9;
-            monday_tm->tm_min = 0;
-            monday_tm->tm_sec = 0;
-            current_time = chrono::system_clock::from_time_t(mktime(monday_tm));
-            days_checked += 2;
-        } else if (tm_info->tm_wday >= 1 && tm_info->tm_wday <= 5 && tm_info->tm_hour >= 15) {
-            // Si es entre lunes y viernes y ya pasó las 15:00, saltar al siguiente día a las 9:00
-            current_time += chrono::hours(24);
-            auto next_day_time_t = chrono::system_clock::to_time_t(current_time);
-            struct tm* next_day_tm = localtime(&next_day_time_t);
-            next_day_tm->tm_hour = 9;
-            next_day_tm->tm_min = 0;
-            next_day_tm->tm_sec = 0;
-            current_time = chrono::system_clock::from_time_t(mktime(next_day_tm));
-            days_checked++;
-        } else {
-            // Avanzar 40 minutos (tiempo de servicio)
-            current_time += chrono::minutes(SERVICE_TIME_MINUTES);
+    auto limite = now + chrono::hours(24 * 14); // Buscar hasta 2 semanas adelante
+    auto desde = now + chrono::minutes(estimateWaitMinutes(sucursal_id, queue_position));
+
+    // Candidatos: (espera prevista en minutos, instante de la franja)
+    vector<pair<long, CalendarioBancario::Instante>> candidatos;
+    size_t dias_revisados = 0;
+    try {
+        auto actual = calendario.siguienteMinutoBancario(desde, sucursal_id);
+        while (dias_revisados < DIAS_RECOMENDACION && actual <= limite) {
+            long dia;
+            int minuto, segundos;
+            CalendarioBancario::descomponer(actual, dia, minuto, segundos);
+            int apertura, cierre;
+            calendario.horarioSucursal(sucursal_id, CalendarioBancario::diaSemana(dia), apertura, cierre);
+
+            vector<int> minutos_citas = minutosDeCitas(sucursal_id, dia);
+            ResultadoSimulacion simulacion = simulador_colas.simularDia(sucursal_id, apertura, cierre, minutos_citas,
+                                                                        DIAS_SIMULADOS);
+            // Las franjas que ya tienen una cita agendada no se ofrecen
+            vector<bool> reservada(simulacion.espera_por_franja.size(), false);
+            for (int minuto : minutos_citas) {
+                if (minuto < apertura) continue;
+                size_t franja = static_cast<size_t>((minuto - apertura) / SimuladorColas::MINUTOS_FRANJA);
+                if (franja < reservada.size()) reservada[franja] = true;
+            }
+            for (size_t f = 0; f < simulacion.espera_por_franja.size(); f++) {
+                auto instante = CalendarioBancario::componer(dia, apertura + static_cast<int>(f) * SimuladorColas::MINUTOS_FRANJA);
+                if (reservada[f] || instante < desde || instante > limite) continue;
+                candidatos.push_back({lround(simulacion.espera_por_franja[f]), instante});
+            }
+            dias_revisados++;
+            actual = calendario.siguienteMinutoBancario(CalendarioBancario::componer(dia + 1, 0), sucursal_id);
         }
+    } catch (const out_of_range&) {
+        // Sin atención hasta el fin del calendario bancario
+    }
+
+    size_t cantidad = min<size_t>(5, candidatos.size());
+    partial_sort(candidatos.begin(), candidatos.begin() + cantidad, candidatos.end());
+    candidatos.resize(cantidad);
+    sort(candidatos.begin(), candidatos.end(),
+         [](const pair<long, CalendarioBancario::Instante>& a, const pair<long, CalendarioBancario::Instante>& b) {
+             return a.second < b.second;
+         });
+
+    const char* dias[] = {"Dom", "Lun", "Mar", "Mié", "Jue", "Vie", "Sáb"};
+    for (const auto& candidato : candidatos) {
+        auto slot_time_t = chrono::system_clock::to_time_t(candidato.second);
+        struct tm* tm_info = localtime(&slot_time_t);
+        char buffer[20];
+        strftime(buffer, sizeof(buffer), "%d/%m %H:%M", tm_info);
+        slots.push_back(string(dias[tm_info->tm_wday]) + " " + string(buffer));
     }
     
     // Si no encontramos suficientes slots, completar con mensaje informativo
@@ -464,18 +462,88 @@ vector<string> SimpleGeolocationSystem::generateValidBankingTimeSlots(int queue_
     return slots;
 }
 
+/**
+ * @brief Estima el tiempo de espera de un cliente que llega ahora a una sucursal
+ * @param sucursal_id ID de la sucursal
+ * @param queue_position Personas en cola delante del cliente
+ * @return Minutos de espera estimados, redondeados
+ * @details En lugar de multiplicar la cola por un tiempo fijo, simula cómo los cajeros
+ *          de la sucursal atienden a quienes están delante con tiempos de atención variables.
+ */
+int SimpleGeolocationSystem::estimateWaitMinutes(int sucursal_id, int queue_position) {
+    return static_cast<int>(lround(simulador_colas.esperaConCola(sucursal_id, queue_position)));
+}
+
+/**
+ * @brief Simula un día de atención de una sucursal con sus citas agendadas
+ * @param sucursal_id ID de la sucursal
+ * @param anio Año
+ * @param mes Mes (1-12)
+ * @param dia Día del mes
+ * @param repeticiones Cantidad de días a simular
+ * @return Estadísticas de espera, cola y utilización (vacías si la sucursal no atiende ese día)
+ */
+ResultadoSimulacion SimpleGeolocationSystem::simularDiaSucursal(int sucursal_id, int anio, int mes, int dia, size_t repeticiones) {
+    const CalendarioBancario& calendario = CalendarioBancario::instancia();
+    if (!calendario.esDiaBancario(anio, mes, dia, sucursal_id)) return ResultadoSimulacion();
+
+    long dias = CalendarioBancario::diasDesdeCivil(anio, mes, dia);
+    int apertura, cierre;
+    calendario.horarioSucursal(sucursal_id, CalendarioBancario::diaSemana(dias), apertura, cierre);
+    return simulador_colas.simularDia(sucursal_id, apertura, cierre, minutosDeCitas(sucursal_id, dias), repeticiones);
+}
+
+/**
+ * @brief Calcula cuántos cajeros necesita una sucursal en una fecha
+ * @param sucursal_id ID de la sucursal
+ * @param anio Año
+ * @param mes Mes (1-12)
+ * @param dia Día del mes
+ * @param espera_objetivo Espera media máxima aceptada en minutos
+ * @return Cajeros necesarios (0 si la sucursal no atiende ese día)
+ */
+int SimpleGeolocationSystem::calcularCajerosNecesarios(int sucursal_id, int anio, int mes, int dia, double espera_objetivo) {
+    const CalendarioBancario& calendario = CalendarioBancario::instancia();
+    if (!calendario.esDiaBancario(anio, mes, dia, sucursal_id)) return 0;
+
+    long dias = CalendarioBancario::diasDesdeCivil(anio, mes, dia);
+    int apertura, cierre;
+    calendario.horarioSucursal(sucursal_id, CalendarioBancario::diaSemana(dias), apertura, cierre);
+    return simulador_colas.cajerosNecesarios(sucursal_id, apertura, cierre, minutosDeCitas(sucursal_id, dias),
+                                             espera_objetivo);
+}
+
+/**
+ * @brief Obtiene los minutos del día de las citas activas de una sucursal en una fecha
+ * @param sucursal_id ID de la sucursal
+ * @param dia Fecha como días desde 1970-01-01
+ * @return Minuto del día de cada cita
+ * @details Consulta el índice de la agenda por sector, sucursal y día (con año, deducido de
+ *          la fecha de agendamiento), por lo que las citas del mismo día de otro año no cuentan.
+ */
+vector<int> SimpleGeolocationSystem::minutosDeCitas(int sucursal_id, long dia) {
+    vector<int> minutos;
+    for (const CitaAgendada* cita : citas_agendadas.citasPorSucursalYDia(obtenerSectorPorSucursal(sucursal_id), sucursal_id, dia)) {
+        long dia_cita;
+        int minuto;
+        if (AgendaCitas::fechaDe(*cita, dia_cita, minuto)) minutos.push_back(minuto);
+    }
+    return minutos;
+}
+
 /**
  * @brief Genera horarios reales basados en la cola actual (función de compatibilidad)
  * @param queue_position Posición actual en la cola de espera
+ * @param sucursal_id ID de la sucursal cuyo horario se usa
  * @return Vector de strings con los horarios disponibles para citas
  * @details Esta función mantiene compatibilidad con versiones anteriores del sistema
  *          y delega la generación de horarios a la función con validaciones bancarias.
  * @note Función mantenida para compatibilidad con código existente
  * @see generateValidBankingTimeSlots() para la implementación completa
  */
-vector<string> SimpleGeolocationSystem::generateTimeSlots(int queue_position) {
+vector<string> SimpleGeolocationSystem::generateTimeSlots(int queue_position, int sucursal_id) {
     // Usar la nueva función con validaciones bancarias
-    return generateValidBankingTimeSlots(queue_position);
+    return generateValidBankingTimeSlots(queue_position, sucursal_id);
 }
 
 /**
@@ -511,11 +579,11 @@ void SimpleGeolocationSystem::displayBranches(const vector<pair<Branch, double>>
             cout << "   Tiempo de espera: 0 minutos" << endl;
         } else {
             cout << "   Personas en cola: " << branch.queue_position << endl;
-            int wait_time = branch.queue_position * SERVICE_TIME_MINUTES;
+            int wait_time = estimateWaitMinutes(branch.id, branch.queue_position);
             cout << "   Tiempo de espera: " << wait_time << " minutos" << endl;
         }
         
-        auto slots = generateValidBankingTimeSlots(branch.queue_position);
+        auto slots = generateValidBankingTimeSlots(branch.queue_position, branch.id);
         cout << "   Horarios disponibles: ";
         for (size_t j = 0; j < slots.size(); j++) {
             if (slots[j] != "No disponible") {
@@ -530,9 +598,9 @@ void SimpleGeolocationSystem::displayBranches(const vector<pair<Branch, double>>
         auto now_time_t = chrono::system_clock::to_time_t(now);
         struct tm* current_tm = localtime(&now_time_t);
         
-        if (!isValidBankingDay(current_tm)) {
-            cout << "Hoy no hay atención bancaria (Domingo)" << endl;
-        } else if (!isValidBankingHour(current_tm)) {
+        if (!isValidBankingDay(current_tm, branch.id)) {
+            cout << "Hoy no hay atención bancaria (" << (current_tm->tm_wday == 0 ? "Domingo" : "Feriado") << ")" << endl;
+        } else if (!isValidBankingHour(current_tm, branch.id)) {
             if (current_tm->tm_wday == 6) {
                 cout << "Fuera del horario de sábado (9:00 AM - 12:00 PM)" << endl;
             } else {
@@ -590,40 +658,27 @@ pair<Branch, double> SimpleGeolocationSystem::runGeolocationSystem() {
  * @param newQueuePosition Nueva posición de la cola para la sucursal
  * @details Esta función permite actualizar dinámicamente el estado de la cola
  *          de una sucursal específica, simulando la llegada o salida de clientes.
- *          Busca la sucursal por su ID y actualiza su posición de cola.
+ *          Obtiene la sucursal directamente por su ID y actualiza su posición de cola.
  * @note Útil para simular cambios en tiempo real en el sistema de colas
  * @warning Si el branchId no existe, no se realizará ningún cambio
  */
 void SimpleGeolocationSystem::updateBranchQueue(int branchId, int newQueuePosition) {
-    // Buscar la sucursal por ID y actualizar su cola
-    for (auto& branch : branches) {
-        if (branch.id == branchId) {
-            branch.queue_position = newQueuePosition;
-            break;
-        }
+    Branch* branch = buscarSucursal(branchId);
+    if (branch) {
+        branch->queue_position = newQueuePosition;
     }
 }
 
 /**
- * @brief Constructor de la estructura CitaAgendada
- * @param dni DNI del cliente
- * @param nombre Nombre completo del cliente
- * @param tel Teléfono del cliente
- * @param suc_id ID de la sucursal
- * @param suc_nombre Nombre de la sucursal
- * @param sec Sector de la sucursal
- * @param fecha_h Fecha y hora de la cita
- * @param num_conf Número de confirmación
- * @param fecha_ag Fecha de agendamiento
- * @param act Estado activo de la cita
- */
-CitaAgendada::CitaAgendada(const string& dni, const string& nombre, const string& tel,
-                           int suc_id, const string& suc_nombre, const string& sec,
-                           const string& fecha_h, const string& num_conf,
-                           const string& fecha_ag, bool act)
-    : dni(dni), nombre_completo(nombre), telefono(tel), sucursal_id(suc_id),
-      sucursal_nombre(suc_nombre), sector(sec), fecha_hora(fecha_h),
-      numero_confirmacion(num_conf), fecha_agendamiento(fecha_ag), activa(act) {}
+ * @brief Obtiene una sucursal por su ID
+ * @param sucursal_id ID de la sucursal
+ * @return Puntero a la sucursal, o nullptr si no existe
+ */
+Branch* SimpleGeolocationSystem::buscarSucursal(int sucursal_id) {
+    if (sucursal_id < 0 || static_cast<size_t>(sucursal_id) >= posicion_sucursal.size()) return nullptr;
+    int posicion = posicion_sucursal[sucursal_id];
+    return posicion >= 0 ? &branches[posicion] : nullptr;
+}
 
 /**
  * @brief Verifica si un cliente ya tiene una cita agendada activa
@@ -631,12 +686,7 @@ CitaAgendada::CitaAgendada(const string& dni, const string& nombre, const string
  * @return true si ya tiene una cita activa, false en caso contrario
  */
 bool SimpleGeolocationSystem::clienteTieneCitaActiva(const string& dni) {
-    for (const auto& cita : citas_agendadas) {
-        if (cita.dni == dni && cita.activa) {
-            return true;
-        }
-    }
-    return false;
+    return citas_agendadas.tieneCitaActiva(dni);
 }
 
 /**
@@ -645,13 +695,7 @@ bool SimpleGeolocationSystem::clienteTieneCitaActiva(const string& dni) {
  * @return true si se agregó exitosamente, false en caso contrario
  */
 bool SimpleGeolocationSystem::agregarCita(const CitaAgendada& cita) {
-    try {
-        citas_agendadas.push_back(cita);
-        guardarCitas(); // Guardar automáticamente
-        return true;
-    } catch (const std::exception& e) {
-        return false;
-    }
+    return citas_agendadas.agregar(cita);
 }
 
 /**
@@ -661,19 +705,7 @@ bool SimpleGeolocationSystem::agregarCita(const CitaAgendada& cita) {
  * @return true si se canceló exitosamente, false si no se encontró
  */
 bool SimpleGeolocationSystem::cancelarCita(const string& dni, const string& numero_confirmacion) {
-    for (auto& cita : citas_agendadas) {
-        string numero_cita_upper = cita.numero_confirmacion;
-        transform(numero_cita_upper.begin(), numero_cita_upper.end(), numero_cita_upper.begin(), ::toupper);
-        string numero_input_upper = numero_confirmacion;
-        transform(numero_input_upper.begin(), numero_input_upper.end(), numero_input_upper.begin(), ::toupper);
-        
-        if (cita.dni == dni && numero_cita_upper == numero_input_upper && cita.activa) {
-            cita.activa = false;
-            guardarCitas(); // Guardar cambios
-            return true;
-        }
-    }
-    return false;
+    return citas_agendadas.cancelar(dni, numero_confirmacion);
 }
 
 /**
@@ -681,16 +713,17 @@ bool SimpleGeolocationSystem::cancelarCita(const string& dni, const string& nume
  * @param sector Sector específico a consultar (vacío para ver todos)
  * @return Vector con las citas del sector especificado
  */
-vector<CitaAgendada> SimpleGeolocationSystem::obtenerCitasPorSector(const string& sector) {
-    vector<CitaAgendada> citas_filtradas;
-    
-    for (const auto& cita : citas_agendadas) {
-        if (cita.activa && (sector.empty() || cita.sector == sector)) {
-            citas_filtradas.push_back(cita);
-        }
-    }
-    
-    return citas_filtradas;
+vector<const CitaAgendada*> SimpleGeolocationSystem::obtenerCitasPorSector(const string& sector) {
+    return citas_agendadas.citasPorSector(sector);
+}
+
+/**
+ * @brief Obtiene las citas activas de un cliente
+ * @param dni DNI del cliente
+ * @return Vector con las citas activas del cliente
+ */
+vector<const CitaAgendada*> SimpleGeolocationSystem::obtenerCitasCliente(const string& dni) {
+    return citas_agendadas.citasActivasDe(dni);
 }
 
 /**
@@ -699,30 +732,7 @@ vector<CitaAgendada> SimpleGeolocationSystem::obtenerCitasPorSector(const string
  * @return true si se guardó exitosamente, false en caso contrario
  */
 bool SimpleGeolocationSystem::guardarCitas(const string& archivo) {
-    try {
-        ofstream file(archivo);
-        if (!file.is_open()) {
-            return false;
-        }
-        
-        for (const auto& cita : citas_agendadas) {
-            file << cita.dni << "|"
-                 << cita.nombre_completo << "|"
-                 << cita.telefono << "|"
-                 << cita.sucursal_id << "|"
-                 << cita.sucursal_nombre << "|"
-                 << cita.sector << "|"
-                 << cita.fecha_hora << "|"
-                 << cita.numero_confirmacion << "|"
-                 << cita.fecha_agendamiento << "|"
-                 << (cita.activa ? "1" : "0") << endl;
-        }
-        
-        file.close();
-        return true;
-    } catch (const std::exception& e) {
-        return false;
-    }
+    return citas_agendadas.guardarComo(archivo);
 }
 
 /**
@@ -731,47 +741,33 @@ bool SimpleGeolocationSystem::guardarCitas(const string& archivo) {
  * @return true si se cargó exitosamente, false en caso contrario
  */
 bool SimpleGeolocationSystem::cargarCitas(const string& archivo) {
-    try {
-        ifstream file(archivo);
-        if (!file.is_open()) {
-            return false; // Archivo no existe, es normal al inicio
-        }
-        
-        citas_agendadas.clear();
-        string line;
-        
-        while (getline(file, line)) {
-            if (line.empty()) continue;
-            
-            vector<string> campos;
-            string campo = "";
-            
-            for (char c : line) {
-                if (c == '|') {
-                    campos.push_back(campo);
-                    campo = "";
-                } else {
-                    campo += c;
-                }
-            }
-            campos.push_back(campo); // Último campo
-            
-            if (campos.size() == 10) {
-                CitaAgendada cita(
-                    campos[0], campos[1], campos[2],
-                    stoi(campos[3]), campos[4], campos[5],
-                    campos[6], campos[7], campos[8],
-                    campos[9] == "1"
-                );
-                citas_agendadas.push_back(cita);
-            }
-        }
-        
-        file.close();
+    if (citas_agendadas.cargar(archivo)) {
         return true;
-    } catch (const std::exception& e) {
-        return false;
     }
+    // Primera ejecución con el formato binario: migrar el archivo de texto anterior
+    ifstream binario(archivo, ios::binary);
+    if (!binario.is_open()) {
+        return citas_agendadas.importarTexto("citas_agendadas.txt");
+    }
+    return false;
+}
+
+/**
+ * @brief Importa citas desde un archivo de texto delimitado por '|'
+ * @param archivo Nombre del archivo de texto
+ * @return true si se importó exitosamente, false en caso contrario
+ */
+bool SimpleGeolocationSystem::importarCitasTexto(const string& archivo) {
+    return citas_agendadas.importarTexto(archivo);
+}
+
+/**
+ * @brief Exporta las citas a un archivo de texto delimitado por '|'
+ * @param archivo Nombre del archivo de texto
+ * @return true si se exportó exitosamente, false en caso contrario
+ */
+bool SimpleGeolocationSystem::exportarCitasTexto(const string& archivo) {
+    return citas_agendadas.exportarTexto(archivo);
 }
 
 /**
@@ -780,20 +776,18 @@ bool SimpleGeolocationSystem::cargarCitas(const string& archivo) {
  * @return String con el nombre del sector
  */
 string SimpleGeolocationSystem::obtenerSectorPorSucursal(int sucursal_id) {
-    for (const auto& branch : branches) {
-        if (branch.id == sucursal_id) {
-            // Determinar sector basado en el nombre de la sucursal
-            string nombre = branch.name;
-            if (nombre.find("Centro") != string::npos) {
-                return "Centro Histórico";
-            } else if (nombre.find("Norte") != string::npos) {
-                return "Norte de Quito";
-            } else if (nombre.find("Sur") != string::npos) {
-                return "Sur de Quito";
-            } else if (nombre.find("Valle") != string::npos || nombre.find("Cumbayá") != string::npos || 
-                       nombre.find("Tumbaco") != string::npos || nombre.find("Sangolquí") != string::npos) {
-                return "Valles de Quito";
-            }
+    if (const Branch* branch = buscarSucursal(sucursal_id)) {
+        // Determinar sector basado en el nombre de la sucursal
+        string nombre = branch->name;
+        if (nombre.find("Centro") != string::npos) {
+            return "Centro Histórico";
+        } else if (nombre.find("Norte") != string::npos) {
+            return "Norte de Quito";
+        } else if (nombre.find("Sur") != string::npos) {
+            return "Sur de Quito";
+        } else if (nombre.find("Valle") != string::npos || nombre.find("Cumbayá") != string::npos || 
+                   nombre.find("Tumbaco") != string::npos || nombre.find("Sangolquí") != string::npos) {
+            return "Valles de Quito";
         }
     }
     return "Sector Desconocido";
@@ -12,7 +12,11 @@
 #ifndef UBICACION_H
 #define UBICACION_H
 
+#include "AgendaCitas.h"
+#include "IndiceEspacial.h"
+#include "SimuladorColas.h"
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 using namespace std;
@@ -83,42 +87,6 @@ public:
            double lat, double lon, int queue = 0);
 };
 
-/**
- * @brief Estructura para almacenar información de citas agendadas
- * @details Esta estructura mantiene registro de todas las citas presenciales
- *          agendadas para evitar duplicados y permitir consultas por sector
- */
-struct CitaAgendada {
-    string dni;                    ///< DNI del cliente que agendó la cita
-    string nombre_completo;        ///< Nombre completo del cliente
-    string telefono;               ///< Teléfono del cliente
-    int sucursal_id;              ///< ID de la sucursal donde se agendó
-    string sucursal_nombre;       ///< Nombre de la sucursal
-    string sector;                ///< Sector/zona de la sucursal
-    string fecha_hora;            ///< Fecha y hora de la cita
-    string numero_confirmacion;   ///< Número de confirmación de la cita
-    string fecha_agendamiento;    ///< Fecha cuando se agendó la cita
-    bool activa;                  ///< Estado de la cita (activa/cancelada)
-    
-    /**
-     * @brief Constructor de la estructura CitaAgendada
-     * @param dni DNI del cliente
-     * @param nombre Nombre completo del cliente
-     * @param tel Teléfono del cliente
-     * @param suc_id ID de la sucursal
-     * @param suc_nombre Nombre de la sucursal
-     * @param sec Sector de la sucursal
-     * @param fecha_h Fecha y hora de la cita
-     * @param num_conf Número de confirmación
-     * @param fecha_ag Fecha de agendamiento
-     * @param act Estado activo de la cita
-     */
-    CitaAgendada(const string& dni, const string& nombre, const string& tel,
-                 int suc_id, const string& suc_nombre, const string& sec,
-                 const string& fecha_h, const string& num_conf,
-                 const string& fecha_ag, bool act = true);
-};
-
 /**
  * @brief Sistema de geolocalización y gestión de sucursales bancarias
  * @details Esta clase implementa un sistema completo de geolocalización para
@@ -130,36 +98,59 @@ struct CitaAgendada {
 class SimpleGeolocationSystem {
 private:
     vector<Branch> branches;              ///< Lista de sucursales bancarias disponibles
-    vector<CitaAgendada> citas_agendadas; ///< Lista de citas agendadas
+    AgendaCitas citas_agendadas;          ///< Citas agendadas, indexadas y con registro de cambios
+    IndiceEspacial indice_sucursales;     ///< Árbol k-d sobre las ubicaciones de las sucursales (misma posición que en branches)
+    unordered_map<string, Location> ubicaciones_barrio; ///< Coordenadas de cada barrio de Quito
+    vector<int> posicion_sucursal;        ///< Posición en branches de cada ID de sucursal (-1 si no existe)
+    SimuladorColas simulador_colas;       ///< Modelo de atención (cajeros, llegadas, tiempos) de cada sucursal
     const double EARTH_RADIUS_KM = 6371.0; ///< Radio de la Tierra en kilómetros para cálculos
-    const int SERVICE_TIME_MINUTES = 40;   ///< Tiempo promedio de atención por cliente en minutos
+    const size_t DIAS_RECOMENDACION = 3;   ///< Días de atención que se comparan al recomendar horarios
+    const size_t DIAS_SIMULADOS = 300;     ///< Repeticiones de cada día simulado para estimar esperas
     
     /**
      * @brief Obtiene coordenadas geográficas para un barrio específico de Quito
      * @param barrio Nombre del barrio para el cual se solicitan las coordenadas
      * @return Objeto Location con las coordenadas del barrio especificado
-     * @details Método privado que mapea barrios específicos de Quito a sus
-     *          coordenadas geográficas aproximadas
+     * @details Método privado que busca el barrio en la tabla hash de barrios
+     *          de Quito y retorna sus coordenadas geográficas aproximadas
      */
     Location getLocationForBarrio(const string& barrio);
     
     /**
      * @brief Valida si un día es válido para operaciones bancarias
      * @param time_info Estructura tm con información de fecha y hora
+     * @param sucursal_id ID de la sucursal cuyo horario se consulta
      * @return true si es un día válido para operaciones bancarias, false en caso contrario
-     * @details Método privado que verifica si el día de la semana permite
-     *          realizar operaciones bancarias (lunes a sábado)
+     * @details Método privado que consulta el calendario bancario compartido
+     *          (lunes a sábado, excepto feriados)
      */
-    bool isValidBankingDay(const struct tm* time_info);
+    bool isValidBankingDay(const struct tm* time_info, int sucursal_id);
     
     /**
      * @brief Valida si una hora es válida para operaciones bancarias
      * @param time_info Estructura tm con información de fecha y hora
+     * @param sucursal_id ID de la sucursal cuyo horario se consulta
      * @return true si es una hora válida para operaciones bancarias, false en caso contrario
      * @details Método privado que verifica si la hora actual está dentro del
-     *          horario de atención bancaria según el día de la semana
+     *          horario de atención de la sucursal en el calendario bancario compartido
+     */
+    bool isValidBankingHour(const struct tm* time_info, int sucursal_id);
+    
+    /**
+     * @brief Obtiene una sucursal por su ID
+     * @param sucursal_id ID de la sucursal
+     * @return Puntero a la sucursal, o nullptr si no existe
+     * @details Acceso directo por la tabla posicion_sucursal, sin recorrer las sucursales
+     */
+    Branch* buscarSucursal(int sucursal_id);
+    
+    /**
+     * @brief Obtiene los minutos del día de las citas activas de una sucursal en una fecha
+     * @param sucursal_id ID de la sucursal
+     * @param dia Fecha como días desde 1970-01-01
+     * @return Minuto del día (hora * 60 + minutos) de cada cita
      */
-    bool isValidBankingHour(const struct tm* time_info);
+    vector<int> minutosDeCitas(int sucursal_id, long dia);
     
 public:
     /**
@@ -173,7 +164,8 @@ public:
      * @brief Inicializa las sucursales bancarias en el sistema
      * @details Carga las sucursales bancarias predefinidas con sus ubicaciones
      *          geográficas reales en Quito, Ecuador, incluyendo coordenadas,
-     *          direcciones y configuración inicial de colas
+     *          direcciones y configuración inicial de colas, y reconstruye el
+     *          índice espacial de sucursales
      */
     void initializeBranches();
     
@@ -198,28 +190,71 @@ public:
     /**
      * @brief Encuentra las sucursales más cercanas a una ubicación
      * @param user_location Ubicación del usuario
+     * @param cantidad Número de sucursales a retornar (por defecto 2)
+     * @return Vector de pares con las sucursales y sus distancias, ordenadas por proximidad
+     * @details Consulta el índice espacial de sucursales en O(log n) en lugar de
+     *          calcular la distancia a todas y ordenarlas
+     */
+    vector<pair<Branch, double>> findNearestBranches(const Location& user_location, size_t cantidad = 2);
+    
+    /**
+     * @brief Encuentra las sucursales dentro de un radio
+     * @param user_location Ubicación del usuario
+     * @param radio_km Radio de búsqueda en kilómetros
      * @return Vector de pares con las sucursales y sus distancias, ordenadas por proximidad
-     * @details Calcula las distancias a todas las sucursales y retorna
-     *          las 2 más cercanas al usuario
      */
-    vector<pair<Branch, double>> findNearestBranches(const Location& user_location);
+    vector<pair<Branch, double>> findBranchesWithinRadius(const Location& user_location, double radio_km);
     
     /**
      * @brief Genera horarios disponibles basados en la posición en cola
      * @param queue_position Posición actual en la cola de espera
+     * @param sucursal_id ID de la sucursal cuyo horario se usa
      * @return Vector de strings con los horarios disponibles
      * @details Función de compatibilidad que delega a generateValidBankingTimeSlots
      */
-    vector<string> generateTimeSlots(int queue_position);
+    vector<string> generateTimeSlots(int queue_position, int sucursal_id);
     
     /**
      * @brief Genera horarios válidos para operaciones bancarias
      * @param queue_position Posición actual en la cola de espera
+     * @param sucursal_id ID de la sucursal cuyo horario se usa
      * @return Vector de strings con los horarios válidos disponibles
      * @details Calcula los próximos horarios disponibles considerando la cola
-     *          y validando días y horas de atención bancaria
+     *          y validando días y horas de atención bancaria; entre ellos elige
+     *          los de menor espera según la simulación de la sucursal
+     */
+    vector<string> generateValidBankingTimeSlots(int queue_position, int sucursal_id);
+    
+    /**
+     * @brief Estima el tiempo de espera de un cliente que llega ahora a una sucursal
+     * @param sucursal_id ID de la sucursal
+     * @param queue_position Personas en cola delante del cliente
+     * @return Minutos de espera estimados
+     * @details Simula la atención de la cola con los cajeros y tiempos de atención de la sucursal
+     */
+    int estimateWaitMinutes(int sucursal_id, int queue_position);
+    
+    /**
+     * @brief Simula un día de atención de una sucursal con sus citas agendadas
+     * @param sucursal_id ID de la sucursal
+     * @param anio Año
+     * @param mes Mes (1-12)
+     * @param dia Día del mes
+     * @param repeticiones Cantidad de días a simular
+     * @return Estadísticas de espera, cola y utilización (vacías si la sucursal no atiende ese día)
+     */
+    ResultadoSimulacion simularDiaSucursal(int sucursal_id, int anio, int mes, int dia, size_t repeticiones);
+    
+    /**
+     * @brief Calcula cuántos cajeros necesita una sucursal en una fecha
+     * @param sucursal_id ID de la sucursal
+     * @param anio Año
+     * @param mes Mes (1-12)
+     * @param dia Día del mes
+     * @param espera_objetivo Espera media máxima aceptada en minutos
+     * @return Cajeros necesarios (0 si la sucursal no atiende ese día)
      */
-    vector<string> generateValidBankingTimeSlots(int queue_position);
+    int calcularCajerosNecesarios(int sucursal_id, int anio, int mes, int dia, double espera_objetivo);
     
     /**
      * @brief Muestra información detallada de las sucursales
@@ -250,7 +285,8 @@ public:
      * @param branchId Identificador único de la sucursal
      * @param newQueuePosition Nueva posición de la cola
      * @details Permite actualizar dinámicamente el estado de la cola
-     *          de una sucursal específica para simular cambios en tiempo real
+     *          de una sucursal específica para simular cambios en tiempo real.
+     *          La sucursal se obtiene directamente por su ID
      */
     void updateBranchQueue(int branchId, int newQueuePosition);
     
@@ -258,7 +294,7 @@ public:
      * @brief Verifica si un cliente ya tiene una cita agendada activa
      * @param dni DNI del cliente a verificar
      * @return true si ya tiene una cita activa, false en caso contrario
-     * @details Busca en la lista de citas activas para evitar duplicados
+     * @details Consulta el índice de citas activas por DNI para evitar duplicados
      */
     bool clienteTieneCitaActiva(const string& dni);
     
@@ -266,7 +302,8 @@ public:
      * @brief Agrega una nueva cita al sistema
      * @param cita Objeto CitaAgendada con la información de la cita
      * @return true si se agregó exitosamente, false en caso contrario
-     * @details Registra una nueva cita en el sistema para control de duplicados
+     * @details Registra una nueva cita en el sistema para control de duplicados;
+     *          solo anexa su línea al archivo de citas
      */
     bool agregarCita(const CitaAgendada& cita);
     
@@ -275,33 +312,61 @@ public:
      * @param dni DNI del cliente
      * @param numero_confirmacion Número de confirmación de la cita
      * @return true si se canceló exitosamente, false si no se encontró
-     * @details Marca una cita como inactiva en lugar de eliminarla
+     * @details Marca una cita como inactiva en lugar de eliminarla y anexa la
+     *          cancelación al archivo de citas
      */
     bool cancelarCita(const string& dni, const string& numero_confirmacion);
     
     /**
      * @brief Obtiene todas las citas agendadas por sector
      * @param sector Sector específico a consultar (vacío para ver todos)
-     * @return Vector con las citas del sector especificado
-     * @details Permite consultar citas por zona geográfica
+     * @return Vector con las citas activas del sector especificado, agrupadas por sucursal y día
+     * @details Permite consultar citas por zona geográfica. Los punteros siguen siendo
+     *          válidos hasta la próxima llamada a cargarCitas()
      */
-    vector<CitaAgendada> obtenerCitasPorSector(const string& sector = "");
+    vector<const CitaAgendada*> obtenerCitasPorSector(const string& sector = "");
+    
+    /**
+     * @brief Obtiene las citas activas de un cliente
+     * @param dni DNI del cliente
+     * @return Vector con las citas activas del cliente, en orden de agendamiento
+     */
+    vector<const CitaAgendada*> obtenerCitasCliente(const string& dni);
     
     /**
      * @brief Guarda las citas en un archivo para persistencia
-     * @param archivo Nombre del archivo donde guardar
+     * @param archivo Nombre del archivo binario donde guardar
      * @return true si se guardó exitosamente, false en caso contrario
-     * @details Mantiene persistencia de las citas entre sesiones
+     * @details Escribe el estado completo de las citas; sobre el archivo de citas
+     *          actual equivale a compactar su registro de cambios
      */
-    bool guardarCitas(const string& archivo = "citas_agendadas.txt");
+    bool guardarCitas(const string& archivo = "citas_agendadas.dat");
     
     /**
      * @brief Carga las citas desde un archivo
-     * @param archivo Nombre del archivo desde donde cargar
+     * @param archivo Nombre del archivo binario desde donde cargar
      * @return true si se cargó exitosamente, false en caso contrario
-     * @details Restaura las citas guardadas al iniciar el sistema
+     * @details Restaura las citas guardadas al iniciar el sistema, reproduciendo
+     *          las altas y cancelaciones registradas en el archivo. Si el archivo
+     *          binario aún no existe, importa el archivo de texto anterior
+     *          (citas_agendadas.txt) cuando está disponible
+     */
+    bool cargarCitas(const string& archivo = "citas_agendadas.dat");
+    
+    /**
+     * @brief Importa citas desde un archivo de texto delimitado por '|'
+     * @param archivo Nombre del archivo de texto
+     * @return true si se importó exitosamente, false en caso contrario
+     * @details Reemplaza las citas actuales y las guarda en el archivo binario
+     */
+    bool importarCitasTexto(const string& archivo = "citas_agendadas.txt");
+    
+    /**
+     * @brief Exporta las citas a un archivo de texto delimitado por '|'
+     * @param archivo Nombre del archivo de texto
+     * @return true si se exportó exitosamente, false en caso contrario
      */
-    bool cargarCitas(const string& archivo = "citas_agendadas.txt");
+    bool exportarCitasTexto(const string& archivo = "citas_agendadas.txt");
     
     /**
      * @brief Obtiene el sector de una sucursal por su ID
@@ -9,11 +9,13 @@
 #include <conio.h>
 #include "Menus.h"
 #include "Ubicacion.h"
+#include "CalendarioBancario.h"
 
 /**
  * @brief Función principal del sistema bancario.
  *
  * - Cambia la codificación de la consola a UTF-8.
+ * - Carga los feriados del calendario bancario desde feriados.txt (si existe).
  * - Instancia el objeto Banco y verifica/recupera los datos desde archivo.
  * - Si datos.txt no existe, permite seleccionar un backup para recuperar.
  * - Llama al menú principal para interacción con el usuario.
@@ -23,6 +25,9 @@
 int main() {
     system("chcp 65001 > nul");
     
+    // Los feriados deben cargarse antes que los turnos, que se numeran por día bancario
+    CalendarioBancario::instancia().cargarFeriados("feriados.txt");
+    
     Banco banco;
     
     // Verificar y recuperar datos usando la nueva función
@@ -31,6 +36,7 @@ int main() {
     // Cargar citas agendadas al sistema de geolocalización
     extern SimpleGeolocationSystem geoSystem;
     geoSystem.cargarCitas();
+    reservar_turnos_citas(banco);
     
     getch();
     menu_principal(banco);
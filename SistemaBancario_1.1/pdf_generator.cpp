@@ -8,7 +8,11 @@
  */
 
 #include "pdf_generator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 #include <vector>
 #include "ListaDoble.h" // Incluye la definición de ListaDoble
 #include "Cliente.h"    // Incluye la definición de Cliente
@@ -17,124 +21,216 @@
 
 using namespace std;
 
+namespace {
+
+// Diseño de página (A4 vertical, coordenadas en puntos desde la esquina inferior izquierda)
+const float MARGEN_X = 50;            // Margen izquierdo
+const float Y_ENCABEZADO = 750;       // Línea base del encabezado de la tabla
+const float ALTO_FILA = 20;           // Separación entre filas
+const float Y_MINIMA = 100;           // Ninguna fila se escribe por debajo de esta altura
+const float Y_PIE = 50;               // Línea base del número de página
+const float ANCHO_TABLA = 400;        // Largo de la línea bajo el encabezado
+const float COLUMNAS[] = {0, 150, 300}; // Desplazamiento de las columnas Nombre, ID Cuenta y Saldo
+const char* const TITULOS[] = {"Nombre", "ID Cuenta", "Saldo"};
+
+// Filas por página: la primera va dos filas debajo del encabezado (la línea ocupa una)
+const size_t FILAS_POR_PAGINA = static_cast<size_t>((Y_ENCABEZADO - 2 * ALTO_FILA - Y_MINIMA) / ALTO_FILA) + 1;
+
 /**
- * @brief Genera un reporte PDF con datos de clientes y sus cuentas bancarias.
- * @param clientes Puntero constante a la lista doblemente enlazada de clientes.
- * @details Esta función crea un documento PDF que contiene un reporte tabular con
- * información de todos los clientes y sus cuentas bancarias. El reporte incluye:
- * - Nombre completo del cliente (nombres + apellidos)
- * - ID de cada cuenta bancaria
- * - Saldo actual de cada cuenta
- * 
- * El PDF se genera con formato A4 en orientación vertical, usando fuente Helvetica
- * de 12 puntos. Incluye paginación automática cuando el contenido excede el espacio
- * disponible en una página.
- * 
- * @note La función utiliza la librería Haru PDF (libhpdf) para la generación del documento.
- * @warning Si no se pueden cargar las fuentes o crear el PDF, la función termina prematuramente.
+ * @brief Fila del reporte: una cuenta y su titular.
  */
-void generateClientDataPDF(const ListaDoble<Cliente*>* clientes) {
-    // Inicialización del documento PDF
+struct FilaReporte {
+    const Cliente* cliente;
+    Cuenta* cuenta;
+};
+
+/**
+ * @brief Escribe el encabezado de la tabla y la línea separadora de una página.
+ */
+void escribirEncabezado(HPDF_Page page) {
+    HPDF_Page_BeginText(page);
+    for (int c = 0; c < 3; c++) {
+        HPDF_Page_TextOut(page, MARGEN_X + COLUMNAS[c], Y_ENCABEZADO, TITULOS[c]);
+    }
+    HPDF_Page_EndText(page);
+
+    HPDF_Page_MoveTo(page, MARGEN_X, Y_ENCABEZADO - ALTO_FILA);
+    HPDF_Page_LineTo(page, MARGEN_X + ANCHO_TABLA, Y_ENCABEZADO - ALTO_FILA);
+    HPDF_Page_Stroke(page);
+}
+
+/**
+ * @brief Renderiza un rango de páginas del reporte en un documento propio y lo guarda.
+ * @param filas Instantánea de la cartera
+ * @param primera Primera página del rango (desde 0)
+ * @param fin Página siguiente a la última del rango
+ * @param total_paginas Páginas del reporte completo (para el pie de página)
+ * @param archivo Ruta del PDF a escribir
+ * @param paginas_listas Contador compartido de páginas terminadas
+ * @return true si el documento se guardó
+ */
+bool renderizarParte(const vector<FilaReporte>& filas, size_t primera, size_t fin, size_t total_paginas,
+                     const string& archivo, atomic<size_t>& paginas_listas) {
     HPDF_Doc pdf = HPDF_New(NULL, NULL);
     if (!pdf) {
-        cerr << "Error al crear el PDF" << endl;
-        return;
+        cerr << "Error al crear el PDF " << archivo << endl;
+        return false;
     }
+    HPDF_SetCompressionMode(pdf, HPDF_COMP_ALL);
 
-    // Creación de la primera página con formato A4 vertical
-    HPDF_Page page = HPDF_AddPage(pdf);
-    HPDF_Page_SetSize(page, HPDF_PAGE_SIZE_A4, HPDF_PAGE_PORTRAIT);
-
-    // Configuración de la fuente Helvetica con tamaño 12
     HPDF_Font font = HPDF_GetFont(pdf, "Helvetica", NULL);
     if (!font) {
         cerr << "Error al cargar la fuente Helvetica" << endl;
         HPDF_Free(pdf);
-        return;
+        return false;
     }
-    HPDF_Page_SetFontAndSize(page, font, 12);
 
-    cout << "Procesando datos de clientes desde memoria..." << endl;
+    string nombre, saldo;
+    const Cliente* titular = nullptr;
+    for (size_t pagina = primera; pagina < fin; pagina++) {
+        HPDF_Page page = HPDF_AddPage(pdf);
+        HPDF_Page_SetSize(page, HPDF_PAGE_SIZE_A4, HPDF_PAGE_PORTRAIT);
+        HPDF_Page_SetFontAndSize(page, font, 12);
+        escribirEncabezado(page);
 
-    // Configuración de posiciones iniciales para el contenido
-    float yPosition = 750;  // Posición vertical inicial (desde arriba)
-    float xPosition = 50;   // Margen izquierdo
+        // Un solo objeto de texto por página con todas las celdas y el pie
+        HPDF_Page_BeginText(page);
+        size_t desde = pagina * FILAS_POR_PAGINA;
+        size_t hasta = min(filas.size(), desde + FILAS_POR_PAGINA);
+        float y = Y_ENCABEZADO - 2 * ALTO_FILA;
+        for (size_t i = desde; i < hasta; i++, y -= ALTO_FILA) {
+            if (filas[i].cliente != titular) {
+                titular = filas[i].cliente;
+                nombre = titular->get_nombres() + " " + titular->get_apellidos();
+            }
+            string cuenta = filas[i].cuenta->get_id_cuenta();
+            saldo = to_string(filas[i].cuenta->get_saldo());
+            HPDF_Page_TextOut(page, MARGEN_X + COLUMNAS[0], y, nombre.c_str());
+            HPDF_Page_TextOut(page, MARGEN_X + COLUMNAS[1], y, cuenta.c_str());
+            HPDF_Page_TextOut(page, MARGEN_X + COLUMNAS[2], y, saldo.c_str());
+        }
+        string pie = "Pagina " + to_string(pagina + 1) + " de " + to_string(total_paginas);
+        HPDF_Page_TextOut(page, MARGEN_X, Y_PIE, pie.c_str());
+        HPDF_Page_EndText(page);
+        paginas_listas++;
+    }
 
-    // Creación del encabezado de la tabla
-    HPDF_Page_BeginText(page);
-    HPDF_Page_TextOut(page, xPosition, yPosition, "Nombre");
-    HPDF_Page_TextOut(page, xPosition + 150, yPosition, "ID Cuenta");
-    HPDF_Page_TextOut(page, xPosition + 300, yPosition, "Saldo");
-    HPDF_Page_EndText(page);
+    bool guardado = HPDF_SaveToFile(pdf, archivo.c_str()) == HPDF_OK;
+    if (!guardado) {
+        cerr << "Error al guardar el PDF " << archivo << endl;
+    }
+    HPDF_Free(pdf);
+    return guardado;
+}
 
-    // Dibujo de línea separadora bajo el encabezado
-    yPosition -= 20;
-    HPDF_Page_MoveTo(page, xPosition, yPosition);
-    HPDF_Page_LineTo(page, xPosition + 400, yPosition);
-    HPDF_Page_Stroke(page);
+} // namespace
+
+/**
+ * @brief Genera el reporte de clientes y cuentas repartiendo sus páginas entre varios hilos.
+ * @param clientes Puntero constante a la lista doblemente enlazada de clientes.
+ * @param opciones Nombre de salida, tamaño de cada parte, hilos y función de avance.
+ * @return Resumen con la cantidad de filas y páginas y los archivos generados.
+ * @details Las partes se asignan a los hilos a medida que quedan libres; el hilo que llama
+ * solo espera e informa el avance cada 100 ms.
+ */
+ResumenReportePDF generarReporteClientesPDF(const ListaDoble<Cliente*>* clientes, const OpcionesReportePDF& opciones) {
+    ResumenReportePDF resumen;
 
-    // Contador para el número total de entradas procesadas
-    int clientCount = 0;
-    
-    // Procesamiento de todos los clientes y sus cuentas usando lambdas anidadas
+    // Instantánea de la cartera: 16 bytes por cuenta, sin copiar nombres ni saldos
+    vector<FilaReporte> filas;
     clientes->recorrer([&](Cliente* c) {
-        // Para cada cliente, procesar todas sus cuentas
         c->get_cuentas()->recorrer([&](Cuenta* cuenta) {
-            clientCount++;
-            yPosition -= 20;
-            
-            // Verificación de espacio en página y creación de nueva página si es necesario
-            if (yPosition < 100) {
-                // Crear nueva página cuando se agota el espacio
-                page = HPDF_AddPage(pdf);
-                HPDF_Page_SetSize(page, HPDF_PAGE_SIZE_A4, HPDF_PAGE_PORTRAIT);
-                HPDF_Page_SetFontAndSize(page, font, 12);
-                yPosition = 750;
-                
-                // Recrear encabezado en la nueva página
-                HPDF_Page_BeginText(page);
-                HPDF_Page_TextOut(page, xPosition, yPosition, "Nombre");
-                HPDF_Page_TextOut(page, xPosition + 150, yPosition, "ID Cuenta");
-                HPDF_Page_TextOut(page, xPosition + 300, yPosition, "Saldo");
-                HPDF_Page_EndText(page);
-                yPosition -= 20;
-                
-                // Recrear línea separadora
-                HPDF_Page_MoveTo(page, xPosition, yPosition);
-                HPDF_Page_LineTo(page, xPosition + 400, yPosition);
-                HPDF_Page_Stroke(page);
-                yPosition -= 20;
+            filas.push_back({c, cuenta});
+        });
+    });
+    resumen.filas = filas.size();
+    resumen.paginas = max<size_t>(1, (filas.size() + FILAS_POR_PAGINA - 1) / FILAS_POR_PAGINA);
+
+    size_t por_parte = max<size_t>(1, opciones.paginas_por_parte);
+    size_t partes = (resumen.paginas + por_parte - 1) / por_parte;
+    for (size_t p = 0; p < partes; p++) {
+        if (partes == 1) {
+            resumen.archivos.push_back(opciones.archivo_base + ".pdf");
+        } else {
+            string numero = to_string(p + 1);
+            numero.insert(0, numero.size() < 3 ? 3 - numero.size() : 0, '0');
+            resumen.archivos.push_back(opciones.archivo_base + "_parte_" + numero + ".pdf");
+        }
+    }
+
+    unsigned hilos = opciones.hilos ? opciones.hilos : thread::hardware_concurrency();
+    if (hilos == 0) hilos = 1;
+    hilos = static_cast<unsigned>(min<size_t>(hilos, partes));
+
+    atomic<size_t> siguiente(0), paginas_listas(0), fallidas(0);
+    atomic<unsigned> activos(hilos);
+    auto trabajo = [&]() {
+        for (size_t p = siguiente++; p < partes; p = siguiente++) {
+            size_t primera = p * por_parte;
+            size_t fin = min(resumen.paginas, primera + por_parte);
+            if (!renderizarParte(filas, primera, fin, resumen.paginas, resumen.archivos[p], paginas_listas)) {
+                fallidas++;
             }
+        }
+        activos--;
+    };
+    vector<thread> trabajadores;
+    for (unsigned t = 0; t < hilos; t++) trabajadores.emplace_back(trabajo);
 
-            // Escritura de datos del cliente y cuenta en la página
-            HPDF_Page_BeginText(page);
-            string fullName = c->get_nombres() + " " + c->get_apellidos();
-            const char* name = fullName.c_str();
-            const char* account = cuenta->get_id_cuenta().c_str();
-            string saldoStr = to_string(cuenta->get_saldo());
-            const char* balance = saldoStr.c_str();
-            
-            // Debug: mostrar información que se está escribiendo
-            cout << "Escribiendo: Nombre=" << name << ", ID=" << account << ", Saldo=" << balance << endl;
-            
-            // Posicionar texto en las columnas correspondientes
-            HPDF_Page_TextOut(page, xPosition, yPosition, name);           // Columna nombre
-            HPDF_Page_TextOut(page, xPosition + 150, yPosition, account);  // Columna ID cuenta
-            HPDF_Page_TextOut(page, xPosition + 300, yPosition, balance);  // Columna saldo
-            HPDF_Page_EndText(page);        });
-    });
+    while (activos > 0) {
+        if (opciones.progreso) opciones.progreso(paginas_listas, resumen.paginas);
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+    for (auto& trabajador : trabajadores) trabajador.join();
+    if (opciones.progreso) opciones.progreso(paginas_listas, resumen.paginas);
+
+    resumen.exito = (fallidas == 0);
+    return resumen;
+}
+
+/**
+ * @brief Genera un reporte PDF con datos de clientes y sus cuentas bancarias.
+ * @param clientes Puntero constante a la lista doblemente enlazada de clientes.
+ * @details Esta función crea un documento PDF que contiene un reporte tabular con
+ * información de todos los clientes y sus cuentas bancarias. El reporte incluye:
+ * - Nombre completo del cliente (nombres + apellidos)
+ * - ID de cada cuenta bancaria
+ * - Saldo actual de cada cuenta
+ * 
+ * El PDF se genera con formato A4 en orientación vertical, usando fuente Helvetica
+ * de 12 puntos. Incluye paginación automática cuando el contenido excede el espacio
+ * disponible en una página. Las páginas se renderizan en paralelo con
+ * generarReporteClientesPDF y el avance se muestra en la consola.
+ * 
+ * @note La función utiliza la librería Haru PDF (libhpdf) para la generación del documento.
+ * @warning Si no se pueden cargar las fuentes o crear el PDF, se informa el error.
+ */
+void generateClientDataPDF(const ListaDoble<Cliente*>* clientes) {
+    cout << "Procesando datos de clientes desde memoria..." << endl;
+
+    OpcionesReportePDF opciones;
+    opciones.progreso = [](size_t listas, size_t total) {
+        cout << "\rPáginas generadas: " << listas << " de " << total
+             << " (" << (total ? listas * 100 / total : 100) << "%)   " << flush;
+    };
+    ResumenReportePDF resumen = generarReporteClientesPDF(clientes, opciones);
+    cout << endl;
 
     // Verificación de datos procesados
-    if (clientCount == 0) {
+    if (resumen.filas == 0) {
         cout << "No se encontraron datos en memoria" << endl;
     }
-
-    // Guardado del documento PDF en archivo
-    HPDF_SaveToFile(pdf, "clientes.pdf");
-    
-    // Liberación de memoria del documento PDF
-    HPDF_Free(pdf);
+    if (!resumen.exito) {
+        cerr << "Error en generateClientDataPDF: no se pudieron generar todas las partes del reporte" << endl;
+        return;
+    }
 
     // Confirmación de éxito en la generación
-    cout << "PDF de clientes generado exitosamente como clientes.pdf" << endl;
-}
\ No newline at end of file
+    if (resumen.archivos.size() == 1) {
+        cout << "PDF de clientes generado exitosamente como " << resumen.archivos[0] << endl;
+    } else {
+        cout << "PDF de clientes generado exitosamente en " << resumen.archivos.size() << " partes ("
+             << resumen.archivos.front() << " ... " << resumen.archivos.back() << ")" << endl;
+    }
+    cout << resumen.filas << " cuentas en " << resumen.paginas << " páginas" << endl;
+}
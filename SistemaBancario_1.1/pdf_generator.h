@@ -14,6 +14,10 @@
 #include "Cliente.h"    // Para la declaración de Cliente
 #include "Cuenta.h"     // Para la declaración de Cuenta
 #include "hpdf.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
 
 /**
  * @brief Genera un reporte PDF con datos de clientes y sus cuentas bancarias.
@@ -23,16 +27,53 @@
  * El reporte incluye nombre completo, ID de cuenta y saldo actual.
  * 
  * @note Utiliza la librería Haru PDF para la generación del documento.
- * @note El archivo se guarda como "clientes.pdf" en el directorio de trabajo.
+ * @note El archivo se guarda como "clientes.pdf" en el directorio de trabajo; si el reporte
+ * supera las 500 páginas se divide en clientes_parte_001.pdf, clientes_parte_002.pdf, etc.
  * @warning Requiere que la librería libhpdf esté correctamente instalada y enlazada.
  * 
  * Características del PDF generado:
  * - Formato: A4 vertical
  * - Fuente: Helvetica 12pt
  * - Paginación automática
- * - Encabezados en cada página
+ * - Encabezados y número de página en cada página
+ * - Páginas renderizadas en paralelo (ver generarReporteClientesPDF)
  * - Formato tabular con columnas alineadas
  */
 void generateClientDataPDF(const ListaDoble<Cliente*>* clientes);
 
+/**
+ * @brief Opciones del generador de reportes de clientes.
+ */
+struct OpcionesReportePDF {
+    std::string archivo_base = "clientes";  ///< Nombre de salida sin extensión
+    size_t paginas_por_parte = 500;         ///< Páginas máximas de cada documento generado
+    unsigned hilos = 0;                     ///< Hilos de render (0 = núcleos disponibles)
+    /// Avance (páginas listas, páginas totales); se invoca desde el hilo que llama. Vacío = sin avance
+    std::function<void(size_t, size_t)> progreso;
+};
+
+/**
+ * @brief Resultado de la generación de un reporte de clientes.
+ */
+struct ResumenReportePDF {
+    size_t filas = 0;                   ///< Cuentas listadas
+    size_t paginas = 0;                 ///< Páginas del reporte completo
+    std::vector<std::string> archivos;  ///< Documentos generados, en orden
+    bool exito = false;                 ///< true si se generaron todas las partes
+};
+
+/**
+ * @brief Genera el reporte de clientes y cuentas repartiendo sus páginas entre varios hilos.
+ * @param clientes Puntero constante a la lista doblemente enlazada de clientes.
+ * @param opciones Nombre de salida, tamaño de cada parte, hilos y función de avance.
+ * @return Resumen con la cantidad de filas y páginas y los archivos generados.
+ * @details Primero se toma una instantánea de la cartera (un par cliente/cuenta por fila) y se
+ * calcula el número de páginas; luego las páginas se dividen en partes de paginas_por_parte
+ * páginas que los hilos renderizan en documentos independientes. Si todo cabe en una parte se
+ * escribe <archivo_base>.pdf; si no, <archivo_base>_parte_001.pdf, _parte_002.pdf, etc. En memoria
+ * hay a lo sumo un documento por hilo, por lo que el consumo no crece con el tamaño de la cartera.
+ * @warning La lista de clientes no debe modificarse mientras se genera el reporte.
+ */
+ResumenReportePDF generarReporteClientesPDF(const ListaDoble<Cliente*>* clientes, const OpcionesReportePDF& opciones);
+
 #endif
\ No newline at end of file